@@ -0,0 +1,152 @@
+/**
+ * @file
+ * @brief Measure the cost per simulated cycle of champsim::cycle_engine against the serial loop, per number of CPUs.
+ * "serial" operates every operable in order on one thread, "engine" operates each CPU's private operables on up to
+ * one OpenMP thread per CPU and then the shared ones in order, as do_cycle() does with PARALLEL_CYCLE_ENGINE.
+ * Every operable does a fixed amount of work per cycle, standing in for a core or a cache, and both runs must end in the same state.
+ * The speedup is bounded by the cores of the machine and by the share of the shared operables in a cycle.
+ *
+ * Usage: cycle_engine_benchmark [cycles] [work per operate] [threads]
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <functional>
+#include <vector>
+
+#include "ChampSim/chrono.h"
+#include "ChampSim/cycle_engine.h"
+#include "ChampSim/operable.h"
+#include "ChampSim/operable_schedule.h"
+
+namespace
+{
+
+constexpr std::size_t PRIVATE_OPERABLES_PER_CPU = 7; // Core, L1I, L1D, ITLB, DTLB, STLB and L2C
+
+class busy_operable : public champsim::operable
+{
+public:
+    busy_operable(champsim::chrono::picoseconds clock_period, long work_): champsim::operable(clock_period), work(work_) {}
+
+    long work;
+    uint64_t state {1};
+
+    long operate() override
+    {
+        for (long i = 0; i < work; ++i)
+        {
+            state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        }
+        return static_cast<long>(state & 1);
+    }
+};
+
+/**
+ * @brief Operables laid out like generated_environment: the cores, then each CPU's caches, then the LLC, the page table walkers and main memory.
+ */
+struct busy_environment
+{
+    std::deque<busy_operable> operables {};
+    std::size_t num_cpus;
+
+    busy_environment(std::size_t num_cpus_, champsim::chrono::picoseconds period, long work): num_cpus(num_cpus_)
+    {
+        // Private operables, then the LLC, one page table walker per CPU and main memory
+        for (std::size_t i = 0; i < num_cpus * PRIVATE_OPERABLES_PER_CPU + 1 + num_cpus + 1; ++i)
+        {
+            operables.emplace_back(period, work);
+        }
+    }
+
+    std::vector<std::reference_wrapper<champsim::operable> > operable_view() { return {std::begin(operables), std::end(operables)}; }
+
+    std::vector<std::reference_wrapper<champsim::operable> > private_operable_view(std::size_t cpu)
+    {
+        std::vector<std::reference_wrapper<champsim::operable> > retval {};
+        retval.emplace_back(operables.at(cpu));
+        for (std::size_t i = 0; i < PRIVATE_OPERABLES_PER_CPU - 1; ++i)
+        {
+            retval.emplace_back(operables.at(num_cpus + cpu * (PRIVATE_OPERABLES_PER_CPU - 1) + i));
+        }
+        return retval;
+    }
+
+    uint64_t checksum() const
+    {
+        uint64_t retval {0};
+        for (const auto& op : operables)
+        {
+            retval = retval * 31 + op.state;
+        }
+        return retval;
+    }
+};
+
+/**
+ * @return ns per cycle of do_cycle() operating through an engine of the given threads.
+ */
+double run(busy_environment& env, int num_threads, champsim::chrono::picoseconds time_quantum, long cycles)
+{
+    std::vector<champsim::cycle_engine::operable_list> private_operables {};
+    for (std::size_t cpu = 0; cpu < env.num_cpus; ++cpu)
+    {
+        private_operables.push_back(env.private_operable_view(cpu));
+    }
+    champsim::cycle_engine engine {std::move(private_operables), num_threads};
+    champsim::operable_schedule schedule {env.operable_view()};
+
+    champsim::chrono::clock global_clock;
+    long progress {0};
+    const auto start = std::chrono::steady_clock::now();
+    for (long cycle = 0; cycle < cycles; ++cycle)
+    {
+        global_clock.tick(time_quantum);
+        schedule.update();
+        progress += engine.operate_private(schedule, global_clock);
+        progress += engine.operate_shared(schedule, global_clock);
+    }
+    const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+
+    // Keep the work observable
+    if (progress < 0)
+    {
+        std::abort();
+    }
+    return elapsed.count() / static_cast<double>(cycles);
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const long cycles      = (argc > 1) ? std::atol(argv[1]) : 200000;
+    const long work        = (argc > 2) ? std::atol(argv[2]) : 50;
+    const int max_threads  = (argc > 3) ? std::atoi(argv[3]) : omp_get_max_threads();
+
+    const champsim::chrono::picoseconds period {250};
+
+    std::printf("%d OpenMP threads at most, %d processors\n", max_threads, omp_get_num_procs());
+    std::printf("%5s %8s %16s %16s %8s %10s\n", "cores", "threads", "serial", "engine", "speedup", "identical");
+    for (std::size_t num_cpus : {1, 2, 4, 8, 16})
+    {
+        busy_environment serial_env {num_cpus, period, work};
+        busy_environment engine_env {num_cpus, period, work};
+
+        const double before = run(serial_env, 1, period, cycles);
+        const double after  = run(engine_env, max_threads, period, cycles);
+        const bool identical = serial_env.checksum() == engine_env.checksum();
+        std::printf("%5zu %8d %10.1f ns/cyc %10.1f ns/cyc %7.2fx %10s\n", num_cpus, std::min(max_threads, static_cast<int>(num_cpus)), before, after, before / after,
+            identical ? "yes" : "NO");
+        if (! identical)
+        {
+            return EXIT_FAILURE;
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,116 @@
+/**
+ * @file
+ * @brief Measure the cost on the simulation thread of recording one DRAM request into the memory trace.
+ * "text" is the fprintf() that MEMORY_TRACE::output_memory_trace_hexadecimal() did before BINARY_MEMORY_TRACE,
+ * "binary" hands the request to a binary_memory_trace::BinaryMemoryTraceWriter.
+ * The requests mix sequential streams with random accesses, and the file sizes are reported too.
+ *
+ * Usage: memory_trace_writer_benchmark [requests] [output directory]
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "binary_memory_trace.h"
+
+namespace
+{
+
+struct request
+{
+    uint64_t address;
+    bool is_write;
+};
+
+std::vector<request> make_requests(std::size_t count)
+{
+    std::mt19937_64 rng {1};
+    std::vector<request> requests {};
+    requests.reserve(count);
+
+    uint64_t stream = 0;
+    while (requests.size() < count)
+    {
+        if (rng() % 4 == 0)
+        {
+            requests.push_back({(rng() % (16ul << 30)) & ~0x3ful, rng() % 3 == 0});
+        }
+        else
+        {
+            stream = (rng() % 64 == 0) ? (rng() % (16ul << 30)) & ~0xffful : stream + 64;
+            requests.push_back({stream, false});
+        }
+    }
+    return requests;
+}
+
+/**
+ * @return ns per request spent on the calling thread, including closing the file.
+ */
+template<typename Record>
+double measure(const std::vector<request>& requests, const std::string& path, Record&& record)
+{
+    FILE* file = std::fopen(path.c_str(), "w");
+    if (file == nullptr)
+    {
+        std::perror(path.c_str());
+        std::exit(EXIT_FAILURE);
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    record(file, requests);
+    std::fclose(file);
+    const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / static_cast<double>(requests.size());
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const std::size_t count        = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 20000000;
+    const std::filesystem::path dir = (argc > 2) ? argv[2] : std::filesystem::temp_directory_path();
+    const std::string text_path    = (dir / "memory_trace_writer_benchmark.trace").string();
+    const std::string binary_path  = (dir / "memory_trace_writer_benchmark.trace.xz").string();
+
+    const auto requests = make_requests(count);
+
+    const double text = measure(requests, text_path,
+        [](FILE* file, const std::vector<request>& requests)
+        {
+            for (const auto& r : requests)
+            {
+                std::fprintf(file, "0x%lx %c\n", r.address, r.is_write ? 'W' : 'R');
+            }
+        });
+
+    double binary_close = 0;
+    const double binary = measure(requests, binary_path,
+        [&binary_close, count](FILE* file, const std::vector<request>& requests)
+        {
+            binary_memory_trace::BinaryMemoryTraceWriter writer {file};
+            for (const auto& r : requests)
+            {
+                writer.write(r.address, r.is_write);
+            }
+
+            const auto start = std::chrono::steady_clock::now();
+            writer.close();
+            const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+            binary_close = elapsed.count() / static_cast<double>(count);
+        });
+
+    std::printf("%-8s %14s %14s\n", "format", "ns/request", "file size");
+    std::printf("%-8s %14.1f %11.1f MiB\n", "text", text, std::filesystem::file_size(text_path) / 1048576.0);
+    std::printf("%-8s %14.1f %11.1f MiB  (%.1f ns/request waiting for the writer at close)\n", "binary", binary,
+        std::filesystem::file_size(binary_path) / 1048576.0, binary_close);
+
+    std::filesystem::remove(text_path);
+    std::filesystem::remove(binary_path);
+    return EXIT_SUCCESS;
+}
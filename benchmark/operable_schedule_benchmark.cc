@@ -0,0 +1,159 @@
+/**
+ * @file
+ * @brief Measure the cost per simulated cycle of ordering the operables in champsim::do_cycle().
+ * "per-cycle sort" rebuilds operable_view() and sorts it every cycle, as do_cycle() used to,
+ * "persistent schedule" updates a champsim::operable_schedule kept across cycles.
+ * The operables do almost no work, so the difference is the scheduling overhead itself.
+ *
+ * Usage: operable_schedule_benchmark [cycles]
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <functional>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#include "ChampSim/chrono.h"
+#include "ChampSim/operable.h"
+#include "ChampSim/operable_schedule.h"
+
+namespace
+{
+
+constexpr std::size_t PRIVATE_OPERABLES_PER_CPU = 7; // Core, L1I, L1D, ITLB, DTLB, STLB and L2C
+
+class dummy_operable : public champsim::operable
+{
+public:
+    using champsim::operable::operable;
+
+    long work {0};
+
+    long operate() override { return ++work & 1; }
+};
+
+/**
+ * @brief Operables laid out like generated_environment: private ones per CPU, then the page table walkers, the LLC and main memory.
+ */
+struct dummy_environment
+{
+    std::deque<dummy_operable> cpu_operables {};
+    std::deque<dummy_operable> shared_operables {};
+
+    dummy_environment(std::size_t num_cpus, champsim::chrono::picoseconds cpu_period, champsim::chrono::picoseconds dram_period)
+    {
+        for (std::size_t i = 0; i < num_cpus * PRIVATE_OPERABLES_PER_CPU; ++i)
+        {
+            cpu_operables.emplace_back(cpu_period);
+        }
+
+        for (std::size_t i = 0; i < num_cpus + 1; ++i)
+        {
+            shared_operables.emplace_back(cpu_period);
+        }
+
+        shared_operables.emplace_back(dram_period);
+    }
+
+    std::vector<std::reference_wrapper<champsim::operable> > operable_view()
+    {
+        std::vector<std::reference_wrapper<champsim::operable> > retval {};
+        std::copy(std::begin(cpu_operables), std::end(cpu_operables), std::back_inserter(retval));
+        std::copy(std::begin(shared_operables), std::end(shared_operables), std::back_inserter(retval));
+        return retval;
+    }
+
+    champsim::operable_schedule schedule() { return champsim::operable_schedule {operable_view()}; }
+};
+
+/**
+ * @return ns per cycle of the old do_cycle() ordering.
+ */
+double run_per_cycle_sort(dummy_environment& env, champsim::chrono::picoseconds time_quantum, long cycles)
+{
+    champsim::chrono::clock global_clock;
+    long progress {0};
+    const auto start = std::chrono::steady_clock::now();
+    for (long cycle = 0; cycle < cycles; ++cycle)
+    {
+        global_clock.tick(time_quantum);
+        auto operables = env.operable_view();
+        std::stable_sort(std::begin(operables), std::end(operables),
+            [](const champsim::operable& lhs, const champsim::operable& rhs)
+            { return lhs.current_time < rhs.current_time; });
+        for (champsim::operable& op : operables)
+        {
+            progress += op.operate_on(global_clock);
+        }
+    }
+    const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+
+    // Keep the work observable
+    if (progress < 0)
+    {
+        std::abort();
+    }
+    return elapsed.count() / static_cast<double>(cycles);
+}
+
+/**
+ * @return ns per cycle of the persistent schedule.
+ */
+double run_persistent_schedule(dummy_environment& env, champsim::chrono::picoseconds time_quantum, long cycles)
+{
+    auto schedule = env.schedule();
+    champsim::chrono::clock global_clock;
+    long progress {0};
+    const auto start = std::chrono::steady_clock::now();
+    for (long cycle = 0; cycle < cycles; ++cycle)
+    {
+        global_clock.tick(time_quantum);
+        schedule.update();
+        for (champsim::operable& op : schedule.operables())
+        {
+            progress += op.operate_on(global_clock);
+        }
+    }
+    const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+
+    if (progress < 0)
+    {
+        std::abort();
+    }
+    return elapsed.count() / static_cast<double>(cycles);
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const long cycles = (argc > 1) ? std::atol(argv[1]) : 2000000;
+
+    const champsim::chrono::picoseconds cpu_period {250};
+    // Lockstep is what the simulator runs today, mixed clocks make the order change from cycle to cycle
+    const std::pair<const char*, champsim::chrono::picoseconds> clockings[] = {
+        {"lockstep", cpu_period},
+        {"mixed clocks", champsim::chrono::picoseconds {625}}
+    };
+
+    std::printf("%-12s %5s %20s %20s %8s\n", "clocking", "cores", "per-cycle sort", "persistent schedule", "speedup");
+    for (const auto& [clocking, dram_period] : clockings)
+    {
+        for (std::size_t num_cpus : {1, 4, 16})
+        {
+            dummy_environment sorted_env {num_cpus, cpu_period, dram_period};
+            dummy_environment scheduled_env {num_cpus, cpu_period, dram_period};
+
+            const double before = run_per_cycle_sort(sorted_env, cpu_period, cycles);
+            const double after  = run_persistent_schedule(scheduled_env, cpu_period, cycles);
+            std::printf("%-12s %5zu %14.1f ns/cyc %14.1f ns/cyc %7.2fx\n", clocking, num_cpus, before, after, before / after);
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
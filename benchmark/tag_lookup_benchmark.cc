@@ -0,0 +1,167 @@
+/**
+ * @file
+ * @brief Measure the throughput of cache tag lookups per associativity.
+ * "blocks" searches the set of champsim::cache_block with std::find_if, as CACHE::try_hit() does without CACHE_SOA_TAG_STORE,
+ * the other columns look up a champsim::tag_array with each compare kernel the running CPU supports.
+ * Half of the lookups hit, in a random way of a random set. Every kernel is checked to find the same way as "blocks" before it is timed.
+ *
+ * Usage: tag_lookup_benchmark [lookups]
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iterator>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "ChampSim/address.h"
+#include "ChampSim/block.h"
+#include "ChampSim/tag_array.h"
+
+namespace
+{
+
+constexpr std::size_t NUM_SET     = 2048;
+constexpr unsigned LOG2_LINE_SIZE = 6;
+const champsim::data::bits OFFSET_BITS {LOG2_LINE_SIZE};
+
+struct lookup
+{
+    long set;
+    champsim::address address;
+};
+
+/**
+ * @brief A cache filled with distinct lines, stored both ways.
+ */
+struct filled_cache
+{
+    std::size_t num_way;
+    std::vector<champsim::cache_block> blocks;
+    std::vector<lookup> lookups {};
+
+    filled_cache(std::size_t num_way_, std::size_t num_lookups): num_way(num_way_), blocks(NUM_SET * num_way_)
+    {
+        std::mt19937_64 rng {1};
+        const auto line_of = [](long set, uint64_t tag)
+        { return champsim::address {((tag * NUM_SET) + static_cast<uint64_t>(set)) << LOG2_LINE_SIZE}; };
+
+        for (std::size_t index = 0; index < std::size(blocks); ++index)
+        {
+            blocks[index].valid   = true;
+            blocks[index].address = line_of(static_cast<long>(index / num_way), index % num_way);
+        }
+
+        lookups.reserve(num_lookups);
+        for (std::size_t i = 0; i < num_lookups; ++i)
+        {
+            const auto set = static_cast<long>(rng() % NUM_SET);
+            const auto way = rng() % num_way;
+            lookups.push_back({set, line_of(set, (rng() % 2 == 0) ? way : way + num_way)});
+        }
+    }
+
+    [[nodiscard]] champsim::tag_array make_tag_array(champsim::tag_array::compare_kernel kernel) const
+    {
+        champsim::tag_array tags {NUM_SET, num_way, kernel};
+        for (std::size_t index = 0; index < std::size(blocks); ++index)
+        {
+            tags.fill(static_cast<long>(index / num_way), static_cast<long>(index % num_way), blocks[index].address.slice_upper(OFFSET_BITS).to<uint64_t>());
+        }
+        return tags;
+    }
+};
+
+template<typename F>
+double time_lookups(const filled_cache& cache, F&& find_way)
+{
+    long hits        = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (const lookup& l : cache.lookups)
+    {
+        hits += (find_way(l) != static_cast<long>(cache.num_way));
+    }
+    const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+
+    // Keep the work observable
+    if (hits < 0)
+    {
+        std::abort();
+    }
+    return elapsed.count() / static_cast<double>(std::size(cache.lookups));
+}
+
+double run_blocks(const filled_cache& cache)
+{
+    return time_lookups(cache, [&cache](const lookup& l)
+        {
+            const auto set_begin = std::next(std::begin(cache.blocks), l.set * static_cast<long>(cache.num_way));
+            const auto set_end   = std::next(set_begin, static_cast<long>(cache.num_way));
+            const auto match     = l.address.slice_upper(OFFSET_BITS);
+            return std::distance(set_begin, std::find_if(set_begin, set_end, [match](const auto& x)
+                                                { return x.valid && x.address.slice_upper(OFFSET_BITS) == match; }));
+        });
+}
+
+double run_tag_array(const filled_cache& cache, champsim::tag_array::compare_kernel kernel)
+{
+    const champsim::tag_array tags = cache.make_tag_array(kernel);
+    for (const lookup& l : cache.lookups)
+    {
+        const auto set_begin = std::next(std::begin(cache.blocks), l.set * static_cast<long>(cache.num_way));
+        const auto expected  = std::distance(set_begin, std::find_if(set_begin, std::next(set_begin, static_cast<long>(cache.num_way)), [&l](const auto& x)
+                                                  { return x.address.slice_upper(OFFSET_BITS) == l.address.slice_upper(OFFSET_BITS); }));
+        if (tags.find(l.set, l.address.slice_upper(OFFSET_BITS).to<uint64_t>()) != expected)
+        {
+            std::fprintf(stderr, "tag_array finds another way than the blocks in a %zu-way set\n", cache.num_way);
+            std::exit(EXIT_FAILURE);
+        }
+    }
+
+    return time_lookups(cache, [&tags](const lookup& l)
+        { return tags.find(l.set, l.address.slice_upper(OFFSET_BITS).to<uint64_t>()); });
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const std::size_t lookups = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+
+    using kernel_type = champsim::tag_array::compare_kernel;
+    const std::pair<const char*, kernel_type> kernels[] = {
+        {"scalar", kernel_type::scalar},
+        {"sse4.1", kernel_type::sse4_1},
+        {"avx2",   kernel_type::avx2  }
+    };
+
+    std::printf("%5s %15s", "ways", "blocks");
+    for (const auto& [name, kernel] : kernels)
+    {
+        std::printf(" %15s", name);
+    }
+    std::printf("   (ns/lookup)\n");
+
+    for (std::size_t num_way : {4, 8, 12, 16, 20, 32, 64})
+    {
+        const filled_cache cache {num_way, lookups};
+        std::printf("%5zu %15.2f", num_way, run_blocks(cache));
+        for (const auto& [name, kernel] : kernels)
+        {
+            if (champsim::tag_array::is_supported(kernel))
+            {
+                std::printf(" %15.2f", run_tag_array(cache, kernel));
+            }
+            else
+            {
+                std::printf(" %15s", "unsupported");
+            }
+        }
+        std::printf("\n");
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,179 @@
+#ifndef ASYNC_ISTREAM_H
+#define ASYNC_ISTREAM_H
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <ios>
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "ProjectConfiguration.h" // User file
+
+namespace champsim
+{
+/**
+ * @brief Reads a stream ahead of its reader on a background thread.
+ * @details
+ * A decoder thread reads (and so decompresses) the underlying stream block by block into a single-producer single-consumer ring,
+ * and read() only copies the decoded bytes out of the ring, so no decompression runs on the simulation thread.
+ * The decoder stays at most the ring depth ahead of the reader, and each side blocks (without spinning) only if the other falls a whole ring behind or ahead.
+ * The bytes come out in the same order as from the underlying stream, so the reader behaves exactly as if it read the stream itself.
+ *
+ * @tparam F The underlying stream, which provides read(), gcount() and eof() as std::istream does.
+ */
+template<typename F>
+class async_istream
+{
+public:
+    static constexpr std::size_t BLOCK_SIZE = 1 << 16; // Bytes
+
+    explicit async_istream(std::string s, std::size_t depth = TRACE_PREFETCH_DEPTH): state(std::make_unique<shared_state>(F {s}, depth))
+    {
+        decoder = std::thread(&shared_state::run, state.get());
+    }
+
+    explicit async_istream(F&& str, std::size_t depth = TRACE_PREFETCH_DEPTH): state(std::make_unique<shared_state>(std::move(str), depth))
+    {
+        decoder = std::thread(&shared_state::run, state.get());
+    }
+
+    async_istream(async_istream&& other) noexcept = default;
+
+    async_istream& operator=(async_istream&& other) noexcept
+    {
+        stop();
+        state   = std::move(other.state);
+        decoder = std::move(other.decoder);
+        gcount_ = other.gcount_;
+        eof_    = other.eof_;
+        return *this;
+    }
+
+    async_istream(const async_istream&)            = delete;
+    async_istream& operator=(const async_istream&) = delete;
+
+    ~async_istream() { stop(); }
+
+    async_istream& read(char* s, std::streamsize count)
+    {
+        auto remaining = static_cast<std::size_t>(count);
+        while (remaining > 0 && state->next_block())
+        {
+            const std::size_t copied = state->copy_out(s, remaining);
+            s += copied;
+            remaining -= copied;
+        }
+
+        gcount_ = count - static_cast<std::streamsize>(remaining);
+        eof_    = (remaining > 0);
+        return *this;
+    }
+
+    [[nodiscard]] bool eof() const { return eof_; }
+
+    [[nodiscard]] std::streamsize gcount() const { return gcount_; }
+
+private:
+    struct block
+    {
+        std::array<char, BLOCK_SIZE> bytes;
+        std::size_t size = 0;
+        bool last        = false; // The underlying stream ends with this block
+    };
+
+    struct shared_state
+    {
+        F file;
+        std::vector<block> ring;
+        alignas(64) std::atomic<std::size_t> ring_head {0}; // Next block the decoder thread fills
+        alignas(64) std::atomic<std::size_t> ring_tail {0}; // Next block the reader drains
+        alignas(64) std::atomic<bool> stopping {false};
+
+        // Touched by the reader only
+        std::size_t offset = 0;     // Bytes of the tail block already read
+        bool finished      = false; // The last block has been drained
+
+        shared_state(F&& file_, std::size_t depth): file(std::move(file_)), ring(std::max<std::size_t>(depth, 1)) {}
+
+        void run()
+        {
+            for (bool last = false; ! last;)
+            {
+                const std::size_t head = ring_head.load(std::memory_order_relaxed);
+                for (std::size_t tail = ring_tail.load(std::memory_order_acquire); head - tail >= std::size(ring); tail = ring_tail.load(std::memory_order_acquire))
+                {
+                    if (stopping.load(std::memory_order_relaxed))
+                    {
+                        return;
+                    }
+                    ring_tail.wait(tail, std::memory_order_acquire); // The reader is a whole ring behind
+                }
+
+                block& b = ring[head % std::size(ring)];
+                file.read(std::data(b.bytes), static_cast<std::streamsize>(std::size(b.bytes)));
+                b.size = static_cast<std::size_t>(file.gcount());
+                b.last = last = file.eof() || (b.size < std::size(b.bytes));
+                ring_head.store(head + 1, std::memory_order_release);
+                ring_head.notify_one();
+            }
+        }
+
+        /** @return Whether a block with bytes left to read is at the tail of the ring, waiting for the decoder if needed */
+        bool next_block()
+        {
+            while (! finished)
+            {
+                const std::size_t tail = ring_tail.load(std::memory_order_relaxed);
+                ring_head.wait(tail, std::memory_order_acquire); // Returns at once unless the decoder is behind
+
+                const block& b = ring[tail % std::size(ring)];
+                if (offset < b.size)
+                {
+                    return true;
+                }
+
+                finished = b.last;
+                offset   = 0;
+                ring_tail.store(tail + 1, std::memory_order_release);
+                ring_tail.notify_one();
+            }
+            return false;
+        }
+
+        /** @return The number of bytes copied from the tail block */
+        std::size_t copy_out(char* s, std::size_t count)
+        {
+            const block& b           = ring[ring_tail.load(std::memory_order_relaxed) % std::size(ring)];
+            const std::size_t copied = std::min(count, b.size - offset);
+            std::memcpy(s, std::data(b.bytes) + offset, copied);
+            offset += copied;
+            return copied;
+        }
+    };
+
+    std::unique_ptr<shared_state> state;
+    std::thread decoder;
+    std::streamsize gcount_ = 0;
+    bool eof_               = false;
+
+    void stop()
+    {
+        if (decoder.joinable())
+        {
+            state->stopping.store(true, std::memory_order_relaxed);
+            // Wake the decoder if it waits for the reader; nothing reads the ring any more
+            state->ring_tail.fetch_add(1, std::memory_order_release);
+            state->ring_tail.notify_one();
+            decoder.join();
+        }
+    }
+};
+} // namespace champsim
+
+#endif
@@ -23,6 +23,10 @@ public:
     // void initialize_branch_predictor();
     bool predict_branch(champsim::address ip);
     void last_branch_result(champsim::address ip, champsim::address branch_target, bool taken, uint8_t branch_type);
+
+#if (USER_CODES == ENABLE)
+    void branch_predictor_checkpoint(champsim::checkpoint_archive& archive);
+#endif /* USER_CODES */
 };
 
 #endif
@@ -21,6 +21,10 @@ struct gshare : champsim::modules::branch_predictor
     static std::size_t gs_table_hash(champsim::address ip, std::bitset<GLOBAL_HISTORY_LENGTH> bh_vector);
     bool predict_branch(champsim::address ip);
     void last_branch_result(champsim::address ip, champsim::address branch_target, bool taken, uint8_t branch_type);
+
+#if (USER_CODES == ENABLE)
+    void branch_predictor_checkpoint(champsim::checkpoint_archive& archive);
+#endif /* USER_CODES */
 };
 
 #endif
@@ -38,6 +38,17 @@ public:
    *  Insert this value into the shift register
    **/
     void push_back(bool ins);
+
+#if (USER_CODES == ENABLE)
+    /**
+   * Save or restore the history through a champsim::checkpoint_archive
+   **/
+    template<typename Archive>
+    void checkpoint(Archive& archive)
+    {
+        archive(words);
+    }
+#endif /* USER_CODES */
 };
 
 template<champsim::data::bits WORD_LEN>
@@ -54,6 +54,10 @@ public:
     bool predict_branch(champsim::address pc);
     void last_branch_result(champsim::address pc, champsim::address branch_target, bool taken, uint8_t branch_type);
     void adjust_threshold(bool correct);
+
+#if (USER_CODES == ENABLE)
+    void branch_predictor_checkpoint(champsim::checkpoint_archive& archive);
+#endif /* USER_CODES */
 };
 
 #endif
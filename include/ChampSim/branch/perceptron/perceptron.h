@@ -51,6 +51,10 @@ struct perceptron : champsim::modules::branch_predictor
 
     bool predict_branch(champsim::address ip);
     void last_branch_result(champsim::address ip, champsim::address branch_target, bool taken, uint8_t branch_type);
+
+#if (USER_CODES == ENABLE)
+    void branch_predictor_checkpoint(champsim::checkpoint_archive& archive);
+#endif /* USER_CODES */
 };
 
 template<std::size_t HISTLEN, std::size_t BITS>
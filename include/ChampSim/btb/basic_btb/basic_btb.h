@@ -21,6 +21,10 @@ public:
     // void initialize_btb();
     std::pair<champsim::address, bool> btb_prediction(champsim::address ip);
     void update_btb(champsim::address ip, champsim::address branch_target, bool taken, uint8_t branch_type);
+
+#if (USER_CODES == ENABLE)
+    void btb_checkpoint(champsim::checkpoint_archive& archive);
+#endif /* USER_CODES */
 };
 
 #endif
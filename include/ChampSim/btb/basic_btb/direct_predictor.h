@@ -48,6 +48,14 @@ struct direct_predictor
     champsim::msl::lru_table<btb_entry_t> BTB {sets, ways};
     std::optional<btb_entry_t> check_hit(champsim::address ip);
     void update(champsim::address ip, champsim::address branch_target, uint8_t branch_type);
+
+#if (USER_CODES == ENABLE)
+    template<typename Archive>
+    void checkpoint(Archive& archive)
+    {
+        archive(BTB);
+    }
+#endif /* USER_CODES */
 };
 
 #endif
@@ -24,6 +24,14 @@ struct indirect_predictor
     std::pair<champsim::address, bool> prediction(champsim::address ip);
     void update_target(champsim::address ip, champsim::address branch_target);
     void update_direction(bool taken);
+
+#if (USER_CODES == ENABLE)
+    template<typename Archive>
+    void checkpoint(Archive& archive)
+    {
+        archive(predictor, conditional_history);
+    }
+#endif /* USER_CODES */
 };
 
 #endif
@@ -32,6 +32,14 @@ struct return_stack
     std::pair<champsim::address, bool> prediction();
     void push(champsim::address ip);
     void calibrate_call_size(champsim::address branch_target);
+
+#if (USER_CODES == ENABLE)
+    template<typename Archive>
+    void checkpoint(Archive& archive)
+    {
+        archive(stack, call_size_trackers);
+    }
+#endif /* USER_CODES */
 };
 
 #endif
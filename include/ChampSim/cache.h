@@ -29,6 +29,7 @@
 #include <iterator> // for size
 #include <limits>   // for numeric_limits
 #include <memory>
+#include <optional>
 #include <stdexcept>
 #include <string>
 #include <type_traits>
@@ -42,7 +43,9 @@
 #include "ChampSim/channel.h"
 #include "ChampSim/chrono.h"
 #include "ChampSim/modules.h"
+#include "ChampSim/msl/flat_hash_table.h"
 #include "ChampSim/operable.h"
+#include "ChampSim/tag_array.h"
 #include "ChampSim/util/to_underlying.h" // for to_underlying
 #include "ChampSim/waitable.h"
 #include "ProjectConfiguration.h" // User file
@@ -83,8 +86,8 @@ class CACHE : public champsim::operable
 
         champsim::chrono::clock::time_point event_cycle = champsim::chrono::clock::time_point::max();
 
-        std::vector<uint64_t> instr_depend_on_me {};
-        std::vector<std::deque<response_type>*> to_return {};
+        champsim::dependent_instructions instr_depend_on_me {};
+        champsim::response_queues<response_type> to_return {};
 
         explicit tag_lookup_type(request_type req): tag_lookup_type(req, false, false) {}
 
@@ -115,8 +118,8 @@ public:
 
         champsim::chrono::clock::time_point time_enqueued;
 
-        std::vector<uint64_t> instr_depend_on_me {};
-        std::vector<std::deque<response_type>*> to_return {};
+        champsim::dependent_instructions instr_depend_on_me {};
+        champsim::response_queues<response_type> to_return {};
 
         fill_type(const tag_lookup_type& req, champsim::chrono::clock::time_point _time_enqueued);
         static fill_type merge(fill_type predecessor, fill_type successor);
@@ -154,11 +157,21 @@ private:
     champsim::address module_address(const T& element) const;
 
     auto matches_address(champsim::address address) const;
+#if (USER_CODES == ENABLE)
+    /** @return The block address, which is the tag compared by matches_address() */
+    [[nodiscard]] uint64_t get_tag(champsim::address address) const;
+#endif /* USER_CODES */
     std::pair<fill_type, request_type> mshr_and_forward_packet(const tag_lookup_type& handle_pkt);
 
-    std::deque<tag_lookup_type> internal_PQ {};
-    std::deque<tag_lookup_type> inflight_tag_check {};
-    std::deque<tag_lookup_type> translation_stash {};
+    champsim::packet_queue<tag_lookup_type> internal_PQ {};
+    champsim::packet_queue<tag_lookup_type> inflight_tag_check {};
+    champsim::packet_queue<tag_lookup_type> translation_stash {};
+#if (USER_CODES == ENABLE) && (INSTRUCTION_INLINE_STORAGE == ENABLE)
+
+    // Kept from cycle to cycle, so operate() does not allocate them every cycle
+    std::vector<tag_lookup_type> partition_buffer {}; // The entries a stable partition moves behind the others
+    std::vector<long long> channels_bandwidth_consumed {};
+#endif /* USER_CODES, INSTRUCTION_INLINE_STORAGE */
 
 public:
     std::vector<channel_type*> upper_levels;
@@ -173,6 +186,13 @@ public:
     champsim::chrono::clock::duration FILL_LATENCY;
     champsim::data::bits OFFSET_BITS;
     set_type block {static_cast<typename set_type::size_type>(NUM_SET * NUM_WAY)};
+#if (CACHE_SOA_TAG_STORE == ENABLE)
+
+private:
+    champsim::tag_array tags {NUM_SET, NUM_WAY}; // The tags and valid bits of block, packed for lookups
+
+public:
+#endif /* CACHE_SOA_TAG_STORE */
     champsim::bandwidth::maximum_type MAX_TAG, MAX_FILL;
     bool prefetch_as_load;
     bool match_offset_bits;
@@ -191,8 +211,38 @@ public:
      * one or more subentries to handle multiple misses to the same cache line. (from google by "cache mshr is")
     */
 #endif
-    std::deque<fill_type> MSHR;
-    std::deque<fill_type> inflight_fills;
+    champsim::packet_queue<fill_type> MSHR;
+    champsim::packet_queue<fill_type> inflight_fills;
+
+private:
+#if (CACHE_INDEXED_MSHR == ENABLE)
+    /**
+     * @brief Indices of MSHR and inflight_fills by block address, so finding an entry does not search the queues.
+     * @details
+     * Each entry is numbered in the order it was appended to its queue, and its position is its number
+     * minus the number of entries removed from the front of the queue.
+     * MSHR holds at most one entry per block. inflight_fills may hold several, since writes are not merged,
+     * and its index points at the oldest one, which is the one a search from the front would find.
+     */
+    champsim::msl::flat_hash_table mshr_index {};          // {block address -> number of the MSHR entry}
+    champsim::msl::flat_hash_table inflight_fill_index {}; // {block address -> number of the oldest inflight fill}
+    champsim::msl::flat_hash_table inflight_fill_count {}; // {block address -> number of inflight fills}
+    uint64_t mshr_removed           = 0;
+    uint64_t inflight_fills_removed = 0;
+
+    static constexpr uint64_t NOT_INDEXED = std::numeric_limits<uint64_t>::max();
+#endif /* CACHE_INDEXED_MSHR */
+
+    champsim::packet_queue<fill_type>::iterator find_mshr(champsim::address address);
+    champsim::packet_queue<fill_type>::iterator find_inflight_fill(champsim::address address);
+    void push_mshr(fill_type fill);
+    void push_inflight_fill(const fill_type& fill);
+    void pop_inflight_fills(std::size_t count);
+
+    /** @brief Move the entry, whose data has returned, from MSHR to inflight_fills */
+    void retire_mshr(champsim::packet_queue<fill_type>::iterator entry);
+
+public:
 
     long operate() final;
     void initialize() final;
@@ -235,6 +285,33 @@ public:
 
     void print_deadlock() final;
 
+#if (EVENT_DRIVEN_SKIP_AHEAD == ENABLE)
+    champsim::chrono::clock::time_point next_event_time() const final;
+    long skip_cycles(long cycles) final;
+#endif /* EVENT_DRIVEN_SKIP_AHEAD */
+
+#if (USER_CODES == ENABLE)
+    /**
+     * @brief Save or restore the blocks and the warmed-up state of the replacement policies and prefetchers.
+     * @note Requests in flight are not part of a checkpoint.
+     */
+    void checkpoint(champsim::checkpoint_archive& archive);
+#endif /* USER_CODES */
+
+#if (USER_CODES == ENABLE) && (FUNCTIONAL_WARMUP == ENABLE)
+    /**
+     * @brief Look up a block without timing, updating the replacement state and the dirty bit as try_hit() does.
+     * @return The data of the block, if it hits.
+     */
+    std::optional<champsim::address> functional_hit(uint32_t triggering_cpu, champsim::address address, champsim::address v_address, champsim::address ip, access_type type);
+
+    /**
+     * @brief Fill a block without timing, choosing the victim as handle_fill() does.
+     * @return The victim, if it is dirty and must be written back to the next level.
+     */
+    std::optional<BLOCK> functional_fill(uint32_t triggering_cpu, champsim::address address, champsim::address v_address, champsim::address data, champsim::address ip, access_type type);
+#endif /* USER_CODES, FUNCTIONAL_WARMUP */
+
 #if (USER_CODES == ENABLE)
 #else
 #include "module_decl.inc" // cache_module_decl.inc
@@ -253,6 +330,12 @@ public:
         virtual void impl_prefetcher_cycle_operate()                                                                                                                               = 0;
         virtual void impl_prefetcher_final_stats()                                                                                                                                 = 0;
         virtual void impl_prefetcher_branch_operate(champsim::address ip, uint8_t branch_type, champsim::address branch_target)                                                    = 0;
+#if (EVENT_DRIVEN_SKIP_AHEAD == ENABLE)
+        virtual bool impl_prefetcher_has_cycle_operate() const                                                                                                                     = 0;
+#endif /* EVENT_DRIVEN_SKIP_AHEAD */
+#if (USER_CODES == ENABLE)
+        virtual void impl_prefetcher_checkpoint(champsim::checkpoint_archive& archive)                                                                                             = 0;
+#endif /* USER_CODES */
     };
 
     struct replacement_module_concept
@@ -266,6 +349,9 @@ public:
         virtual void impl_update_replacement_state(uint32_t triggering_cpu, long set, long way, champsim::address full_addr, champsim::address ip, champsim::address victim_addr, access_type type, bool hit) = 0;
         virtual void impl_replacement_cache_fill(uint32_t triggering_cpu, long set, long way, champsim::address full_addr, champsim::address ip, champsim::address victim_addr, access_type type)             = 0;
         virtual void impl_replacement_final_stats()                                                                                                                                                           = 0;
+#if (USER_CODES == ENABLE)
+        virtual void impl_replacement_checkpoint(champsim::checkpoint_archive& archive)                                                                                                                       = 0;
+#endif /* USER_CODES */
     };
 
     template<typename... Ps>
@@ -287,6 +373,12 @@ public:
         void impl_prefetcher_cycle_operate() final;
         void impl_prefetcher_final_stats() final;
         void impl_prefetcher_branch_operate(champsim::address ip, uint8_t branch_type, champsim::address branch_target) final;
+#if (EVENT_DRIVEN_SKIP_AHEAD == ENABLE)
+        bool impl_prefetcher_has_cycle_operate() const final { return (false || ... || champsim::modules::prefetcher::has_cycle_operate<Ps&>); }
+#endif /* EVENT_DRIVEN_SKIP_AHEAD */
+#if (USER_CODES == ENABLE)
+        void impl_prefetcher_checkpoint(champsim::checkpoint_archive& archive) final;
+#endif /* USER_CODES */
     };
 
     template<typename... Rs>
@@ -310,6 +402,9 @@ public:
         void impl_update_replacement_state(uint32_t triggering_cpu, long set, long way, champsim::address full_addr, champsim::address ip, champsim::address victim_addr, access_type type, bool hit) final;
         void impl_replacement_cache_fill(uint32_t triggering_cpu, long set, long way, champsim::address full_addr, champsim::address ip, champsim::address victim_addr, access_type type) final;
         void impl_replacement_final_stats() final;
+#if (USER_CODES == ENABLE)
+        void impl_replacement_checkpoint(champsim::checkpoint_archive& archive) final;
+#endif /* USER_CODES */
     };
 
     std::unique_ptr<prefetcher_module_concept> pref_module_pimpl;
@@ -565,6 +660,36 @@ void CACHE::replacement_module_model<Rs...>::impl_replacement_final_stats()
         { (..., process_one(r)); }, intern_);
 }
 
+#if (USER_CODES == ENABLE)
+template<typename... Ps>
+void CACHE::prefetcher_module_model<Ps...>::impl_prefetcher_checkpoint(champsim::checkpoint_archive& archive)
+{
+    [[maybe_unused]] auto process_one = [&](auto& p)
+    {
+        using namespace champsim::modules;
+        if constexpr (prefetcher::has_checkpoint<decltype(p)>)
+            p.prefetcher_checkpoint(archive);
+    };
+
+    std::apply([&](auto&... p)
+        { (..., process_one(p)); }, intern_);
+}
+
+template<typename... Rs>
+void CACHE::replacement_module_model<Rs...>::impl_replacement_checkpoint(champsim::checkpoint_archive& archive)
+{
+    [[maybe_unused]] auto process_one = [&](auto& r)
+    {
+        using namespace champsim::modules;
+        if constexpr (replacement::has_checkpoint<decltype(r)>)
+            r.replacement_checkpoint(archive);
+    };
+
+    std::apply([&](auto&... r)
+        { (..., process_one(r)); }, intern_);
+}
+#endif /* USER_CODES */
+
 #if (USER_CODES == ENABLE)
 #else
 #ifdef SET_ASIDE_CHAMPSIM_MODULE
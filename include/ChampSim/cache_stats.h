@@ -33,5 +33,8 @@ struct cache_stats
 };
 
 cache_stats operator-(cache_stats lhs, cache_stats rhs);
+#if (USER_CODES == ENABLE) && (SAMPLED_SIMULATION == ENABLE)
+cache_stats operator+(cache_stats lhs, cache_stats rhs);
+#endif /* USER_CODES, SAMPLED_SIMULATION */
 
 #endif
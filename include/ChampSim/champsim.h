@@ -27,8 +27,10 @@
 #if (USER_CODES == ENABLE)
 #include <vector>
 
+#include "ChampSim/checkpoint.h"
 #include "ChampSim/environment.h"
 #include "ChampSim/phase_info.h"
+#include "ChampSim/telemetry.h"
 #include "ChampSim/tracereader.h"
 #else
 #include "ChampSim/extent.h"
@@ -102,7 +104,17 @@ auto lowest_address_for_width(data::bits width) -> address;
 #endif /* USER_CODES */
 
 #if (USER_CODES == ENABLE)
-std::vector<phase_stats> main(environment& env, std::vector<phase_info>& phases, std::vector<tracereader>& traces);
+/**
+ * @brief Run the phases of the simulation.
+ * @param checkpoint With a restore path, the warmed-up state is restored from it and the warmup phases are skipped.
+ * With a save path, the warmed-up state is saved to it once the warmup phases finish.
+ * @param telemetry With a path, a snapshot of the cores, caches and main memory is written to it every interval cycles of the timed phases.
+ */
+#if (TELEMETRY == ENABLE)
+std::vector<phase_stats> main(environment& env, std::vector<phase_info>& phases, std::vector<tracereader>& traces, const checkpoint_options& checkpoint = {}, const telemetry::telemetry_options& telemetry = {});
+#else
+std::vector<phase_stats> main(environment& env, std::vector<phase_info>& phases, std::vector<tracereader>& traces, const checkpoint_options& checkpoint = {});
+#endif /* TELEMETRY */
 #endif /* USER_CODES */
 
 } // namespace champsim
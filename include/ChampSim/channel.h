@@ -28,6 +28,31 @@
 #include "ChampSim/address.h"
 #include "ProjectConfiguration.h" // User file
 
+#if (USER_CODES == ENABLE) && (INSTRUCTION_INLINE_STORAGE == ENABLE)
+#include "ChampSim/msl/pool_allocator.h"
+#endif /* USER_CODES, INSTRUCTION_INLINE_STORAGE */
+
+namespace champsim
+{
+/**
+ * @brief The queues packets wait in, the instructions waiting for a packet, and the queues its response goes to.
+ * @details With INSTRUCTION_INLINE_STORAGE, these recycle their storage, so packets passing through the hierarchy do not allocate.
+ */
+#if (USER_CODES == ENABLE) && (INSTRUCTION_INLINE_STORAGE == ENABLE)
+template<typename T>
+using packet_queue           = std::deque<T, msl::pool_allocator<T>>;
+using dependent_instructions = std::vector<uint64_t, msl::pool_allocator<uint64_t>>;
+template<typename Response>
+using response_queues = std::vector<packet_queue<Response>*, msl::pool_allocator<packet_queue<Response>*>>;
+#else
+template<typename T>
+using packet_queue           = std::deque<T>;
+using dependent_instructions = std::vector<uint64_t>;
+template<typename Response>
+using response_queues = std::vector<std::deque<Response>*>;
+#endif /* USER_CODES, INSTRUCTION_INLINE_STORAGE */
+} // namespace champsim
+
 #if (USER_CODES == ENABLE)
 
 #if (RAMULATOR == ENABLE) || (RAMULATOR2 == ENABLE)
@@ -88,7 +113,7 @@ class channel
 
 #endif /* MEMORY_USE_OS_TRANSPARENT_MANAGEMENT */
 
-        std::vector<uint64_t> instr_depend_on_me {};
+        champsim::dependent_instructions instr_depend_on_me {};
     };
 
     struct response
@@ -97,9 +122,9 @@ class channel
         champsim::address v_address {};
         champsim::address data {};
         uint32_t pf_metadata = 0;
-        std::vector<uint64_t> instr_depend_on_me {};
+        champsim::dependent_instructions instr_depend_on_me {};
 
-        response(champsim::address addr, champsim::address v_addr, champsim::address data_, uint32_t pf_meta, std::vector<uint64_t> deps)
+        response(champsim::address addr, champsim::address v_addr, champsim::address data_, uint32_t pf_meta, champsim::dependent_instructions deps)
         : address(addr), v_address(v_addr), data(data_), pf_metadata(pf_meta), instr_depend_on_me(deps)
         {
         }
@@ -121,8 +146,8 @@ public:
     using request_type  = request;
     using stats_type    = cache_queue_stats;
 
-    std::deque<request_type> RQ {}, PQ {}, WQ {}; // Request queues: read queue, pending queue, write queue
-    std::deque<response_type> returned {};        // Response queue
+    champsim::packet_queue<request_type> RQ {}, PQ {}, WQ {}; // Request queues: read queue, pending queue, write queue
+    champsim::packet_queue<response_type> returned {};        // Response queue
 
     stats_type sim_stats {}, roi_stats {};
 
@@ -174,8 +199,8 @@ struct DRAM_CHANNEL final : public champsim::operable
 
 #endif /* MEMORY_USE_OS_TRANSPARENT_MANAGEMENT */
 
-        std::vector<uint64_t> instr_depend_on_me {};
-        std::vector<std::deque<response_type>*> to_return {}; // Store the response queue
+        champsim::dependent_instructions instr_depend_on_me {};
+        champsim::response_queues<response_type> to_return {}; // Store the response queue
 
         explicit request_type(const typename champsim::channel::request_type& req);
         request_type() {};
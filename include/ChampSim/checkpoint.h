@@ -0,0 +1,259 @@
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <map>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "ProjectConfiguration.h" // User file
+
+#if (USER_CODES == ENABLE)
+
+namespace champsim
+{
+
+/**
+ * @brief Where a run saves its warmed-up state to, and where it restores it from, empty for none.
+ */
+struct checkpoint_options
+{
+    std::string save_path {};
+    std::string restore_path {};
+};
+
+/**
+ * @brief A binary archive of the warmed-up state of the simulated system.
+ * @details
+ * Saving and loading go through the same checkpoint() member of each component: it hands its state to operator(),
+ * which writes the state when saving and overwrites it when loading, so both directions always agree on the layout.
+ * Trivially copyable values are stored as raw bytes, containers as their size followed by their elements,
+ * and any type with a checkpoint(checkpoint_archive&) member stores itself through it.
+ * Every component opens a named section and stores its configuration with expect(),
+ * so a checkpoint taken with another configuration is rejected instead of being misread.
+ */
+class checkpoint_archive
+{
+public:
+    enum class mode
+    {
+        save,
+        load
+    };
+
+    checkpoint_archive(std::string path_, mode direction_);
+    ~checkpoint_archive();
+
+    checkpoint_archive(const checkpoint_archive&)            = delete;
+    checkpoint_archive& operator=(const checkpoint_archive&) = delete;
+
+    [[nodiscard]] bool saving() const { return direction == mode::save; }
+    [[nodiscard]] bool loading() const { return direction == mode::load; }
+
+    template<typename... Ts>
+    void operator()(Ts&... values)
+    {
+        (..., transfer(values));
+    }
+
+    /**
+     * @brief Start the state of one component, checking on load that the checkpoint holds this component next.
+     */
+    void section(std::string_view name);
+
+    /**
+     * @brief Store a configuration value, checking on load that this run is configured the same.
+     */
+    template<typename T>
+    void expect(const T& value, std::string_view what)
+    {
+        T stored = value;
+        transfer(stored);
+        if (! (stored == value))
+        {
+            mismatch(what);
+        }
+    }
+
+private:
+    std::string path;
+    mode direction;
+    FILE* file = nullptr;
+
+    void transfer_bytes(void* data, std::size_t size);
+    [[noreturn]] void mismatch(std::string_view what) const;
+
+    template<typename T>
+    static auto checkpoint_member_impl(int) -> decltype(std::declval<T&>().checkpoint(std::declval<checkpoint_archive&>()), std::true_type {});
+    template<typename>
+    static auto checkpoint_member_impl(long) -> std::false_type;
+
+    template<typename T>
+    constexpr static bool has_checkpoint = decltype(checkpoint_member_impl<T>(0))::value;
+
+    std::size_t transfer_size(std::size_t size)
+    {
+        uint64_t stored = size;
+        transfer_bytes(&stored, sizeof(stored));
+        return static_cast<std::size_t>(stored);
+    }
+
+    template<typename T>
+    void transfer(T& value)
+    {
+        if constexpr (has_checkpoint<T>)
+        {
+            value.checkpoint(*this);
+        }
+        else
+        {
+            static_assert(std::is_trivially_copyable_v<T>, "A checkpointed type must be trivially copyable or have a checkpoint(checkpoint_archive&) member");
+            transfer_bytes(&value, sizeof(T));
+        }
+    }
+
+    template<typename T, std::size_t N>
+    void transfer(std::array<T, N>& values)
+    {
+        if constexpr (std::is_trivially_copyable_v<T> && ! has_checkpoint<T>)
+        {
+            transfer_bytes(values.data(), sizeof(values));
+        }
+        else
+        {
+            for (T& value : values)
+            {
+                transfer(value);
+            }
+        }
+    }
+
+    template<typename T, typename Allocator>
+    void transfer(std::vector<T, Allocator>& values)
+    {
+        const std::size_t size = transfer_size(std::size(values));
+        if (loading() && size != std::size(values))
+        {
+            if constexpr (std::is_default_constructible_v<T>)
+            {
+                values.resize(size);
+            }
+            else
+            {
+                mismatch("number of elements");
+            }
+        }
+
+        if constexpr (std::is_trivially_copyable_v<T> && ! has_checkpoint<T>)
+        {
+            transfer_bytes(values.data(), size * sizeof(T));
+        }
+        else
+        {
+            for (T& value : values)
+            {
+                transfer(value);
+            }
+        }
+    }
+
+    void transfer(std::vector<bool>& values)
+    {
+        const std::size_t size = transfer_size(std::size(values));
+        values.resize(size);
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            bool value = values[i];
+            transfer(value);
+            values[i] = value;
+        }
+    }
+
+    template<typename T, typename Allocator>
+    void transfer(std::deque<T, Allocator>& values)
+    {
+        const std::size_t size = transfer_size(std::size(values));
+        if (loading())
+        {
+            values.resize(size);
+        }
+        for (T& value : values)
+        {
+            transfer(value);
+        }
+    }
+
+    template<typename Map>
+    void transfer_map(Map& values)
+    {
+        const std::size_t size = transfer_size(std::size(values));
+        if (saving())
+        {
+            for (auto& [key, value] : values)
+            {
+                auto stored_key = key;
+                transfer(stored_key);
+                transfer(value);
+            }
+        }
+        else
+        {
+            values.clear();
+            for (std::size_t i = 0; i < size; ++i)
+            {
+                typename Map::key_type key {};
+                typename Map::mapped_type value {};
+                transfer(key);
+                transfer(value);
+                values.emplace_hint(std::end(values), std::move(key), std::move(value));
+            }
+        }
+    }
+
+    template<typename K, typename V, typename Compare, typename Allocator>
+    void transfer(std::map<K, V, Compare, Allocator>& values)
+    {
+        transfer_map(values);
+    }
+
+    template<typename K, typename V, typename Hash, typename Equal, typename Allocator>
+    void transfer(std::unordered_map<K, V, Hash, Equal, Allocator>& values)
+    {
+        transfer_map(values);
+    }
+
+    template<typename T, typename U>
+    void transfer(std::pair<T, U>& value)
+    {
+        transfer(value.first);
+        transfer(value.second);
+    }
+
+    template<typename... Ts>
+    void transfer(std::tuple<Ts...>& value)
+    {
+        std::apply([this](auto&... elements)
+            { (..., transfer(elements)); }, value);
+    }
+
+    void transfer(std::string& value)
+    {
+        value.resize(transfer_size(std::size(value)));
+        transfer_bytes(value.data(), std::size(value));
+    }
+};
+
+} // namespace champsim
+
+#endif /* USER_CODES */
+
+#endif /* CHECKPOINT_H */
@@ -168,6 +168,7 @@ public:
     std::vector<std::reference_wrapper<O3_CPU> > cpu_view() final;
     std::vector<std::reference_wrapper<CACHE> > cache_view() final;
     std::vector<std::reference_wrapper<PageTableWalker> > ptw_view() final;
+    VirtualMemory& vmem_view() final;
 
 #if (RAMULATOR == ENABLE)
 #else
@@ -176,6 +177,9 @@ public:
 #endif /* RAMULATOR */
 
     std::vector<std::reference_wrapper<operable> > operable_view() final;
+#if (USE_OPENMP == ENABLE) && (PARALLEL_CYCLE_ENGINE == ENABLE)
+    std::vector<std::reference_wrapper<operable> > private_operable_view(std::size_t cpu) final;
+#endif /* USE_OPENMP, PARALLEL_CYCLE_ENGINE */
 };
 
 #if (RAMULATOR == ENABLE)
@@ -279,7 +283,10 @@ champsim::configured::generated_environment<ID>::generated_environment()
   DRAM {champsim::chrono::picoseconds {DRAM_DATA_TRANSFER_PERIOD}, champsim::chrono::picoseconds {DRAM_IO_CLOCK_PERIOD}, std::size_t {24}, std::size_t {24}, std::size_t {24}, std::size_t {52}, champsim::chrono::microseconds {32000}, {&channels.at(index_type(ChannelIndex::LLC_to_MAIN_MEMORY_Queues))}, DRAM_RQ_SIZE, DRAM_WQ_SIZE, DRAM_CHANNELS, champsim::data::bytes {DRAM_CHANNEL_WIDTH}, DRAM_ROWS, DRAM_COLUMNS, DRAM_RANKS, DRAM_BANK_GROUPS, DRAM_BANKS, 8192},
 #endif /* RAMULATOR */
 
-#if (RAMULATOR == ENABLE) || (RAMULATOR2 == ENABLE)
+#if (RAMULATOR2 == ENABLE) && (MEMORY_USE_HYBRID == ENABLE) && (USER_CODES == ENABLE)
+  /* Virtual memory's initialization */
+  vmem {champsim::data::bytes {PAGE_SIZE}, PAGE_TABLE_LEVELS, champsim::chrono::picoseconds {MINOR_FAULT_PENALTY}, memory_controller.size(), 1, memory_controller.fast_memory_size(), static_cast<VirtualMemory::page_placement>(PAGE_PLACEMENT_POLICY)},
+#elif (RAMULATOR == ENABLE) || (RAMULATOR2 == ENABLE)
   /* Virtual memory's initialization */
   vmem {champsim::data::bytes {PAGE_SIZE}, PAGE_TABLE_LEVELS, champsim::chrono::picoseconds {MINOR_FAULT_PENALTY}, memory_controller.size(), 1},
 #else
@@ -562,6 +569,22 @@ auto champsim::configured::generated_environment<ID>::ptw_view() -> std::vector<
     return retval;
 }
 
+#if (RAMULATOR == ENABLE)
+#if (MEMORY_USE_HYBRID == ENABLE)
+template<unsigned long long ID, typename MEMORY_TYPE, typename MEMORY_TYPE2>
+auto champsim::configured::generated_environment<ID, MEMORY_TYPE, MEMORY_TYPE2>::vmem_view() -> VirtualMemory&
+#else
+template<unsigned long long ID, typename MEMORY_TYPE>
+auto champsim::configured::generated_environment<ID, MEMORY_TYPE>::vmem_view() -> VirtualMemory&
+#endif /* MEMORY_USE_HYBRID */
+#else
+template<unsigned long long ID>
+auto champsim::configured::generated_environment<ID>::vmem_view() -> VirtualMemory&
+#endif /* RAMULATOR */
+{
+    return vmem;
+}
+
 #if (RAMULATOR == ENABLE)
 #if (MEMORY_USE_HYBRID == ENABLE)
 template<unsigned long long ID, typename MEMORY_TYPE, typename MEMORY_TYPE2>
@@ -592,6 +615,35 @@ auto champsim::configured::generated_environment<ID>::operable_view() -> std::ve
     return retval;
 }
 
+#if (USE_OPENMP == ENABLE) && (PARALLEL_CYCLE_ENGINE == ENABLE)
+#if (RAMULATOR == ENABLE)
+#if (MEMORY_USE_HYBRID == ENABLE)
+template<unsigned long long ID, typename MEMORY_TYPE, typename MEMORY_TYPE2>
+auto champsim::configured::generated_environment<ID, MEMORY_TYPE, MEMORY_TYPE2>::private_operable_view(std::size_t cpu) -> std::vector<std::reference_wrapper<champsim::operable> >
+#else
+template<unsigned long long ID, typename MEMORY_TYPE>
+auto champsim::configured::generated_environment<ID, MEMORY_TYPE>::private_operable_view(std::size_t cpu) -> std::vector<std::reference_wrapper<champsim::operable> >
+#endif /* MEMORY_USE_HYBRID */
+#else
+template<unsigned long long ID>
+auto champsim::configured::generated_environment<ID>::private_operable_view(std::size_t cpu) -> std::vector<std::reference_wrapper<champsim::operable> >
+#endif /* RAMULATOR */
+{
+    // Each CPU owns a contiguous run of caches in CacheIndex, from its DTLB to its STLB
+    constexpr std::size_t caches_per_cpu = index_type(CacheIndex::CPU0_STLB) - index_type(CacheIndex::CPU0_DTLB) + 1;
+
+    std::vector<std::reference_wrapper<champsim::operable> > retval {};
+    auto make_ref = [](auto& x)
+    { return std::ref<champsim::operable>(x); };
+
+    retval.push_back(make_ref(cores.at(cpu)));
+    const auto first_cache = std::next(std::begin(caches), static_cast<std::ptrdiff_t>(cpu * caches_per_cpu));
+    std::transform(first_cache, std::next(first_cache, static_cast<std::ptrdiff_t>(caches_per_cpu)), std::back_inserter(retval), make_ref);
+
+    return retval;
+}
+#endif /* USE_OPENMP, PARALLEL_CYCLE_ENGINE */
+
 #if (RAMULATOR == ENABLE)
 #elif (RAMULATOR2 == ENABLE)
 template<unsigned long long ID>
@@ -6,6 +6,7 @@
 
 #include "ChampSim/event_counter.h"
 #include "ChampSim/instruction.h"
+#include "ProjectConfiguration.h" // User file
 
 struct cpu_stats
 {
@@ -25,5 +26,8 @@ struct cpu_stats
 };
 
 cpu_stats operator-(cpu_stats lhs, cpu_stats rhs);
+#if (USER_CODES == ENABLE) && (SAMPLED_SIMULATION == ENABLE)
+cpu_stats operator+(cpu_stats lhs, cpu_stats rhs);
+#endif /* USER_CODES, SAMPLED_SIMULATION */
 
 #endif
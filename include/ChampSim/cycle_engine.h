@@ -0,0 +1,73 @@
+#ifndef CYCLE_ENGINE_H
+#define CYCLE_ENGINE_H
+
+#include <cstddef>
+#include <vector>
+
+#include "ChampSim/chrono.h"
+#include "ChampSim/operable.h"
+#include "ChampSim/operable_schedule.h"
+#include "ProjectConfiguration.h" // User file
+
+#if (USER_CODES == ENABLE) && (USE_OPENMP == ENABLE) && (PARALLEL_CYCLE_ENGINE == ENABLE)
+
+namespace champsim
+{
+
+/**
+ * @brief The threads of the cycle engine given by --threads, 0 when not given, which runs as many as OpenMP has up to one per processor.
+ */
+inline int cycle_engine_threads {0};
+
+/**
+ * @brief Operates the operables of a cycle, each CPU's private operables on a pool of OpenMP threads and then the shared ones in order.
+ * @details
+ * A CPU's core, TLBs, L1s and L2C only exchange packets with each other and, through their channels, with the LLC and the page table walker.
+ * Every CPU's private operables come before the LLC, the page table walkers and main memory in operable_view(), so when every operable is
+ * due at the same time, the serial loop operates all private operables before any shared one, and the CPUs' private operables never meet.
+ * Operating each CPU's private operables on its own thread, then the shared operables in order, is then the same cycle as the serial loop.
+ * The page table walkers stay with the shared operables, since they all allocate pages from the one VirtualMemory.
+ * Cycles in which operables of different clocks are due fall back to the serial loop.
+ */
+class cycle_engine
+{
+public:
+    using operable_list = operable_schedule::operable_list;
+
+    cycle_engine() = default;
+
+    /**
+     * @param private_operables Each CPU's private operables, which together are the first operables of operable_view().
+     * @param num_threads The most threads to operate the private operables on, 1 operates every operable serially.
+     */
+    cycle_engine(std::vector<operable_list> private_operables, int num_threads);
+
+    /**
+     * @return The threads that operate the private operables, 1 when they are operated serially.
+     */
+    [[nodiscard]] int threads() const { return num_threads; }
+
+    /**
+     * @brief Operate each CPU's private operables on the threads, if every operable of the schedule is due at the same time.
+     * @return The progress of the operated operables.
+     */
+    long operate_private(const operable_schedule& schedule, const champsim::chrono::clock& clock);
+
+    /**
+     * @brief Operate the operables that operate_private() left, in the order of the schedule.
+     * @return The progress of the operated operables.
+     */
+    long operate_shared(const operable_schedule& schedule, const champsim::chrono::clock& clock) const;
+
+private:
+    std::vector<operable_list> private_operables {}; // [cpu]
+    std::size_t num_private {0};                     // The private operables of all CPUs
+    int num_threads {1};
+    std::size_t first_shared {0}; // The first operable of the schedule that operate_private() left
+};
+
+} // namespace champsim
+
+#endif /* USER_CODES, USE_OPENMP, PARALLEL_CYCLE_ENGINE */
+
+#endif
@@ -135,8 +135,8 @@ struct DRAM_CHANNEL final : public champsim::operable
         champsim::address data {};
         champsim::chrono::clock::time_point ready_time = champsim::chrono::clock::time_point::max();
 
-        std::vector<uint64_t> instr_depend_on_me {};
-        std::vector<std::deque<response_type>*> to_return {};
+        champsim::dependent_instructions instr_depend_on_me {};
+        champsim::response_queues<response_type> to_return {};
 
         explicit request_type(const typename champsim::channel::request_type& req);
     };
@@ -29,9 +29,11 @@
 
 #if (USER_CODES == ENABLE)
 #include <forward_list>
+#include <utility>
 
 #include "ChampSim/chrono.h"
 #include "ChampSim/defaults.hpp"
+#include "ChampSim/operable_schedule.h"
 #include "ChampSim/vmem.h"
 
 namespace champsim
@@ -42,6 +44,7 @@ struct environment
     virtual std::vector<std::reference_wrapper<O3_CPU> > cpu_view()          = 0;
     virtual std::vector<std::reference_wrapper<CACHE> > cache_view()         = 0;
     virtual std::vector<std::reference_wrapper<PageTableWalker> > ptw_view() = 0;
+    virtual VirtualMemory& vmem_view()                                       = 0;
 
 #if (RAMULATOR == ENABLE)
 #else
@@ -51,6 +54,31 @@ struct environment
 #endif /* RAMULATOR */
 
     virtual std::vector<std::reference_wrapper<operable> > operable_view() = 0;
+
+#if (USE_OPENMP == ENABLE) && (PARALLEL_CYCLE_ENGINE == ENABLE)
+    /**
+     * @brief Operables that only communicate with their own CPU and the shared operables (the core, its TLBs, L1s and L2C), in operable_view() order.
+     * @note Every CPU's private operables come before the LLC, page table walkers and main memory in operable_view(),
+     * so operating different CPUs' private operables concurrently and then the shared ones in order is the serial order of a cycle.
+     */
+    virtual std::vector<std::reference_wrapper<operable> > private_operable_view(std::size_t cpu) = 0;
+#endif /* USE_OPENMP, PARALLEL_CYCLE_ENGINE */
+
+    /**
+     * @brief The order in which the operables are operated, built from operable_view() on first use and kept across cycles.
+     */
+    operable_schedule& schedule()
+    {
+        if (persistent_schedule.empty())
+        {
+            persistent_schedule = operable_schedule {operable_view()};
+        }
+
+        return persistent_schedule;
+    }
+
+private:
+    operable_schedule persistent_schedule {};
 };
 
 namespace configured
@@ -0,0 +1,51 @@
+#ifndef FUNCTIONAL_WARMUP_H
+#define FUNCTIONAL_WARMUP_H
+
+#include <cstdint>
+#include <unordered_map>
+
+#include "ChampSim/address.h"
+#include "ChampSim/channel.h"
+#include "ProjectConfiguration.h" // User file
+
+#if (USER_CODES == ENABLE) && (FUNCTIONAL_WARMUP == ENABLE)
+
+class CACHE;
+class PageTableWalker;
+
+namespace champsim
+{
+class environment;
+
+/**
+ * @brief Warms up the caches, TLBs and main memory of a system with the accesses of retired instructions, without timing.
+ * @details
+ * An access is served at once through the levels its request would travel: each cache looks it up, asks the next level on a miss and fills the block on the way back,
+ * writing a dirty victim back to the next level, as the timing model does once everything has settled.
+ * Requests with virtual addresses are translated through the TLBs first, the last TLB walks the page table,
+ * and the last cache accesses main memory, where an OS-transparent management design tracks the access.
+ * Prefetchers, queues and statistics are left untouched.
+ */
+class functional_warmer
+{
+public:
+    using request_type = channel::request_type;
+
+    explicit functional_warmer(environment& env);
+
+    /**
+     * @brief Serve a request sent through a channel.
+     * @return The data of the block, which is the physical page for translations.
+     */
+    champsim::address access(channel* channel, request_type request);
+
+private:
+    std::unordered_map<const channel*, CACHE*> caches;         // The cache each channel leads to
+    std::unordered_map<const channel*, PageTableWalker*> ptws; // The page table walker each channel leads to
+    environment& env;
+};
+} // namespace champsim
+
+#endif /* USER_CODES, FUNCTIONAL_WARMUP */
+
+#endif /* FUNCTIONAL_WARMUP_H */
@@ -20,6 +20,7 @@
 #include <algorithm>
 #include <array>
 #include <cstdint>
+#include <deque>
 #include <functional>
 #include <limits>
 #include <string_view>
@@ -31,6 +32,10 @@
 #include "ProjectConfiguration.h" // User file
 
 #if (USER_CODES == ENABLE)
+#if (INSTRUCTION_INLINE_STORAGE == ENABLE)
+#include "ChampSim/msl/pool_allocator.h"
+#include "ChampSim/msl/static_vector.h"
+#endif /* INSTRUCTION_INLINE_STORAGE */
 #else
 #include "ChampSim/champsim.h"
 #endif /* USER_CODES */
@@ -100,6 +105,22 @@ struct program_ordered
      */
     static auto precedes(const T& instr) { return precedes(instr.instr_id); }
 };
+
+#if (USER_CODES == ENABLE) && (INSTRUCTION_INLINE_STORAGE == ENABLE)
+// The trace formats bound the number of operands, so the operands fit inline
+inline constexpr std::size_t MAX_INSTR_DESTINATIONS = std::max(NUM_INSTR_DESTINATIONS, NUM_INSTR_DESTINATIONS_SPARC);
+inline constexpr std::size_t MAX_INSTR_SOURCES      = NUM_INSTR_SOURCES;
+
+template<typename T>
+using destination_operands = msl::static_vector<T, MAX_INSTR_DESTINATIONS>;
+template<typename T>
+using source_operands = msl::static_vector<T, MAX_INSTR_SOURCES>;
+#else
+template<typename T>
+using destination_operands = std::vector<T>;
+template<typename T>
+using source_operands = std::vector<T>;
+#endif /* USER_CODES, INSTRUCTION_INLINE_STORAGE */
 } // namespace champsim
 
 struct ooo_model_instr : champsim::program_ordered<ooo_model_instr>
@@ -128,14 +149,18 @@ struct ooo_model_instr : champsim::program_ordered<ooo_model_instr>
     unsigned completed_mem_ops                              = 0;
     int num_reg_dependent                                   = 0;
 
-    std::vector<PHYSICAL_REGISTER_ID> destination_registers = {}; // output registers
-    std::vector<PHYSICAL_REGISTER_ID> source_registers      = {}; // input registers
+    champsim::destination_operands<PHYSICAL_REGISTER_ID> destination_registers = {}; // output registers
+    champsim::source_operands<PHYSICAL_REGISTER_ID> source_registers           = {}; // input registers
 
-    std::vector<champsim::address> destination_memory       = {};
-    std::vector<champsim::address> source_memory            = {};
+    champsim::destination_operands<champsim::address> destination_memory       = {};
+    champsim::source_operands<champsim::address> source_memory                 = {};
 
+#if (USER_CODES == ENABLE) && (INSTRUCTION_INLINE_STORAGE == ENABLE)
+    // Nothing refers to other instructions, so instructions are trivially copyable
+#else
     // these are indices of instructions in the ROB that depend on me
     std::vector<std::reference_wrapper<ooo_model_instr>> registers_instrs_depend_on_me;
+#endif /* USER_CODES, INSTRUCTION_INLINE_STORAGE */
 
 private:
     template<typename T>
@@ -224,4 +249,17 @@ public:
     [[nodiscard]] std::size_t num_mem_ops() const { return std::size(destination_memory) + std::size(source_memory); }
 };
 
+namespace champsim
+{
+/**
+ * @brief The queues that carry instructions from the trace to retirement.
+ * @details With INSTRUCTION_INLINE_STORAGE, the blocks freed as instructions leave a queue are recycled for the instructions that enter one.
+ */
+#if (USER_CODES == ENABLE) && (INSTRUCTION_INLINE_STORAGE == ENABLE)
+using instruction_queue = std::deque<ooo_model_instr, msl::pool_allocator<ooo_model_instr>>;
+#else
+using instruction_queue = std::deque<ooo_model_instr>;
+#endif /* USER_CODES, INSTRUCTION_INLINE_STORAGE */
+} // namespace champsim
+
 #endif
@@ -68,8 +68,8 @@ inline void handle_event<Event::BEGIN_PHASE>(Heartbeat* hb, [[maybe_unused]] boo
 }
 
 template<>
-inline void handle_event<Event::RETIRE>(Heartbeat* hb, uint32_t& cpu, std::deque<ooo_model_instr>::const_iterator& begin,
-    std::deque<ooo_model_instr>::const_iterator& end, uint64_t& current_cycles)
+inline void handle_event<Event::RETIRE>(Heartbeat* hb, uint32_t& cpu, champsim::instruction_queue::const_iterator& begin,
+    champsim::instruction_queue::const_iterator& end, uint64_t& current_cycles)
 {
     hb->add_cpu(cpu);
     hb->num_retired[cpu] += std::distance(begin, end);
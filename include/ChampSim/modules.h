@@ -34,6 +34,13 @@
 class CACHE;
 class O3_CPU;
 
+#if (USER_CODES == ENABLE)
+namespace champsim
+{
+class checkpoint_archive;
+} // namespace champsim
+#endif /* USER_CODES */
+
 namespace champsim::modules
 {
 inline constexpr bool warn_if_any_missing = true;
@@ -80,6 +87,16 @@ struct branch_predictor : public bound_to<O3_CPU>
 
     template<typename T, typename... Args>
     constexpr static bool has_predict_branch = decltype(predict_branch_member_impl<T, Args...>(0))::value;
+
+#if (USER_CODES == ENABLE)
+    template<typename T>
+    static auto checkpoint_member_impl(int) -> decltype(std::declval<T>().branch_predictor_checkpoint(std::declval<champsim::checkpoint_archive&>()), std::true_type {});
+    template<typename>
+    static auto checkpoint_member_impl(long) -> std::false_type;
+
+    template<typename T>
+    constexpr static bool has_checkpoint = decltype(checkpoint_member_impl<T>(0))::value;
+#endif /* USER_CODES */
 };
 
 struct btb : public bound_to<O3_CPU>
@@ -109,6 +126,16 @@ struct btb : public bound_to<O3_CPU>
 
     template<typename T, typename... Args>
     constexpr static bool has_btb_prediction = decltype(predict_branch_member_impl<T, Args...>(0))::value;
+
+#if (USER_CODES == ENABLE)
+    template<typename T>
+    static auto checkpoint_member_impl(int) -> decltype(std::declval<T>().btb_checkpoint(std::declval<champsim::checkpoint_archive&>()), std::true_type {});
+    template<typename>
+    static auto checkpoint_member_impl(long) -> std::false_type;
+
+    template<typename T>
+    constexpr static bool has_checkpoint = decltype(checkpoint_member_impl<T>(0))::value;
+#endif /* USER_CODES */
 };
 
 struct prefetcher : public bound_to<CACHE>
@@ -165,6 +192,16 @@ struct prefetcher : public bound_to<CACHE>
 
     template<typename T, typename... Args>
     constexpr static bool has_branch_operate = decltype(branch_operate_member_impl<T, Args...>(0))::value;
+
+#if (USER_CODES == ENABLE)
+    template<typename T>
+    static auto checkpoint_member_impl(int) -> decltype(std::declval<T>().prefetcher_checkpoint(std::declval<champsim::checkpoint_archive&>()), std::true_type {});
+    template<typename>
+    static auto checkpoint_member_impl(long) -> std::false_type;
+
+    template<typename T>
+    constexpr static bool has_checkpoint = decltype(checkpoint_member_impl<T>(0))::value;
+#endif /* USER_CODES */
 };
 
 struct replacement : public bound_to<CACHE>
@@ -210,6 +247,16 @@ struct replacement : public bound_to<CACHE>
 
     template<typename T, typename... Args>
     constexpr static bool has_final_stats = decltype(final_stats_member_impl<T, Args...>(0))::value;
+
+#if (USER_CODES == ENABLE)
+    template<typename T>
+    static auto checkpoint_member_impl(int) -> decltype(std::declval<T>().replacement_checkpoint(std::declval<champsim::checkpoint_archive&>()), std::true_type {});
+    template<typename>
+    static auto checkpoint_member_impl(long) -> std::false_type;
+
+    template<typename T>
+    constexpr static bool has_checkpoint = decltype(checkpoint_member_impl<T>(0))::value;
+#endif /* USER_CODES */
 };
 } // namespace champsim::modules
 
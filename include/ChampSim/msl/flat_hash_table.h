@@ -0,0 +1,164 @@
+#ifndef MSL_FLAT_HASH_TABLE_H
+#define MSL_FLAT_HASH_TABLE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace champsim::msl
+{
+/**
+ * @brief A map from 64-bit keys to 64-bit values, stored in one flat array with open addressing and linear probing.
+ * @details
+ * A lookup is a hash and a short probe over contiguous memory, and the whole table lives in a single allocation that grows by doubling.
+ * Erasing shifts the following entries of the probe sequence back instead of leaving tombstones, so probes never get longer.
+ * The largest 64-bit value is reserved as the empty key.
+ */
+class flat_hash_table
+{
+public:
+    using key_type    = uint64_t;
+    using mapped_type = uint64_t;
+
+    explicit flat_hash_table(std::size_t initial_capacity = MIN_CAPACITY) { rehash(initial_capacity); }
+
+    /**
+     * @brief Insert the key with the value unless the key is already present.
+     * @return The value of the key, and whether it was inserted.
+     */
+    std::pair<mapped_type, bool> try_emplace(key_type key, mapped_type value)
+    {
+        std::size_t index = probe(key);
+        if (entries[index].key == key)
+        {
+            return {entries[index].value, false};
+        }
+
+        if ((occupancy + 1) * MAX_LOAD_DENOMINATOR > entries.size() * MAX_LOAD_NUMERATOR)
+        {
+            rehash(entries.size() * 2);
+            index = probe(key);
+        }
+        entries[index] = {key, value};
+        occupancy++;
+        return {value, true};
+    }
+
+    void insert_or_assign(key_type key, mapped_type value)
+    {
+        if (entry& found = entries[probe(key)]; found.key == key)
+        {
+            found.value = value;
+        }
+        else
+        {
+            try_emplace(key, value);
+        }
+    }
+
+    /** @return Whether the key was present. */
+    bool erase(key_type key)
+    {
+        std::size_t hole = probe(key);
+        if (entries[hole].key != key)
+        {
+            return false;
+        }
+
+        // Move back every later entry of the probe sequence whose home is not between the hole and the entry
+        for (std::size_t index = (hole + 1) & mask; entries[index].key != EMPTY_KEY; index = (index + 1) & mask)
+        {
+            if (((index - home(entries[index].key)) & mask) >= ((index - hole) & mask))
+            {
+                entries[hole] = entries[index];
+                hole          = index;
+            }
+        }
+        entries[hole] = entry {};
+        occupancy--;
+        return true;
+    }
+
+    /** @return The value of the key, or fallback if the key is not present. */
+    [[nodiscard]] mapped_type value_or(key_type key, mapped_type fallback) const
+    {
+        const entry& found = entries[probe(key)];
+        return (found.key == key) ? found.value : fallback;
+    }
+
+    void clear() { rehash(MIN_CAPACITY); }
+
+    [[nodiscard]] std::size_t size() const { return occupancy; }
+
+    /** @return Bytes used by the table entries */
+    [[nodiscard]] std::size_t footprint() const { return entries.capacity() * sizeof(entry); }
+
+    /** @brief Save or restore the table through a champsim::checkpoint_archive */
+    template<typename Archive>
+    void checkpoint(Archive& archive)
+    {
+        archive(entries, mask, occupancy, shift);
+    }
+
+private:
+    static constexpr key_type EMPTY_KEY               = std::numeric_limits<key_type>::max();
+    static constexpr std::size_t MIN_CAPACITY         = 16;
+    static constexpr std::size_t MAX_LOAD_NUMERATOR   = 1; // Grow beyond 1/2 load
+    static constexpr std::size_t MAX_LOAD_DENOMINATOR = 2;
+
+    struct entry
+    {
+        key_type key      = EMPTY_KEY;
+        mapped_type value = 0;
+    };
+
+    std::vector<entry> entries;
+    std::size_t mask      = 0;
+    std::size_t occupancy = 0;
+    unsigned shift        = 0;
+
+    // Fibonacci hashing spreads consecutive keys, such as page numbers or block addresses, over the table
+    [[nodiscard]] std::size_t home(key_type key) const { return static_cast<std::size_t>((key * 0x9E3779B97F4A7C15ull) >> shift); }
+
+    /** @return The slot holding the key, or the empty slot where it would be inserted */
+    [[nodiscard]] std::size_t probe(key_type key) const
+    {
+        std::size_t index = home(key);
+        while (entries[index].key != key && entries[index].key != EMPTY_KEY)
+        {
+            index = (index + 1) & mask;
+        }
+        return index;
+    }
+
+    void rehash(std::size_t capacity)
+    {
+        std::size_t rounded = MIN_CAPACITY;
+        while (rounded < capacity)
+        {
+            rounded <<= 1;
+        }
+
+        std::vector<entry> old_entries(rounded);
+        old_entries.swap(entries);
+        mask  = rounded - 1;
+        shift = 64;
+        for (std::size_t c = rounded; c > 1; c >>= 1)
+        {
+            shift--;
+        }
+
+        for (const entry& old : old_entries)
+        {
+            if (old.key != EMPTY_KEY)
+            {
+                entries[probe(old.key)] = old;
+            }
+        }
+    }
+};
+} // namespace champsim::msl
+
+#endif
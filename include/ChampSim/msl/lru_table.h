@@ -196,6 +196,17 @@ public:
     lru_table(std::size_t sets, std::size_t ways, SetProj set_proj): lru_table(sets, ways, set_proj, {}) {}
 
     lru_table(std::size_t sets, std::size_t ways): lru_table(sets, ways, {}, {}) {}
+
+    /**
+     * Save or restore the contents of the table through a champsim::checkpoint_archive.
+     */
+    template<typename Archive>
+    void checkpoint(Archive& archive)
+    {
+        archive.expect(NUM_SET, "number of table sets");
+        archive.expect(NUM_WAY, "number of table ways");
+        archive(access_count, block);
+    }
 };
 } // namespace champsim::msl
 
@@ -0,0 +1,106 @@
+#ifndef MSL_POOL_ALLOCATOR_H
+#define MSL_POOL_ALLOCATOR_H
+
+#include <cstddef>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace champsim::msl
+{
+namespace detail
+{
+/**
+ * @brief The freed blocks of one thread, kept by size to be handed out again.
+ * @details
+ * The pool is never destroyed, so blocks freed during static destruction still have a home, and the memory goes back with the process.
+ * A block may be freed by another thread than the one that allocated it, so each size keeps at most MAX_FREE_BLOCKS and the rest go back to the heap.
+ */
+class block_pool
+{
+public:
+    static constexpr std::size_t MAX_FREE_BLOCKS = 4096;
+
+    static block_pool& local()
+    {
+        thread_local block_pool* pool = new block_pool;
+        return *pool;
+    }
+
+    void* allocate(std::size_t bytes)
+    {
+        std::vector<void*>& free_blocks = free_list(bytes);
+        if (free_blocks.empty())
+        {
+            return ::operator new(bytes);
+        }
+
+        void* block = free_blocks.back();
+        free_blocks.pop_back();
+        return block;
+    }
+
+    void deallocate(void* block, std::size_t bytes)
+    {
+        std::vector<void*>& free_blocks = free_list(bytes);
+        if (free_blocks.size() >= MAX_FREE_BLOCKS)
+        {
+            ::operator delete(block);
+            return;
+        }
+
+        free_blocks.push_back(block);
+    }
+
+private:
+    // Containers use a handful of block sizes, so a linear search beats hashing
+    std::vector<std::pair<std::size_t, std::vector<void*> > > free_lists;
+
+    std::vector<void*>& free_list(std::size_t bytes)
+    {
+        for (auto& [size, free_blocks] : free_lists)
+        {
+            if (size == bytes)
+            {
+                return free_blocks;
+            }
+        }
+        return free_lists.emplace_back(bytes, std::vector<void*> {}).second;
+    }
+};
+} // namespace detail
+
+/**
+ * @brief An allocator that recycles the blocks it frees instead of returning them to the heap.
+ * @details
+ * Queues such as std::deque allocate and free blocks of the same sizes over and over as elements pass through them.
+ * Once the queues have reached their working size, every block they ask for is one they freed earlier, so they stop calling malloc.
+ */
+template<typename T>
+class pool_allocator
+{
+    static_assert(alignof(T) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+
+public:
+    using value_type = T;
+
+    pool_allocator() noexcept = default;
+
+    template<typename U>
+    pool_allocator(const pool_allocator<U>& /*other*/) noexcept
+    {
+    }
+
+    [[nodiscard]] T* allocate(std::size_t n) { return static_cast<T*>(detail::block_pool::local().allocate(n * sizeof(T))); }
+
+    void deallocate(T* block, std::size_t n) { detail::block_pool::local().deallocate(block, n * sizeof(T)); }
+
+    template<typename U>
+    friend bool operator==(const pool_allocator& /*lhs*/, const pool_allocator<U>& /*rhs*/) noexcept
+    {
+        return true;
+    }
+};
+} // namespace champsim::msl
+
+#endif
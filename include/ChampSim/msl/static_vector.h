@@ -0,0 +1,82 @@
+#ifndef MSL_STATIC_VECTOR_H
+#define MSL_STATIC_VECTOR_H
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+
+namespace champsim::msl
+{
+/**
+ * @brief A vector of at most N elements stored inline, so it never allocates and copying it is copying an array.
+ * @details Pushing beyond the capacity is an error.
+ */
+template<typename T, std::size_t N>
+class static_vector
+{
+public:
+    using value_type      = T;
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference       = T&;
+    using const_reference = const T&;
+    using pointer         = T*;
+    using const_pointer   = const T*;
+    using iterator        = T*;
+    using const_iterator  = const T*;
+
+    static_vector() = default;
+
+    static_vector(std::initializer_list<T> values)
+    {
+        for (const T& value : values)
+        {
+            push_back(value);
+        }
+    }
+
+    [[nodiscard]] iterator begin() { return std::data(elements); }
+    [[nodiscard]] const_iterator begin() const { return std::data(elements); }
+    [[nodiscard]] const_iterator cbegin() const { return begin(); }
+    [[nodiscard]] iterator end() { return begin() + count; }
+    [[nodiscard]] const_iterator end() const { return begin() + count; }
+    [[nodiscard]] const_iterator cend() const { return end(); }
+
+    [[nodiscard]] pointer data() { return std::data(elements); }
+    [[nodiscard]] const_pointer data() const { return std::data(elements); }
+
+    [[nodiscard]] reference operator[](size_type index) { return elements[index]; }
+    [[nodiscard]] const_reference operator[](size_type index) const { return elements[index]; }
+
+    [[nodiscard]] size_type size() const { return count; }
+    [[nodiscard]] bool empty() const { return count == 0; }
+    [[nodiscard]] static constexpr size_type capacity() { return N; }
+
+    void push_back(const T& value)
+    {
+        assert(count < N);
+        elements[count++] = value;
+    }
+
+    iterator erase(const_iterator first, const_iterator last)
+    {
+        const auto position = static_cast<size_type>(first - begin());
+        std::move(begin() + (last - begin()), end(), begin() + position);
+        count -= static_cast<size_type>(last - first);
+        return begin() + position;
+    }
+
+    void clear() { count = 0; }
+
+    friend bool operator==(const static_vector& lhs, const static_vector& rhs) { return std::equal(std::begin(lhs), std::end(lhs), std::begin(rhs), std::end(rhs)); }
+
+private:
+    std::array<T, N> elements {};
+    size_type count = 0;
+};
+} // namespace champsim::msl
+
+#endif
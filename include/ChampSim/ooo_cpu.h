@@ -47,6 +47,7 @@
 
 #if (USER_CODES == ENABLE)
 #include "ChampSim/address.h"
+#include "ChampSim/functional_warmup.h"
 #else
 #include "ChampSim/champsim.h"
 #endif /* USER_CODES */
@@ -85,7 +86,7 @@ struct LSQ_ENTRY : champsim::program_ordered<LSQ_ENTRY>
 
     LSQ_ENTRY(champsim::address addr, champsim::program_ordered<LSQ_ENTRY>::id_type id, champsim::address ip, std::array<uint8_t, 2> asid);
     void finish(ooo_model_instr& rob_entry) const;
-    void finish(std::deque<ooo_model_instr>::iterator begin, std::deque<ooo_model_instr>::iterator end) const;
+    void finish(champsim::instruction_queue::iterator begin, champsim::instruction_queue::iterator end) const;
 };
 
 // cpu
@@ -123,14 +124,17 @@ public:
     dib_type DIB;
 
     // reorder buffer, load/store queue, register file
-    std::deque<ooo_model_instr> IFETCH_BUFFER;
-    std::deque<ooo_model_instr> DISPATCH_BUFFER;
-    std::deque<ooo_model_instr> DECODE_BUFFER;
-    std::deque<ooo_model_instr> ROB;
-    std::deque<ooo_model_instr> DIB_HIT_BUFFER;
+    champsim::instruction_queue IFETCH_BUFFER;
+    champsim::instruction_queue DISPATCH_BUFFER;
+    champsim::instruction_queue DECODE_BUFFER;
+    champsim::instruction_queue ROB;
+    champsim::instruction_queue DIB_HIT_BUFFER;
+#if (USER_CODES == ENABLE) && (INSTRUCTION_INLINE_STORAGE == ENABLE)
+    std::vector<ooo_model_instr> decode_partition_buffer; // The instructions promote_to_decode() moves behind the decoded ones, kept to reuse its storage
+#endif /* USER_CODES, INSTRUCTION_INLINE_STORAGE */
 
     std::vector<std::optional<LSQ_ENTRY>> LQ;
-    std::deque<LSQ_ENTRY> SQ;
+    champsim::packet_queue<LSQ_ENTRY> SQ;
 
     // Constants
     const std::size_t IFETCH_BUFFER_SIZE, DISPATCH_BUFFER_SIZE, DECODE_BUFFER_SIZE, REGISTER_FILE_SIZE, ROB_SIZE, SQ_SIZE, DIB_HIT_BUFFER_SIZE;
@@ -152,7 +156,7 @@ public:
     champsim::chrono::clock::time_point fetch_resume_time {};
 
     const long IN_QUEUE_SIZE;
-    std::deque<ooo_model_instr> input_queue;
+    champsim::instruction_queue input_queue;
 
     CacheBus L1I_bus, L1D_bus;
     CACHE* l1i;
@@ -178,7 +182,7 @@ public:
     bool do_init_instruction(ooo_model_instr& instr);
     bool do_predict_branch(ooo_model_instr& instr);
     void do_check_dib(ooo_model_instr& instr);
-    bool do_fetch_instruction(std::deque<ooo_model_instr>::iterator begin, std::deque<ooo_model_instr>::iterator end);
+    bool do_fetch_instruction(champsim::instruction_queue::iterator begin, champsim::instruction_queue::iterator end);
     void do_dib_update(const ooo_model_instr& instr);
     void do_scheduling(ooo_model_instr& instr);
     void do_execution(ooo_model_instr& instr);
@@ -200,6 +204,45 @@ public:
 
     void print_deadlock() final;
 
+#if (EVENT_DRIVEN_SKIP_AHEAD == ENABLE)
+    champsim::chrono::clock::time_point next_event_time() const final;
+#endif /* EVENT_DRIVEN_SKIP_AHEAD */
+
+#if (USER_CODES == ENABLE)
+    /**
+     * @brief Save or restore the retired instruction count, the decoded instruction buffer, the branch predictors and the BTBs.
+     * @note Instructions in flight are not part of a checkpoint, the run resumes after the last retired instruction.
+     */
+    void checkpoint(champsim::checkpoint_archive& archive);
+#endif /* USER_CODES */
+
+#if (USER_CODES == ENABLE) && (FUNCTIONAL_WARMUP == ENABLE)
+    /**
+     * @brief Retire an instruction without timing.
+     * @details
+     * The instruction updates the branch predictors, the BTBs and the decoded instruction buffer as do_predict_branch() and do_dib_update() do,
+     * is fetched through the L1I unless it hits in the decoded instruction buffer, and accesses its loads and stores through the L1D.
+     */
+    void functional_retire(ooo_model_instr& instr, champsim::functional_warmer& warmer);
+#endif /* USER_CODES, FUNCTIONAL_WARMUP */
+
+#if (USER_CODES == ENABLE) && (USE_OPENMP == ENABLE) && (PARALLEL_CYCLE_ENGINE == ENABLE)
+    /**
+     * @brief Keep the retire events of retire_rob() until flush_retire_events() instead of handling them right away.
+     * @details Cores operating on different threads must not call the shared event listeners concurrently.
+     */
+    void defer_retire_events(bool defer) { defer_retire = defer; }
+
+    /**
+     * @brief Handle the deferred retire events in the order they happened.
+     */
+    void flush_retire_events();
+
+    bool defer_retire = false;
+    champsim::instruction_queue deferred_retired;                           // The instructions of the deferred retire events, back to back
+    std::vector<std::pair<std::ptrdiff_t, uint64_t> > deferred_retire_events; // The number of instructions and the cycle of each deferred retire event
+#endif /* USER_CODES, USE_OPENMP, PARALLEL_CYCLE_ENGINE */
+
 #if (USER_CODES == ENABLE)
 #else
 #include "module_decl.inc" // ooo_cpu_module_decl.inc
@@ -213,6 +256,9 @@ public:
         virtual void impl_initialize_branch_predictor()                                                                                    = 0;
         virtual void impl_last_branch_result(champsim::address ip, champsim::address target, bool taken, uint8_t branch_type)              = 0;
         virtual bool impl_predict_branch(champsim::address ip, champsim::address predicted_target, bool always_taken, uint8_t branch_type) = 0;
+#if (USER_CODES == ENABLE)
+        virtual void impl_branch_predictor_checkpoint(champsim::checkpoint_archive& archive)                                               = 0;
+#endif /* USER_CODES */
     };
 
     struct btb_module_concept
@@ -222,6 +268,9 @@ public:
         virtual void impl_initialize_btb()                                                                                      = 0;
         virtual void impl_update_btb(champsim::address ip, champsim::address predicted_target, bool taken, uint8_t branch_type) = 0;
         virtual std::pair<champsim::address, bool> impl_btb_prediction(champsim::address ip, uint8_t branch_type)               = 0;
+#if (USER_CODES == ENABLE)
+        virtual void impl_btb_checkpoint(champsim::checkpoint_archive& archive)                                                 = 0;
+#endif /* USER_CODES */
     };
 
     template<typename... Bs>
@@ -234,6 +283,9 @@ public:
         void impl_initialize_branch_predictor() final;
         void impl_last_branch_result(champsim::address ip, champsim::address target, bool taken, uint8_t branch_type) final;
         [[nodiscard]] bool impl_predict_branch(champsim::address ip, champsim::address predicted_target, bool always_taken, uint8_t branch_type) final;
+#if (USER_CODES == ENABLE)
+        void impl_branch_predictor_checkpoint(champsim::checkpoint_archive& archive) final;
+#endif /* USER_CODES */
     };
 
     template<typename... Ts>
@@ -246,6 +298,9 @@ public:
         void impl_initialize_btb() final;
         void impl_update_btb(champsim::address ip, champsim::address predicted_target, bool taken, uint8_t branch_type) final;
         [[nodiscard]] std::pair<champsim::address, bool> impl_btb_prediction(champsim::address ip, uint8_t branch_type) final;
+#if (USER_CODES == ENABLE)
+        void impl_btb_checkpoint(champsim::checkpoint_archive& archive) final;
+#endif /* USER_CODES */
     };
 
     std::unique_ptr<branch_module_concept> branch_module_pimpl;
@@ -410,6 +465,33 @@ std::pair<champsim::address, bool> O3_CPU::btb_module_model<Ts...>::impl_btb_pre
 }
 
 #if (USER_CODES == ENABLE)
+template<typename... Bs>
+void O3_CPU::branch_module_model<Bs...>::impl_branch_predictor_checkpoint(champsim::checkpoint_archive& archive)
+{
+    [[maybe_unused]] auto process_one = [&](auto& b)
+    {
+        using namespace champsim::modules;
+        if constexpr (branch_predictor::has_checkpoint<decltype(b)>)
+            b.branch_predictor_checkpoint(archive);
+    };
+
+    std::apply([&](auto&... b)
+        { (..., process_one(b)); }, intern_);
+}
+
+template<typename... Ts>
+void O3_CPU::btb_module_model<Ts...>::impl_btb_checkpoint(champsim::checkpoint_archive& archive)
+{
+    [[maybe_unused]] auto process_one = [&](auto& t)
+    {
+        using namespace champsim::modules;
+        if constexpr (btb::has_checkpoint<decltype(t)>)
+            t.btb_checkpoint(archive);
+    };
+
+    std::apply([&](auto&... t)
+        { (..., process_one(t)); }, intern_);
+}
 #else
 #include "ooo_cpu_module_def.inc"
 #endif /* USER_CODES */
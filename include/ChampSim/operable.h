@@ -51,6 +51,24 @@ public:
     virtual void print_deadlock() {} // LCOV_EXCL_LINE
 
     [[deprecated]] uint64_t current_cycle() const;
+
+#if (EVENT_DRIVEN_SKIP_AHEAD == ENABLE)
+    long last_progress {0}; // Progress made by the latest operate()
+
+    /**
+     * @brief Get the earliest time at which operate() may do any work, assuming no other operable changes this one before then.
+     * Work that is blocked on another operable is not an event, since that operable reports its own progress first.
+     * The default reports the next cycle, which never lets the simulation skip over this operable.
+     */
+    virtual champsim::chrono::clock::time_point next_event_time() const { return current_time + clock_period; }
+
+    /**
+     * @brief Advance this operable over idle cycles in which operate() would do no work.
+     * @param cycles The number of skipped cycles.
+     * @return The progress operate() would have reported over the skipped cycles.
+     */
+    virtual long skip_cycles(long cycles);
+#endif /* EVENT_DRIVEN_SKIP_AHEAD */
 };
 
 } // namespace champsim
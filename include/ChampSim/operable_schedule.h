@@ -0,0 +1,54 @@
+#ifndef OPERABLE_SCHEDULE_H
+#define OPERABLE_SCHEDULE_H
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+#include "ChampSim/operable.h"
+#include "ProjectConfiguration.h" // User file
+
+#if (USER_CODES == ENABLE)
+
+namespace champsim
+{
+
+/**
+ * @brief The order in which the operables are operated, kept across cycles instead of being rebuilt and sorted every cycle.
+ * Operables are ordered by current_time, and operables due at the same time keep the order in which they were given,
+ * which is the order std::stable_sort() over operable_view() produces.
+ * @note Every operable is operated in every cycle, so the order only changes when operables with different clock periods
+ * overtake each other. An insertion sort restores it in one pass without any comparison swap when nothing overtook,
+ * which is the common case, where a heap would pay a pop and a push per operable per cycle.
+ */
+class operable_schedule
+{
+public:
+    using operable_list = std::vector<std::reference_wrapper<operable> >;
+
+    operable_schedule() = default;
+
+    /**
+     * @param operables All operables, in the order used to break ties.
+     */
+    explicit operable_schedule(operable_list operables);
+
+    /**
+     * @brief Restore the order after the operables' current_time changed.
+     */
+    void update();
+
+    bool empty() const { return ordered.empty(); }
+
+    const operable_list& operables() const { return ordered; }
+
+private:
+    operable_list ordered {};
+    std::vector<std::size_t> rank {}; // Tie-breaking rank of each entry in ordered
+};
+
+} // namespace champsim
+
+#endif /* USER_CODES */
+
+#endif
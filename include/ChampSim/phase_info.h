@@ -40,8 +40,32 @@ struct phase_info
     long long length; // Instruction number to execute
     std::vector<std::size_t> trace_index;
     std::vector<std::string> trace_names;
+#if (USER_CODES == ENABLE) && (FUNCTIONAL_WARMUP == ENABLE)
+    bool is_functional = false; // Whether this warmup phase runs without timing, see do_functional_phase()
+#endif /* USER_CODES, FUNCTIONAL_WARMUP */
+#if (USER_CODES == ENABLE) && (SAMPLED_SIMULATION == ENABLE)
+    double weight  = 1.0;   // Weight of the sample this phase measures
+    bool is_sample = false; // Whether this phase measures a sample of a sampled run, see champsim::sampling
+#endif /* USER_CODES, SAMPLED_SIMULATION */
 };
 
+#if (USER_CODES == ENABLE) && (SAMPLED_SIMULATION == ENABLE)
+/**
+ * @brief Results of one sample of a sampled run.
+ */
+struct sample_stats
+{
+    std::string name;
+    double weight;
+    std::vector<O3_CPU::stats_type> cpu_stats;
+    std::vector<CACHE::stats_type> cache_stats;
+    uint64_t memory_reads         = 0;              // Read requests main memory served
+    uint64_t memory_writes        = 0;              // Write requests main memory served
+    uint64_t fast_memory_requests = 0;              // Requests the fast memory served, with hybrid memory
+    champsim::chrono::picoseconds elapsed {};       // Simulated time
+};
+#endif /* USER_CODES, SAMPLED_SIMULATION */
+
 struct phase_stats
 {
     std::string name;
@@ -49,6 +73,9 @@ struct phase_stats
     std::vector<O3_CPU::stats_type> roi_cpu_stats, sim_cpu_stats;
     std::vector<CACHE::stats_type> roi_cache_stats, sim_cache_stats;
     std::vector<DRAM_CHANNEL::stats_type> roi_dram_stats, sim_dram_stats;
+#if (USER_CODES == ENABLE) && (SAMPLED_SIMULATION == ENABLE)
+    std::vector<sample_stats> samples; // Results of each sample, when this phase gathers the samples of a sampled run
+#endif /* USER_CODES, SAMPLED_SIMULATION */
 };
 
 } // namespace champsim
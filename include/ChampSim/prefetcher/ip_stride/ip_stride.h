@@ -55,6 +55,10 @@ public:
     uint32_t prefetcher_cache_operate(champsim::address addr, champsim::address ip, uint8_t cache_hit, bool useful_prefetch, access_type type, uint32_t metadata_in);
     uint32_t prefetcher_cache_fill(champsim::address addr, long set, long way, uint8_t prefetch, champsim::address evicted_addr, uint32_t metadata_in);
     void prefetcher_cycle_operate();
+
+#if (USER_CODES == ENABLE)
+    void prefetcher_checkpoint(champsim::checkpoint_archive& archive);
+#endif /* USER_CODES */
 };
 
 #endif
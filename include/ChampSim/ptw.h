@@ -26,6 +26,8 @@
 #include "ChampSim/address.h"
 #include "ChampSim/bandwidth.h"
 #include "ChampSim/channel.h"
+#include "ChampSim/checkpoint.h"
+#include "ChampSim/functional_warmup.h"
 #include "ChampSim/operable.h"
 #include "ChampSim/ptw_builder.h"
 #include "ChampSim/util/lru_table.h"
@@ -60,8 +62,8 @@ class PageTableWalker : public champsim::operable
         champsim::address v_address {};
         champsim::waitable<champsim::address> data {};
 
-        std::vector<uint64_t> instr_depend_on_me {};
-        std::vector<std::deque<response_type>*> to_return {};
+        champsim::dependent_instructions instr_depend_on_me {};
+        champsim::response_queues<response_type> to_return {};
 
         uint32_t pf_metadata          = 0;
         uint32_t cpu                  = std::numeric_limits<uint32_t>::max();
@@ -72,9 +74,15 @@ class PageTableWalker : public champsim::operable
         mshr_type(const request_type& req, std::size_t level);
     };
 
-    std::deque<mshr_type> MSHR;
-    std::deque<mshr_type> finished;
-    std::deque<mshr_type> completed;
+    champsim::packet_queue<mshr_type> MSHR;
+    champsim::packet_queue<mshr_type> finished;
+    champsim::packet_queue<mshr_type> completed;
+#if (USER_CODES == ENABLE) && (INSTRUCTION_INLINE_STORAGE == ENABLE)
+
+    // Kept from cycle to cycle, so operate() and handle_read() do not allocate them every time
+    std::vector<mshr_type> next_steps_buffer {};
+    std::vector<std::optional<pscl_entry>> pscl_hits {};
+#endif /* USER_CODES, INSTRUCTION_INLINE_STORAGE */
 
     std::vector<channel_type*> upper_levels;
     channel_type* lower_level;
@@ -102,6 +110,29 @@ public:
 
     void begin_phase() final;
     void print_deadlock() final;
+
+#if (EVENT_DRIVEN_SKIP_AHEAD == ENABLE)
+    champsim::chrono::clock::time_point next_event_time() const final;
+#endif /* EVENT_DRIVEN_SKIP_AHEAD */
+
+#if (USER_CODES == ENABLE)
+    /**
+     * @brief Save or restore the paging structure caches.
+     */
+    void checkpoint(champsim::checkpoint_archive& archive);
+#endif /* USER_CODES */
+
+#if (USER_CODES == ENABLE) && (FUNCTIONAL_WARMUP == ENABLE)
+    /** @return The channels from the TLBs this walker serves */
+    [[nodiscard]] const std::vector<channel_type*>& upper_channels() const { return upper_levels; }
+
+    /**
+     * @brief Walk the page table without timing.
+     * @details The walk starts from the paging structure caches, reads each page table entry through the cache below and fills the paging structure caches, as handle_read() and handle_fill() do.
+     * @return The physical page of the virtual address.
+     */
+    champsim::address functional_walk(champsim::functional_warmer& warmer, uint32_t cpu, champsim::address v_address);
+#endif /* USER_CODES, FUNCTIONAL_WARMUP */
 };
 
 #endif
@@ -9,6 +9,7 @@
 
 #if (USER_CODES == ENABLE) && (RAMULATOR2 == ENABLE)
 
+#include <cstddef>
 #include <cstdint>
 #include <deque>
 #include <memory>
@@ -17,11 +18,13 @@
 
 #include "ChampSim/address.h"
 #include "ChampSim/channel.h"
+#include "ChampSim/checkpoint.h"
 #include "ChampSim/chrono.h"
 #include "ChampSim/dram_stats.h"
 #include "ChampSim/operable.h"
 #include "Ramulator2/base/request.h"
 #include "os_transparent_management.h"
+#include "shadow_management.h"
 
 #if (MEMORY_USE_HYBRID == ENABLE)
 #include <array>
@@ -38,6 +41,34 @@ class IMemorySystem;
 struct Request;
 } // namespace Ramulator
 
+/**
+ * @brief ChampSim's packets of the read requests in the memories, which return_data() uses to answer the LLC.
+ * @details
+ * A Ramulator request only carries the handle of its packet, so copying a request never copies the packet's vectors.
+ * Released entries are reused, and copying a packet into a reused entry reuses the entry's vector storage.
+ */
+class PacketTable
+{
+public:
+    using packet_type              = DRAM_CHANNEL::request_type;
+
+    static constexpr int NO_PACKET = -1;
+
+    /** @return The handle of the entry holding a copy of the packet */
+    int hold(const packet_type& packet);
+
+    void release(int handle) { free_handles.push_back(handle); };
+
+    packet_type& operator[](int handle) { return packets[handle]; };
+
+    /** @return Number of packets held */
+    std::size_t size() const { return packets.size() - free_handles.size(); };
+
+private:
+    std::vector<packet_type> packets;
+    std::vector<int> free_handles;
+};
+
 /* Prototype */
 
 #if (MEMORY_USE_HYBRID == ENABLE)
@@ -70,10 +101,19 @@ class MEMORY_CONTROLLER : public champsim::operable
         Max
     };
 
+    PacketTable packets; // Packets of the read requests in the memories
+
     void initiate_requests();
     bool add_rq(request_type& packet, champsim::channel* ul);
     bool add_wq(request_type& packet);
 
+    /**
+     * @brief Send a request to a memory, which answers it through return_data()
+     * @return Whether the memory accepts the request
+     * @note The address is relative to the memory. A read request holds its packet in the packet table until it is answered.
+     */
+    bool send_request(Ramulator::IMemorySystem* memory, Ramulator::Addr_t address, int type, int source_id, const DRAM_CHANNEL::request_type& packet, uint8_t memory_id);
+
 public:
     const uint8_t memory_id  = MEMORY_NUMBER_ONE;
     const uint8_t memory2_id = MEMORY_NUMBER_TWO;
@@ -85,6 +125,10 @@ public:
     OS_TRANSPARENT_MANAGEMENT* os_transparent_management = nullptr;
 #endif /* MEMORY_USE_OS_TRANSPARENT_MANAGEMENT */
 
+#if (SHADOW_OS_TRANSPARENT_MANAGEMENT == ENABLE)
+    SHADOW_MANAGEMENT* shadow_management = nullptr; // Built once the capacities are known, as os_transparent_management
+#endif /* SHADOW_OS_TRANSPARENT_MANAGEMENT */
+
 #if (MEMORY_USE_SWAPPING_UNIT == ENABLE)
     /* Swapping unit */
     struct BUFFER_ENTRY
@@ -98,18 +142,41 @@ public:
         bool dirty[SWAPPING_SEGMENT_NUMBER];                                 // Whether a "new" write request is received
     };
 
-    std::array<BUFFER_ENTRY, SWAPPING_BUFFER_ENTRY_NUMBER> buffer = {};
-    uint64_t base_address[SWAPPING_SEGMENT_NUMBER]; // Here base_address[0] for segment 1, base_address[1] for segment 2. Address is hardware address and at cache line granularity.
-    uint8_t active_entry_number;
-    uint8_t finish_number;
-
     // Scoped enumerations
     enum class SwappingState : uint8_t
     {
         Idle,
         Swapping
     };
-    SwappingState states; // The state of swapping mechanism
+
+    /**
+     * @brief A swapping engine, which swaps a pair of segments through its own buffer.
+     * @details
+     * The engines swap different segments in parallel, and each of them issues the reads of both segments and the writes of the
+     * cache lines it has read as the memories accept them, so the reads of a swap overlap the writes of another.
+     * An engine keeps at most buffer_depth cache lines of its segments in flight, a line being in flight from its first read until
+     * both its writes are accepted, so a shallow engine swaps a large segment in several rounds.
+     */
+    struct SWAPPING_ENGINE
+    {
+        std::array<BUFFER_ENTRY, SWAPPING_BUFFER_ENTRY_NUMBER> buffer = {};
+        uint64_t base_address[SWAPPING_SEGMENT_NUMBER]                = {0}; // Here base_address[0] for segment 1, base_address[1] for segment 2. Address is hardware address and at cache line granularity.
+        uint8_t active_entry_number                                   = 0;
+        uint8_t finish_number                                         = 0;
+        uint8_t buffer_depth                                          = SWAPPING_BUFFER_ENTRY_NUMBER; // Cache lines swapped at once, from SWAPPING_ENGINE_BUFFER_DEPTHS
+        SwappingState states                                          = SwappingState::Idle; // The state of this engine
+
+        uint64_t start_cycle                                          = 0; // When the swap started
+#if (MEMORY_USE_OS_TRANSPARENT_MANAGEMENT == ENABLE)
+        OS_TRANSPARENT_MANAGEMENT::RemappingRequestHandle remapping_request_handle = {}; // The remapping request being swapped
+#endif /* MEMORY_USE_OS_TRANSPARENT_MANAGEMENT */
+
+        SIMULATOR_STATISTICS::SwappingEngineStatistics statistics;
+    };
+
+    std::array<SWAPPING_ENGINE, SWAPPING_ENGINE_NUMBER> engines;
+    uint8_t first_engine; // The engine that issues first in this cycle, which rotates so no engine takes the memories' queues from the others
+    uint64_t swapping_cycle;
 
     uint64_t swapping_count;
     uint64_t swapping_traffic_in_bytes;
@@ -146,6 +213,14 @@ public:
      */
     [[nodiscard]] champsim::data::bytes size() const;
 
+    /**
+     * @brief
+     * Get the size of the fast memory, which is the lowest part of the physical space
+     *
+     * @return Size of the fast memory [Byte]
+     */
+    [[nodiscard]] champsim::data::bytes fast_memory_size() const;
+
     /**
      * @brief Get the number of valid members in the related write/read queue
      * @param[in] queue_type The type of queue
@@ -172,19 +247,61 @@ public:
      */
     void return_data(Ramulator::Request& request);
 
+#if (TELEMETRY == ENABLE)
+    /**
+     * @brief Get the running counters of each channel of a memory
+     * @param[in] memory The memory_id of the memory
+     */
+    std::vector<Ramulator::ChannelCounters> get_channel_counters(uint8_t memory) const;
+#endif /* TELEMETRY */
+
+#if (MEMORY_USE_OS_TRANSPARENT_MANAGEMENT == ENABLE)
+    /**
+     * @brief Save or restore the remapping tables and the hotness tracking of the OS-transparent management design.
+     * @note Remapping requests and swaps in flight are not part of a checkpoint.
+     */
+    void checkpoint(champsim::checkpoint_archive& archive);
+
+#if (FUNCTIONAL_WARMUP == ENABLE)
+    /**
+     * @brief Track a request in the OS-transparent management design without timing, so its hotness tracking and remapping tables warm up.
+     * @note The remapping requests it makes finish at once, as they do without the swapping unit, but the ones swapping engines already swap finish once timing resumes.
+     */
+    void functional_access(const request_type& packet);
+#endif /* FUNCTIONAL_WARMUP */
+#endif /* MEMORY_USE_OS_TRANSPARENT_MANAGEMENT */
+
 #if (MEMORY_USE_SWAPPING_UNIT == ENABLE)
 public:
-    // Input address should be hardware address and at byte granularity
+    // Input address should be hardware address and at byte granularity. The first idle engine swaps the segments.
     bool start_swapping_segments(uint64_t address_1, uint64_t address_2, uint8_t size);
 
-    // Input address should be hardware address and at byte granularity
+    // Input address should be hardware address and at byte granularity. The engine swapping the same segments swaps the new data too.
     bool update_swapping_segments(uint64_t address_1, uint64_t address_2, uint8_t size);
 
 private:
     /* Member functions for swapping */
-    void initialize_swapping();
+    void initialize_swapping(SWAPPING_ENGINE& engine);
+
+    bool start_swapping_segments(SWAPPING_ENGINE& engine, uint64_t address_1, uint64_t address_2, uint8_t size);
+    bool update_swapping_segments(SWAPPING_ENGINE& engine, uint64_t address_1, uint64_t address_2, uint8_t size);
+
+    uint8_t operate_swapping(SWAPPING_ENGINE& engine);
 
-    uint8_t operate_swapping();
+    // Find the engine and the buffer entry swapping the address, which is hardware address and at cache line granularity.
+    SWAPPING_ENGINE* find_swapping_entry(uint64_t address, uint8_t& segment_index, uint8_t& entry_index);
+    bool find_swapping_entry(const SWAPPING_ENGINE& engine, uint64_t address, uint8_t& segment_index, uint8_t& entry_index) const;
+
+    // Whether the entry has issued the read of the segment and waits for its data.
+    static bool is_waiting_for_read(const BUFFER_ENTRY& entry, uint8_t segment_index);
+
+    // Whether an engine swaps any cache line of the segments. Input address should be hardware address and at byte granularity.
+    bool is_under_swapping(uint64_t address_1, uint64_t address_2, uint8_t size);
+
+#if (MEMORY_USE_OS_TRANSPARENT_MANAGEMENT == ENABLE)
+    // A remapping request can start unless an engine still swaps its data
+    bool can_start_remapping_request(const OS_TRANSPARENT_MANAGEMENT::RemappingRequest& remapping_request);
+#endif /* MEMORY_USE_OS_TRANSPARENT_MANAGEMENT */
 
     // This function is used by memories, like Ramulator.
     void return_swapping_data(Ramulator::Request& request);
@@ -210,6 +327,7 @@ class MEMORY_CONTROLLER : public champsim::operable
     Ramulator::IFrontEnd* frontend          = nullptr;
     Ramulator::IMemorySystem* memory_system = nullptr;
     double io_freq_scale                    = {};
+    double leap_operation                   = {}; // Accumulated CPU cycles to skip before the next memory tick
 
     // Memory capacity [Byte].
     uint64_t max_address                    = 0;
@@ -222,10 +340,19 @@ class MEMORY_CONTROLLER : public champsim::operable
         Max
     };
 
+    PacketTable packets; // Packets of the read requests in the memory
+
     void initiate_requests();
     bool add_rq(const request_type& packet, champsim::channel* ul);
     bool add_wq(const request_type& packet);
 
+    /**
+     * @brief Send a request to the memory, which answers it through return_data()
+     * @return Whether the memory accepts the request
+     * @note A read request holds its packet in the packet table until it is answered.
+     */
+    bool send_request(Ramulator::IMemorySystem* memory, Ramulator::Addr_t address, int type, int source_id, const DRAM_CHANNEL::request_type& packet, uint8_t memory_id);
+
 public:
     const uint8_t memory_id = 0;
 
@@ -241,6 +368,13 @@ public:
     void end_phase(unsigned cpu) final;
     void print_deadlock() final;
 
+#if (EVENT_DRIVEN_SKIP_AHEAD == ENABLE)
+    static constexpr long MAX_SKIP_CYCLES = 4096; // Longest lookahead for the next memory event [CPU cycles]
+
+    champsim::chrono::clock::time_point next_event_time() const final;
+    long skip_cycles(long cycles) final;
+#endif /* EVENT_DRIVEN_SKIP_AHEAD */
+
     /**
      * @brief
      * Get the size of the physical space of the memory system
@@ -274,6 +408,14 @@ public:
      * @note Write requests don't return responses to LLC
      */
     void return_data(Ramulator::Request& request);
+
+#if (TELEMETRY == ENABLE)
+    /**
+     * @brief Get the running counters of each channel of a memory
+     * @param[in] memory The memory_id of the memory
+     */
+    std::vector<Ramulator::ChannelCounters> get_channel_counters(uint8_t memory) const;
+#endif /* TELEMETRY */
 };
 
 #endif /* MEMORY_USE_HYBRID */
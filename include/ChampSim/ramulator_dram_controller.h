@@ -487,7 +487,7 @@ long MEMORY_CONTROLLER<T, T2>::operate()
 
 #if (MEMORY_USE_OS_TRANSPARENT_MANAGEMENT == ENABLE)
 #if (IDEAL_SINGLE_MEMPOD == ENABLE)
-    os_transparent_management->check_interval_swap(swapping_states, warmup);
+    os_transparent_management->check_interval_swap(warmup);
 #endif /* IDEAL_SINGLE_MEMPOD */
 #endif /* MEMORY_USE_OS_TRANSPARENT_MANAGEMENT */
 
@@ -8,6 +8,11 @@
 #define REG_ALLOC_H
 
 #include "ChampSim/instruction.h"
+#include "ProjectConfiguration.h" // User file
+
+#if (USER_CODES == ENABLE) && (INSTRUCTION_INLINE_STORAGE == ENABLE)
+#include "ChampSim/msl/pool_allocator.h"
+#endif /* USER_CODES, INSTRUCTION_INLINE_STORAGE */
 
 struct physical_register
 {
@@ -21,7 +26,12 @@ class RegisterAllocator
 {
 private:
     std::array<PHYSICAL_REGISTER_ID, std::numeric_limits<uint8_t>::max() + 1> frontend_RAT, backend_RAT;
+#if (USER_CODES == ENABLE) && (INSTRUCTION_INLINE_STORAGE == ENABLE)
+    // Registers are freed and reused every cycle, so the queue recycles its blocks
+    std::queue<PHYSICAL_REGISTER_ID, std::deque<PHYSICAL_REGISTER_ID, champsim::msl::pool_allocator<PHYSICAL_REGISTER_ID>>> free_registers;
+#else
     std::queue<PHYSICAL_REGISTER_ID> free_registers;
+#endif /* USER_CODES, INSTRUCTION_INLINE_STORAGE */
     std::vector<physical_register> physical_register_file;
 
 public:
@@ -44,6 +44,9 @@ public:
 
     void update_brrip(long set, long way);
     void update_srrip(long set, long way);
+#if (USER_CODES == ENABLE)
+    void replacement_checkpoint(champsim::checkpoint_archive& archive);
+#endif /* USER_CODES */
 };
 
 #endif
@@ -19,6 +19,9 @@ struct random : public champsim::modules::replacement
     // void update_replacement_state(uint32_t triggering_cpu, long set, long way, uint64_t full_addr, uint64_t ip, uint64_t victim_addr, access_type type, uint8_t
     // hit);
     //  void replacement_final_stats()
+#if (USER_CODES == ENABLE)
+    void replacement_checkpoint(champsim::checkpoint_archive& archive);
+#endif /* USER_CODES */
 };
 
 #endif
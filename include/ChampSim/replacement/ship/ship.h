@@ -51,6 +51,9 @@ public:
 
     // use this function to print out your own stats at the end of simulation
     // void replacement_final_stats() {}
+#if (USER_CODES == ENABLE)
+    void replacement_checkpoint(champsim::checkpoint_archive& archive);
+#endif /* USER_CODES */
 };
 
 #endif
@@ -34,6 +34,9 @@ struct srrip : public champsim::modules::replacement
 
     // use this function to print out your own stats at the end of simulation
     // void replacement_final_stats() {}
+#if (USER_CODES == ENABLE)
+    void replacement_checkpoint(champsim::checkpoint_archive& archive);
+#endif /* USER_CODES */
 };
 
 #endif
@@ -0,0 +1,66 @@
+#ifndef SAMPLING_H
+#define SAMPLING_H
+
+#include <string>
+#include <vector>
+
+#include "ChampSim/phase_info.h"
+#include "ProjectConfiguration.h" // User file
+
+#if (USER_CODES == ENABLE) && (SAMPLED_SIMULATION == ENABLE)
+
+namespace champsim::sampling
+{
+
+/**
+ * @brief How a run is sampled: from a SimPoint file, periodically (SMARTS), or not at all.
+ */
+struct sampling_options
+{
+    std::string simpoint_path {};          // File of (start instruction, weight) lines, one per sample
+    long long period               = 0;    // Instructions from the start of one periodic sample to the next
+    long long sample_instructions  = 1000; // Instructions measured in each sample
+    long long warmup_instructions  = 2000; // Instructions warmed up in detail before each sample
+
+    [[nodiscard]] bool enabled() const { return ! simpoint_path.empty() || period > 0; }
+};
+
+/**
+ * @brief Build the phases of a sampled run, which replace the warmup and simulation phases.
+ * @details
+ * Each sample is reached by a functional warmup phase, warmed up in detail for options.warmup_instructions, then measured for options.sample_instructions.
+ * SimPoint samples start at the instructions of the file, whose weights they carry.
+ * Periodic samples are equally weighted and end each period of the first length instructions.
+ */
+std::vector<phase_info> sampled_phases(const sampling_options& options, long long length, const std::vector<std::string>& trace_names);
+
+/**
+ * @brief The metrics a sampled run estimates, measured in one sample.
+ */
+struct sample_metrics
+{
+    std::vector<double> ipc;     // Per CPU
+    double llc_mpki;             // Demand (load, RFO and translation) misses of the LLC per kilo instructions of all CPUs
+    double memory_bandwidth;     // [GB/s] Requests main memory served, as blocks, over the simulated time
+    double fast_memory_hit_rate; // Share of the main memory requests the fast memory served, with hybrid memory
+};
+
+[[nodiscard]] sample_metrics metrics(const sample_stats& sample);
+
+/**
+ * @brief The weighted mean of a metric over the samples and the half width of its 95% confidence interval.
+ * @note The half width is NaN with fewer than two samples.
+ */
+struct estimate
+{
+    double mean;
+    double half_width;
+};
+
+[[nodiscard]] estimate weighted_estimate(const std::vector<double>& values, const std::vector<double>& weights);
+
+} // namespace champsim::sampling
+
+#endif /* USER_CODES, SAMPLED_SIMULATION */
+
+#endif /* SAMPLING_H */
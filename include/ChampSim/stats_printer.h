@@ -40,6 +40,9 @@ public:
     static std::vector<std::string> format(CACHE::stats_type stats);
     static std::vector<std::string> format(DRAM_CHANNEL::stats_type stats);
     static std::vector<std::string> format(phase_stats& stats);
+#if (USER_CODES == ENABLE) && (SAMPLED_SIMULATION == ENABLE)
+    static std::vector<std::string> format(const std::vector<sample_stats>& samples);
+#endif /* USER_CODES, SAMPLED_SIMULATION */
 };
 
 class json_printer
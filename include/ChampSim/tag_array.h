@@ -0,0 +1,73 @@
+#ifndef TAG_ARRAY_H
+#define TAG_ARRAY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "ProjectConfiguration.h" // User file
+
+#if (USER_CODES == ENABLE)
+
+namespace champsim
+{
+
+/**
+ * @brief The tags of a cache kept apart from its blocks, as a structure of arrays.
+ * @details
+ * The tags of each set are packed next to each other and the valid bits of each set are packed into bitmasks,
+ * so a lookup compares all ways of a set with a few SIMD compares instead of walking the blocks one by one.
+ * The blocks stay the home of everything else (addresses, data, dirty and prefetch bits and metadata),
+ * so the replacement policies and the prefetchers still see the same blocks as before.
+ */
+class tag_array
+{
+public:
+    /** @brief The instructions that compare the tags of a set */
+    enum class compare_kernel
+    {
+        scalar,
+        sse4_1,
+        avx2
+    };
+
+    /** @return The fastest kernel supported by the running CPU */
+    [[nodiscard]] static compare_kernel best_kernel();
+
+    /** @return Whether the running CPU supports the kernel */
+    [[nodiscard]] static bool is_supported(compare_kernel kernel);
+
+    tag_array(std::size_t num_set, std::size_t num_way, compare_kernel kernel = best_kernel());
+
+    /** @return The first valid way of the set holding the tag, or the number of ways if there is none */
+    [[nodiscard]] long find(long set, uint64_t tag) const;
+
+    /** @return The first way of the set holding the tag, valid or not, or the number of ways if there is none */
+    [[nodiscard]] long find_any(long set, uint64_t tag) const;
+
+    /** @return The first invalid way of the set, or the number of ways if there is none */
+    [[nodiscard]] long find_invalid(long set) const;
+
+    void fill(long set, long way, uint64_t tag);
+    void invalidate(long set, long way);
+
+private:
+    using compare_function = uint64_t (*)(const uint64_t* tags, std::size_t count, uint64_t tag);
+
+    static constexpr std::size_t WAYS_PER_MASK = 64;
+
+    std::size_t num_way;
+    std::size_t masks_per_set;
+    compare_function compare;
+    std::vector<uint64_t> tags;  // Indexed by set * num_way + way
+    std::vector<uint64_t> valid; // Indexed by set * masks_per_set + way / WAYS_PER_MASK
+
+    [[nodiscard]] long first_match(long set, uint64_t tag, bool valid_only) const;
+    uint64_t& valid_mask(long set, long way);
+};
+
+} // namespace champsim
+
+#endif /* USER_CODES */
+
+#endif
@@ -0,0 +1,199 @@
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <array>
+#include <cassert>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ChampSim/chrono.h"
+#include "ChampSim/environment.h"
+#include "ProjectConfiguration.h" // User file
+
+#if (USER_CODES == ENABLE) && (TELEMETRY == ENABLE)
+
+/**
+ * @brief Layout of the telemetry file written with --telemetry.
+ * @details
+ * The file is MAGIC, the uint32_t number of columns, and for each column its column_type as a uint8_t and its name as a uint16_t length followed by the characters.
+ * Blocks follow, each the uint32_t number of its rows, at most ROWS_PER_BLOCK, and then all values of the first column, all values of the second column, and so on,
+ * so a reader loads one metric without reading the others. Values are in the byte order of the simulating machine.
+ */
+namespace champsim::telemetry
+{
+constexpr std::array<char, 8> MAGIC  = {'C', 'S', 'T', 'E', 'L', 'E', 'M', '1'};
+constexpr std::size_t ROWS_PER_BLOCK = 1024;
+
+enum class column_type : uint8_t
+{
+    uint64  = 0, // Running counts and times
+    uint32  = 1, // Occupancies at the snapshot
+    float32 = 2  // Rates and ratios over the interval since the previous snapshot
+};
+
+[[nodiscard]] constexpr std::size_t width(column_type type) { return (type == column_type::uint64) ? sizeof(uint64_t) : sizeof(uint32_t); }
+
+struct column
+{
+    std::string name;
+    column_type type;
+};
+
+/**
+ * @brief Where the snapshots go and how often they are taken, no snapshot is taken without a path.
+ */
+struct telemetry_options
+{
+    std::string path {};         // File the snapshots are written to
+    uint64_t interval = 100000;  // Cycles of the fastest clock from one snapshot to the next
+
+    [[nodiscard]] bool enabled() const { return ! path.empty(); }
+};
+
+/**
+ * @brief Writes rows of values into the telemetry file on a background thread.
+ * @details
+ * The simulation thread stores each value straight into its column of the current block, so a full block is already columnar.
+ * Full blocks are handed to the writer thread, which does all the file I/O.
+ * A handoff happens once every ROWS_PER_BLOCK rows, so a mutex is cheap enough for it, and blocks are recycled instead of allocated.
+ */
+class column_writer
+{
+public:
+    /**
+     * @param file The opened output file, not closed by the writer.
+     */
+    column_writer(FILE* file, std::vector<column> columns_);
+    ~column_writer();
+
+    column_writer(const column_writer&)            = delete;
+    column_writer& operator=(const column_writer&) = delete;
+
+    /** @brief Store the value of the next column of the current row */
+    template<typename T>
+    void add(T value)
+    {
+        assert(next_column < columns.size() && width(columns[next_column].type) == sizeof(T));
+        std::memcpy(current.data.data() + column_offsets[next_column] + current.rows * sizeof(T), &value, sizeof(T));
+        next_column++;
+    };
+
+    /** @brief Finish the current row, which all columns have a value in */
+    void end_row();
+
+    [[nodiscard]] std::size_t column_number() const { return columns.size(); }
+    [[nodiscard]] uint64_t row_number() const { return rows; }
+
+    /**
+     * @brief Write out every finished row and stop the writer thread.
+     */
+    void close();
+
+private:
+    struct block
+    {
+        std::vector<uint8_t> data; // Each column holds ROWS_PER_BLOCK values from its offset on
+        uint32_t rows = 0;
+    };
+
+    FILE* file;
+    std::vector<column> columns;
+    std::vector<std::size_t> column_offsets;
+    std::size_t next_column = 0;
+    uint64_t rows           = 0;
+    block current;
+
+    std::mutex mutex;
+    std::condition_variable full_ready;
+    std::deque<block> full_blocks;  // Blocks the writer thread has yet to write
+    std::vector<block> free_blocks; // Blocks written out, to be filled again
+    bool stopping = false;
+    std::thread writer;
+
+    [[nodiscard]] block new_block() const;
+    void write_block(const block& full) const;
+    void run();
+};
+
+/**
+ * @brief Takes a snapshot of the cores, caches and main memory every options.interval cycles of the timed phases.
+ * @details
+ * A snapshot holds
+ *  - the simulated time, the cycles counted so far, and the number of the timed phase,
+ *  - per CPU, the instructions retired so far and the IPC over the interval,
+ *  - per cache, the misses of all access types per kilo instructions of all CPUs over the interval, and the MSHR entries in use,
+ *  - per channel of each memory with Ramulator2, the bandwidth [GB/s] and the row buffer hit rate over the interval, and the requests waiting in its queues,
+ *  - with an OS-transparent management design, the remapping requests waiting or being served.
+ * The simulation thread reads the components between two cycles, and each snapshot costs about as much as one simulated cycle,
+ * so the overhead stays far below 1% with intervals of thousands of cycles.
+ */
+class sampler
+{
+public:
+    sampler(environment& env_, const telemetry_options& options_);
+    ~sampler();
+
+    sampler(const sampler&)            = delete;
+    sampler& operator=(const sampler&) = delete;
+
+    /** @brief Start a timed phase, whose components have restarted their statistics */
+    void begin_phase(champsim::chrono::clock::time_point now);
+
+    /** @return Cycles until the next snapshot, at least 1 */
+    [[nodiscard]] uint64_t cycles_to_next_sample() const { return next_sample - cycles; }
+
+    /** @brief Count the cycles the phase went through, and take a snapshot once an interval is over */
+    void advance(uint64_t elapsed_cycles, champsim::chrono::clock::time_point now)
+    {
+        cycles += elapsed_cycles;
+        if (cycles >= next_sample)
+        {
+            sample(now);
+            next_sample = cycles + options.interval;
+        }
+    };
+
+    /** @brief Write out the snapshots, and report how many there are and the time the simulation thread spent taking them */
+    void close();
+
+private:
+    environment& env;
+    telemetry_options options;
+    FILE* file = nullptr;
+    std::unique_ptr<column_writer> writer;
+
+    uint64_t cycles      = 0;
+    uint64_t next_sample = 0;
+    uint32_t phase       = 0;
+
+    // Values at the previous snapshot, the intervals start from
+    champsim::chrono::clock::time_point previous_time {};
+    std::vector<long long> previous_retired;
+    std::vector<long long> previous_cpu_cycles;
+    std::vector<long> previous_misses;
+#if (RAMULATOR2 == ENABLE)
+    std::vector<std::vector<Ramulator::ChannelCounters>> previous_channels; // Per memory
+#endif /* RAMULATOR2 */
+
+    std::chrono::steady_clock::time_point start_time;
+    std::chrono::steady_clock::duration sampling_time {};
+
+    [[nodiscard]] std::vector<column> columns();
+    void sample(champsim::chrono::clock::time_point now);
+};
+
+} // namespace champsim::telemetry
+
+#endif /* USER_CODES, TELEMETRY */
+
+#endif /* TELEMETRY_H */
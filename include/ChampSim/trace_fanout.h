@@ -0,0 +1,108 @@
+#ifndef TRACE_FANOUT_H
+#define TRACE_FANOUT_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <type_traits>
+#include <vector>
+
+#include "ChampSim/instruction.h"
+#include "ChampSim/tracereader.h"
+#include "ProjectConfiguration.h" // User file
+
+#if (USER_CODES == ENABLE) && (MULTI_CONFIG_SWEEP == ENABLE)
+
+namespace champsim
+{
+
+/**
+ * @brief Broadcasts the decoded instructions of the traces to several simulator processes through shared memory.
+ * @details
+ * The producer decodes each trace once and writes the instructions into one ring per trace, in a shared memory file.
+ * Every consumer reads each ring at its own pace, and the producer waits only for the slowest consumer that has not finished,
+ * so the consumers run side by side, at most the ring depth apart.
+ * With several traces, a consumer may wait at the head of one ring while the producer waits for it on another ring, whose
+ * cores it ticks in lockstep with the first. So a waiting consumer moves what the producer has written into its other rings
+ * into private queues, and the producer never waits for a consumer that waits itself.
+ * A consumer sees exactly the instructions it would have read from the traces itself, and its tracereader numbers them, so its run is unchanged.
+ */
+class trace_fanout
+{
+public:
+    /** @brief Create the shared memory for the consumers, as the producer */
+    trace_fanout(std::size_t num_traces, std::size_t num_consumers, std::size_t depth = TRACE_FANOUT_DEPTH);
+
+    /** @brief Attach to the shared memory of a producer that started this process, as one of its consumers */
+    trace_fanout(int fd, std::size_t consumer_);
+
+    ~trace_fanout();
+
+    trace_fanout(const trace_fanout&)            = delete;
+    trace_fanout& operator=(const trace_fanout&) = delete;
+
+    /** @return The shared memory file, which the consumer processes inherit */
+    [[nodiscard]] int file_descriptor() const { return fd; }
+
+    /**
+     * @brief Decode the traces into the rings until they end or every consumer has finished.
+     * @param idle Called periodically while no ring has room, to notice the consumers that exited without finish().
+     */
+    void broadcast(std::vector<tracereader>& traces, const std::function<void()>& idle);
+
+    /** @return The readers of this consumer, one per trace */
+    [[nodiscard]] std::vector<tracereader> readers();
+
+    /** @brief Stop waiting for a consumer, which reads no more */
+    void finish(std::size_t consumer_);
+
+    /** @brief Stop waiting for this consumer */
+    void finish() { finish(consumer); }
+
+private:
+    static_assert(std::is_trivially_copyable_v<ooo_model_instr>, "Instructions are copied between processes");
+    static_assert(std::atomic<uint64_t>::is_always_lock_free, "The rings are shared between processes");
+
+    struct alignas(64) counter
+    {
+        std::atomic<uint64_t> value;
+    };
+
+    struct layout
+    {
+        uint64_t num_traces;
+        uint64_t num_consumers;
+        uint64_t depth;
+        uint64_t instr_size; // Catches a consumer built differently from its producer
+    };
+
+    struct reader;
+
+    int fd;
+    std::size_t consumer;
+    std::size_t bytes;
+    std::byte* memory;
+    layout* shape;
+    counter* heads;    // [trace], the instructions written into each ring
+    counter* ended;    // [trace], whether the trace has no instructions after the head
+    counter* tails;    // [consumer * num_traces + trace], the instructions each consumer has read
+    counter* finished; // [consumer], whether the consumer reads no more
+    ooo_model_instr* slots; // [trace * depth + index]
+
+    std::vector<std::deque<ooo_model_instr>> spilled; // [trace], the instructions this consumer took out of the ring before it reads them
+
+    static std::size_t size_of(std::size_t num_traces, std::size_t num_consumers, std::size_t depth);
+    void map(std::size_t num_traces, std::size_t num_consumers, std::size_t depth);
+    [[nodiscard]] uint64_t slowest_tail(std::size_t trace) const;
+    [[nodiscard]] counter& tail(std::size_t trace) const; // This consumer's tail of the ring
+    ooo_model_instr take(std::size_t trace);              // The next instruction of the ring, for this consumer
+    void spill(std::size_t waiting_trace);                // Take every instruction written into the other rings, into spilled
+};
+
+} // namespace champsim
+
+#endif /* USER_CODES, MULTI_CONFIG_SWEEP */
+
+#endif
@@ -93,7 +93,7 @@ class bulk_tracereader
 
     constexpr static std::size_t buffer_size    = 128;
     constexpr static std::size_t refresh_thresh = 1;
-    std::deque<ooo_model_instr> instr_buffer;
+    champsim::instruction_queue instr_buffer;
 
 public:
     ooo_model_instr operator()();
@@ -142,7 +142,7 @@ ooo_model_instr bulk_tracereader<T, F>::operator()()
         set_branch_targets(std::begin(instr_buffer), std::end(instr_buffer));
     }
 
-    auto retval = instr_buffer.front();
+    auto retval = std::move(instr_buffer.front());
     instr_buffer.pop_front();
 
     return retval;
@@ -43,6 +43,34 @@ auto extract_if(InputIt begin, InputIt end, OutputIt d_begin, F func)
     return std::pair {begin, d_begin};
 }
 
+/**
+ * @brief std::stable_partition that moves the elements failing func into buffer rather than into a temporary buffer of its own.
+ * @details func is applied once per element, in order, as std::stable_partition does with enough memory. The buffer keeps its storage from call to call.
+ */
+template<typename It, typename F, typename Buffer>
+It stable_partition(It begin, It end, F func, Buffer& buffer)
+{
+    buffer.clear();
+    auto kept = begin;
+    for (auto i = begin; i != end; ++i)
+    {
+        if (func(*i))
+        {
+            if (kept != i)
+            {
+                *kept = std::move(*i);
+            }
+            ++kept;
+        }
+        else
+        {
+            buffer.push_back(std::move(*i));
+        }
+    }
+    std::move(std::begin(buffer), std::end(buffer), kept);
+    return kept;
+}
+
 template<typename R, typename Output, typename F, typename G>
 long int transform_while_n(R& queue, Output out, bandwidth sz, F&& test_func, G&& transform_func)
 {
@@ -17,6 +17,7 @@
 #ifndef VMEM_H
 #define VMEM_H
 
+#include <array>
 #include <cstdint>
 #include <deque>
 #include <map>
@@ -28,7 +29,11 @@
 #include "ProjectConfiguration.h" // User file
 
 #if (USER_CODES == ENABLE)
+#include <vector>
+
+#include "ChampSim/checkpoint.h"
 #include "ChampSim/dram_controller.h"
+#include "ChampSim/msl/flat_hash_table.h"
 #include "ChampSim/util/bit_enum.h"
 #include "ChampSim/util/units.h"
 
@@ -38,38 +43,101 @@ class VirtualMemory
 {
 private:
     /**
-     * @brief Virtual page to physical page mapping
+     * @brief The translations of one application (here is CPU #), which has its own virtual address space
      * @details
-     * Each application (here is CPU #) has its own virtual address space
-     * {(CPU #, virtual page #) -> physical page #}
-     * 
-     * @todo
-     * Performance improvement (vector)
+     * Both tables are flat hash tables, so a translation or a page table walk step is a hash and a short probe.
      */
-    std::map<std::pair<uint32_t, champsim::page_number>, champsim::page_number> vpage_to_ppage_map;
-    std::map<std::tuple<uint32_t, uint32_t, champsim::address_slice<champsim::dynamic_extent> >, champsim::address> page_table;
+    struct address_space
+    {
+        champsim::msl::flat_hash_table vpage_to_ppage; // {virtual page # -> physical page #}
+        champsim::msl::flat_hash_table page_table;     // {(virtual address bits above the level, level) -> PTE page address}
+
+        template<typename Archive>
+        void checkpoint(Archive& archive)
+        {
+            archive(vpage_to_ppage, page_table);
+        }
+    };
+
+    std::vector<address_space> address_spaces; // Indexed by CPU #
     std::optional<uint64_t> randomization_seed;
     champsim::data::bytes memory_size;
 
 public:
+    /**
+     * @brief Where newly allocated physical pages are placed in a hybrid memory system
+     * @details The fast memory is the lowest part of the physical address space.
+     */
+    enum class page_placement : unsigned
+    {
+        random      = PAGE_PLACEMENT_RANDOM,      // Uniformly over both memories
+        first_touch = PAGE_PLACEMENT_FIRST_TOUCH, // Fast memory until it is full, then slow memory
+        interleaved = PAGE_PLACEMENT_INTERLEAVED  // Alternate between the memories in proportion to their capacities
+    };
+
     /** @todo if we want to integrate SSD simulator, proper page fault penalty must be considered */
     const champsim::chrono::clock::duration minor_fault_penalty;
     const std::size_t pt_levels;
     const pte_entry pte_page_size; // Size of a PTE page
 
 private:
-    std::deque<champsim::page_number> ppage_free_list;
+    /**
+     * @brief A range of physical pages handed out in a pseudo-random order that is never materialized
+     * @details
+     * The order is a bijection of the page indices computed on demand by a keyed Feistel network,
+     * cycle-walked into the range, so the k-th page is found in constant time and memory.
+     * Without a randomization seed the pages are handed out in ascending order.
+     */
+    class page_permutation
+    {
+    public:
+        uint64_t first     = 0; // Index of the first page of the range
+        uint64_t count     = 0; // Number of pages in the range
+        uint64_t allocated = 0; // Pages handed out since the free list was generated
+
+        page_permutation() = default;
+        page_permutation(uint64_t first_, uint64_t count_, std::optional<uint64_t> seed);
+
+        [[nodiscard]] bool exhausted() const { return allocated == count; }
+
+        /** @return The index of the next page to hand out, which is then taken */
+        uint64_t take();
+
+    private:
+        static constexpr std::size_t ROUNDS = 4;
+
+        bool shuffled       = false;
+        unsigned half_width = 0; // The network permutes 2 * half_width bits
+        std::array<uint64_t, ROUNDS> round_keys {};
+
+        [[nodiscard]] uint64_t encrypt(uint64_t index) const;
+    };
+
+    /**
+     * @brief The free list of physical pages, generated lazily
+     * @details
+     * The free list is the pages [first_ppage, first_ppage + ppage_count), shuffled if a randomization seed is given.
+     * The pages of the fast memory and of the slow memory are separate ranges, so a placement policy picks the memory
+     * of each page and the range of that memory picks the page.
+     */
+    champsim::page_number first_ppage {};
+    uint64_t ppage_count     = 0;
+    uint64_t ppage_allocated = 0;        // Pages handed out since the free list was generated
+    champsim::page_number next_ppage {}; // The front of the free list
+    champsim::data::bytes fast_memory_size;
+    page_placement placement;
+    std::array<page_permutation, 2> ppage_ranges; // Fast memory, slow memory
+
     champsim::page_number active_pte_page {};
     champsim::address_slice<champsim::dynamic_extent> next_pte_page;
 
-    // champsim::page_number next_ppage;
-    // champsim::page_number last_ppage; // The last (or end) physical page number of the physical address space
-
     [[nodiscard]] champsim::page_number ppage_front() const;
     void ppage_pop();
 
-    void shuffle_pages();
     void populate_pages();
+    void draw_ppage();
+
+    address_space& space_of(uint32_t cpu_num);
 
 public:
     /**
@@ -86,6 +154,15 @@ public:
     VirtualMemory(champsim::data::bytes page_table_page_size, std::size_t page_table_levels, champsim::chrono::clock::duration minor_penalty, champsim::data::bytes memory_size_);
     VirtualMemory(champsim::data::bytes page_table_page_size, std::size_t page_table_levels, champsim::chrono::clock::duration minor_penalty, champsim::data::bytes memory_size_, std::optional<uint64_t> randomization_seed_);
 
+    /**
+     * Initialize the virtual memory of a hybrid memory system.
+     *
+     * :param fast_memory_size: The size of the fast memory, which is the lowest part of the physical address space. Unit is byte.
+     * :param placement: Where newly allocated physical pages are placed.
+     */
+    VirtualMemory(champsim::data::bytes page_table_page_size, std::size_t page_table_levels, champsim::chrono::clock::duration minor_penalty, champsim::data::bytes memory_size_, std::optional<uint64_t> randomization_seed_,
+        champsim::data::bytes fast_memory_size_, page_placement placement_);
+
     /**
      * Find the bit location of the lowest bit for the given page table level.
      */
@@ -129,6 +206,11 @@ public:
      * :returns: A pair of the page table page address and the latency to be applied to the operation.
      */
     std::pair<champsim::address, champsim::chrono::clock::duration> get_pte_pa(uint32_t cpu_num, champsim::page_number vaddr, std::size_t level);
+
+    /**
+     * Save or restore the page mappings, the page tables and the free physical pages.
+     */
+    void checkpoint(champsim::checkpoint_archive& archive);
 };
 
 #else
@@ -78,6 +78,7 @@ public:
 
     bool is_ready_at(time_type cycle) const;
     bool has_unknown_readiness() const;
+    time_type ready_time() const; // time_type::max() if the readiness is unknown
 
     auto& operator*();
     auto& operator*() const;
@@ -138,6 +139,12 @@ bool champsim::waitable<T>::has_unknown_readiness() const
     return ! event_cycle.has_value();
 }
 
+template<typename T>
+auto champsim::waitable<T>::ready_time() const -> time_type
+{
+    return event_cycle.value_or(time_sentinel);
+}
+
 template<typename T>
 auto& champsim::waitable<T>::operator*()
 {
@@ -20,36 +20,67 @@
 #define CPU_USE_MULTIPLE_CORES     (DISABLE) // Whether CPU uses multiple cores to run simulation (go to include/ChampSim/champsim_constants.h to check related parameters)
 #define PRINT_STATISTICS_INTO_FILE (ENABLE)  // Whether print simulation statistics into files
 #define PRINT_MEMORY_TRACE         (ENABLE)  // Whether print memory trace into files
+#define EVENT_DRIVEN_SKIP_AHEAD    (ENABLE)  // Whether skip the cycles in which no component has work to do, results are identical to operating every cycle
+#define CACHE_SOA_TAG_STORE        (ENABLE)  // Whether caches look up tags in a packed tag array with SIMD compares, results are identical to searching the blocks
+#define CACHE_INDEXED_MSHR         (ENABLE)  // Whether caches find MSHR entries and inflight fills by block address through hash indices, results are identical to searching the queues
+#define INSTRUCTION_INLINE_STORAGE (ENABLE)  // Whether instructions keep their operands inline and the queues of the cores, caches and memory controllers recycle their storage, so nothing allocates per simulated instruction in steady state
+#define TRACE_PREFETCH_THREAD      (ENABLE)  // Whether each trace is read and decompressed ahead of the simulation on its own thread, results are identical to reading it inline
+#define MULTI_CONFIG_SWEEP         (ENABLE)  // Whether --sweep runs one simulator process per memory configuration, all fed from a single decoding of the traces
+#define FUNCTIONAL_WARMUP          (ENABLE)  // Whether --functional-warmup-instructions can warm up caches, TLBs, branch predictors and remapping tables without timing, before the detailed warmup
+#define SAMPLED_SIMULATION         (ENABLE)  // Whether --simpoints or --smarts can replace the warmup and simulation phases by detailed samples reached by functional warmup, requires FUNCTIONAL_WARMUP
+#define TELEMETRY                  (ENABLE)  // Whether --telemetry can write a snapshot of per-core, per-cache and per-channel metrics every --telemetry-interval cycles into a columnar binary file, on a background thread
 
 // Check
 #if ((RAMULATOR == ENABLE) && (RAMULATOR2 == ENABLE))
 #error "RAMULATOR and RAMULATOR2 cannot both be ENABLE. Pick one."
 #endif
 
+#if ((MULTI_CONFIG_SWEEP == ENABLE) && (INSTRUCTION_INLINE_STORAGE == DISABLE))
+#error "MULTI_CONFIG_SWEEP copies instructions between processes, which needs INSTRUCTION_INLINE_STORAGE."
+#endif
+
+#if ((SAMPLED_SIMULATION == ENABLE) && (FUNCTIONAL_WARMUP == DISABLE))
+#error "SAMPLED_SIMULATION reaches each sample by functional warmup, which needs FUNCTIONAL_WARMUP."
+#endif
+
 // Functionalities related to hybrid memory system
 #if (MEMORY_USE_HYBRID == ENABLE)
 #define MEMORY_USE_SWAPPING_UNIT             (ENABLE) // Whether memory controller uses swapping unit to swap data (data swapping overhead is considered)
 #define MEMORY_USE_OS_TRANSPARENT_MANAGEMENT (ENABLE) // Whether memory controller uses OS-transparent management designs to simulate the memory system instead of static (no-migration) methodss
+#define SHADOW_OS_TRANSPARENT_MANAGEMENT     (DISABLE) // Whether memory controller also feeds its requests to functional-only models of several OS-transparent management designs, which report how each would have done per epoch
 
 #endif /* MEMORY_USE_HYBRID */
 
+// Placement policies of newly allocated physical pages in hybrid memory systems
+#define PAGE_PLACEMENT_RANDOM      (0u) // Uniformly over both memories
+#define PAGE_PLACEMENT_FIRST_TOUCH (1u) // Fast memory until it is full, then slow memory
+#define PAGE_PLACEMENT_INTERLEAVED (2u) // Alternate between the memories in proportion to their capacities
+
 /** Configuration for hybrid memory systems */
 #if (MEMORY_USE_HYBRID == ENABLE)
-#define NUMBER_OF_MEMORIES (2u) // We use two memories for hybrid memory system.
-#define MEMORY_NUMBER_ONE  (0u)
-#define MEMORY_NUMBER_TWO  (1u)
-#define ADD_HBM_128MB      (ENABLE)
+#define NUMBER_OF_MEMORIES    (2u) // We use two memories for hybrid memory system.
+#define MEMORY_NUMBER_ONE     (0u)
+#define MEMORY_NUMBER_TWO     (1u)
+#define ADD_HBM_128MB         (ENABLE)
+#define PAGE_PLACEMENT_POLICY (PAGE_PLACEMENT_RANDOM) // Where the virtual memory places newly allocated physical pages
 #else
 #define NUMBER_OF_MEMORIES (1u)
 #endif /* MEMORY_USE_HYBRID */
 
 /** Configuration for swapping unit in the memory controller */
 #if (MEMORY_USE_SWAPPING_UNIT == ENABLE)
-#define SWAPPING_BUFFER_ENTRY_NUMBER (64)
-#define SWAPPING_SEGMENT_ONE         (0)
-#define SWAPPING_SEGMENT_TWO         (1)
-#define SWAPPING_SEGMENT_NUMBER      (2)
-#define TEST_SWAPPING_UNIT           (DISABLE) /** @todo Use unit testing to test this unit */
+#define SWAPPING_ENGINE_NUMBER         (1)       // Number of swapping engines, which swap different segments in parallel
+#define SWAPPING_BUFFER_ENTRY_NUMBER   (64)      // Cache lines in the buffer of each swapping engine, the largest segment it can swap
+#define SWAPPING_ENGINE_BUFFER_DEPTHS  {}        // Cache lines each engine swaps at once, by engine, e.g. {16, 64}. An engine left out or given 0 swaps SWAPPING_BUFFER_ENTRY_NUMBER lines at once
+#define SWAPPING_SEGMENT_ONE           (0)
+#define SWAPPING_SEGMENT_TWO           (1)
+#define SWAPPING_SEGMENT_NUMBER        (2)
+#define SWAPPING_LATENCY_BUCKET_NUMBER (24)      // Buckets of the swap latency distribution, where bucket i counts latencies below 2^i cycles that the buckets before don't
+#define TEST_SWAPPING_UNIT             (DISABLE) /** @todo Use unit testing to test this unit */
+
+#if (SWAPPING_ENGINE_NUMBER < 1) || (SWAPPING_ENGINE_NUMBER > 255)
+#error "SWAPPING_ENGINE_NUMBER must be between 1 and 255."
+#endif
 
 #endif /* MEMORY_USE_SWAPPING_UNIT */
 
@@ -92,6 +123,9 @@
 #error OS-transparent management designs need to be enabled.
 #endif /* IDEAL_LINE_LOCATION_TABLE, COLOCATED_LINE_LOCATION_TABLE */
 
+// Whether the remapping requests of hotter data are swapped first instead of in arrival order, see RemappingRequestQueue
+#define REMAPPING_REQUEST_PRIORITY (DISABLE)
+
 // Statistics of OS-transparent management designs
 #define TRACKING_LOAD_STORE_STATISTICS (DISABLE)
 
@@ -103,8 +137,21 @@
 
 #endif /* MEMORY_USE_OS_TRANSPARENT_MANAGEMENT */
 
+#if (SHADOW_OS_TRANSPARENT_MANAGEMENT == ENABLE)
+#define SHADOW_EPOCH_us (50) // [us] Length of an epoch of the shadow models, the same as the interval of MemPod
+#endif /* SHADOW_OS_TRANSPARENT_MANAGEMENT */
+
+#if (TRACE_PREFETCH_THREAD == ENABLE)
+#define TRACE_PREFETCH_DEPTH (16) // Number of decoded 64 KiB blocks each trace's decoder thread may run ahead of the simulation
+#endif /* TRACE_PREFETCH_THREAD */
+
+#if (MULTI_CONFIG_SWEEP == ENABLE)
+#define TRACE_FANOUT_DEPTH (1u << 16) // Number of instructions the fastest process of a sweep may run ahead of the slowest, per trace
+#endif /* MULTI_CONFIG_SWEEP */
+
 #if (PRINT_MEMORY_TRACE == ENABLE)
-#define CONTINUOUS_ADDRESS (ENABLE)
+#define CONTINUOUS_ADDRESS  (ENABLE)
+#define BINARY_MEMORY_TRACE (DISABLE) // Whether write the memory trace as a delta-encoded, xz-compressed binary file (.trace.xz) on a background thread instead of text
 #endif /* PRINT_MEMORY_TRACE */
 
 // Data block management granularity
@@ -131,7 +178,9 @@
 #endif /* IDEAL_SINGLE_MEMPOD */
 
 #if (USE_OPENMP == ENABLE)
-#define SET_THREADS_NUMBER (6)
+#define SET_THREADS_NUMBER    (6)
+#define PARALLEL_CHANNEL_TICK (ENABLE) // Whether Ramulator 2.0's GenericDRAM memory system can tick its channel controllers in parallel (opt-in by its num_tick_threads parameter), results are identical to serial execution
+#define PARALLEL_CYCLE_ENGINE (ENABLE) // Whether each CPU's core, TLBs, L1s and L2C are operated on OpenMP threads every cycle before the shared LLC, page table walkers and main memory (see --threads), results are identical to serial execution
 #endif /* USE_OPENMP */
 
 #define KiB (1024ul) // Unit is byte
@@ -152,6 +201,7 @@
 #include <cstdio>
 #include <cstdlib>
 #include <functional>
+#include <memory>
 #include <string>
 
 #if (USE_OPENMP == ENABLE)
@@ -197,14 +247,27 @@ public:
     void output_file_initialization(char** string_array, uint32_t number);
 };
 
+#if (BINARY_MEMORY_TRACE == ENABLE)
+namespace binary_memory_trace
+{
+class BinaryMemoryTraceWriter;
+} // namespace binary_memory_trace
+#endif /* BINARY_MEMORY_TRACE */
+
 // Memory trace output class
 class MEMORY_TRACE : public DATA_OUTPUT
 {
 public:
     MEMORY_TRACE(std::string v1, std::string v2);
     MEMORY_TRACE(std::string v1, std::string v2, char** string_array, uint32_t number);
+    ~MEMORY_TRACE();
 
     void output_memory_trace_hexadecimal(uint64_t address, char type);
+
+#if (BINARY_MEMORY_TRACE == ENABLE)
+private:
+    std::unique_ptr<binary_memory_trace::BinaryMemoryTraceWriter> binary_writer; // Started by the first request
+#endif /* BINARY_MEMORY_TRACE */
 };
 
 // Simulator statistics output class
@@ -227,8 +290,31 @@ public:
     uint64_t swapping_count;
     uint64_t swapping_traffic_in_bytes;
 
+#if (MEMORY_USE_SWAPPING_UNIT == ENABLE)
+    /** @brief Statistics of a swapping engine, whose latencies count memory controller cycles from the start to the finish of a swap */
+    struct SwappingEngineStatistics
+    {
+        uint64_t swaps                                                            = 0;
+        uint64_t traffic_in_bytes                                                 = 0;
+        uint64_t busy_cycles                                                      = 0; // Sum of the latencies, as an engine swaps a pair of segments at a time
+        uint64_t max_latency_cycles                                               = 0;
+        std::array<uint64_t, SWAPPING_LATENCY_BUCKET_NUMBER> latency_distribution = {0};
+    };
+
+    std::array<SwappingEngineStatistics, SWAPPING_ENGINE_NUMBER> swapping_engine_statistics;
+    uint64_t swapping_cycles; // Memory controller cycles, over which the engines' bandwidth utilization is reported
+#endif /* MEMORY_USE_SWAPPING_UNIT */
+
     uint64_t remapping_request_queue_congestion;
 
+#if (MEMORY_USE_OS_TRANSPARENT_MANAGEMENT == ENABLE)
+    uint64_t remapping_request_enqueued, remapping_request_duplicated, remapping_request_cancelled, remapping_request_finished;
+    uint64_t remapping_request_queue_max_occupancy;
+    double remapping_request_queue_average_occupancy;
+    double remapping_request_average_waiting_cycles, remapping_request_average_service_cycles;
+    uint64_t remapping_request_max_latency_cycles;
+#endif /* MEMORY_USE_OS_TRANSPARENT_MANAGEMENT */
+
 #if (IDEAL_VARIABLE_GRANULARITY == ENABLE)
     uint64_t no_free_space_for_migration;
     uint64_t no_invalid_group_for_migration;
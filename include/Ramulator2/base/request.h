@@ -9,14 +9,47 @@
 #include "Ramulator2/base/base.h"
 
 #if (USER_CODES == ENABLE)
+#include <algorithm>
 #include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
 
 #include "ChampSim/champsim_constants.h"
-#include "ChampSim/channel.h"
 
 namespace Ramulator
 {
 
+struct Request;
+
+/**
+ * @brief A callback as a plain function and the object it is called with, so a request is copied without allocating.
+ * @note Use RequestCallback::to<&Class::method>(object) to call a member function.
+ */
+struct RequestCallback
+{
+    using Function    = void (*)(void* context, Request& request);
+
+    Function function = nullptr;
+    void* context     = nullptr;
+
+    RequestCallback() = default;
+
+    RequestCallback(std::nullptr_t) {};
+
+    RequestCallback(Function function, void* context): function(function), context(context) {};
+
+    template <auto Method, typename Class>
+    static RequestCallback to(Class* object)
+    {
+        return {[](void* context, Request& request) { (static_cast<Class*>(context)->*Method)(request); }, object};
+    };
+
+    explicit operator bool() const { return function != nullptr; };
+
+    void operator()(Request& request) const { function(context, request); };
+};
+
 struct Request
 {
     Addr_t addr = -1;
@@ -45,11 +78,11 @@ struct Request
 
     std::array<int, 4> scratchpad = {0}; // A scratchpad for the request
 
-    std::function<void(Request&)> callback;
+    RequestCallback callback;
 
 #if (RAMULATOR2 == ENABLE)
-    // ChampSim's memory controller's packet
-    DRAM_CHANNEL::request_type packet;
+    // The handle of ChampSim's packet in its memory controller's packet table, or -1 if the request has none
+    int packet_handle = -1;
 #endif /* RAMULATOR */
 
     std::array<uint8_t, BLOCK_SIZE> data = {0}; // a cache line
@@ -61,45 +94,196 @@ struct Request
 
     Request(Addr_t addr, int type);
     Request(AddrVec_t addr_vec, int type);
-    Request(Addr_t addr, int type, int source_id, std::function<void(Request&)> callback);
-    Request(Addr_t addr, int type, int source_id, std::function<void(Request&)> callback, uint8_t memory_id);
+    Request(Addr_t addr, int type, int source_id, RequestCallback callback);
+    Request(Addr_t addr, int type, int source_id, RequestCallback callback, uint8_t memory_id);
 
 #if (RAMULATOR2 == ENABLE)
     // This instructor is used for ChampSim's memory controller
-    Request(Addr_t addr, int type, int source_id, std::function<void(Request&)> callback, DRAM_CHANNEL::request_type packet, uint8_t memory_id);
+    Request(Addr_t addr, int type, int source_id, RequestCallback callback, int packet_handle, uint8_t memory_id);
 #endif /* RAMULATOR */
 };
 
+/**
+ * @brief A pooled request buffer that keeps requests in arrival order and in per-bank sub-queues.
+ * @details
+ * Requests live in a slot pool that only grows, so enqueue and remove never allocate in steady state, and an iterator
+ * (a buffer and a slot) stays valid until its own request is removed. Iteration visits requests in arrival order,
+ * as the previous std::list did. Each slot also keeps its pre-decoded bank and row, the arrival sequence number and
+ * the readiness of its command in SoA arrays, so schedulers compare requests without walking the DRAM hierarchy.
+ */
 struct ReqBuffer
 {
-    std::list<Request> buffer;
-    size_t max_size = 32;
+    static constexpr int npos = -1;
 
-    using iterator  = std::list<Request>::iterator;
+    size_t max_size           = 32;
 
-    iterator begin() { return buffer.begin(); };
+    class iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type        = Request;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = Request*;
+        using reference         = Request&;
 
-    iterator end() { return buffer.end(); };
+        iterator() = default;
 
-    size_t size() const { return buffer.size(); }
+        iterator(ReqBuffer* buffer, int slot): m_buffer(buffer), m_slot(slot) {};
 
-    bool enqueue(const Request& request)
-    {
-        if (buffer.size() <= max_size)
+        Request& operator*() const { return m_buffer->m_slots[m_slot]; };
+
+        Request* operator->() const { return &m_buffer->m_slots[m_slot]; };
+
+        iterator& operator++()
         {
-            buffer.push_back(request);
-            return true;
-        }
-        else
+            m_slot = m_buffer->m_next[m_slot];
+            return *this;
+        };
+
+        iterator operator++(int)
         {
-            return false;
+            iterator old = *this;
+            ++(*this);
+            return old;
+        };
+
+        bool operator==(const iterator& other) const { return m_slot == other.m_slot && (m_slot == npos || m_buffer == other.m_buffer); };
+
+        bool operator!=(const iterator& other) const { return ! (*this == other); };
+
+        int slot() const { return m_slot; };
+
+        /** @brief Whether the request's command was ready at the latest decode_commands() */
+        bool is_ready() const { return m_buffer->m_ready[m_slot]; };
+
+    private:
+        ReqBuffer* m_buffer = nullptr;
+        int m_slot          = npos;
+    };
+
+    iterator begin() { return iterator(this, m_head); };
+
+    iterator end() { return iterator(this, npos); };
+
+    size_t size() const { return m_size; }
+
+    bool enqueue(const Request& request);
+
+    void remove(iterator it);
+
+    /**
+     * @brief Enable the per-bank sub-queues.
+     * @param count The size of each level of the DRAM organization.
+     * @param bank_level The level whose nodes each get a sub-queue.
+     * @param row_level The level of rows.
+     */
+    void set_organization(const std::vector<int>& count, int bank_level, int row_level);
+
+    /**
+     * @brief Update each request's command to the prerequisite of its final command, and record whether it is ready.
+     * @details
+     * Requests to the same bank with the same final command and row get the same answer, since the DRAM state does
+     * not change while a scheduler looks for a request, so the DRAM is only queried once for them.
+     */
+    template<typename DRAM>
+    void decode_commands(DRAM* dram)
+    {
+        m_ready_banks.clear();
+        for (int bank : m_active_banks)
+        {
+            const bool is_wildcard = (bank == m_num_banks);
+            m_decoded.clear();
+            bool bank_ready = false;
+            for (int slot = m_bank_head[bank]; slot != npos; slot = m_bank_next[slot])
+            {
+                auto& req  = m_slots[slot];
+                auto found = std::find_if(m_decoded.begin(), m_decoded.end(), [&req, row = m_row[slot]](const DecodedCommand& decoded)
+                    { return decoded.final_command == req.final_command && decoded.row == row; });
+                if (is_wildcard || found == m_decoded.end())
+                {
+                    const int command = dram->get_preq_command(req.final_command, req.addr_vec);
+                    const bool ready  = dram->check_ready(command, req.addr_vec);
+                    if (! is_wildcard && m_decoded.size() < MAX_DECODED_PER_BANK)
+                    {
+                        m_decoded.push_back({req.final_command, m_row[slot], command, ready});
+                    }
+                    req.command   = command;
+                    m_ready[slot] = ready;
+                }
+                else
+                {
+                    req.command   = found->command;
+                    m_ready[slot] = found->ready;
+                }
+                bank_ready = bank_ready || m_ready[slot];
+            }
+
+            if (bank_ready)
+            {
+                m_ready_banks.push_back(bank);
+            }
         }
-    }
+    };
 
-    void remove(iterator it)
+    /**
+     * @brief First-ready, first-come-first-serve over the latest decode_commands().
+     * @return The earliest arrived ready request, else the earliest arrived request. Ties go to the earlier enqueued one.
+     */
+    iterator first_ready_first_come();
+
+private:
+    static constexpr size_t MAX_DECODED_PER_BANK = 16; // Distinct (final command, row) pairs remembered per bank
+
+    struct DecodedCommand
     {
-        buffer.erase(it);
-    }
+        int final_command;
+        int row;
+        int command;
+        bool ready;
+    };
+
+    /** @return Whether the request in slot lhs precedes the one in slot rhs under first-come-first-serve */
+    bool arrives_before(int lhs, int rhs) const
+    {
+        const Clk_t lhs_arrive = m_slots[lhs].arrive;
+        const Clk_t rhs_arrive = m_slots[rhs].arrive;
+        return (lhs_arrive < rhs_arrive) || (lhs_arrive == rhs_arrive && m_seq[lhs] < m_seq[rhs]);
+    };
+
+    void decode_bank(int slot);
+
+    std::vector<Request> m_slots {}; // Request pool, indexed by slot
+    std::vector<int> m_free {};      // Unused slots
+    size_t m_size = 0;
+
+    // Arrival order
+    std::vector<int> m_prev {};
+    std::vector<int> m_next {};
+    int m_head = npos;
+    int m_tail = npos;
+
+    // Pre-decoded state, indexed by slot
+    std::vector<uint64_t> m_seq {}; // Enqueue order
+    std::vector<int> m_bank {};     // Flattened bank, m_num_banks if the request does not target one bank
+    std::vector<int> m_row {};
+    std::vector<uint8_t> m_ready {};
+    uint64_t m_next_seq = 0;
+
+    // Per-bank sub-queues, in arrival order
+    std::vector<int> m_bank_prev {};
+    std::vector<int> m_bank_next {};
+    std::vector<int> m_bank_head = std::vector<int>(1, npos);
+    std::vector<int> m_bank_tail = std::vector<int>(1, npos);
+    std::vector<int> m_active_pos = std::vector<int>(1, npos); // Position of each bank in m_active_banks
+    std::vector<int> m_active_banks {};                        // Banks with requests
+    std::vector<int> m_ready_banks {};                         // Banks with ready requests at the latest decode_commands()
+    std::vector<DecodedCommand> m_decoded {};
+
+    // Organization
+    std::vector<int> m_bank_stride {};
+    int m_bank_level = -1;
+    int m_row_level  = -1;
+    int m_num_banks  = 0;
 };
 
 } // namespace Ramulator
@@ -6,12 +6,97 @@
 #include <string>
 #include <type_traits>
 
+#include "ProjectConfiguration.h" // User file
+
+#if (USER_CODES == ENABLE)
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#endif /* USER_CODES */
+
 
 namespace Ramulator {
 
 using Clk_t     = int64_t;            // Clock cycle
 using Addr_t    = int64_t;            // Plain address as seen by the OS
+
+#if (USER_CODES == ENABLE)
+/**
+ * @brief   Device address vector as is sent to the device from the controller
+ * @details
+ * The levels are stored inline, since a DRAM organization only has a handful of them,
+ * so copying a request (or a future action) never allocates. It offers the part of std::vector that Ramulator uses,
+ * and converts from std::vector<int> for the plugins that build their address vectors that way.
+ */
+class AddrVec_t {
+  public:
+    static constexpr std::size_t MAX_LEVELS = 8;
+
+    using value_type = int;
+    using iterator = int*;
+    using const_iterator = const int*;
+
+    AddrVec_t() = default;
+    explicit AddrVec_t(std::size_t size, int value = 0) { resize(size, value); };
+    AddrVec_t(std::initializer_list<int> levels) { assign(levels.begin(), levels.end()); };
+    AddrVec_t(const std::vector<int>& levels) { assign(levels.begin(), levels.end()); };
+
+    std::size_t size() const { return m_size; };
+    bool empty() const { return m_size == 0; };
+
+    int& operator[](std::size_t level) { return m_levels[level]; };
+    const int& operator[](std::size_t level) const { return m_levels[level]; };
+
+    iterator begin() { return m_levels.data(); };
+    iterator end() { return m_levels.data() + m_size; };
+    const_iterator begin() const { return m_levels.data(); };
+    const_iterator end() const { return m_levels.data() + m_size; };
+
+    void push_back(int value) {
+      assert(m_size < MAX_LEVELS);
+      m_levels[m_size++] = value;
+    };
+
+    void resize(std::size_t size, int value = 0) {
+      assert(size <= MAX_LEVELS);
+      std::fill(m_levels.begin() + m_size, m_levels.begin() + std::max<std::size_t>(size, m_size), value);
+      m_size = static_cast<uint8_t>(size);
+    };
+
+    void clear() { m_size = 0; };
+
+    bool operator==(const AddrVec_t& other) const { return std::equal(begin(), end(), other.begin(), other.end()); };
+
+  private:
+    std::array<int, MAX_LEVELS> m_levels = {};
+    uint8_t m_size = 0;
+
+    template<typename Iterator>
+    void assign(Iterator first, Iterator last) {
+      assert(std::size_t(last - first) <= MAX_LEVELS);
+      m_size = static_cast<uint8_t>(std::copy(first, last, m_levels.begin()) - m_levels.begin());
+    };
+};
+
+#else
 using AddrVec_t = std::vector<int>;   // Device address vector as is sent to the device from the controller
+#endif /* USER_CODES */
+
+#if (USER_CODES == ENABLE) && (TELEMETRY == ENABLE)
+/**
+ * @brief   Running counters of one channel controller, which ChampSim samples for its telemetry
+ */
+struct ChannelCounters {
+  size_t served_requests = 0;   // Requests whose last command is issued, and reads forwarded from the write buffer
+  size_t row_hits = 0;
+  size_t row_misses = 0;
+  size_t row_conflicts = 0;
+  size_t queue_occupancy = 0;   // Requests waiting in the read, write and priority buffers now
+};
+#endif /* USER_CODES, TELEMETRY */
 
 template<typename T>
 using Registry_t = std::unordered_map<std::string, T>;
@@ -1,7 +1,9 @@
 #ifndef RAMULATOR_DRAM_DRAM_H
 #define RAMULATOR_DRAM_DRAM_H
 
+#include <algorithm>
 #include <functional>
+#include <limits>
 #include <map>
 #include <string>
 #include <vector>
@@ -42,7 +44,11 @@ class IDRAM : public Clocked<IDRAM> {
     SpecLUT<Command_t> m_request_translations{m_requests};  // A LUT of the final DRAM commands needed by every request
 
     // TODO: make this a priority queue
+#if (USER_CODES == ENABLE)
+    FutureActions m_future_actions;              // A vector of requests that requires future state changes
+#else
     std::vector<FutureAction> m_future_actions;  // A vector of requests that requires future state changes
+#endif /* USER_CODES */
 
   /************************************************
    *                Node States
@@ -60,6 +66,10 @@ class IDRAM : public Clocked<IDRAM> {
     SpecLUT<int> m_timing_vals{m_timings};  // The LUT of the values for each timing constraints
 
     TimingCons m_timing_cons;           // The actual timing constraints used by Ramulator's DRAM model
+#if (USER_CODES == ENABLE)
+    TimingCons m_target_timing_cons;    // The constraints of m_timing_cons on the node that a command is issued to
+    TimingCons m_sibling_timing_cons;   // The constraints of m_timing_cons on the siblings of that node
+#endif
 
     Clk_t m_read_latency = -1;          // Number of cycles needed between issuing RD command and receiving data.
 
@@ -143,6 +153,30 @@ class IDRAM : public Clocked<IDRAM> {
     */
     virtual void finalize() {};
 
+#if (USER_CODES == ENABLE)
+    /**
+     * @brief     Get the number of ticks until the device may change its state without a new command
+     * @details
+     * Only the pending future actions change the device state on their own, so the earliest one bounds the idle ticks.
+     * @return    1 for the next tick, std::numeric_limits<Clk_t>::max() if no future action is pending
+     */
+    virtual Clk_t get_cycles_to_next_event() const {
+      Clk_t cycles = std::numeric_limits<Clk_t>::max();
+      for (const auto& future_action : m_future_actions) {
+        if (future_action.clk > m_clk) {
+          cycles = std::min(cycles, future_action.clk - m_clk);
+        }
+      }
+      return cycles;
+    };
+
+    /**
+     * @brief     Advance the device over idle ticks
+     * @param[in] cycles The number of skipped ticks, which is less than get_cycles_to_next_event()
+     */
+    virtual void skip_cycles(Clk_t cycles) { m_clk += cycles; };
+#endif /* USER_CODES */
+
   /************************************************
    *        Interface to Query Device Spec
    ***********************************************/   
@@ -6,6 +6,8 @@
 #include <deque>
 #include <functional>
 #include <concepts>
+#include <algorithm>
+#include <utility>
 
 #include "ProjectConfiguration.h" // User file
 
@@ -27,6 +29,89 @@ concept IsDRAMSpec = requires(T t) {
 //   typename T::Node; 
 // };
 
+#if (USER_CODES == ENABLE)
+/**
+ * @brief     Issue-history of every command at a node
+ * @details
+ * The last issues of each command are kept in a ring buffer as long as its largest timing window,
+ * and the ring buffers of all commands share one contiguous array.
+ * 
+ */
+class CommandHistory {
+  public:
+    // Commands are added in the order of their ids
+    void add_command(int window) {
+      m_offset.push_back(m_clks.size());
+      m_window.push_back(window);
+      m_latest.push_back(0);
+      m_clks.resize(m_clks.size() + window, -1);
+    };
+
+    int window(int command) const { return m_window[command]; };
+
+    // Record an issue of the command in place of its oldest one
+    void push(int command, Clk_t clk) {
+      int& latest = m_latest[command];
+      latest = (latest == 0 ? m_window[command] : latest) - 1;
+      m_clks[m_offset[command] + latest] = clk;
+    };
+
+    // The clock of the issue that is 'age' issues before the latest one (age 0), or -1
+    Clk_t get(int command, int age) const {
+      int index = m_latest[command] + age;
+      if (index >= m_window[command]) {
+        index -= m_window[command];
+      }
+      return m_clks[m_offset[command] + index];
+    };
+
+  private:
+    std::vector<Clk_t> m_clks;
+    std::vector<int> m_offset;
+    std::vector<int> m_window;
+    std::vector<int> m_latest;
+};
+
+/**
+ * @brief     States of the rows of a bank-ish node that are not closed
+ * @details
+ * A bank only has one or two such rows, so they are kept in a short list that keeps its memory when cleared,
+ * instead of a map that allocates on every activation (a per-row array would make closing all rows as slow as the number of rows).
+ * It offers the subset of std::map used by the lambdas.
+ * 
+ */
+template<typename RowId_t, typename RowState_t>
+class RowStateTable {
+  public:
+    using Entry = std::pair<RowId_t, RowState_t>;
+    using iterator = typename std::vector<Entry>::iterator;
+
+    RowStateTable() { m_rows.reserve(2); };
+
+    iterator begin() { return m_rows.begin(); };
+    iterator end() { return m_rows.end(); };
+    std::size_t size() const { return m_rows.size(); };
+    bool empty() const { return m_rows.empty(); };
+
+    iterator find(RowId_t row) {
+      return std::find_if(m_rows.begin(), m_rows.end(), [row](const Entry& entry) { return entry.first == row; });
+    };
+
+    RowState_t& operator[](RowId_t row) {
+      auto entry = find(row);
+      if (entry != m_rows.end()) {
+        return entry->second;
+      }
+      return m_rows.emplace_back(row, RowState_t{}).second;
+    };
+
+    void clear() { m_rows.clear(); };
+
+  private:
+    std::vector<Entry> m_rows;
+};
+#endif
+
 
 /**
  * @brief     CRTP-ish (?) base class of a DRAM Device Node
@@ -47,11 +132,19 @@ struct DRAMNodeBase {
     int m_state = -1;      // The state of the node
 
     std::vector<Clk_t> m_cmd_ready_clk;             // The next cycle that each command can be issued again at this level
+#if (USER_CODES == ENABLE)
+    CommandHistory m_cmd_history;                   // Issue-history of each command at this level
+#else
     std::vector<std::deque<Clk_t>> m_cmd_history;   // Issue-history of each command at this level
+#endif
 
     using RowId_t = int;
     using RowState_t = int;
+#if (USER_CODES == ENABLE)
+    RowStateTable<RowId_t, RowState_t> m_row_state;  // The state of the rows, if I am a bank-ish node
+#else
     std::map<RowId_t, RowState_t> m_row_state;  // The state of the rows, if I am a bank-ish node
+#endif
 
     DRAMNodeBase(T* spec, NodeType* parent, int level, int id):
 #if (USER_CODES == ENABLE)
@@ -61,6 +154,15 @@ struct DRAMNodeBase {
 #endif
       int num_cmds = T::m_commands.size();
       m_cmd_ready_clk.resize(num_cmds, -1);
+#if (USER_CODES == ENABLE)
+      for (int cmd = 0; cmd < num_cmds; cmd++) {
+        int window = 0;
+        for (const auto& t : spec->m_timing_cons[level][cmd]) {
+          window = std::max(window, t.window);
+        }
+        m_cmd_history.add_command(window);
+      }
+#else
       m_cmd_history.resize(num_cmds);
       for (int cmd = 0; cmd < num_cmds; cmd++) {
         int window = 0;
@@ -73,6 +175,7 @@ struct DRAMNodeBase {
           m_cmd_history[cmd].clear();
         }
       }
+#endif
 
       m_state = spec->m_init_states[m_level];
 
@@ -137,6 +240,60 @@ struct DRAMNodeBase {
       }
     };
 
+#if (USER_CODES == ENABLE)
+    // Only called on nodes on the path of the command, as the parent updates the timing of the siblings
+    void update_timing(int command, const AddrVec_t& addr_vec, Clk_t clk) {
+      /************************************************
+       *          Update Target Node Timing
+       ***********************************************/
+      // Update history
+      if (m_cmd_history.window(command)) {
+        m_cmd_history.push(command, clk);
+      }
+
+      for (const auto& t : m_spec->m_target_timing_cons[m_level][command]) {
+        // Get the oldest history
+        Clk_t past = m_cmd_history.get(command, t.window-1);
+        if (past < 0) {
+          // not enough history
+          continue; 
+        }
+
+        // update earliest schedulable time of every command
+        Clk_t future = past + t.val;
+        m_cmd_ready_clk[t.cmd] = std::max(m_cmd_ready_clk[t.cmd], future);
+      }
+
+      if (!m_child_nodes.size()) {
+        // stop recursion: updated all levels
+        return; 
+      }
+
+      int child_id = addr_vec[m_level+1];
+      if (child_id == -1) {
+        // recursively update all of my children
+        for (auto child : m_child_nodes) {
+          child->update_timing(command, addr_vec, clk);
+        }
+        return;
+      }
+
+      /************************************************
+       *      Update Sibling Node Timing of my Child
+       ***********************************************/
+      const auto& sibling_cons = m_spec->m_sibling_timing_cons[m_level+1][command];
+      for (auto child : m_child_nodes) {
+        if (child->m_node_id == child_id) {
+          child->update_timing(command, addr_vec, clk);
+          continue;
+        }
+        // update earliest schedulable time of every command
+        for (const auto& t : sibling_cons) {
+          child->m_cmd_ready_clk[t.cmd] = std::max(child->m_cmd_ready_clk[t.cmd], clk + t.val);
+        }
+      }
+    };
+#else
     void update_timing(int command, const AddrVec_t& addr_vec, Clk_t clk) {
       /************************************************
        *         Update Sibling Node Timing
@@ -192,6 +349,7 @@ struct DRAMNodeBase {
         child->update_timing(command, addr_vec, clk);
       }
     };
+#endif
 
     int get_preq_command(int command, const AddrVec_t& addr_vec, Clk_t m_clk) {
       int child_id = addr_vec[m_level + 1];
@@ -212,6 +370,49 @@ struct DRAMNodeBase {
       return m_child_nodes[child_id]->get_preq_command(command, addr_vec, m_clk);
     };
 
+#if (USER_CODES == ENABLE)
+    bool check_ready(int command, const AddrVec_t& addr_vec, Clk_t clk) {
+      // Walk down the path of the command, and only recurse for the children of a wildcard
+      NodeType* node = static_cast<NodeType*>(this);
+      while (true) {
+        if (node->m_cmd_ready_clk[command] != -1 && clk < node->m_cmd_ready_clk[command]) {
+          // stop: the check failed at this level
+          return false; 
+        }
+
+        if (node->m_level == m_spec->m_command_scopes[command] || !node->m_child_nodes.size()) {
+          // stop: the check passed at all levels
+          return true; 
+        }
+
+        int child_id = addr_vec[node->m_level+1];
+        if (child_id == -1) {
+          // if it is a same bank command, recurse all children in rank level
+          return std::all_of(node->m_child_nodes.begin(), node->m_child_nodes.end(),
+                             [&](NodeType* child) { return child->check_ready(command, addr_vec, clk); });
+        }
+        node = node->m_child_nodes[child_id];
+      }
+    };
+
+    bool check_rowbuffer_hit(int command, const AddrVec_t& addr_vec, Clk_t m_clk) {
+      NodeType* node = static_cast<NodeType*>(this);
+      while (true) {
+        int child_id = addr_vec[node->m_level+1];
+        if (m_spec->m_rowhits[node->m_level][command]) {
+          // stop: there is a row hit at this level
+          return m_spec->m_rowhits[node->m_level][command](node, command, child_id, m_clk);  
+        }
+
+        if (!node->m_child_nodes.size()) {
+          // stop: there were no row hits at any level
+          return false; 
+        }
+
+        node = node->m_child_nodes[child_id];
+      }
+    };
+#else
     bool check_ready(int command, const AddrVec_t& addr_vec, Clk_t clk) {
       if (m_cmd_ready_clk[command] != -1 && clk < m_cmd_ready_clk[command]) {
         // stop recursion: the check failed at this level
@@ -253,6 +454,7 @@ struct DRAMNodeBase {
       // recursively check for row hits at my child
       return m_child_nodes[child_id]->check_rowbuffer_hit(command, addr_vec, m_clk);
     };    
+#endif
     
     bool check_node_open(int command, const AddrVec_t& addr_vec, Clk_t m_clk) {
 
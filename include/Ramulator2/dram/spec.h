@@ -13,6 +13,10 @@
 
 #include "ProjectConfiguration.h" // User file
 
+#if (USER_CODES == ENABLE)
+#include <mutex>
+#endif /* USER_CODES */
+
 namespace Ramulator {
 
 using Level_t = int;
@@ -45,6 +49,24 @@ struct FutureAction {
   Clk_t clk;
 };
 
+#if (USER_CODES == ENABLE)
+/**
+ * @brief    The future actions of a device, which channel controllers ticking on different threads may add at the same time
+ * @note     Only adding is guarded, as the device resolves its future actions in its own tick() before the controllers tick.
+ *           Every action only changes the state of its own channel, so the order in which channels add them does not matter.
+ */
+class FutureActions : public std::vector<FutureAction> {
+  public:
+    void push_back(const FutureAction& action) {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      std::vector<FutureAction>::push_back(action);
+    };
+
+  private:
+    std::mutex m_mutex;
+};
+#endif /* USER_CODES */
+
 // Timing Constraint
 struct TimingConsEntry {
   /// The command that the timing constraint is constraining.
@@ -97,6 +119,19 @@ void populate_timingcons(T* spec, std::vector<TimingConsInitializer> initializer
       }
     }
   }
+
+#if (USER_CODES == ENABLE)
+  // Split the constraints once, so that the nodes do not skip the other kind on every issued command
+  spec->m_target_timing_cons.assign(T::m_levels.size(), std::vector<std::vector<TimingConsEntry>>(T::m_commands.size()));
+  spec->m_sibling_timing_cons.assign(T::m_levels.size(), std::vector<std::vector<TimingConsEntry>>(T::m_commands.size()));
+  for (size_t level = 0; level < T::m_levels.size(); level++) {
+    for (size_t cmd = 0; cmd < T::m_commands.size(); cmd++) {
+      for (const auto& t : spec->m_timing_cons[level][cmd]) {
+        (t.sibling ? spec->m_sibling_timing_cons : spec->m_target_timing_cons)[level][cmd].push_back(t);
+      }
+    }
+  }
+#endif
 };
 
 
@@ -64,6 +64,58 @@ class IDRAMController : public Clocked<IDRAMController> {
      * @return    Capacity
      */
     virtual size_t get_queue_size(const int type) const { return 0; };
+
+    /**
+     * @brief     Get the number of ticks until the controller may do anything besides advancing its clock
+     * @return    1 for the next tick
+     */
+    virtual Clk_t get_cycles_to_next_event() const { return 1; };
+
+    /**
+     * @brief     Advance the controller over idle ticks
+     * @param[in] cycles The number of skipped ticks, which is less than get_cycles_to_next_event()
+     */
+    virtual void skip_cycles(Clk_t cycles) {};
+
+#if (TELEMETRY == ENABLE)
+    /**
+     * @brief     Get the running counters of the channel
+     * @return    Counters, all 0 if the controller does not keep them
+     */
+    virtual ChannelCounters get_counters() const { return {}; };
+#endif /* TELEMETRY */
+
+    /**
+     * @brief     Keep the requests completed in tick() until flush_completions() instead of calling their callbacks right away
+     * @details   Controllers ticking on different threads must not call back into the frontend concurrently
+     */
+    void defer_completions(bool defer) { m_defer_completions = defer; };
+
+    /**
+     * @brief     Call the callbacks of the deferred requests in the order they completed
+     */
+    void flush_completions() {
+      for (auto& req : m_completions) {
+        req.callback(req);
+      }
+      m_completions.clear();
+    };
+
+  protected:
+    /**
+     * @brief     Call the callback of a completed request, unless completions are deferred
+     */
+    void complete(Request& req) {
+      if (m_defer_completions) {
+        m_completions.push_back(req);
+      } else {
+        req.callback(req);
+      }
+    };
+
+  private:
+    bool m_defer_completions = false;
+    std::vector<Request> m_completions;
 #endif /* USER_CODES */
 };
 
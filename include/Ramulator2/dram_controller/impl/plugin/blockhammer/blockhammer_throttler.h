@@ -2,11 +2,20 @@
 #define RAMULATOR_PLUGIN_BLOCKHAMMER_THROTTLER_
 
 #include "Ramulator2/frontend/impl/processor/bhO3/bhllc.h"
+#if (USER_CODES == ENABLE)
+#include "Ramulator2/dram_controller/impl/plugin/counter_table/counter_table.h"
+#endif
 
 namespace Ramulator {
 class AttackThrottler {
 public:
+#if (USER_CODES == ENABLE)
+  // One counter per (thread, bank) in each of the 'n_ctrs' tables
+  AttackThrottler(BHO3LLC* llc, int n_rh, int n_bl, int t_cbf, int t_refw, int n_ctrs, int n_threads, int n_banks)
+  : m_n_banks(n_banks), m_act_counters(n_ctrs, n_threads * n_banks, 0) {
+#else
   AttackThrottler(BHO3LLC* llc, int n_rh, int n_bl, int t_cbf, int t_refw, int n_ctrs) {
+#endif
     m_n_rh = n_rh; 
     m_n_bl = n_bl; 
     m_t_cbf = t_cbf; 
@@ -14,16 +23,22 @@ public:
     m_n_ctrs = n_ctrs;
     m_active_idx = 0;
     m_llc = llc;
+#if (USER_CODES != ENABLE)
     for (int i = 0; i < n_ctrs; i++) {
       m_act_counters.push_back(new std::unordered_map<int, int>);
     }
+#endif
   }
 
   void update() {
     m_clk++;
     if (m_clk >= m_t_cbf) {
       m_clk = 0;
+#if (USER_CODES == ENABLE)
+      m_act_counters.reset(m_active_idx);
+#else
       m_act_counters[m_active_idx]->clear();
+#endif
       m_active_idx = (m_active_idx + 1) % m_n_ctrs;
     }
   }
@@ -31,11 +46,15 @@ public:
   void insert(int thread_id, int bank_id) {
     auto key = hash(thread_id, bank_id);
     for (int i = 0; i < m_n_ctrs; i++) {
+#if (USER_CODES == ENABLE)
+      m_act_counters.at(i, key)++;
+#else
       auto& counter_map = *m_act_counters[i];
       if (counter_map.find(key) == counter_map.end()) {
         counter_map[key] = 0;
       }
       counter_map[key]++;
+#endif
     }
   }
 
@@ -43,17 +62,29 @@ public:
     if (thread_id < 0) { 
       return 0.0f;
     }
+#if (USER_CODES == ENABLE)
+    auto key = hash(thread_id, bank_id);
+    if (m_act_counters.at(m_active_idx, key) == 0) {
+      return 0.0f;
+    }
+    float rhli = (float) m_act_counters.at(m_active_idx, key) / (m_n_rh * (float) m_t_cbf / m_t_refw - m_n_bl);
+#else
     auto& counter_map = *m_act_counters[m_active_idx];
     auto key = hash(thread_id, bank_id);
     if (counter_map.find(key) == counter_map.end()) {
       return 0.0f;
     }
     float rhli = (float) counter_map[key] / (m_n_rh * (float) m_t_cbf / m_t_refw - m_n_bl);
+#endif
     return rhli;
   }
 
   int hash(int thread_id, int bank_id) {
+#if (USER_CODES == ENABLE)
+    return thread_id * m_n_banks + bank_id;
+#else
     return thread_id * 100000 + bank_id;
+#endif
   }
 
 private:
@@ -64,7 +95,12 @@ private:
   int m_t_refw = -1;
   int m_n_ctrs = -1;
   int m_active_idx = -1;
+#if (USER_CODES == ENABLE)
+  int m_n_banks = -1;
+  FlatCounterTable<int> m_act_counters;
+#else
   std::vector<std::unordered_map<int, int>*> m_act_counters;
+#endif
   std::vector<int> m_blacklisted_threads;
   BHO3LLC* m_llc = nullptr;
 };      // class AttackThrottler
@@ -5,6 +5,9 @@
 #include <cstdint>
 
 #include "ProjectConfiguration.h" // User file
+#if (USER_CODES == ENABLE)
+#include "Ramulator2/dram_controller/impl/plugin/counter_table/counter_table.h"
+#endif
 
 namespace Ramulator {
 
@@ -135,7 +138,12 @@ template <typename elem_t>
 class HistoryBuffer {
 public:
   // Slight modification, we allow 'max_freq' activations within 'size' ticks
+#if (USER_CODES == ENABLE)
+  // Elements are indices below 'num_elems' (e.g., row addresses), so they are counted in a flat table
+  HistoryBuffer(uint32_t size, uint32_t max_freq, uint32_t num_elems) : elem_counter(1, num_elems, 0) {
+#else
   HistoryBuffer(uint32_t size, uint32_t max_freq) {
+#endif
     this->m_size = size;
     this->m_max_freq = max_freq;
     this->m_tick = 0;
@@ -144,9 +152,21 @@ public:
 
   ~HistoryBuffer() {
     history.clear();
+#if (USER_CODES != ENABLE)
     elem_counter.clear();
+#endif
   }
 
+#if (USER_CODES == ENABLE)
+  inline bool exists(elem_t elem) {
+    // Empty history entries hold -1
+    return elem >= 0 && elem_counter.at(0, elem) > 0;
+  }
+
+  inline bool exceeds(elem_t elem) {
+    return elem_counter.at(0, elem) >= m_max_freq;
+  }
+#else
   inline bool exists(elem_t elem) {
     return elem_counter.find(elem) != elem_counter.end();
   }
@@ -154,6 +174,7 @@ public:
   inline bool exceeds(elem_t elem) {
     return elem_counter[elem] >= m_max_freq;
   }
+#endif
 
   bool search(elem_t elem) {
     return exists(elem) && exceeds(elem);
@@ -161,11 +182,16 @@ public:
 
   void insert(elem_t elem) {
     history[m_tick % m_size] = {elem, m_tick};
+#if (USER_CODES == ENABLE)
+    elem_counter.at(0, elem)++;
+  }
+#else
     if (!exists(elem)) {
       elem_counter[elem] = 0;
     }
     elem_counter[elem]++;
   }
+#endif
 
   void update() {
     m_tick++;
@@ -173,9 +199,13 @@ public:
     if (!exists(elem)) {
       return;
     }
+#if (USER_CODES == ENABLE)
+    elem_counter.at(0, elem)--;
+#else
     if (--elem_counter[elem] == 0) {
       elem_counter.erase(elem);
     }
+#endif
   }
 
 private:
@@ -183,7 +213,11 @@ private:
   uint32_t m_size;
   uint32_t m_max_freq;
   std::vector<HistoryEntry<elem_t>> history;
+#if (USER_CODES == ENABLE)
+  FlatCounterTable<uint32_t> elem_counter;
+#else
   std::unordered_map<elem_t, uint32_t> elem_counter;
+#endif
 };      // class HistoryBuffer
 };  // namespace Ramulator
 
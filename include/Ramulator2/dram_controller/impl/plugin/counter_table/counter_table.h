@@ -0,0 +1,232 @@
+#ifndef RAMULATOR_PLUGIN_COUNTER_TABLE_H_
+#define RAMULATOR_PLUGIN_COUNTER_TABLE_H_
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <span>
+#include <vector>
+
+namespace Ramulator {
+
+/**
+ * @brief  Fixed-size tables of exact counters (or small entries), e.g., one table per bank indexed by row.
+ *
+ * All tables live in one contiguous array, so a lookup is an index computation instead of a hash,
+ * and resetting a table is a fill over memory that is already allocated.
+ * An entry that was never touched holds the initial value, which plays the role of a missing map entry.
+ */
+template <typename T>
+class FlatCounterTable {
+  public:
+    FlatCounterTable() = default;
+    FlatCounterTable(int num_tables, int num_entries, const T& init_value = T{}) :
+      m_num_tables(num_tables), m_num_entries(num_entries), m_init_value(init_value),
+      m_entries(std::size_t(num_tables) * num_entries, init_value) {};
+
+    T& at(int table, int entry) {
+      assert(table >= 0 && table < m_num_tables && entry >= 0 && entry < m_num_entries);
+      return m_entries[std::size_t(table) * m_num_entries + entry];
+    };
+
+    const T& at(int table, int entry) const {
+      assert(table >= 0 && table < m_num_tables && entry >= 0 && entry < m_num_entries);
+      return m_entries[std::size_t(table) * m_num_entries + entry];
+    };
+
+    // All entries of one table, e.g., to search a set or to find its maximum
+    std::span<T> table(int table) {
+      return {m_entries.data() + std::size_t(table) * m_num_entries, std::size_t(m_num_entries)};
+    };
+
+    void reset() { std::fill(m_entries.begin(), m_entries.end(), m_init_value); };
+    void reset(int table) { std::ranges::fill(this->table(table), m_init_value); };
+
+    int num_tables() const { return m_num_tables; };
+    int num_entries() const { return m_num_entries; };
+
+  private:
+    int m_num_tables = 0;
+    int m_num_entries = 0;
+    T m_init_value{};
+    std::vector<T> m_entries;
+};      // class FlatCounterTable
+
+/**
+ * @brief  A fixed set of counters whose minimum and maximum are found in O(1), i.e., the Stream-Summary of Space-Saving.
+ *
+ * Counters of equal value share a bucket, and the buckets form a list sorted by value,
+ * so incrementing a counter moves it to the next bucket, and the first and last buckets hold the minimum and the maximum.
+ * A counter can only be lowered to at most the minimum (as the Misra-Gries and Space-Saving algorithms do),
+ * which keeps every operation O(1). All counters start at zero.
+ */
+class CounterSummary {
+  public:
+    CounterSummary() = default;
+    explicit CounterSummary(int num_counters) :
+      m_bucket_of(num_counters), m_prev(num_counters), m_next(num_counters),
+      m_value(num_counters + 1), m_first(num_counters + 1), m_bucket_prev(num_counters + 1), m_bucket_next(num_counters + 1) {
+      // One more bucket than counters, as a counter takes its new bucket before leaving its old one
+      assert(num_counters > 0);
+      reset();
+    };
+
+    int size() const { return int(m_bucket_of.size()); };
+    int count(int counter) const { return m_value[m_bucket_of[counter]]; };
+
+    int min() const { return m_value[m_head]; };
+    int max() const { return m_value[m_tail]; };
+    // A counter holding the minimum (maximum) value
+    int min_counter() const { return m_first[m_head]; };
+    int max_counter() const { return m_first[m_tail]; };
+
+    void increment(int counter) {
+      int bucket = m_bucket_of[counter];
+      int value = m_value[bucket] + 1;
+      int next = m_bucket_next[bucket];
+      if (next == NIL || m_value[next] != value) {
+        next = new_bucket(value, bucket);
+      }
+      move(counter, next);
+    };
+
+    // Set a counter to a value that is not above the minimum
+    void lower(int counter, int value) {
+      assert(value <= min());
+      int bucket = m_head;
+      if (m_value[bucket] != value) {
+        bucket = new_bucket(value, NIL);
+      }
+      if (bucket != m_bucket_of[counter]) {
+        move(counter, bucket);
+      }
+    };
+
+    // Set all counters to zero
+    void reset() {
+      int num_counters = size();
+      for (int counter = 0; counter < num_counters; counter++) {
+        m_bucket_of[counter] = 0;
+        m_prev[counter] = counter - 1;
+        m_next[counter] = counter + 1 < num_counters ? counter + 1 : NIL;
+      }
+
+      m_value[0] = 0;
+      m_first[0] = 0;
+      m_bucket_prev[0] = m_bucket_next[0] = NIL;
+      m_head = m_tail = 0;
+
+      m_free_buckets.clear();
+      for (int bucket = num_counters; bucket > 0; bucket--) {
+        m_free_buckets.push_back(bucket);
+      }
+    };
+
+  private:
+    static constexpr int NIL = -1;
+
+    // Per counter: its bucket and its neighbours in the bucket
+    std::vector<int> m_bucket_of;
+    std::vector<int> m_prev;
+    std::vector<int> m_next;
+
+    // Per bucket: its value, its first counter and its neighbours in the sorted list
+    std::vector<int> m_value;
+    std::vector<int> m_first;
+    std::vector<int> m_bucket_prev;
+    std::vector<int> m_bucket_next;
+    std::vector<int> m_free_buckets;
+    int m_head = NIL;
+    int m_tail = NIL;
+
+    // Link a new bucket after the given one (or at the head)
+    int new_bucket(int value, int after) {
+      int bucket = m_free_buckets.back();
+      m_free_buckets.pop_back();
+
+      m_value[bucket] = value;
+      m_first[bucket] = NIL;
+      m_bucket_prev[bucket] = after;
+      m_bucket_next[bucket] = after == NIL ? m_head : m_bucket_next[after];
+      if (m_bucket_next[bucket] == NIL) {
+        m_tail = bucket;
+      } else {
+        m_bucket_prev[m_bucket_next[bucket]] = bucket;
+      }
+      if (after == NIL) {
+        m_head = bucket;
+      } else {
+        m_bucket_next[after] = bucket;
+      }
+      return bucket;
+    };
+
+    void move(int counter, int bucket) {
+      // Leave the old bucket, and free it when it becomes empty
+      int old_bucket = m_bucket_of[counter];
+      if (m_prev[counter] == NIL) {
+        m_first[old_bucket] = m_next[counter];
+      } else {
+        m_next[m_prev[counter]] = m_next[counter];
+      }
+      if (m_next[counter] != NIL) {
+        m_prev[m_next[counter]] = m_prev[counter];
+      }
+
+      if (m_first[old_bucket] == NIL) {
+        int prev = m_bucket_prev[old_bucket], next = m_bucket_next[old_bucket];
+        (prev == NIL ? m_head : m_bucket_next[prev]) = next;
+        (next == NIL ? m_tail : m_bucket_prev[next]) = prev;
+        m_free_buckets.push_back(old_bucket);
+      }
+
+      // Join the new one
+      m_bucket_of[counter] = bucket;
+      m_prev[counter] = NIL;
+      m_next[counter] = m_first[bucket];
+      if (m_first[bucket] != NIL) {
+        m_prev[m_first[bucket]] = counter;
+      }
+      m_first[bucket] = counter;
+    };
+};      // class CounterSummary
+
+/**
+ * @brief  A small table of (key, counter) entries tracking the most frequent keys of a bounded key space, as Misra-Gries and Space-Saving do.
+ *
+ * Keys are found through a flat index over the key space and counters are kept in a CounterSummary,
+ * so finding a key, incrementing its counter and finding the entry with the minimum counter are all O(1).
+ * Entries that were never assigned hold no key.
+ */
+class SpaceSavingTable {
+  public:
+    static constexpr int NO_KEY = -1;
+
+    SpaceSavingTable(int num_entries, int num_keys) :
+      m_counters(num_entries), m_keys(num_entries, NO_KEY), m_entry_of(num_keys, NO_KEY) {};
+
+    // @return The entry tracking the key, or NO_KEY
+    int find(int key) const { return m_entry_of[key]; };
+    int key(int entry) const { return m_keys[entry]; };
+
+    // Track another key with an entry, which keeps its counter
+    void replace(int entry, int key) {
+      if (m_keys[entry] != NO_KEY) {
+        m_entry_of[m_keys[entry]] = NO_KEY;
+      }
+      m_keys[entry] = key;
+      m_entry_of[key] = entry;
+    };
+
+    CounterSummary& counters() { return m_counters; };
+    const CounterSummary& counters() const { return m_counters; };
+
+  private:
+    CounterSummary m_counters;
+    std::vector<int> m_keys;      // Entry -> key
+    std::vector<int> m_entry_of;  // Key -> entry
+};      // class SpaceSavingTable
+
+}       // namespace Ramulator
+
+#endif  // RAMULATOR_PLUGIN_COUNTER_TABLE_H_
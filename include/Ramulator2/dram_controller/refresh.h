@@ -4,6 +4,8 @@
 #include <vector>
 #include <string>
 
+#include "ProjectConfiguration.h" // User file
+
 #include "Ramulator2/base/base.h"
 
 
@@ -14,6 +16,20 @@ class IRefreshManager {
 
   public:
     virtual void tick() = 0;
+
+#if (USER_CODES == ENABLE)
+    /**
+     * @brief     Get the number of ticks until the refresh manager may send a refresh request
+     * @return    1 for the next tick
+     */
+    virtual Clk_t get_cycles_to_next_event() const { return 1; };
+
+    /**
+     * @brief     Advance the refresh manager over idle ticks
+     * @param[in] cycles The number of skipped ticks, which is less than get_cycles_to_next_event()
+     */
+    virtual void skip_cycles(Clk_t cycles) {};
+#endif /* USER_CODES */
 };
 
 }        // namespace Ramulator
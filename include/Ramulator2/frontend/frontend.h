@@ -57,7 +57,11 @@ class IFrontEnd : public Clocked<IFrontEnd>, public TopLevel<IFrontEnd> {
      * (tries to) send to the memory system, and return if this is successful
      * 
      */
+#if (USER_CODES == ENABLE)
+    virtual bool receive_external_requests(int req_type_id, Addr_t addr, int source_id, RequestCallback callback) { return false; }
+#else
     virtual bool receive_external_requests(int req_type_id, Addr_t addr, int source_id, std::function<void(Request&)> callback) { return false; }
+#endif /* USER_CODES */
 
 #if (USER_CODES == ENABLE)
     virtual void set_num_cores(int num_cores) {};
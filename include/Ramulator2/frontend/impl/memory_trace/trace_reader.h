@@ -0,0 +1,293 @@
+#ifndef     RAMULATOR_FRONTEND_MEMORY_TRACE_TRACE_READER_H
+#define     RAMULATOR_FRONTEND_MEMORY_TRACE_TRACE_READER_H
+
+#include <array>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "ProjectConfiguration.h" // User file
+
+#include "Ramulator2/base/exception.h"
+#include "binary_memory_trace.h"
+
+#if (USER_CODES == ENABLE)
+
+namespace Ramulator {
+
+/**
+ * @brief    A source of trace bytes, plain or decompressed on the fly.
+ */
+class ITraceByteSource {
+  public:
+    virtual ~ITraceByteSource() = default;
+
+    /**
+     * @return   The number of bytes read into dst, 0 at the end of the trace.
+     */
+    virtual std::size_t read(char* dst, std::size_t count) = 0;
+};
+
+/**
+ * @brief    Open a text trace, decompressing .gz, .xz and .bz2 files with champsim::inf_istream.
+ */
+std::unique_ptr<ITraceByteSource> open_trace_bytes(const std::string& path);
+
+/**
+ * @brief    Streams the records of a memory trace, with bounded memory and one pass at a time.
+ * @details
+ * Text traces and the delta-encoded memory traces written under BINARY_MEMORY_TRACE are parsed by a background thread
+ * into two alternating batches of records, so only two batches are in memory and parsing overlaps with simulation.
+ * next() returns false at the end of a pass; rewind() restarts the trace from its first record.
+ */
+template<typename Record>
+class TraceReader {
+  public:
+    using line_parser_t   = std::function<Record(std::string_view line)>;
+    using request_decoder_t = std::function<Record(uint64_t address, bool is_write)>;
+
+    static constexpr std::size_t BATCH_SIZE = 1 << 16;   // Records per batch of a text trace
+
+    /**
+     * @param    decode_request    Builds a record from a request of a delta-encoded memory trace, empty if they are not accepted.
+     */
+    TraceReader(std::string path, line_parser_t parse_line, request_decoder_t decode_request = nullptr):
+      m_path(std::move(path)), m_parse_line(std::move(parse_line)), m_decode_request(std::move(decode_request)) {
+      start_parser();
+    };
+
+    ~TraceReader() { stop_parser(); };
+
+    TraceReader(const TraceReader&) = delete;
+    TraceReader& operator=(const TraceReader&) = delete;
+
+    bool next(Record& record) {
+      while (m_batch_idx >= m_batch.size()) {
+        if (!take_batch()) {
+          return false;
+        }
+      }
+      record = m_batch[m_batch_idx++];
+      return true;
+    };
+
+    void rewind() {
+      stop_parser();
+      start_parser();
+    };
+
+  private:
+    std::string m_path;
+    line_parser_t m_parse_line;
+    request_decoder_t m_decode_request;
+
+    // The consumer owns m_batch and the parser thread fills the other batch
+    std::vector<Record> m_batch;
+    std::size_t m_batch_idx = 0;
+    std::thread m_parser;
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::deque<std::vector<Record>> m_filled;   // At most one batch waits here
+    std::vector<Record> m_spare;                // A consumed batch handed back for reuse
+    bool m_parser_done = false;
+    bool m_stop = false;
+    std::exception_ptr m_error;
+
+    void start_parser() {
+      m_batch.clear();
+      m_batch_idx = 0;
+      m_filled.clear();
+      m_parser_done = false;
+      m_stop = false;
+      m_error = nullptr;
+      m_parser = std::thread(&TraceReader::parse, this);
+    };
+
+    void stop_parser() {
+      if (!m_parser.joinable()) {
+        return;
+      }
+      {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+      }
+      m_cv.notify_all();
+      m_parser.join();
+    };
+
+    /**
+     * @brief    Swap in the next parsed batch, waiting for the parser if needed.
+     * @return   false if the parser reached the end of the trace.
+     */
+    bool take_batch() {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_cv.wait(lock, [this] { return !m_filled.empty() || m_parser_done; });
+      if (m_error) {
+        std::rethrow_exception(m_error);
+      }
+      if (m_filled.empty()) {
+        return false;
+      }
+
+      m_spare = std::move(m_batch);
+      m_batch = std::move(m_filled.front());
+      m_filled.pop_front();
+      m_batch_idx = 0;
+      lock.unlock();
+      m_cv.notify_all();
+      return true;
+    };
+
+    /**
+     * @brief    Hand a full batch to the consumer, waiting while the previous one is still unclaimed.
+     * @return   false if the reader is being stopped.
+     */
+    bool publish(std::vector<Record>& batch) {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_cv.wait(lock, [this] { return m_filled.empty() || m_stop; });
+      if (m_stop) {
+        return false;
+      }
+      m_filled.push_back(std::move(batch));
+      batch = std::move(m_spare);
+      batch.clear();
+      lock.unlock();
+      m_cv.notify_all();
+      return true;
+    };
+
+    static std::size_t read_exact(ITraceByteSource& source, char* dst, std::size_t count) {
+      std::size_t total = 0;
+      for (std::size_t got = 1; total < count && got > 0; total += got) {
+        got = source.read(dst + total, count - total);
+      }
+      return total;
+    };
+
+    /**
+     * @return   false if the reader is being stopped.
+     */
+    bool parse_text(ITraceByteSource& source, std::string_view prefix, std::vector<Record>& batch) {
+      std::vector<char> chunk(1 << 20);
+      std::string line;
+      bool running = true;
+
+      const auto consume = [&](std::string_view text) {
+        for (std::size_t newline = text.find('\n'); running && newline != std::string_view::npos; newline = text.find('\n')) {
+          line.append(text.substr(0, newline));
+          text.remove_prefix(newline + 1);
+          if (!line.empty()) {
+            batch.push_back(m_parse_line(line));
+          }
+          line.clear();
+
+          if (batch.size() >= BATCH_SIZE) {
+            running = publish(batch);
+          }
+        }
+        line.append(text);
+      };
+
+      consume(prefix);
+      for (std::size_t count = source.read(chunk.data(), chunk.size()); running && count > 0; count = source.read(chunk.data(), chunk.size())) {
+        consume(std::string_view(chunk.data(), count));
+      }
+
+      // The last line may have no newline
+      if (running && !line.empty()) {
+        batch.push_back(m_parse_line(line));
+      }
+      return running;
+    };
+
+    /**
+     * @return   false if the reader is being stopped.
+     */
+    bool parse_requests(ITraceByteSource& source, std::vector<Record>& batch) {
+      if (!m_decode_request) {
+        throw ConfigurationError("Trace {} is a memory request trace, which this frontend cannot read!", m_path);
+      }
+
+      std::vector<uint8_t> payload;
+      while (true) {
+        char header[binary_memory_trace::BLOCK_HEADER_SIZE];
+        const std::size_t header_size = read_exact(source, header, sizeof(header));
+        if (header_size == 0) {
+          return true;
+        }
+
+        uint32_t request_count, payload_size;
+        std::memcpy(&request_count, header, sizeof(request_count));
+        std::memcpy(&payload_size, header + sizeof(request_count), sizeof(payload_size));
+        payload.resize(payload_size);
+        if ((header_size != sizeof(header)) || (read_exact(source, reinterpret_cast<char*>(payload.data()), payload_size) != payload_size)) {
+          throw ConfigurationError("Trace {} is truncated!", m_path);
+        }
+
+        const uint8_t* cursor = payload.data();
+        const uint8_t* end = payload.data() + payload.size();
+        uint64_t address = 0;
+        for (uint32_t request = 0; request < request_count; request++) {
+          uint64_t value;
+          const std::size_t size = binary_memory_trace::get_varint(cursor, end, value);
+          if (size == 0) {
+            throw ConfigurationError("Trace {} format invalid!", m_path);
+          }
+          cursor += size;
+
+          address = binary_memory_trace::decode_address(address, value);
+          batch.push_back(m_decode_request(address, binary_memory_trace::decode_is_write(value)));
+          if ((batch.size() >= BATCH_SIZE) && !publish(batch)) {
+            return false;
+          }
+        }
+      }
+    };
+
+    void parse() {
+      try {
+        auto source = open_trace_bytes(m_path);
+        std::vector<Record> batch;
+        batch.reserve(BATCH_SIZE);
+
+        std::array<char, binary_memory_trace::MAGIC.size()> magic;
+        const std::size_t magic_size = read_exact(*source, magic.data(), magic.size());
+
+        bool running;
+        if ((magic_size == magic.size()) && (magic == binary_memory_trace::MAGIC)) {
+          running = parse_requests(*source, batch);
+        } else {
+          running = parse_text(*source, std::string_view(magic.data(), magic_size), batch);
+        }
+        if (running && !batch.empty()) {
+          publish(batch);
+        }
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_error = std::current_exception();
+      }
+
+      {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_parser_done = true;
+      }
+      m_cv.notify_all();
+    };
+};
+
+}        // namespace Ramulator
+
+#endif /* USER_CODES */
+
+#endif   // RAMULATOR_FRONTEND_MEMORY_TRACE_TRACE_READER_H
@@ -92,7 +92,11 @@ class BHO3Core: public Clocked<BHO3Core> {
     ITranslation* m_translation;
     BHO3LLC* m_llc;
 
+#if (USER_CODES == ENABLE)
+    RequestCallback m_callback;
+#else
     std::function<void(Request&)> m_callback;
+#endif /* USER_CODES */
 
     int    m_num_bubbles = 0;
     Addr_t m_load_addr = -1;
@@ -88,7 +88,11 @@ class SimpleO3Core : public Clocked<SimpleO3Core> {
     ITranslation* m_translation;
     SimpleO3LLC* m_llc;
 
+#if (USER_CODES == ENABLE)
+    RequestCallback m_callback;
+#else
     std::function<void(Request&)> m_callback;
+#endif /* USER_CODES */
 
     int    m_num_bubbles = 0;
     Addr_t m_load_addr = -1;
@@ -97,6 +97,27 @@ class IMemorySystem : public TopLevel<IMemorySystem> {
      * @return    Capacity
      */
     virtual size_t get_queue_size(Request& req) const { return 0; };
+
+    /**
+     * @brief     Get the number of ticks until the memory system may do anything besides advancing its clock
+     * @return    1 for the next tick
+     */
+    virtual Clk_t get_cycles_to_next_event() const { return 1; };
+
+    /**
+     * @brief     Advance the memory system over idle ticks, which is cheaper than calling tick() for each of them
+     * @param[in] cycles The number of skipped ticks, which is less than get_cycles_to_next_event()
+     */
+    virtual void skip_cycles(Clk_t cycles) {};
+
+#if (TELEMETRY == ENABLE)
+    /**
+     * @brief     Get the running counters of a channel
+     * @param[in] channel_id The channel, less than get_channel()
+     * @return    Counters, all 0 if the memory system does not keep them
+     */
+    virtual ChannelCounters get_channel_counters(int channel_id) const { return {}; };
+#endif /* TELEMETRY */
 #endif /* USER_CODES */
 };
 
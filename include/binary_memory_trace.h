@@ -0,0 +1,128 @@
+#ifndef BINARY_MEMORY_TRACE_H
+#define BINARY_MEMORY_TRACE_H
+
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Layout of the binary memory trace written when BINARY_MEMORY_TRACE is enabled.
+ * @details
+ * The file is one xz stream. Its decompressed content is MAGIC followed by blocks, and each block is
+ *  - uint32_t number of requests,
+ *  - uint32_t number of payload bytes,
+ *  - the payload, one LEB128 varint per request holding (zigzag(address - previous address) << 1) | is_write.
+ * The previous address restarts from 0 at each block, so every block decodes on its own,
+ * and each block is flushed as its own xz block.
+ */
+namespace binary_memory_trace
+{
+constexpr std::array<char, 8> MAGIC         = {'R', '2', 'M', 'T', 'D', 'E', 'L', 'T'};
+constexpr std::size_t BLOCK_HEADER_SIZE     = 2 * sizeof(uint32_t);
+constexpr std::size_t MAX_VARINT_SIZE       = 10;
+constexpr std::size_t REQUESTS_PER_BLOCK    = 1 << 16;
+
+inline uint64_t encode_request(uint64_t previous_address, uint64_t address, bool is_write)
+{
+    const int64_t delta = static_cast<int64_t>(address - previous_address);
+    const uint64_t zigzag = (static_cast<uint64_t>(delta) << 1) ^ static_cast<uint64_t>(delta >> 63);
+    return (zigzag << 1) | (is_write ? 1 : 0);
+}
+
+inline uint64_t decode_address(uint64_t previous_address, uint64_t value)
+{
+    const uint64_t zigzag = value >> 1;
+    const int64_t delta   = static_cast<int64_t>(zigzag >> 1) ^ -static_cast<int64_t>(zigzag & 1);
+    return previous_address + static_cast<uint64_t>(delta);
+}
+
+inline bool decode_is_write(uint64_t value) { return (value & 1) != 0; }
+
+/** @return Number of bytes written into @p output */
+inline std::size_t put_varint(uint8_t* output, uint64_t value)
+{
+    std::size_t size = 0;
+    while (value >= 0x80)
+    {
+        output[size++] = static_cast<uint8_t>(value) | 0x80;
+        value >>= 7;
+    }
+    output[size++] = static_cast<uint8_t>(value);
+    return size;
+}
+
+/** @return Number of bytes read from @p input, 0 if the varint does not end before @p end */
+inline std::size_t get_varint(const uint8_t* input, const uint8_t* end, uint64_t& value)
+{
+    value = 0;
+    for (std::size_t size = 0; size < MAX_VARINT_SIZE && input + size < end; size++)
+    {
+        value |= static_cast<uint64_t>(input[size] & 0x7f) << (7 * size);
+        if ((input[size] & 0x80) == 0)
+        {
+            return size + 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Writes the binary memory trace on a background thread.
+ * @details
+ * The simulation thread only stores each request into a single-producer single-consumer ring buffer.
+ * The writer thread drains it, delta-encodes the requests into blocks and compresses them with liblzma,
+ * so neither formatting nor compression nor file I/O runs on the simulation thread.
+ * The producer waits only if the writer falls a whole ring behind, so no request is dropped.
+ */
+class BinaryMemoryTraceWriter
+{
+public:
+    /**
+     * @param file The opened output file, not closed by the writer.
+     */
+    explicit BinaryMemoryTraceWriter(FILE* file);
+    ~BinaryMemoryTraceWriter();
+
+    BinaryMemoryTraceWriter(const BinaryMemoryTraceWriter&)            = delete;
+    BinaryMemoryTraceWriter& operator=(const BinaryMemoryTraceWriter&) = delete;
+
+    /** @note Must be called from a single thread. */
+    void write(uint64_t address, bool is_write)
+    {
+        assert((address >> 62) == 0); // Room for the zigzag sign and the request type
+        const std::size_t head = ring_head.load(std::memory_order_relaxed);
+        while (head - ring_tail.load(std::memory_order_acquire) >= RING_SIZE)
+        {
+            std::this_thread::yield(); // The writer thread is a whole ring behind
+        }
+
+        ring[head & (RING_SIZE - 1)] = (address << 1) | (is_write ? 1 : 0);
+        ring_head.store(head + 1, std::memory_order_release);
+    };
+
+    /**
+     * @brief Write out everything pushed so far, finish the xz stream and stop the writer thread.
+     */
+    void close();
+
+private:
+    static constexpr std::size_t RING_SIZE = 1 << 20; // Requests, a power of two
+
+    FILE* file;
+    std::vector<uint64_t> ring;            // (address << 1) | is_write of each request
+    alignas(64) std::atomic<std::size_t> ring_head {0}; // Next slot the simulation thread fills
+    alignas(64) std::atomic<std::size_t> ring_tail {0}; // Next slot the writer thread drains
+    alignas(64) std::atomic<bool> stopping {false};
+    std::thread writer;
+
+    void run();
+};
+
+} // namespace binary_memory_trace
+
+#endif /* BINARY_MEMORY_TRACE_H */
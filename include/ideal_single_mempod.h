@@ -4,6 +4,7 @@
 #include <cassert>
 #include <cstdlib>
 #include <deque>
+#include <functional>
 #include <iostream>
 #include <map>
 #include <unordered_map>
@@ -11,7 +12,10 @@
 
 #include "ChampSim/champsim_constants.h"
 #include "ChampSim/channel.h"
+#include "ChampSim/checkpoint.h"
 #include "ProjectConfiguration.h" // User file
+#include "remapping_request_queue.h"
+#include "sparse_remapping_table.h"
 
 /** @note Abbreviation:
  *  FM -> Fast memory (e.g., HBM, DDR4)
@@ -95,10 +99,12 @@ public:
     };
 
     std::unordered_map<REMAPPING_TABLE_ENTRY_WIDTH, MEA_COUNTER_WIDTH>& mea_counter_table;
-    std::unordered_map<REMAPPING_TABLE_ENTRY_WIDTH, REMAPPING_TABLE_ENTRY_WIDTH>& address_remapping_table;
-    std::unordered_map<REMAPPING_TABLE_ENTRY_WIDTH, REMAPPING_TABLE_ENTRY_WIDTH>& invert_address_remapping_table;
+    // Segments are mapped to themselves unless they were swapped, so only swapped segments are stored
+    SparseRemappingTable address_remapping_table;        // Physical segment -> hardware segment
+    SparseRemappingTable invert_address_remapping_table; // Hardware segment in fast memory -> physical segment
 
-    std::deque<RemappingRequest> remapping_request_queue;
+    RemappingRequestQueue<RemappingRequest> remapping_request_queue {REMAPPING_REQUEST_QUEUE_LENGTH};
+    using RemappingRequestHandle = RemappingRequestQueue<RemappingRequest>::handle_type;
     uint64_t remapping_request_queue_congestion;
 
     double interval_cycle;
@@ -125,9 +131,17 @@ public:
     void cold_data_detection();
 
     // MemPod interval swap
-    void check_interval_swap(uint8_t swapping_states, bool warmup);
+    void check_interval_swap(bool warmup);
     bool issue_remapping_request(RemappingRequest& remapping_request);
-    bool finish_remapping_request();
+    bool finish_remapping_request(RemappingRequestHandle handle = RemappingRequestQueue<RemappingRequest>::FRONT);
+
+    // Start a remapping request for one of several swapping engines, the first that can_start accepts
+    bool issue_remapping_request(RemappingRequest& remapping_request, RemappingRequestHandle& handle, const std::function<bool(const RemappingRequest&)>& can_start);
+    // Get a started remapping request, which may be updated (e.g., enlarged) while it is swapped
+    void get_remapping_request(RemappingRequestHandle handle, RemappingRequest& remapping_request);
+
+    // Save or restore the MEA counters, the remapping tables and the interval state, without the remapping requests in flight
+    void checkpoint(champsim::checkpoint_archive& archive);
 
 private:
     void get_hot_page_from_mea_counter(std::vector<REMAPPING_TABLE_ENTRY_WIDTH>& hot_pages);
@@ -136,7 +150,7 @@ private:
     void update_mea_counter(uint64_t segment_address);
 
     void reset_mea_counter();
-    void cancel_not_started_remapping_request(uint8_t swapping_states);
+    void cancel_not_started_remapping_request();
     bool enqueue_remapping_request(RemappingRequest& remapping_request, bool warmup);
 };
 
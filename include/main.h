@@ -17,10 +17,12 @@
 #include <fstream>
 #include <numeric>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "ChampSim/cache.h" // for CACHE
 #include "ChampSim/champsim.h"
+#include "ChampSim/cycle_engine.h"
 
 #if (USER_CODES == ENABLE)
 #ifndef CHAMPSIM_TEST_BUILD
@@ -81,6 +83,22 @@
 
 #endif /* RAMULATOR */
 
+// Includes of the sweep mode
+#if (RAMULATOR2 == ENABLE) && (MULTI_CONFIG_SWEEP == ENABLE)
+#include <fcntl.h>
+#include <spawn.h>
+#include <sys/wait.h>
+
+#include <filesystem>
+
+#include "ChampSim/trace_fanout.h"
+#endif /* RAMULATOR2, MULTI_CONFIG_SWEEP */
+
+// Includes of sampled runs
+#if (USER_CODES == ENABLE) && (SAMPLED_SIMULATION == ENABLE)
+#include "ChampSim/sampling.h"
+#endif /* USER_CODES, SAMPLED_SIMULATION */
+
 /* Macro */
 
 /* Type */
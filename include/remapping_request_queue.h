@@ -0,0 +1,439 @@
+#ifndef REMAPPING_REQUEST_QUEUE_H
+#define REMAPPING_REQUEST_QUEUE_H
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "ChampSim/msl/flat_hash_table.h"
+#include "ProjectConfiguration.h" // User file
+
+#if (MEMORY_USE_OS_TRANSPARENT_MANAGEMENT == ENABLE)
+
+/**
+ * @brief The remapping requests an OS-transparent management design waits to swap.
+ * @details
+ * Requests live in a fixed pool of slots and are indexed by a key the design chooses (e.g., the set that a request remaps),
+ * so duplicates are found without scanning the queue, and no request allocates.
+ * A single swapping engine serves one request at a time, the one front() starts. Several engines serve a request each, the ones start() starts.
+ * A request is ready when it is the oldest one with its key, since it never overtakes an earlier one with the same key, nor starts before it finishes.
+ * Only ready requests are linked into the order of their priority, so starting one does not scan the requests waiting behind others.
+ * Ready requests are served from the highest priority (e.g., hotness) down, and within a priority in the order they became ready:
+ * on arrival, or when the request before them with the same key finished. Without REMAPPING_REQUEST_PRIORITY, all have the same priority.
+ */
+template<typename Request>
+class RemappingRequestQueue
+{
+public:
+    using priority_type = uint8_t;
+    using handle_type   = uint32_t;
+
+    static constexpr handle_type FRONT = std::numeric_limits<handle_type>::max(); // The handle of the request front() serves
+
+    struct Statistics
+    {
+        uint64_t enqueued             = 0; // Requests added
+        uint64_t duplicated           = 0; // Requests dropped or merged since they duplicate a queued one
+        uint64_t cancelled            = 0; // Requests removed before they started
+        uint64_t finished             = 0; // Requests served
+        uint64_t max_occupancy        = 0;
+        uint64_t occupancy_cycles     = 0; // Sum of the occupancy over the cycles until last_update_cycle
+        uint64_t last_update_cycle    = 0;
+        uint64_t total_waiting_cycles = 0; // From arrival to start, of finished requests
+        uint64_t total_service_cycles = 0; // From start to finish
+        uint64_t max_latency_cycles   = 0; // From arrival to finish
+
+        double average_occupancy() const { return last_update_cycle ? double(occupancy_cycles) / last_update_cycle : 0.0; };
+        double average_waiting_cycles() const { return finished ? double(total_waiting_cycles) / finished : 0.0; };
+        double average_service_cycles() const { return finished ? double(total_service_cycles) / finished : 0.0; };
+    };
+
+    explicit RemappingRequestQueue(std::size_t capacity)
+    : entries(capacity), key_index(2 * capacity) // Each request has at most one key, so the index stays under half load and never grows
+    {
+        free_slots.reserve(capacity);
+        for (std::size_t slot = capacity; slot > 0; slot--)
+        {
+            free_slots.push_back(static_cast<slot_type>(slot - 1));
+        }
+        order_head.fill(NIL);
+        order_tail.fill(NIL);
+    };
+
+    std::size_t size() const { return occupancy; };
+    std::size_t capacity() const { return entries.size(); };
+    bool empty() const { return occupancy == 0; };
+    bool full() const { return occupancy == entries.size(); };
+
+    /** @return Whether a request with this key is queued, started or not */
+    bool contains(uint64_t key) const { return oldest(key) != NIL; };
+
+    /**
+     * @brief Visit the requests with this key in arrival order, until visit returns false.
+     * @note visit may update a request, but not the key it was added with.
+     */
+    template<typename Visit>
+    void for_each(uint64_t key, Visit&& visit)
+    {
+        for (slot_type slot = oldest(key); slot != NIL; slot = entries[slot].next_in_key)
+        {
+            if (visit(entries[slot].request) == false)
+            {
+                return;
+            }
+        }
+    };
+
+    /**
+     * @brief Add a request unless the queue is full.
+     * @return Whether the request is added.
+     */
+    bool push(const Request& request, uint64_t key, priority_type priority, uint64_t cycle)
+    {
+        if (full())
+        {
+            return false;
+        }
+        update_occupancy(cycle);
+
+        const slot_type slot = free_slots.back();
+        free_slots.pop_back();
+
+        Entry& entry        = entries[slot];
+        entry.request       = request;
+        entry.key           = key;
+        entry.arrival_cycle = cycle;
+        entry.next_in_key   = NIL;
+#if (REMAPPING_REQUEST_PRIORITY == DISABLE)
+        priority = 0;
+#endif /* REMAPPING_REQUEST_PRIORITY */
+        entry.priority = priority;
+
+        if (const slot_type first = oldest(key); first == NIL)
+        {
+            // The only request with this key is ready
+            key_index.insert_or_assign(key, slot);
+            entry.previous_in_key = NIL;
+            entry.last_in_key     = slot;
+            link_order(slot);
+        }
+        else
+        {
+            // Wait behind the latest request with this key
+            const slot_type last       = entries[first].last_in_key;
+            entry.previous_in_key      = last;
+            entries[last].next_in_key  = slot;
+            entries[first].last_in_key = slot;
+        }
+
+        occupancy++;
+        statistics.enqueued++;
+        statistics.max_occupancy = std::max<uint64_t>(statistics.max_occupancy, occupancy);
+        return true;
+    };
+
+    /** @brief Count a request that is dropped or merged since it duplicates a queued one */
+    void drop_duplicate() { statistics.duplicated++; };
+
+    /** @return The request being served, which is started now if none is, or nullptr if no request can start (e.g., the queue is empty, or holds only requests start() started) */
+    Request* front(uint64_t cycle)
+    {
+        if (in_progress == NIL && start(cycle, in_progress, [](const Request&) { return true; }) == false)
+        {
+            return nullptr;
+        }
+
+        return &entries[in_progress].request;
+    };
+
+    /** @brief Remove the request being served once it finishes, starting one first if none is */
+    Request pop_front(uint64_t cycle) { return finish(FRONT, cycle); };
+
+    /**
+     * @brief Start the first ready request that can_start accepts, e.g., whose data no swapping engine swaps, in the order front() would start them.
+     * @return Whether a request is started, with its handle, which stays valid until the request finishes.
+     */
+    template<typename CanStart>
+    bool start(uint64_t cycle, handle_type& handle, CanStart&& can_start)
+    {
+        // From the highest priority that has requests not started
+        for (std::size_t word = not_empty_orders.size(); word > 0; word--)
+        {
+            for (uint64_t orders = not_empty_orders[word - 1]; orders != 0;)
+            {
+                const unsigned bit  = 63 - std::countl_zero(orders);
+                const auto priority = static_cast<priority_type>((word - 1) * 64 + bit);
+                orders &= ~(uint64_t(1) << bit);
+
+                for (slot_type previous = NIL, slot = order_head[priority]; slot != NIL; previous = slot, slot = entries[slot].next_in_order)
+                {
+                    if (can_start(std::as_const(entries[slot].request)) == false)
+                    {
+                        continue;
+                    }
+
+                    unlink_order(priority, previous, slot);
+                    link_started(slot);
+                    entries[slot].start_cycle = cycle;
+                    handle                    = slot;
+                    return true;
+                }
+            }
+        }
+
+        return false;
+    };
+
+    /** @return The started request with this handle, which its design may update while it is served */
+    Request& at(handle_type handle) { return entries[handle].request; };
+
+    /** @brief Remove the started request with this handle once it finishes, or the one front() serves with FRONT */
+    Request finish(handle_type handle, uint64_t cycle)
+    {
+        if (handle == FRONT)
+        {
+            if (front(cycle) == nullptr)
+            {
+                std::cout << __func__ << ": no remapping request to finish." << std::endl;
+                std::abort();
+            }
+            handle      = in_progress;
+            in_progress = NIL;
+        }
+        update_occupancy(cycle);
+
+        const Entry& entry = entries[handle];
+        statistics.finished++;
+        statistics.total_waiting_cycles += entry.start_cycle - entry.arrival_cycle;
+        statistics.total_service_cycles += cycle - entry.start_cycle;
+        statistics.max_latency_cycles = std::max(statistics.max_latency_cycles, cycle - entry.arrival_cycle);
+
+        Request request      = entry.request;
+        const slot_type next = entry.next_in_key;
+        unlink_started(handle);
+        release(handle);
+
+        // The next request with this key is ready now
+        if (next != NIL)
+        {
+            link_order(next);
+        }
+        return request;
+    };
+
+    /** @brief Remove every request that is not started, keeping the ones being served */
+    void cancel_not_started(uint64_t cycle)
+    {
+        update_occupancy(cycle);
+
+        // Only the oldest request with a key is ready or started, so the others wait behind a ready or a started one
+        for (slot_type slot = started_head; slot != NIL; slot = entries[slot].next_started)
+        {
+            cancel_from(entries[slot].next_in_key);
+        }
+
+        for (std::size_t word = 0; word < not_empty_orders.size(); word++)
+        {
+            for (uint64_t orders = not_empty_orders[word]; orders != 0; orders &= orders - 1)
+            {
+                const auto priority = static_cast<priority_type>(word * 64 + std::countr_zero(orders));
+
+                for (slot_type slot = order_head[priority]; slot != NIL;)
+                {
+                    const slot_type next = entries[slot].next_in_order;
+                    cancel_from(slot);
+                    slot = next;
+                }
+                order_head[priority] = NIL;
+                order_tail[priority] = NIL;
+            }
+            not_empty_orders[word] = 0;
+        }
+    };
+
+    const Statistics& get_statistics() const { return statistics; };
+
+    /** @brief Copy the statistics into output_statistics, which prints them */
+    void report_statistics() const
+    {
+        output_statistics.remapping_request_enqueued                = statistics.enqueued;
+        output_statistics.remapping_request_duplicated              = statistics.duplicated;
+        output_statistics.remapping_request_cancelled               = statistics.cancelled;
+        output_statistics.remapping_request_finished                = statistics.finished;
+        output_statistics.remapping_request_queue_max_occupancy     = statistics.max_occupancy;
+        output_statistics.remapping_request_queue_average_occupancy = statistics.average_occupancy();
+        output_statistics.remapping_request_average_waiting_cycles  = statistics.average_waiting_cycles();
+        output_statistics.remapping_request_average_service_cycles  = statistics.average_service_cycles();
+        output_statistics.remapping_request_max_latency_cycles      = statistics.max_latency_cycles;
+    };
+
+private:
+    using slot_type                         = uint32_t;
+    static constexpr slot_type NIL          = std::numeric_limits<slot_type>::max();
+    static constexpr std::size_t PRIORITIES = std::size_t(std::numeric_limits<priority_type>::max()) + 1;
+
+    struct Entry
+    {
+        Request request;
+        uint64_t key;
+        uint64_t arrival_cycle, start_cycle;
+        slot_type previous_in_key, next_in_key; // Requests with the same key, in arrival order
+        slot_type last_in_key;                  // Latest request with the same key, kept by the oldest one
+        slot_type next_in_order;                // Ready requests with the same priority, in the order they became ready
+        slot_type previous_started, next_started; // Started requests, which the requests with their keys wait behind
+        priority_type priority;
+    };
+
+    std::vector<Entry> entries;
+    std::vector<slot_type> free_slots;
+    std::size_t occupancy   = 0;
+    slot_type in_progress   = NIL;
+    slot_type started_head  = NIL;
+
+    std::array<slot_type, PRIORITIES> order_head, order_tail;
+    std::array<uint64_t, PRIORITIES / 64> not_empty_orders {}; // A bit for each priority that has ready requests
+
+    champsim::msl::flat_hash_table key_index; // {key -> oldest request with this key}
+
+    Statistics statistics;
+
+    slot_type oldest(uint64_t key) const { return static_cast<slot_type>(key_index.value_or(key, NIL)); };
+
+    // Link a request that became ready after the ready requests with its priority
+    void link_order(slot_type slot)
+    {
+        const priority_type priority = entries[slot].priority;
+        entries[slot].next_in_order  = NIL;
+
+        if (order_tail[priority] == NIL)
+        {
+            order_head[priority] = slot;
+            not_empty_orders[priority / 64] |= uint64_t(1) << (priority % 64);
+        }
+        else
+        {
+            entries[order_tail[priority]].next_in_order = slot;
+        }
+        order_tail[priority] = slot;
+    };
+
+    // Unlink a request that starts from the ready requests with its priority, after the previous one
+    void unlink_order(priority_type priority, slot_type previous, slot_type slot)
+    {
+        if (previous == NIL)
+        {
+            order_head[priority] = entries[slot].next_in_order;
+        }
+        else
+        {
+            entries[previous].next_in_order = entries[slot].next_in_order;
+        }
+
+        if (order_tail[priority] == slot)
+        {
+            order_tail[priority] = previous;
+        }
+        if (order_head[priority] == NIL)
+        {
+            not_empty_orders[priority / 64] &= ~(uint64_t(1) << (priority % 64));
+        }
+    };
+
+    // Link a request that starts into the started requests
+    void link_started(slot_type slot)
+    {
+        entries[slot].previous_started = NIL;
+        entries[slot].next_started     = started_head;
+        if (started_head != NIL)
+        {
+            entries[started_head].previous_started = slot;
+        }
+        started_head = slot;
+    };
+
+    // Unlink a request that finishes from the started requests
+    void unlink_started(slot_type slot)
+    {
+        const Entry& entry = entries[slot];
+        if (entry.previous_started == NIL)
+        {
+            started_head = entry.next_started;
+        }
+        else
+        {
+            entries[entry.previous_started].next_started = entry.next_started;
+        }
+        if (entry.next_started != NIL)
+        {
+            entries[entry.next_started].previous_started = entry.previous_started;
+        }
+    };
+
+    // Cancel a request that is not started and the ones waiting behind it with its key
+    void cancel_from(slot_type slot)
+    {
+        while (slot != NIL)
+        {
+            const slot_type next = entries[slot].next_in_key;
+            release(slot);
+            statistics.cancelled++;
+            slot = next;
+        }
+    };
+
+    // Unlink a request from the requests with its key and free its slot
+    void release(slot_type slot)
+    {
+        Entry& entry = entries[slot];
+
+        if (entry.previous_in_key == NIL)
+        {
+            // The next request becomes the oldest with this key
+            if (entry.next_in_key == NIL)
+            {
+                key_index.erase(entry.key);
+            }
+            else
+            {
+                key_index.insert_or_assign(entry.key, entry.next_in_key);
+                entries[entry.next_in_key].previous_in_key = NIL;
+                entries[entry.next_in_key].last_in_key     = entry.last_in_key;
+            }
+        }
+        else
+        {
+            entries[entry.previous_in_key].next_in_key = entry.next_in_key;
+            if (entry.next_in_key == NIL)
+            {
+                entries[oldest(entry.key)].last_in_key = entry.previous_in_key;
+            }
+            else
+            {
+                entries[entry.next_in_key].previous_in_key = entry.previous_in_key;
+            }
+        }
+
+        free_slots.push_back(slot);
+        occupancy--;
+    };
+
+    void update_occupancy(uint64_t cycle)
+    {
+        if (cycle > statistics.last_update_cycle)
+        {
+            statistics.occupancy_cycles += occupancy * (cycle - statistics.last_update_cycle);
+            statistics.last_update_cycle = cycle;
+        }
+    };
+};
+
+#endif /* MEMORY_USE_OS_TRANSPARENT_MANAGEMENT */
+
+#endif /* REMAPPING_REQUEST_QUEUE_H */
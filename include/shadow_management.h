@@ -0,0 +1,101 @@
+#ifndef SHADOW_MANAGEMENT_H
+#define SHADOW_MANAGEMENT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "ChampSim/chrono.h"
+#include "ProjectConfiguration.h" // User file
+#include "sparse_remapping_table.h"
+
+/** @note Abbreviation:
+ *  FM -> Fast memory (e.g., HBM, DDR4)
+ *  SM -> Slow memory (e.g., DDR4, PCM)
+*/
+
+#if (SHADOW_OS_TRANSPARENT_MANAGEMENT == ENABLE)
+
+/**
+ * @brief Functional-only models of several OS-transparent management designs, fed with the same memory requests as the simulated one.
+ * @details
+ * Each model keeps its own remapping of data segments between fast and slow memories, and moves segments the moment it decides to,
+ * without queues, swapping or any other timing. None of them influences the simulation.
+ * At the end of every epoch, each model reports the fraction of requests it would have served from fast memory,
+ * the traffic its migrations would have caused and the size of its remapping tables, which ranks the designs before running each of them in timing.
+ */
+class SHADOW_MANAGEMENT
+{
+public:
+    struct Statistics
+    {
+        uint64_t accesses                   = 0;
+        uint64_t fast_memory_hits           = 0;
+        uint64_t migrations                 = 0; // Number of segment swaps
+        uint64_t migration_traffic_in_bytes = 0;
+    };
+
+    /**
+     * @brief A management design that moves data segments between fast and slow memories.
+     * @note Segments are mapped to the hardware segment of the same number until they are swapped.
+     */
+    class Policy
+    {
+    public:
+        const std::string name;
+        Statistics epoch; // Since the beginning of this epoch
+        Statistics total; // Over the epochs outside warmup
+
+        Policy(std::string name_, uint8_t offset_bits_, uint64_t max_address, uint64_t fast_memory_max_address);
+        virtual ~Policy() = default;
+
+        // Adress is physical address and at byte granularity
+        void access(uint64_t address);
+
+        // Decide the migrations that are made once per epoch
+        virtual void end_epoch() {};
+
+        /** @return Bytes used by the remapping tables and the hotness tracking */
+        virtual std::size_t footprint() const;
+
+        /** @return Number of segments that are not in their original hardware segment */
+        std::size_t remapped_segments() const { return address_remapping_table.size(); };
+
+    protected:
+        const uint8_t offset_bits; // Address format in the data management granularity
+        const uint64_t total_capacity_at_granularity;
+        const uint64_t fast_memory_capacity_at_granularity;
+
+        SparseRemappingTable address_remapping_table;        // Physical segment -> hardware segment
+        SparseRemappingTable invert_address_remapping_table; // Hardware segment -> physical segment
+
+        // Track an access to a physical segment, which is in hardware segment h_segment
+        virtual void track(uint64_t p_segment, uint64_t h_segment) = 0;
+
+        // Exchange the hardware segments of two physical segments
+        void swap(uint64_t p_segment, uint64_t p_segment2);
+    };
+
+    SHADOW_MANAGEMENT(uint64_t max_address, uint64_t fast_memory_max_address);
+    ~SHADOW_MANAGEMENT();
+
+    // Adress is physical address and at byte granularity
+    void memory_activity_tracking(uint64_t address, champsim::chrono::clock::time_point time, bool warmup);
+
+private:
+    std::vector<std::unique_ptr<Policy>> policies;
+
+    const champsim::chrono::clock::duration epoch_length;
+    champsim::chrono::clock::time_point next_epoch {};
+    bool started         = false;
+    bool warmup_of_epoch = true;
+    uint32_t epochs      = 0; // Epochs outside warmup
+
+    void end_epoch(bool warmup);
+};
+
+#endif /* SHADOW_OS_TRANSPARENT_MANAGEMENT */
+
+#endif /* SHADOW_MANAGEMENT_H */
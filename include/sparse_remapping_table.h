@@ -0,0 +1,53 @@
+#ifndef SPARSE_REMAPPING_TABLE_H
+#define SPARSE_REMAPPING_TABLE_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "ChampSim/msl/flat_hash_table.h"
+
+/**
+ * @brief An address remapping table that maps every address to itself unless it was remapped.
+ * @details
+ * Only remapped entries are stored, in a champsim::msl::flat_hash_table,
+ * so the footprint follows the number of remapped segments instead of the memory capacity.
+ * Remapping an address back to itself removes its entry.
+ */
+class SparseRemappingTable
+{
+public:
+    explicit SparseRemappingTable(std::size_t initial_capacity = 1024): table(initial_capacity) {};
+
+    /** @return The address that key is remapped to, or key itself if it is not remapped. */
+    uint64_t lookup(uint64_t key) const { return table.value_or(key, key); };
+
+    void remap(uint64_t key, uint64_t value)
+    {
+        if (key == value)
+        {
+            table.erase(key);
+        }
+        else
+        {
+            table.insert_or_assign(key, value);
+        }
+    };
+
+    /** @return Number of remapped addresses */
+    std::size_t size() const { return table.size(); };
+
+    /** @return Bytes used by the table entries */
+    std::size_t footprint() const { return table.footprint(); };
+
+    /** @brief Save or restore the table through a champsim::checkpoint_archive */
+    template<typename Archive>
+    void checkpoint(Archive& archive)
+    {
+        table.checkpoint(archive);
+    };
+
+private:
+    champsim::msl::flat_hash_table table;
+};
+
+#endif /* SPARSE_REMAPPING_TABLE_H */
@@ -4,13 +4,16 @@
 #include <cassert>
 #include <cstdlib>
 #include <deque>
+#include <functional>
 #include <iostream>
 #include <map>
 #include <vector>
 
 #include "ChampSim/champsim_constants.h"
+#include "ChampSim/checkpoint.h"
 #include "ChampSim/util/bits.h"
 #include "ProjectConfiguration.h" // User file
+#include "remapping_request_queue.h"
 
 /** @note Abbreviation:
  *  FM -> Fast memory (e.g., HBM, DDR4)
@@ -77,7 +80,8 @@ public:
         uint8_t size; // Number of cache lines to remap
     };
 
-    std::deque<RemappingRequest> remapping_request_queue;
+    RemappingRequestQueue<RemappingRequest> remapping_request_queue {REMAPPING_REQUEST_QUEUE_LENGTH};
+    using RemappingRequestHandle = RemappingRequestQueue<RemappingRequest>::handle_type;
     uint64_t remapping_request_queue_congestion;
 
     // Scoped enumerations
@@ -196,11 +200,19 @@ public:
     void physical_to_hardware_address(uint64_t& address);
 
     bool issue_remapping_request(RemappingRequest& remapping_request);
-    bool finish_remapping_request();
+    bool finish_remapping_request(RemappingRequestHandle handle = RemappingRequestQueue<RemappingRequest>::FRONT);
+
+    // Start a remapping request for one of several swapping engines, the first that can_start accepts
+    bool issue_remapping_request(RemappingRequest& remapping_request, RemappingRequestHandle& handle, const std::function<bool(const RemappingRequest&)>& can_start);
+    // Get a started remapping request, which may be updated (e.g., enlarged) while it is swapped
+    void get_remapping_request(RemappingRequestHandle handle, RemappingRequest& remapping_request);
 
     // Detect cold data block
     void cold_data_detection();
 
+    // Save or restore the hotness tracking, the access distributions and the placement table, without the remapping requests in flight
+    void checkpoint(champsim::checkpoint_archive& archive);
+
 private:
 #if (COLD_DATA_DETECTION_IN_GROUP == ENABLE)
     // Detect cold data block in group
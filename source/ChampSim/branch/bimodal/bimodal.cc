@@ -1,5 +1,9 @@
 #include "ChampSim/branch/bimodal/bimodal.h"
 
+#if (USER_CODES == ENABLE)
+#include "ChampSim/checkpoint.h"
+#endif /* USER_CODES */
+
 bool bimodal::predict_branch(champsim::address ip)
 {
     auto value = bimodal_table[hash(ip)];
@@ -10,3 +14,10 @@ void bimodal::last_branch_result(champsim::address ip, champsim::address branch_
 {
     bimodal_table[hash(ip)] += taken ? 1 : -1;
 }
+
+#if (USER_CODES == ENABLE)
+void bimodal::branch_predictor_checkpoint(champsim::checkpoint_archive& archive)
+{
+    archive(bimodal_table);
+}
+#endif /* USER_CODES */
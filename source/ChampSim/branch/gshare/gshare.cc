@@ -1,5 +1,9 @@
 #include "ChampSim/branch/gshare/gshare.h"
 
+#if (USER_CODES == ENABLE)
+#include "ChampSim/checkpoint.h"
+#endif /* USER_CODES */
+
 std::size_t gshare::gs_table_hash(champsim::address ip, std::bitset<GLOBAL_HISTORY_LENGTH> bh_vector)
 {
     constexpr champsim::data::bits LOG2_HISTORY_TABLE_SIZE {champsim::lg2(GS_HISTORY_TABLE_SIZE)};
@@ -29,3 +33,10 @@ void gshare::last_branch_result(champsim::address ip, champsim::address branch_t
     branch_history_vector <<= 1;
     branch_history_vector[0] = taken;
 }
+
+#if (USER_CODES == ENABLE)
+void gshare::branch_predictor_checkpoint(champsim::checkpoint_archive& archive)
+{
+    archive(branch_history_vector, gs_history_table);
+}
+#endif /* USER_CODES */
@@ -49,6 +49,10 @@ sources for you to plagiarize.
 
 #include <numeric>
 
+#if (USER_CODES == ENABLE)
+#include "ChampSim/checkpoint.h"
+#endif /* USER_CODES */
+
 bool hashed_perceptron::predict_branch(champsim::address pc)
 {
     auto get_index = [pc_slice = pc.slice_lower<TABLE_INDEX_BITS>().to<uint64_t>()](const auto& hist)
@@ -109,3 +113,10 @@ void hashed_perceptron::adjust_threshold(bool correct)
         }
     }
 }
+
+#if (USER_CODES == ENABLE)
+void hashed_perceptron::branch_predictor_checkpoint(champsim::checkpoint_archive& archive)
+{
+    archive(tables, ghist_words, theta, tc);
+}
+#endif /* USER_CODES */
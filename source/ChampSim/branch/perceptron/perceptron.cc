@@ -40,6 +40,10 @@
 
 #include <cmath>
 
+#if (USER_CODES == ENABLE)
+#include "ChampSim/checkpoint.h"
+#endif /* USER_CODES */
+
 bool perceptron::predict_branch(champsim::address ip)
 {
     // hash the address to get an index into the table of perceptrons
@@ -88,3 +92,17 @@ void perceptron::last_branch_result(champsim::address ip, champsim::address bran
         perceptrons[index].update(taken, history);
     }
 }
+
+#if (USER_CODES == ENABLE)
+void perceptron::branch_predictor_checkpoint(champsim::checkpoint_archive& archive)
+{
+    archive(perceptrons, global_history);
+
+    // Predictions in flight are not checkpointed, so the speculative history restarts from the real one
+    if (archive.loading())
+    {
+        spec_global_history = global_history;
+        perceptron_state_buf.clear();
+    }
+}
+#endif /* USER_CODES */
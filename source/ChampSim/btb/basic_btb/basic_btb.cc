@@ -10,6 +10,10 @@
 
 #include "ChampSim/instruction.h"
 
+#if (USER_CODES == ENABLE)
+#include "ChampSim/checkpoint.h"
+#endif /* USER_CODES */
+
 std::pair<champsim::address, bool> basic_btb::btb_prediction(champsim::address ip)
 {
     // use BTB for all other branches + direct calls
@@ -46,3 +50,10 @@ void basic_btb::update_btb(champsim::address ip, champsim::address branch_target
 
     direct.update(ip, branch_target, branch_type);
 }
+
+#if (USER_CODES == ENABLE)
+void basic_btb::btb_checkpoint(champsim::checkpoint_archive& archive)
+{
+    archive(ras, indirect, direct);
+}
+#endif /* USER_CODES */
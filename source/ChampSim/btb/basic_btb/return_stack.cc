@@ -1,5 +1,9 @@
 #include "ChampSim/btb/basic_btb/return_stack.h"
 
+#if (USER_CODES == ENABLE)
+#include <atomic>
+#endif /* USER_CODES */
+
 std::pair<champsim::address, bool> return_stack::prediction()
 {
     if (std::empty(stack))
@@ -27,7 +31,11 @@ void return_stack::calibrate_call_size(champsim::address branch_target)
         auto call_ip = stack.back();
         stack.pop_back();
 
+#if (USER_CODES == ENABLE)
+        static std::atomic<int> num_times_returned_backwards = 0; // Shared by the cores, which may operate on different threads
+#else
         static int num_times_returned_backwards = 0;
+#endif /* USER_CODES */
         if (call_ip > branch_target && num_times_returned_backwards < 10)
         {
             ++num_times_returned_backwards;
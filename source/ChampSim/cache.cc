@@ -38,6 +38,7 @@
 
 #if (USER_CODES == ENABLE)
 #include "ChampSim/champsim_constants.h"
+#include "ChampSim/checkpoint.h"
 #include "ChampSim/util/bit_enum.h"
 #else
 #include "ChampSim/champsim.h"
@@ -47,7 +48,11 @@ CACHE::CACHE(CACHE&& other)
 : operable(other),
   upper_levels(std::move(other.upper_levels)), lower_level(std::move(other.lower_level)), lower_translate(std::move(other.lower_translate)),
   cpu(other.cpu), NAME(std::move(other.NAME)), NUM_SET(other.NUM_SET), NUM_WAY(other.NUM_WAY), MSHR_SIZE(other.MSHR_SIZE), PQ_SIZE(other.PQ_SIZE),
-  HIT_LATENCY(other.HIT_LATENCY), FILL_LATENCY(other.FILL_LATENCY), OFFSET_BITS(other.OFFSET_BITS), block(std::move(other.block)), MAX_TAG(other.MAX_TAG),
+  HIT_LATENCY(other.HIT_LATENCY), FILL_LATENCY(other.FILL_LATENCY), OFFSET_BITS(other.OFFSET_BITS), block(std::move(other.block)),
+#if (CACHE_SOA_TAG_STORE == ENABLE)
+  tags(std::move(other.tags)),
+#endif /* CACHE_SOA_TAG_STORE */
+  MAX_TAG(other.MAX_TAG),
   MAX_FILL(other.MAX_FILL), prefetch_as_load(other.prefetch_as_load), match_offset_bits(other.match_offset_bits), virtual_prefetch(other.virtual_prefetch),
   pref_activate_mask(std::move(other.pref_activate_mask)),
   sim_stats(std::move(other.sim_stats)), roi_stats(std::move(other.roi_stats)),
@@ -80,6 +85,9 @@ auto CACHE::operator=(CACHE&& other) -> CACHE&
     this->OFFSET_BITS  = other.OFFSET_BITS;
     ;
     this->block              = std::move(other.block);
+#if (CACHE_SOA_TAG_STORE == ENABLE)
+    this->tags = std::move(other.tags);
+#endif /* CACHE_SOA_TAG_STORE */
     this->MAX_TAG            = other.MAX_TAG;
     this->MAX_FILL           = other.MAX_FILL;
     this->prefetch_as_load   = other.prefetch_as_load;
@@ -113,8 +121,8 @@ CACHE::fill_type::fill_type(const tag_lookup_type& req, champsim::chrono::clock:
 
 CACHE::fill_type CACHE::fill_type::merge(fill_type predecessor, fill_type successor)
 {
-    std::vector<uint64_t> merged_instr {};
-    std::vector<std::deque<response_type>*> merged_return {};
+    champsim::dependent_instructions merged_instr {};
+    champsim::response_queues<response_type> merged_return {};
 
     std::set_union(std::begin(predecessor.instr_depend_on_me), std::end(predecessor.instr_depend_on_me), std::begin(successor.instr_depend_on_me), std::end(successor.instr_depend_on_me), std::back_inserter(merged_instr));
     std::set_union(std::begin(predecessor.to_return), std::end(predecessor.to_return), std::begin(successor.to_return), std::end(successor.to_return), std::back_inserter(merged_return));
@@ -179,6 +187,10 @@ auto CACHE::matches_address(champsim::address addr) const
     };
 }
 
+#if (USER_CODES == ENABLE)
+uint64_t CACHE::get_tag(champsim::address address) const { return address.slice_upper(OFFSET_BITS).to<uint64_t>(); }
+#endif /* USER_CODES */
+
 template<typename T>
 champsim::address CACHE::module_address(const T& element) const
 {
@@ -192,8 +204,12 @@ bool CACHE::handle_fill(const fill_type& fill)
 
     // find victim
     auto [set_begin, set_end] = get_set_span(fill.address);
+#if (CACHE_SOA_TAG_STORE == ENABLE)
+    auto way = std::next(set_begin, tags.find_invalid(get_set_index(fill.address)));
+#else
     auto way                  = std::find_if_not(set_begin, set_end, [](auto x)
                          { return x.valid; });
+#endif /* CACHE_SOA_TAG_STORE */
     if (way == set_end)
     {
         way = std::next(set_begin, impl_find_victim(fill.cpu, fill.instr_id, get_set_index(fill.address), &*set_begin, fill.ip, fill.address, fill.type));
@@ -280,6 +296,9 @@ bool CACHE::handle_fill(const fill_type& fill)
         }
 
         *way = fill_block(fill, metadata_thru);
+#if (CACHE_SOA_TAG_STORE == ENABLE)
+        tags.fill(get_set_index(fill.address), way_idx, get_tag(fill.address));
+#endif /* CACHE_SOA_TAG_STORE */
     }
 
     // COLLECT STATS
@@ -304,8 +323,12 @@ bool CACHE::try_hit(const tag_lookup_type& handle_pkt)
 
     // access cache
     auto [set_begin, set_end]  = get_set_span(handle_pkt.address);
+#if (CACHE_SOA_TAG_STORE == ENABLE)
+    auto way = std::next(set_begin, tags.find(get_set_index(handle_pkt.address), get_tag(handle_pkt.address)));
+#else
     auto way                   = std::find_if(set_begin, set_end, [matcher = matches_address(handle_pkt.address)](const auto& x)
                           { return x.valid && matcher(x); });
+#endif /* CACHE_SOA_TAG_STORE */
 
     const auto hit             = (way != set_end);
     const auto useful_prefetch = (hit && way->prefetch && ! handle_pkt.prefetch_from_this);
@@ -406,13 +429,13 @@ bool CACHE::handle_miss(const tag_lookup_type& handle_pkt)
     auto mshr_pkt   = mshr_and_forward_packet(handle_pkt);
 
     // check mshr
-    auto fill_entry = std::find_if(std::begin(MSHR), std::end(MSHR), matches_address(handle_pkt.address));
+    auto fill_entry = find_mshr(handle_pkt.address);
     bool mshr_full  = (MSHR.size() == MSHR_SIZE);
 
     // check inflight fills
     if (fill_entry == MSHR.end())
     {
-        fill_entry = std::find_if(inflight_fills.begin(), inflight_fills.end(), matches_address(handle_pkt.address));
+        fill_entry = find_inflight_fill(handle_pkt.address);
     }
 
     if (fill_entry != inflight_fills.end()) // miss or fill already inflight
@@ -450,7 +473,7 @@ bool CACHE::handle_miss(const tag_lookup_type& handle_pkt)
         // Allocate an MSHR
         if (mshr_pkt.second.response_requested)
         {
-            MSHR.emplace_back(std::move(mshr_pkt.first));
+            push_mshr(std::move(mshr_pkt.first));
         }
     }
 
@@ -478,7 +501,7 @@ bool CACHE::handle_write(const tag_lookup_type& handle_pkt)
 
     fill_type to_allocate {handle_pkt, current_time};
     to_allocate.data_promise.ready_at(current_time + (warmup ? champsim::chrono::clock::duration {} : FILL_LATENCY));
-    inflight_fills.push_back(to_allocate);
+    push_inflight_fill(to_allocate);
 
     sim_stats.misses.increment(std::pair {handle_pkt.type, handle_pkt.cpu});
 
@@ -558,7 +581,7 @@ long CACHE::operate()
     auto complete_end           = std::find_if_not(fill_begin, fill_end, [this](const auto& x)
                   { return this->handle_fill(x); });
     fill_bw.consume(std::distance(fill_begin, complete_end));
-    inflight_fills.erase(fill_begin, complete_end);
+    pop_inflight_fills(static_cast<std::size_t>(std::distance(fill_begin, complete_end)));
 
     // Initiate tag checks
     const champsim::bandwidth::maximum_type bandwidth_from_tag_checks {champsim::to_underlying(MAX_TAG) * (long) (HIT_LATENCY / clock_period) - (long) std::size(inflight_tag_check)};
@@ -570,7 +593,11 @@ long CACHE::operate()
 
     auto stash_bandwidth_consumed = champsim::transform_while_n(translation_stash, std::back_inserter(inflight_tag_check), initiate_tag_bw, is_translated, initiate_tag_check<false>());
     initiate_tag_bw.consume(stash_bandwidth_consumed);
+#if (USER_CODES == ENABLE) && (INSTRUCTION_INLINE_STORAGE == ENABLE)
+    channels_bandwidth_consumed.clear();
+#else
     std::vector<long long> channels_bandwidth_consumed {};
+#endif /* USER_CODES, INSTRUCTION_INLINE_STORAGE */
 
     if (std::size(upper_levels) > 1)
     {
@@ -622,9 +649,15 @@ long CACHE::operate()
     auto [tag_check_ready_begin, tag_check_ready_end] = champsim::get_span_p(std::begin(inflight_tag_check), std::end(inflight_tag_check), tag_check_bw,
         [is_ready, is_translated](const auto& pkt)
         { return is_ready(pkt) && is_translated(pkt); });
+#if (USER_CODES == ENABLE) && (INSTRUCTION_INLINE_STORAGE == ENABLE)
+    auto hits_end                                     = champsim::stable_partition(tag_check_ready_begin, tag_check_ready_end, [this](const auto& pkt)
+                                            { return this->try_hit(pkt); }, partition_buffer);
+    auto finish_tag_check_end                         = champsim::stable_partition(hits_end, tag_check_ready_end, do_handle_miss, partition_buffer);
+#else
     auto hits_end                                     = std::stable_partition(tag_check_ready_begin, tag_check_ready_end, [this](const auto& pkt)
                                             { return this->try_hit(pkt); });
     auto finish_tag_check_end                         = std::stable_partition(hits_end, tag_check_ready_end, do_handle_miss);
+#endif /* USER_CODES, INSTRUCTION_INLINE_STORAGE */
     tag_check_bw.consume(std::distance(tag_check_ready_begin, finish_tag_check_end));
     inflight_tag_check.erase(tag_check_ready_begin, finish_tag_check_end);
 
@@ -658,6 +691,56 @@ long CACHE::operate()
     return progress + fill_bw.amount_consumed() + initiate_tag_bw.amount_consumed() + tag_check_bw.amount_consumed();
 }
 
+#if (EVENT_DRIVEN_SKIP_AHEAD == ENABLE)
+champsim::chrono::clock::time_point CACHE::next_event_time() const
+{
+    const auto next_cycle = current_time + clock_period;
+
+    auto has_request      = [](const channel_type* ul)
+    {
+        return ! std::empty(ul->RQ) || ! std::empty(ul->WQ) || ! std::empty(ul->PQ);
+    };
+    // Translations rejected by the lower level are reissued every cycle, translated entries in the stash wait only for tag check bandwidth
+    auto needs_translation = [](const tag_lookup_type& x)
+    {
+        return x.is_translated || ! x.translate_issued;
+    };
+    if (last_progress > 0 || pref_module_pimpl->impl_prefetcher_has_cycle_operate() || ! std::empty(lower_level->returned) || (lower_translate != nullptr && ! std::empty(lower_translate->returned)) || ! std::empty(internal_PQ) || std::any_of(std::begin(upper_levels), std::end(upper_levels), has_request) || std::any_of(std::begin(translation_stash), std::end(translation_stash), needs_translation))
+    {
+        return next_cycle;
+    }
+
+    // Tag checks and fills are retried every cycle once they are ready, since a rejected attempt updates the statistics
+    auto event_time = champsim::chrono::clock::time_point::max();
+    for (const auto& entry : inflight_tag_check)
+    {
+        if (! entry.is_translated && ! entry.translate_issued)
+        {
+            return next_cycle;
+        }
+        event_time = std::min(event_time, entry.event_cycle);
+    }
+
+    for (const auto& fill : inflight_fills)
+    {
+        event_time = std::min(event_time, fill.data_promise.ready_time());
+    }
+
+    return std::max(event_time, next_cycle);
+}
+
+long CACHE::skip_cycles(long cycles)
+{
+    // Keep the round-robin order of the upper levels as if operate() ran in every skipped cycle
+    if (std::size(upper_levels) > 1)
+    {
+        std::rotate(upper_levels.begin(), upper_levels.begin() + (cycles % static_cast<long>(std::size(upper_levels))), upper_levels.end());
+    }
+
+    return champsim::operable::skip_cycles(cycles);
+}
+#endif /* EVENT_DRIVEN_SKIP_AHEAD */
+
 // LCOV_EXCL_START exclude deprecated function
 uint64_t CACHE::get_set(uint64_t address) const { return static_cast<uint64_t>(get_set_index(champsim::address {address})); }
 
@@ -690,8 +773,12 @@ auto CACHE::get_set_span(champsim::address address) const -> std::pair<set_type:
 uint64_t CACHE::get_way(uint64_t address, uint64_t /*unused set index*/) const
 {
     champsim::address intern_addr {address};
+#if (CACHE_SOA_TAG_STORE == ENABLE)
+    return static_cast<uint64_t>(tags.find_any(get_set_index(intern_addr), get_tag(intern_addr)));
+#else
     auto [begin, end] = get_set_span(intern_addr);
     return static_cast<uint64_t>(std::distance(begin, std::find_if(begin, end, matches_address(champsim::address {address}))));
+#endif /* CACHE_SOA_TAG_STORE */
 }
 
 // LCOV_EXCL_STOP
@@ -699,11 +786,18 @@ uint64_t CACHE::get_way(uint64_t address, uint64_t /*unused set index*/) const
 long CACHE::invalidate_entry(champsim::address inval_addr)
 {
     auto [begin, end] = get_set_span(inval_addr);
+#if (CACHE_SOA_TAG_STORE == ENABLE)
+    auto inv_way = std::next(begin, tags.find_any(get_set_index(inval_addr), get_tag(inval_addr)));
+#else
     auto inv_way      = std::find_if(begin, end, matches_address(inval_addr));
+#endif /* CACHE_SOA_TAG_STORE */
 
     if (inv_way != end)
     {
         inv_way->valid = false;
+#if (CACHE_SOA_TAG_STORE == ENABLE)
+        tags.invalidate(get_set_index(inval_addr), std::distance(begin, inv_way));
+#endif /* CACHE_SOA_TAG_STORE */
     }
 
     return std::distance(begin, inv_way);
@@ -748,7 +842,7 @@ bool CACHE::prefetch_line(uint64_t /*deprecated*/, uint64_t /*deprecated*/, uint
 void CACHE::finish_packet(const response_type& packet)
 {
     // check MSHR information
-    auto mshr_entry = std::find_if(std::begin(MSHR), std::end(MSHR), matches_address(packet.address));
+    auto mshr_entry = find_mshr(packet.address);
 
     // sanity check
     if (mshr_entry == MSHR.end())
@@ -782,8 +876,99 @@ void CACHE::finish_packet(const response_type& packet)
 #endif /* PRINT_STATISTICS_INTO_FILE */
     }
 
-    std::iter_swap(mshr_entry, std::begin(MSHR));
-    inflight_fills.push_back(MSHR.front());
+    retire_mshr(mshr_entry);
+}
+
+auto CACHE::find_mshr(champsim::address address) -> champsim::packet_queue<fill_type>::iterator
+{
+#if (CACHE_INDEXED_MSHR == ENABLE)
+    const uint64_t number = mshr_index.value_or(get_tag(address), NOT_INDEXED);
+    if (number == NOT_INDEXED)
+    {
+        return std::end(MSHR);
+    }
+    return std::next(std::begin(MSHR), static_cast<long>(number - mshr_removed));
+#else
+    return std::find_if(std::begin(MSHR), std::end(MSHR), matches_address(address));
+#endif /* CACHE_INDEXED_MSHR */
+}
+
+auto CACHE::find_inflight_fill(champsim::address address) -> champsim::packet_queue<fill_type>::iterator
+{
+#if (CACHE_INDEXED_MSHR == ENABLE)
+    const uint64_t number = inflight_fill_index.value_or(get_tag(address), NOT_INDEXED);
+    if (number == NOT_INDEXED)
+    {
+        return std::end(inflight_fills);
+    }
+    return std::next(std::begin(inflight_fills), static_cast<long>(number - inflight_fills_removed));
+#else
+    return std::find_if(std::begin(inflight_fills), std::end(inflight_fills), matches_address(address));
+#endif /* CACHE_INDEXED_MSHR */
+}
+
+void CACHE::push_mshr(fill_type fill)
+{
+#if (CACHE_INDEXED_MSHR == ENABLE)
+    const bool inserted = mshr_index.try_emplace(get_tag(fill.address), mshr_removed + std::size(MSHR)).second;
+    assert(inserted); // Misses to a block in the MSHR are merged into its entry
+    (void) inserted;
+#endif /* CACHE_INDEXED_MSHR */
+    MSHR.push_back(std::move(fill));
+}
+
+void CACHE::push_inflight_fill(const fill_type& fill)
+{
+#if (CACHE_INDEXED_MSHR == ENABLE)
+    const uint64_t tag = get_tag(fill.address);
+    inflight_fill_index.try_emplace(tag, inflight_fills_removed + std::size(inflight_fills));
+    inflight_fill_count.insert_or_assign(tag, inflight_fill_count.value_or(tag, 0) + 1);
+#endif /* CACHE_INDEXED_MSHR */
+    inflight_fills.push_back(fill);
+}
+
+void CACHE::pop_inflight_fills(std::size_t count)
+{
+#if (CACHE_INDEXED_MSHR == ENABLE)
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const champsim::address address = inflight_fills.front().address;
+        const uint64_t tag              = get_tag(address);
+        const uint64_t remaining        = inflight_fill_count.value_or(tag, 0) - 1;
+        inflight_fills.pop_front();
+        inflight_fills_removed++;
+
+        if (remaining == 0)
+        {
+            inflight_fill_index.erase(tag);
+            inflight_fill_count.erase(tag);
+        }
+        else
+        {
+            // Several fills of the block are in flight, which is rare, so search for the next oldest
+            auto next = std::find_if(std::begin(inflight_fills), std::end(inflight_fills), matches_address(address));
+            inflight_fill_index.insert_or_assign(tag, inflight_fills_removed + static_cast<uint64_t>(std::distance(std::begin(inflight_fills), next)));
+            inflight_fill_count.insert_or_assign(tag, remaining);
+        }
+    }
+#else
+    inflight_fills.erase(std::begin(inflight_fills), std::next(std::begin(inflight_fills), static_cast<long>(count)));
+#endif /* CACHE_INDEXED_MSHR */
+}
+
+void CACHE::retire_mshr(champsim::packet_queue<fill_type>::iterator entry)
+{
+    std::iter_swap(entry, std::begin(MSHR));
+#if (CACHE_INDEXED_MSHR == ENABLE)
+    // The entry that was at the front takes the place of the retired one
+    mshr_index.erase(get_tag(MSHR.front().address));
+    if (entry != std::begin(MSHR))
+    {
+        mshr_index.insert_or_assign(get_tag(entry->address), mshr_removed + static_cast<uint64_t>(std::distance(std::begin(MSHR), entry)));
+    }
+    mshr_removed++;
+#endif /* CACHE_INDEXED_MSHR */
+    push_inflight_fill(MSHR.front());
     MSHR.pop_front();
 }
 
@@ -817,7 +1002,11 @@ void CACHE::finish_translation(const response_type& packet)
     // Restart stashed translations
     auto finish_begin = std::find_if_not(std::begin(translation_stash), std::end(translation_stash), [](const auto& x)
         { return x.is_translated; });
+#if (USER_CODES == ENABLE) && (INSTRUCTION_INLINE_STORAGE == ENABLE)
+    auto finish_end   = champsim::stable_partition(finish_begin, std::end(translation_stash), matches_vpage, partition_buffer);
+#else
     auto finish_end   = std::stable_partition(finish_begin, std::end(translation_stash), matches_vpage);
+#endif /* USER_CODES, INSTRUCTION_INLINE_STORAGE */
     std::for_each(finish_begin, finish_end, mark_translated);
 
     // Find all packets that match the page of the returned packet
@@ -1029,6 +1218,115 @@ void CACHE::initialize()
     impl_initialize_replacement();
 }
 
+#if (USER_CODES == ENABLE)
+void CACHE::checkpoint(champsim::checkpoint_archive& archive)
+{
+    archive.section(NAME);
+    archive.expect(NUM_SET, "number of sets");
+    archive.expect(NUM_WAY, "number of ways");
+
+    archive(block);
+#if (CACHE_SOA_TAG_STORE == ENABLE)
+    if (archive.loading())
+    {
+        for (std::size_t index = 0; index < std::size(block); ++index)
+        {
+            const auto set = static_cast<long>(index / NUM_WAY);
+            const auto way = static_cast<long>(index % NUM_WAY);
+            tags.fill(set, way, get_tag(block[index].address));
+            if (! block[index].valid)
+            {
+                tags.invalidate(set, way);
+            }
+        }
+    }
+#endif /* CACHE_SOA_TAG_STORE */
+    repl_module_pimpl->impl_replacement_checkpoint(archive);
+    pref_module_pimpl->impl_prefetcher_checkpoint(archive);
+}
+#endif /* USER_CODES */
+
+#if (USER_CODES == ENABLE) && (FUNCTIONAL_WARMUP == ENABLE)
+std::optional<champsim::address> CACHE::functional_hit(uint32_t triggering_cpu, champsim::address address, champsim::address v_address, champsim::address ip, access_type type)
+{
+    cpu                       = triggering_cpu;
+
+    BLOCK lookup;
+    lookup.address            = address;
+    lookup.v_address          = v_address;
+
+    auto [set_begin, set_end] = get_set_span(address);
+#if (CACHE_SOA_TAG_STORE == ENABLE)
+    auto way = std::next(set_begin, tags.find(get_set_index(address), get_tag(address)));
+#else
+    auto way                  = std::find_if(set_begin, set_end, [matcher = matches_address(address)](const auto& x)
+                         { return x.valid && matcher(x); });
+#endif /* CACHE_SOA_TAG_STORE */
+
+    const auto hit = (way != set_end);
+    impl_update_replacement_state(triggering_cpu, get_set_index(address), std::distance(set_begin, way), module_address(lookup), ip, {}, type, hit);
+
+    if (! hit)
+    {
+        return std::nullopt;
+    }
+
+    way->dirty |= (type == access_type::WRITE);
+    way->prefetch = false;
+    return way->data;
+}
+
+auto CACHE::functional_fill(uint32_t triggering_cpu, champsim::address address, champsim::address v_address, champsim::address data, champsim::address ip, access_type type) -> std::optional<BLOCK>
+{
+    cpu = triggering_cpu;
+
+    BLOCK to_fill;
+    to_fill.valid             = true;
+    to_fill.dirty             = (type == access_type::WRITE);
+    to_fill.address           = address;
+    to_fill.v_address         = v_address;
+    to_fill.data              = data;
+
+    auto [set_begin, set_end] = get_set_span(address);
+    const auto set            = get_set_index(address);
+#if (CACHE_SOA_TAG_STORE == ENABLE)
+    auto way = std::next(set_begin, tags.find_invalid(set));
+#else
+    auto way                  = std::find_if_not(set_begin, set_end, [](auto x)
+                         { return x.valid; });
+#endif /* CACHE_SOA_TAG_STORE */
+    if (way == set_end)
+    {
+        way = std::next(set_begin, impl_find_victim(triggering_cpu, 0, set, &*set_begin, ip, address, type));
+    }
+    assert(way != set_end || type != access_type::WRITE); // Writes may not bypass
+
+    const auto way_idx = std::distance(set_begin, way);
+    std::optional<BLOCK> writeback;
+    champsim::address evicting_address {};
+    if (way != set_end && way->valid)
+    {
+        evicting_address = module_address(*way);
+        if (way->dirty)
+        {
+            writeback = *way;
+        }
+    }
+
+    impl_replacement_cache_fill(triggering_cpu, set, way_idx, module_address(to_fill), ip, evicting_address, type);
+
+    if (way != set_end)
+    {
+        *way = to_fill;
+#if (CACHE_SOA_TAG_STORE == ENABLE)
+        tags.fill(set, way_idx, get_tag(address));
+#endif /* CACHE_SOA_TAG_STORE */
+    }
+
+    return writeback;
+}
+#endif /* USER_CODES, FUNCTIONAL_WARMUP */
+
 void CACHE::begin_phase()
 {
     stats_type new_roi_stats;
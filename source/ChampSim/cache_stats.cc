@@ -15,3 +15,22 @@ cache_stats operator-(cache_stats lhs, cache_stats rhs)
     result.total_miss_latency_cycles = lhs.total_miss_latency_cycles - rhs.total_miss_latency_cycles;
     return result;
 }
+
+#if (USER_CODES == ENABLE) && (SAMPLED_SIMULATION == ENABLE)
+cache_stats operator+(cache_stats lhs, cache_stats rhs)
+{
+    lhs.pf_requested += rhs.pf_requested;
+    lhs.pf_issued += rhs.pf_issued;
+    lhs.pf_useful += rhs.pf_useful;
+    lhs.pf_useless += rhs.pf_useless;
+    lhs.pf_fill += rhs.pf_fill;
+
+    lhs.hits += rhs.hits;
+    lhs.misses += rhs.misses;
+    lhs.miss_merge += rhs.miss_merge;
+    lhs.fill += rhs.fill;
+
+    lhs.total_miss_latency_cycles += rhs.total_miss_latency_cycles;
+    return lhs;
+}
+#endif /* USER_CODES, SAMPLED_SIMULATION */
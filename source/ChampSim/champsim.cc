@@ -24,15 +24,25 @@
 #endif /* USE_VCPKG */
 
 #include <algorithm>
+#include <cassert>
 #include <chrono>
+#include <memory>
 #include <numeric>
+#include <utility>
 
+#include "ChampSim/cycle_engine.h"
 #include "ChampSim/environment.h"
 #include "ChampSim/event_listeners.h"
+#include "ChampSim/functional_warmup.h"
 #include "ChampSim/ooo_cpu.h"
 #include "ChampSim/operable.h"
+#include "ChampSim/telemetry.h"
 #include "ChampSim/tracereader.h"
 
+#if (USER_CODES == ENABLE) && (SAMPLED_SIMULATION == ENABLE)
+#include <array>
+#endif /* USER_CODES, SAMPLED_SIMULATION */
+
 #if (USER_CODES == DISABLE)
 #include "ChampSim/phase_info.h"
 #endif /* USER_CODES */
@@ -46,22 +56,109 @@ std::chrono::seconds elapsed_time() { return std::chrono::duration_cast<std::chr
 namespace champsim
 {
 
-long do_cycle(environment& env, std::vector<tracereader>& traces, std::vector<std::size_t> trace_index, champsim::chrono::clock& global_clock)
+#if (EVENT_DRIVEN_SKIP_AHEAD == ENABLE)
+/**
+ * @brief Jump over the cycles in which no operable has any work to do, all operables must be clocked by time_quantum.
+ * @param max_cycles The most cycles to skip.
+ * @return The number of skipped cycles and the progress the operables would have reported over them.
+ */
+std::pair<long, long> skip_idle_cycles(const operable_schedule::operable_list& operables, champsim::chrono::clock& global_clock, champsim::chrono::clock::duration time_quantum, long max_cycles)
 {
-    auto operables = env.operable_view();
-    std::sort(std::begin(operables), std::end(operables),
-        [](const champsim::operable& lhs, const champsim::operable& rhs)
-        { return lhs.current_time < rhs.current_time; });
+    const auto now        = global_clock.now();
+    auto event_time       = champsim::chrono::clock::time_point::max();
+    for (champsim::operable& op : operables)
+    {
+        event_time = std::min(event_time, op.next_event_time());
+        if (event_time <= now + time_quantum)
+        {
+            return {0, 0};
+        }
+    }
+
+    // Every cycle before the earliest event is idle
+    const long idle_cycles = std::min(static_cast<long>((event_time - now - champsim::chrono::clock::duration {1}) / time_quantum), max_cycles);
+    if (idle_cycles <= 0)
+    {
+        return {0, 0};
+    }
+
+    global_clock.tick(time_quantum * idle_cycles);
 
-    // Operate
     long progress {0};
     for (champsim::operable& op : operables)
+    {
+        progress += op.skip_cycles(idle_cycles);
+    }
+
+    return {idle_cycles, progress};
+}
+#endif /* EVENT_DRIVEN_SKIP_AHEAD */
+
+#if (USER_CODES == ENABLE) && (USE_OPENMP == ENABLE) && (PARALLEL_CYCLE_ENGINE == ENABLE)
+/**
+ * @brief Build the engine that operates the CPUs' private operables on the threads given by --threads, up to one per CPU.
+ * Without --threads, it runs as many threads as OpenMP has, up to one per processor, since waiting threads would take turns with working ones.
+ */
+cycle_engine make_cycle_engine(environment& env)
+{
+    std::vector<cycle_engine::operable_list> private_operables {};
+    for (std::size_t cpu = 0; cpu < std::size(env.cpu_view()); ++cpu)
+    {
+        private_operables.push_back(env.private_operable_view(cpu));
+    }
+
+#ifndef NDEBUG
+    // Every private operable must come before the shared ones in operable_view()
+    std::vector<const champsim::operable*> private_addresses {};
+    for (const auto& ops : private_operables)
+    {
+        for (const champsim::operable& op : ops)
+        {
+            private_addresses.push_back(&op);
+        }
+    }
+    std::vector<const champsim::operable*> first_addresses {};
+    for (const champsim::operable& op : env.operable_view())
+    {
+        first_addresses.push_back(&op);
+    }
+    first_addresses.resize(std::min(std::size(first_addresses), std::size(private_addresses)));
+    assert(std::is_permutation(std::cbegin(private_addresses), std::cend(private_addresses), std::cbegin(first_addresses), std::cend(first_addresses)));
+#endif /* NDEBUG */
+
+    const int num_threads = (cycle_engine_threads > 0) ? cycle_engine_threads : std::min(omp_get_max_threads(), omp_get_num_procs());
+    return cycle_engine {std::move(private_operables), num_threads};
+}
+
+long do_cycle(operable_schedule& schedule, cycle_engine& engine, std::vector<std::reference_wrapper<O3_CPU>>& cpus, std::vector<tracereader>& traces, const std::vector<std::size_t>& trace_index, champsim::chrono::clock& global_clock)
+#else
+long do_cycle(operable_schedule& schedule, std::vector<std::reference_wrapper<O3_CPU>>& cpus, std::vector<tracereader>& traces, const std::vector<std::size_t>& trace_index, champsim::chrono::clock& global_clock)
+#endif /* USER_CODES, USE_OPENMP, PARALLEL_CYCLE_ENGINE */
+{
+    // Operables due at the same time keep their operable_view() order, so the order of operation is fully defined
+    schedule.update();
+
+    // Operate
+    long progress {0};
+#if (USER_CODES == ENABLE) && (USE_OPENMP == ENABLE) && (PARALLEL_CYCLE_ENGINE == ENABLE)
+    progress += engine.operate_private(schedule, global_clock);
+
+    // The cores retired before any shared operable was operated, as in the serial loop
+    for (O3_CPU& cpu : cpus)
+    {
+        cpu.flush_retire_events();
+    }
+
+    progress += engine.operate_shared(schedule, global_clock);
+#else
+    for (champsim::operable& op : schedule.operables())
     {
         progress += op.operate_on(global_clock);
     }
+#endif /* USER_CODES, USE_OPENMP, PARALLEL_CYCLE_ENGINE */
 
     // Read from trace
-    for (O3_CPU& cpu : env.cpu_view())
+    for (O3_CPU& cpu : cpus)
     {
         auto& trace = traces.at(trace_index.at(cpu.cpu));
         for (auto pkt_count = cpu.IN_QUEUE_SIZE - static_cast<long>(std::size(cpu.input_queue)); ! trace.eof() && pkt_count > 0; --pkt_count)
@@ -73,10 +170,92 @@ long do_cycle(environment& env, std::vector<tracereader>& traces, std::vector<st
     return progress;
 }
 
+#if (USER_CODES == ENABLE) && (FUNCTIONAL_WARMUP == ENABLE)
+/**
+ * @brief Warm up the system without timing, retiring one instruction of each CPU in turn.
+ * @details No cycle passes, so the phase only warms up the state that instructions leave behind (see O3_CPU::functional_retire() and champsim::functional_warmer).
+ */
+void do_functional_phase(const phase_info& phase, environment& env, std::vector<tracereader>& traces)
+{
+    auto operables = env.operable_view();
+    auto cpus      = env.cpu_view();
+
+    // Initialize phase
+    for (champsim::operable& op : operables)
+    {
+        op.warmup = true;
+        op.begin_phase();
+    }
+
+    functional_warmer warmer {env};
+    auto phase_complete = [&](const O3_CPU& cpu)
+    {
+        return cpu.sim_instr() >= phase.length;
+    };
+    auto any_eof = [&]()
+    {
+        return std::any_of(std::begin(traces), std::end(traces), [](const auto& tr)
+            { return tr.eof(); });
+    };
+
+    // Perform phase
+    while (! any_eof() && ! std::all_of(std::begin(cpus), std::end(cpus), phase_complete))
+    {
+        for (O3_CPU& cpu : cpus)
+        {
+            if (phase_complete(cpu))
+            {
+                continue;
+            }
+
+            // Instructions read ahead by a previous phase come first
+            if (std::empty(cpu.input_queue))
+            {
+                cpu.input_queue.push_back(traces.at(phase.trace_index.at(cpu.cpu))());
+            }
+            cpu.functional_retire(cpu.input_queue.front(), warmer);
+            cpu.input_queue.pop_front();
+        }
+    }
+
+    for (O3_CPU& cpu : cpus)
+    {
+        for (champsim::operable& op : operables)
+        {
+            op.end_phase(cpu.cpu);
+        }
+
+#if (USE_VCPKG == ENABLE)
+        fmt::print("{} complete CPU {} instructions: {} (Simulation time: {:%H hr %M min %S sec})\n", phase.name, cpu.cpu, cpu.sim_instr(), elapsed_time());
+#endif /* USE_VCPKG */
+
+#if (PRINT_STATISTICS_INTO_FILE == ENABLE)
+        std::fprintf(output_statistics.file_handler, "%s complete CPU %d instructions: %lld (Simulation time: {: %ld sec})\n",
+            phase.name.c_str(), cpu.cpu, cpu.sim_instr(), elapsed_time().count());
+#endif /* PRINT_STATISTICS_INTO_FILE */
+    }
+}
+#endif /* USER_CODES, FUNCTIONAL_WARMUP */
+
+#if (USER_CODES == ENABLE) && (TELEMETRY == ENABLE)
+phase_stats do_phase(const phase_info& phase, environment& env, std::vector<tracereader>& traces, champsim::chrono::clock& global_clock, telemetry::sampler* telemetry)
+#else
 phase_stats do_phase(const phase_info& phase, environment& env, std::vector<tracereader>& traces, champsim::chrono::clock& global_clock)
+#endif /* USER_CODES, TELEMETRY */
 {
     auto operables                                                 = env.operable_view();
+    auto& schedule                                                 = env.schedule();
+    auto cpus                                                      = env.cpu_view();
+#if (USER_CODES == ENABLE)
+    // Named members rather than a structured binding, since phase_info has more members with the user features
+    const auto& phase_name  = phase.name;
+    const auto is_warmup    = phase.is_warmup;
+    const auto length       = phase.length;
+    auto trace_index        = phase.trace_index;
+    const auto& trace_names = phase.trace_names;
+#else
     auto [phase_name, is_warmup, length, trace_index, trace_names] = phase;
+#endif /* USER_CODES */
 
     // Initialize phase
     for (champsim::operable& op : operables)
@@ -85,10 +264,33 @@ phase_stats do_phase(const phase_info& phase, environment& env, std::vector<trac
         op.begin_phase();
     }
 
+#if (USER_CODES == ENABLE) && (USE_OPENMP == ENABLE) && (PARALLEL_CYCLE_ENGINE == ENABLE)
+    auto engine = make_cycle_engine(env);
+    for (O3_CPU& cpu : cpus)
+    {
+        // The event listeners are shared, so cores operating concurrently hand their retire events to do_cycle()
+        cpu.defer_retire_events(engine.threads() > 1);
+    }
+#endif /* USER_CODES, USE_OPENMP, PARALLEL_CYCLE_ENGINE */
+
+#if (USER_CODES == ENABLE) && (TELEMETRY == ENABLE)
+    if (telemetry != nullptr)
+    {
+        telemetry->begin_phase(global_clock.now());
+    }
+#endif /* USER_CODES, TELEMETRY */
+
     const auto time_quantum = std::accumulate(std::cbegin(operables), std::cend(operables), champsim::chrono::clock::duration::max(),
         [](const auto acc, const operable& y)
         { return std::min(acc, y.clock_period); });
 
+#if (EVENT_DRIVEN_SKIP_AHEAD == ENABLE)
+    const bool lockstep_clocks = std::all_of(std::cbegin(operables), std::cend(operables), [time_quantum](const operable& op)
+        { return op.clock_period == time_quantum; });
+    uint64_t phase_cycles {0};
+    uint64_t skipped_cycles {0};
+#endif /* EVENT_DRIVEN_SKIP_AHEAD */
+
     bool livelock_trigger {false};
     uint64_t livelock_period {10000000};
     uint64_t livelock_timer {0};
@@ -96,15 +298,34 @@ phase_stats do_phase(const phase_info& phase, environment& env, std::vector<trac
     std::vector<double> livelock_threshold {0.01, 0.02, 0.05};
     std::vector<uint64_t> livelock_instr(std::size(env.cpu_view()), 0);
 
+#if (USER_CODES == ENABLE) && (USE_OPENMP == ENABLE) && (PARALLEL_CYCLE_ENGINE == ENABLE)
+    const auto phase_start_time  = std::chrono::steady_clock::now();
+    const auto phase_start_clock = global_clock.now();
+#endif /* USER_CODES, USE_OPENMP, PARALLEL_CYCLE_ENGINE */
+
     // Perform phase
     int stalled_cycle {0};
     std::vector<bool> phase_complete(std::size(env.cpu_view()), false);
+#if (USER_CODES == ENABLE) && (INSTRUCTION_INLINE_STORAGE == ENABLE)
+    auto next_phase_complete = phase_complete; // Assigned in each cycle rather than copied, so its storage is reused
+#endif /* USER_CODES, INSTRUCTION_INLINE_STORAGE */
     while (! std::accumulate(std::begin(phase_complete), std::end(phase_complete), true, std::logical_and {}))
     {
+#if (USER_CODES == ENABLE) && (INSTRUCTION_INLINE_STORAGE == ENABLE)
+        next_phase_complete = phase_complete;
+#else
         auto next_phase_complete = phase_complete;
+#endif /* USER_CODES, INSTRUCTION_INLINE_STORAGE */
         global_clock.tick(time_quantum);
 
-        auto progress = do_cycle(env, traces, trace_index, global_clock);
+#if (USER_CODES == ENABLE) && (USE_OPENMP == ENABLE) && (PARALLEL_CYCLE_ENGINE == ENABLE)
+        auto progress = do_cycle(schedule, engine, cpus, traces, trace_index, global_clock);
+#else
+        auto progress = do_cycle(schedule, cpus, traces, trace_index, global_clock);
+#endif /* USER_CODES, USE_OPENMP, PARALLEL_CYCLE_ENGINE */
+#if (EVENT_DRIVEN_SKIP_AHEAD == ENABLE)
+        ++phase_cycles;
+#endif /* EVENT_DRIVEN_SKIP_AHEAD */
 
         if (progress == 0)
         {
@@ -120,7 +341,7 @@ phase_stats do_phase(const phase_info& phase, environment& env, std::vector<trac
         if (livelock_timer >= livelock_period)
         {
             // for each cpu
-            for (O3_CPU& cpu : env.cpu_view())
+            for (O3_CPU& cpu : cpus)
             {
                 // for each threshold
                 for (auto thres = std::begin(livelock_threshold); thres != std::end(livelock_threshold); thres++)
@@ -168,6 +389,13 @@ phase_stats do_phase(const phase_info& phase, environment& env, std::vector<trac
             livelock_timer = 0;
         }
 
+#if (USER_CODES == ENABLE) && (TELEMETRY == ENABLE)
+        if (telemetry != nullptr)
+        {
+            telemetry->advance(1, global_clock.now());
+        }
+#endif /* USER_CODES, TELEMETRY */
+
         if (stalled_cycle >= DEADLOCK_CYCLE || livelock_trigger)
         {
             std::for_each(std::begin(operables), std::end(operables), [](champsim::operable& c)
@@ -183,13 +411,13 @@ phase_stats do_phase(const phase_info& phase, environment& env, std::vector<trac
         }
 
         // Check for phase finish
-        for (O3_CPU& cpu : env.cpu_view())
+        for (O3_CPU& cpu : cpus)
         {
             // Phase complete
             next_phase_complete[cpu.cpu] = next_phase_complete[cpu.cpu] || (cpu.sim_instr() >= length);
         }
 
-        for (O3_CPU& cpu : env.cpu_view())
+        for (O3_CPU& cpu : cpus)
         {
             if (next_phase_complete[cpu.cpu] != phase_complete[cpu.cpu])
             {
@@ -210,6 +438,32 @@ phase_stats do_phase(const phase_info& phase, environment& env, std::vector<trac
         }
 
         phase_complete = next_phase_complete;
+
+#if (EVENT_DRIVEN_SKIP_AHEAD == ENABLE)
+        // Stop short of the next livelock check, so it sees the same cycles as without skipping
+        if (lockstep_clocks && ! std::accumulate(std::begin(phase_complete), std::end(phase_complete), true, std::logical_and {}))
+        {
+            long max_idle_cycles = static_cast<long>(livelock_period - livelock_timer - 1);
+#if (USER_CODES == ENABLE) && (TELEMETRY == ENABLE)
+            if (telemetry != nullptr)
+            {
+                // Nor does it skip over a snapshot
+                max_idle_cycles = std::min(max_idle_cycles, static_cast<long>(telemetry->cycles_to_next_sample() - 1));
+            }
+#endif /* USER_CODES, TELEMETRY */
+            const auto [idle_cycles, idle_progress] = skip_idle_cycles(operables, global_clock, time_quantum, max_idle_cycles);
+            phase_cycles += static_cast<uint64_t>(idle_cycles);
+            skipped_cycles += static_cast<uint64_t>(idle_cycles);
+            livelock_timer += static_cast<uint64_t>(idle_cycles);
+            stalled_cycle = (idle_progress > 0) ? 0 : (stalled_cycle + static_cast<int>(idle_cycles));
+#if (USER_CODES == ENABLE) && (TELEMETRY == ENABLE)
+            if (telemetry != nullptr)
+            {
+                telemetry->advance(static_cast<uint64_t>(idle_cycles), global_clock.now());
+            }
+#endif /* USER_CODES, TELEMETRY */
+        }
+#endif /* EVENT_DRIVEN_SKIP_AHEAD */
     }
 
 #if (USE_VCPKG == ENABLE)
@@ -227,6 +481,37 @@ phase_stats do_phase(const phase_info& phase, environment& env, std::vector<trac
     }
 #endif /* PRINT_STATISTICS_INTO_FILE */
 
+#if (EVENT_DRIVEN_SKIP_AHEAD == ENABLE)
+#if (USE_VCPKG == ENABLE)
+    fmt::print("{} skip-ahead: {} of {} cycles skipped\n", phase_name, skipped_cycles, phase_cycles);
+#endif /* USE_VCPKG */
+
+#if (PRINT_STATISTICS_INTO_FILE == ENABLE)
+    std::fprintf(output_statistics.file_handler, "%s skip-ahead: %lu of %lu cycles skipped\n", phase_name.c_str(), skipped_cycles, phase_cycles);
+#endif /* PRINT_STATISTICS_INTO_FILE */
+#endif /* EVENT_DRIVEN_SKIP_AHEAD */
+
+#if (USER_CODES == ENABLE) && (USE_OPENMP == ENABLE) && (PARALLEL_CYCLE_ENGINE == ENABLE)
+    for (O3_CPU& cpu : cpus)
+    {
+        cpu.defer_retire_events(false);
+    }
+
+    // Wall time per simulated cycle, to compare runs of different --threads and CPU counts
+    const std::chrono::duration<double> phase_wall_time = std::chrono::steady_clock::now() - phase_start_time;
+    const auto engine_cycles                            = static_cast<uint64_t>((global_clock.now() - phase_start_clock) / time_quantum);
+    const double ns_per_cycle                           = (engine_cycles > 0) ? (phase_wall_time.count() * 1e9 / static_cast<double>(engine_cycles)) : 0.0;
+
+#if (USE_VCPKG == ENABLE)
+    fmt::print("{} cycle engine: {} CPUs on {} threads, {} cycles in {:.3f} sec ({:.1f} ns/cycle)\n", phase_name, std::size(cpus), engine.threads(), engine_cycles, phase_wall_time.count(), ns_per_cycle);
+#endif /* USE_VCPKG */
+
+#if (PRINT_STATISTICS_INTO_FILE == ENABLE)
+    std::fprintf(output_statistics.file_handler, "%s cycle engine: %zu CPUs on %d threads, %lu cycles in %.3f sec (%.1f ns/cycle)\n",
+        phase_name.c_str(), std::size(cpus), engine.threads(), engine_cycles, phase_wall_time.count(), ns_per_cycle);
+#endif /* PRINT_STATISTICS_INTO_FILE */
+#endif /* USER_CODES, USE_OPENMP, PARALLEL_CYCLE_ENGINE */
+
     phase_stats stats;
     stats.name = phase.name;
 
@@ -235,7 +520,6 @@ phase_stats do_phase(const phase_info& phase, environment& env, std::vector<trac
         stats.trace_names.push_back(trace_names.at(trace_index.at(i)));
     }
 
-    auto cpus = env.cpu_view();
     std::transform(std::begin(cpus), std::end(cpus), std::back_inserter(stats.sim_cpu_stats), [](const O3_CPU& cpu)
         { return cpu.sim_stats; });
     std::transform(std::begin(cpus), std::end(cpus), std::back_inserter(stats.roi_cpu_stats), [](const O3_CPU& cpu)
@@ -264,29 +548,209 @@ phase_stats do_phase(const phase_info& phase, environment& env, std::vector<trac
     return stats;
 }
 
+#if (USER_CODES == ENABLE)
+/**
+ * @brief Save or restore the warmed-up state of every component, in a fixed order.
+ */
+void checkpoint_environment(environment& env, checkpoint_archive& archive)
+{
+    for (O3_CPU& cpu : env.cpu_view())
+    {
+        cpu.checkpoint(archive);
+    }
+    for (CACHE& cache : env.cache_view())
+    {
+        cache.checkpoint(archive);
+    }
+    for (PageTableWalker& ptw : env.ptw_view())
+    {
+        ptw.checkpoint(archive);
+    }
+    env.vmem_view().checkpoint(archive);
+#if (RAMULATOR2 == ENABLE) && (MEMORY_USE_OS_TRANSPARENT_MANAGEMENT == ENABLE)
+    env.dram_view().checkpoint(archive);
+#endif /* RAMULATOR2, MEMORY_USE_OS_TRANSPARENT_MANAGEMENT */
+}
+
+/**
+ * @brief Restore the warmed-up state and move each trace past the instructions its CPU retired during warmup.
+ * @note The traces are compressed streams, so they are moved forward by decoding the skipped instructions.
+ */
+void restore_checkpoint(environment& env, const std::vector<phase_info>& phases, std::vector<tracereader>& traces, const std::string& path)
+{
+    checkpoint_archive archive {path, checkpoint_archive::mode::load};
+    checkpoint_environment(env, archive);
+
+    auto first_phase = std::find_if(std::begin(phases), std::end(phases), [](const auto& phase)
+        { return ! phase.is_warmup; });
+    if (first_phase == std::end(phases))
+    {
+        return;
+    }
+
+    for (O3_CPU& cpu : env.cpu_view())
+    {
+        auto& trace = traces.at(first_phase->trace_index.at(cpu.cpu));
+        for (long long instr = 0; instr < cpu.num_retired && ! trace.eof(); ++instr)
+        {
+            trace();
+        }
+    }
+
+    fmt::print("Restored the warmed-up state from checkpoint {}\n", path);
+}
+#endif /* USER_CODES */
+
+#if (USER_CODES == ENABLE) && (SAMPLED_SIMULATION == ENABLE)
+/**
+ * @return The requests main memory served so far, as reads, writes and requests the fast memory served.
+ */
+std::array<uint64_t, 3> memory_requests([[maybe_unused]] environment& env)
+{
+#if (RAMULATOR == ENABLE) || (RAMULATOR2 == ENABLE)
+    auto& dram = env.dram_view();
+#if (MEMORY_USE_HYBRID == ENABLE)
+    return {dram.read_request_in_memory + dram.read_request_in_memory2, dram.write_request_in_memory + dram.write_request_in_memory2, dram.read_request_in_memory + dram.write_request_in_memory};
+#else
+    return {dram.read_request_in_memory, dram.write_request_in_memory, 0};
+#endif /* MEMORY_USE_HYBRID */
+#else
+    return {0, 0, 0}; // The statistics of the phase count them
+#endif /* RAMULATOR || RAMULATOR2 */
+}
+
+/**
+ * @brief Record a measured sample, all samples of a run are gathered in one phase whose statistics sum theirs.
+ */
+void add_sample(std::vector<phase_stats>& results, phase_stats& stats, const phase_info& phase, const std::array<uint64_t, 3>& memory_requests, champsim::chrono::picoseconds elapsed)
+{
+    sample_stats sample {phase.name, phase.weight, stats.sim_cpu_stats, stats.sim_cache_stats, memory_requests[0], memory_requests[1], memory_requests[2], elapsed};
+#if (RAMULATOR == DISABLE) && (RAMULATOR2 == DISABLE)
+    for (const auto& channel : stats.sim_dram_stats)
+    {
+        sample.memory_reads += channel.RQ_ROW_BUFFER_HIT + channel.RQ_ROW_BUFFER_MISS;
+        sample.memory_writes += channel.WQ_ROW_BUFFER_HIT + channel.WQ_ROW_BUFFER_MISS;
+    }
+#endif /* RAMULATOR, RAMULATOR2 */
+
+    if (std::empty(results) || std::empty(results.back().samples))
+    {
+        stats.name = "Sampled simulation";
+        stats.samples.push_back(sample);
+        results.push_back(stats);
+        return;
+    }
+
+    auto& sampled = results.back();
+    auto add      = [](auto& sums, const auto& values)
+    {
+        std::transform(std::begin(sums), std::end(sums), std::begin(values), std::begin(sums), [](auto x, auto y)
+            { return x + y; });
+    };
+    add(sampled.sim_cpu_stats, stats.sim_cpu_stats);
+    add(sampled.roi_cpu_stats, stats.roi_cpu_stats);
+    add(sampled.sim_cache_stats, stats.sim_cache_stats);
+    add(sampled.roi_cache_stats, stats.roi_cache_stats);
+    sampled.samples.push_back(sample);
+}
+#endif /* USER_CODES, SAMPLED_SIMULATION */
+
 // simulation entry point
+#if (USER_CODES == ENABLE) && (TELEMETRY == ENABLE)
+std::vector<phase_stats> main(environment& env, std::vector<phase_info>& phases, std::vector<tracereader>& traces, const checkpoint_options& checkpoint, const telemetry::telemetry_options& telemetry)
+#elif (USER_CODES == ENABLE)
+std::vector<phase_stats> main(environment& env, std::vector<phase_info>& phases, std::vector<tracereader>& traces, const checkpoint_options& checkpoint)
+#else
 std::vector<phase_stats> main(environment& env, std::vector<phase_info>& phases, std::vector<tracereader>& traces)
+#endif /* USER_CODES */
 {
     for (champsim::operable& op : env.operable_view())
     {
         op.initialize();
     }
 
+#if (USER_CODES == ENABLE)
+    const bool restored = ! checkpoint.restore_path.empty();
+    if (restored)
+    {
+        restore_checkpoint(env, phases, traces, checkpoint.restore_path);
+    }
+    bool saved = checkpoint.save_path.empty();
+#endif /* USER_CODES */
+
+#if (USER_CODES == ENABLE) && (TELEMETRY == ENABLE)
+    std::unique_ptr<telemetry::sampler> telemetry_sampler;
+    if (telemetry.enabled())
+    {
+        telemetry_sampler = std::make_unique<telemetry::sampler>(env, telemetry);
+    }
+#endif /* USER_CODES, TELEMETRY */
+
     champsim::chrono::clock global_clock;
     std::vector<phase_stats> results;
     for (auto phase : phases)
     {
+#if (USER_CODES == ENABLE)
+        if (phase.is_warmup && restored)
+        {
+            continue;
+        }
+
+        if (! phase.is_warmup && ! saved)
+        {
+            checkpoint_archive archive {checkpoint.save_path, checkpoint_archive::mode::save};
+            checkpoint_environment(env, archive);
+            saved = true;
+            fmt::print("Saved the warmed-up state to checkpoint {}\n", checkpoint.save_path);
+        }
+#endif /* USER_CODES */
+
         // call event listeners
         handle_event<Event::BEGIN_PHASE>(phase.is_warmup);
         // handle_begin_phase(0, phase.is_warmup);
 
+#if (USER_CODES == ENABLE) && (FUNCTIONAL_WARMUP == ENABLE)
+        if (phase.is_functional)
+        {
+            do_functional_phase(phase, env, traces);
+            continue;
+        }
+#endif /* USER_CODES, FUNCTIONAL_WARMUP */
+
+#if (USER_CODES == ENABLE) && (SAMPLED_SIMULATION == ENABLE)
+        const auto memory_requests_before = memory_requests(env);
+        const auto phase_begin            = global_clock.now();
+#endif /* USER_CODES, SAMPLED_SIMULATION */
+
+#if (USER_CODES == ENABLE) && (TELEMETRY == ENABLE)
+        auto stats = do_phase(phase, env, traces, global_clock, telemetry_sampler.get());
+#else
         auto stats = do_phase(phase, env, traces, global_clock);
+#endif /* USER_CODES, TELEMETRY */
+
+#if (USER_CODES == ENABLE) && (SAMPLED_SIMULATION == ENABLE)
+        if (phase.is_sample)
+        {
+            auto requests = memory_requests(env);
+            std::transform(std::begin(requests), std::end(requests), std::begin(memory_requests_before), std::begin(requests), std::minus {});
+            add_sample(results, stats, phase, requests, global_clock.now() - phase_begin);
+            continue;
+        }
+#endif /* USER_CODES, SAMPLED_SIMULATION */
+
         if (! phase.is_warmup)
         {
             results.push_back(stats);
         }
     }
 
+#if (USER_CODES == ENABLE) && (TELEMETRY == ENABLE)
+    if (telemetry_sampler != nullptr)
+    {
+        telemetry_sampler->close();
+    }
+#endif /* USER_CODES, TELEMETRY */
+
     return results;
 }
 } // namespace champsim
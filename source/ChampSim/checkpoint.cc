@@ -0,0 +1,62 @@
+#include "ChampSim/checkpoint.h"
+
+#if (USER_CODES == ENABLE)
+#include <cstdlib>
+#include <iostream>
+
+namespace
+{
+constexpr std::string_view MAGIC = "CHAMPSIM-CHECKPOINT-1";
+constexpr std::size_t BUFFER_SIZE = 1 << 20; // [B]
+} // namespace
+
+champsim::checkpoint_archive::checkpoint_archive(std::string path_, mode direction_): path(std::move(path_)), direction(direction_)
+{
+    file = std::fopen(path.c_str(), saving() ? "wb" : "rb");
+    if (file == nullptr)
+    {
+        std::cerr << __func__ << ": cannot open checkpoint " << path << std::endl;
+        std::abort();
+    }
+    std::setvbuf(file, nullptr, _IOFBF, BUFFER_SIZE);
+
+    section(MAGIC);
+}
+
+champsim::checkpoint_archive::~checkpoint_archive()
+{
+    if (saving() && std::fflush(file) != 0)
+    {
+        std::cerr << __func__ << ": cannot write checkpoint " << path << std::endl;
+    }
+    std::fclose(file);
+}
+
+void champsim::checkpoint_archive::section(std::string_view name)
+{
+    std::string stored {name};
+    transfer(stored);
+    if (stored != name)
+    {
+        std::cerr << __func__ << ": checkpoint " << path << " holds \"" << stored << "\" where \"" << name << "\" is expected" << std::endl;
+        std::abort();
+    }
+}
+
+void champsim::checkpoint_archive::transfer_bytes(void* data, std::size_t size)
+{
+    const std::size_t count = saving() ? std::fwrite(data, 1, size, file) : std::fread(data, 1, size, file);
+    if (count != size)
+    {
+        std::cerr << __func__ << ": checkpoint " << path << (saving() ? " cannot be written" : " is truncated") << std::endl;
+        std::abort();
+    }
+}
+
+void champsim::checkpoint_archive::mismatch(std::string_view what) const
+{
+    std::cerr << __func__ << ": checkpoint " << path << " was taken with another " << what << std::endl;
+    std::abort();
+}
+
+#endif /* USER_CODES */
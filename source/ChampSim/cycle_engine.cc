@@ -0,0 +1,54 @@
+#include "ChampSim/cycle_engine.h"
+
+#if (USER_CODES == ENABLE) && (USE_OPENMP == ENABLE) && (PARALLEL_CYCLE_ENGINE == ENABLE)
+#include <algorithm>
+#include <iterator>
+#include <numeric>
+#include <utility>
+
+champsim::cycle_engine::cycle_engine(std::vector<operable_list> private_operables_, int num_threads_)
+    : private_operables(std::move(private_operables_)),
+      num_private(std::accumulate(std::cbegin(private_operables), std::cend(private_operables), std::size_t {0}, [](std::size_t acc, const operable_list& x)
+          { return acc + std::size(x); })),
+      num_threads(std::clamp(num_threads_, 1, std::max(static_cast<int>(std::size(private_operables)), 1)))
+{
+}
+
+long champsim::cycle_engine::operate_private(const operable_schedule& schedule, const champsim::chrono::clock& clock)
+{
+    const auto& operables = schedule.operables();
+    first_shared          = 0;
+    if (num_threads <= 1 || std::size(operables) < num_private || operables.front().get().current_time != operables.back().get().current_time)
+    {
+        return 0;
+    }
+
+    // The schedule is ordered by time, so every operable is due at the same time and they are in operable_view() order
+    long progress {0};
+    const auto num_cpus = static_cast<long>(std::size(private_operables));
+#pragma omp parallel for num_threads(num_threads) schedule(static) reduction(+ : progress)
+    for (long cpu = 0; cpu < num_cpus; ++cpu)
+    {
+        for (champsim::operable& op : private_operables[static_cast<std::size_t>(cpu)])
+        {
+            progress += op.operate_on(clock);
+        }
+    }
+
+    first_shared = num_private;
+    return progress;
+}
+
+long champsim::cycle_engine::operate_shared(const operable_schedule& schedule, const champsim::chrono::clock& clock) const
+{
+    const auto& operables = schedule.operables();
+    long progress {0};
+    for (auto it = std::next(std::cbegin(operables), static_cast<std::ptrdiff_t>(first_shared)); it != std::cend(operables); ++it)
+    {
+        progress += it->get().operate_on(clock);
+    }
+
+    return progress;
+}
+
+#endif /* USER_CODES, USE_OPENMP, PARALLEL_CYCLE_ENGINE */
@@ -0,0 +1,88 @@
+#include "ChampSim/functional_warmup.h"
+
+#if (USER_CODES == ENABLE) && (FUNCTIONAL_WARMUP == ENABLE)
+#include "ChampSim/cache.h"
+#include "ChampSim/environment.h"
+#include "ChampSim/ptw.h"
+
+champsim::functional_warmer::functional_warmer(environment& env_): env(env_)
+{
+    for (CACHE& cache : env.cache_view())
+    {
+        for (auto* ul : cache.upper_levels)
+        {
+            caches.emplace(ul, &cache);
+        }
+    }
+
+    for (PageTableWalker& ptw : env.ptw_view())
+    {
+        for (auto* ul : ptw.upper_channels())
+        {
+            ptws.emplace(ul, &ptw);
+        }
+    }
+}
+
+champsim::address champsim::functional_warmer::access(channel* channel, request_type request)
+{
+    if (auto cache_it = caches.find(channel); cache_it != std::end(caches))
+    {
+        CACHE& cache = *cache_it->second;
+
+        // Translate the virtual address first, as the cache does before its tag check
+        if (! request.is_translated)
+        {
+            request_type translation = request;
+            translation.type          = access_type::LOAD;
+            translation.is_translated = true;
+
+            const champsim::page_number p_page {access(cache.lower_translate, translation)};
+            request.address       = champsim::address {champsim::splice(p_page, champsim::page_offset {request.v_address})};
+            request.is_translated = true;
+        }
+
+        if (auto data = cache.functional_hit(request.cpu, request.address, request.v_address, request.ip, request.type); data.has_value())
+        {
+            return *data;
+        }
+
+        // Writebacks are allocated without reading the next level, as CACHE::handle_write() does
+        champsim::address data = request.data;
+        if (request.type != access_type::WRITE || cache.match_offset_bits)
+        {
+            request_type miss = request;
+            miss.type         = (request.type == access_type::WRITE) ? access_type::RFO : request.type;
+            data              = access(cache.lower_level, miss);
+        }
+
+        if (auto victim = cache.functional_fill(request.cpu, request.address, request.v_address, data, request.ip, request.type); victim.has_value())
+        {
+            request_type writeback;
+            writeback.cpu       = request.cpu;
+            writeback.address   = victim->address;
+            writeback.v_address = victim->v_address;
+            writeback.data      = victim->data;
+            writeback.type      = access_type::WRITE;
+#if (TRACKING_LOAD_STORE_STATISTICS == ENABLE)
+            writeback.type_origin = access_type::WRITE; // WRITEBACK
+#endif /* TRACKING_LOAD_STORE_STATISTICS */
+            access(cache.lower_level, writeback);
+        }
+
+        return data;
+    }
+
+    if (auto ptw_it = ptws.find(channel); ptw_it != std::end(ptws))
+    {
+        return ptw_it->second->functional_walk(*this, request.cpu, request.address);
+    }
+
+    // Main memory
+#if (RAMULATOR2 == ENABLE) && (MEMORY_USE_OS_TRANSPARENT_MANAGEMENT == ENABLE)
+    env.dram_view().functional_access(request);
+#endif /* RAMULATOR2, MEMORY_USE_OS_TRANSPARENT_MANAGEMENT */
+    return request.data;
+}
+
+#endif /* USER_CODES, FUNCTIONAL_WARMUP */
@@ -20,6 +20,10 @@
 #include "ChampSim/stats_printer.h"
 #include "ProjectConfiguration.h" // User file
 
+#if (USER_CODES == ENABLE) && (SAMPLED_SIMULATION == ENABLE)
+#include "ChampSim/sampling.h"
+#endif /* USER_CODES, SAMPLED_SIMULATION */
+
 #if (USE_VCPKG == ENABLE)
 #include <nlohmann/json.hpp>
 #endif /* USE_VCPKG */
@@ -105,6 +109,33 @@ void to_json(nlohmann::json& j, const DRAM_CHANNEL::stats_type stats)
 
 namespace champsim
 {
+#if (USER_CODES == ENABLE) && (SAMPLED_SIMULATION == ENABLE)
+void to_json(nlohmann::json& j, const champsim::sample_stats& stats)
+{
+    std::map<std::string, nlohmann::json> caches;
+    for (const auto& x : stats.cache_stats)
+    {
+        caches.emplace(x.name, x);
+    }
+
+    const auto metrics = champsim::sampling::metrics(stats);
+    j                  = nlohmann::json {
+        {                 "name",                                              stats.name},
+        {               "weight",                                            stats.weight},
+        {                "cores",                                         stats.cpu_stats},
+        {               "caches",                                                  caches},
+        {         "memory reads",                                      stats.memory_reads},
+        {        "memory writes",                                     stats.memory_writes},
+        { "fast memory requests",                              stats.fast_memory_requests},
+        {   "simulated time (ps)",                                   stats.elapsed.count()},
+        {                  "IPC",                                             metrics.ipc},
+        {             "LLC MPKI",                                        metrics.llc_mpki},
+        {"memory bandwidth (GB/s)",                                metrics.memory_bandwidth},
+        { "fast memory hit rate",                            metrics.fast_memory_hit_rate}
+    };
+}
+#endif /* USER_CODES, SAMPLED_SIMULATION */
+
 void to_json(nlohmann::json& j, const champsim::phase_stats stats)
 {
     std::map<std::string, nlohmann::json> roi_stats;
@@ -129,6 +160,12 @@ void to_json(nlohmann::json& j, const champsim::phase_stats stats)
     };
     statsmap.emplace("roi", roi_stats);
     statsmap.emplace("sim", sim_stats);
+#if (USER_CODES == ENABLE) && (SAMPLED_SIMULATION == ENABLE)
+    if (! stats.samples.empty())
+    {
+        statsmap.emplace("samples", stats.samples);
+    }
+#endif /* USER_CODES, SAMPLED_SIMULATION */
     j = statsmap;
 }
 } // namespace champsim
@@ -33,10 +33,12 @@
 #include "ChampSim/deadlock.h"
 #include "ChampSim/event_listeners.h"
 #include "ChampSim/instruction.h"
+#include "ChampSim/util/algorithm.h"
 #include "ChampSim/util/span.h"
 
 #if (USER_CODES == ENABLE)
 #include "ChampSim/champsim_constants.h"
+#include "ChampSim/checkpoint.h"
 
 #else
 #include "ChampSim/champsim.h"
@@ -73,6 +75,72 @@ void O3_CPU::initialize()
     impl_initialize_btb();
 }
 
+#if (USER_CODES == ENABLE)
+void O3_CPU::checkpoint(champsim::checkpoint_archive& archive)
+{
+    archive.section("CPU " + std::to_string(cpu));
+    archive(num_retired, DIB);
+    branch_module_pimpl->impl_branch_predictor_checkpoint(archive);
+    btb_module_pimpl->impl_btb_checkpoint(archive);
+}
+#endif /* USER_CODES */
+
+#if (USER_CODES == ENABLE) && (FUNCTIONAL_WARMUP == ENABLE)
+void O3_CPU::functional_retire(ooo_model_instr& instr, champsim::functional_warmer& warmer)
+{
+    // Predict and resolve the branch, without the statistics and the code prefetcher
+    auto [predicted_branch_target, always_taken] = impl_btb_prediction(instr.ip, instr.branch);
+    instr.branch_prediction                      = impl_predict_branch(instr.ip, predicted_branch_target, always_taken, instr.branch) || always_taken;
+    if (instr.is_branch)
+    {
+        impl_update_btb(instr.ip, instr.branch_target, instr.branch_taken, instr.branch);
+        impl_last_branch_result(instr.ip, instr.branch_target, instr.branch_taken, instr.branch);
+    }
+
+    champsim::functional_warmer::request_type packet;
+    packet.cpu           = cpu;
+    packet.instr_id      = instr.instr_id;
+    packet.ip            = instr.ip;
+    packet.asid[0]       = instr.asid[0];
+    packet.asid[1]       = instr.asid[1];
+    packet.is_translated = false;
+
+    // Instructions found in the decoded instruction buffer are not fetched
+    if (! DIB.check_hit(instr.ip).has_value())
+    {
+        packet.address   = instr.ip;
+        packet.v_address = instr.ip;
+        packet.type      = access_type::LOAD;
+        warmer.access(L1I_bus.lower_level, packet);
+    }
+    do_dib_update(instr);
+
+    for (auto address : instr.source_memory)
+    {
+        packet.address   = address;
+        packet.v_address = address;
+        packet.type      = access_type::LOAD;
+#if (TRACKING_LOAD_STORE_STATISTICS == ENABLE)
+        packet.type_origin = access_type::LOAD;
+#endif /* TRACKING_LOAD_STORE_STATISTICS */
+        warmer.access(L1D_bus.lower_level, packet);
+    }
+
+    for (auto address : instr.destination_memory)
+    {
+        packet.address   = address;
+        packet.v_address = address;
+        packet.type      = access_type::WRITE;
+#if (TRACKING_LOAD_STORE_STATISTICS == ENABLE)
+        packet.type_origin = access_type::WRITE;
+#endif /* TRACKING_LOAD_STORE_STATISTICS */
+        warmer.access(L1D_bus.lower_level, packet);
+    }
+
+    ++num_retired;
+}
+#endif /* USER_CODES, FUNCTIONAL_WARMUP */
+
 void O3_CPU::begin_phase()
 {
     begin_phase_instr = num_retired;
@@ -113,7 +181,7 @@ void O3_CPU::initialize_instruction()
         stop_fetch = do_init_instruction(input_queue.front());
 
         // Add to IFETCH_BUFFER
-        IFETCH_BUFFER.push_back(input_queue.front());
+        IFETCH_BUFFER.push_back(std::move(input_queue.front()));
         input_queue.pop_front();
 
         IFETCH_BUFFER.back().ready_time = current_time;
@@ -294,7 +362,7 @@ long O3_CPU::fetch_instruction()
     return progress;
 }
 
-bool O3_CPU::do_fetch_instruction(std::deque<ooo_model_instr>::iterator begin, std::deque<ooo_model_instr>::iterator end)
+bool O3_CPU::do_fetch_instruction(champsim::instruction_queue::iterator begin, champsim::instruction_queue::iterator end)
 {
     CacheBus::request_type fetch_packet;
     fetch_packet.v_address = begin->ip;
@@ -337,7 +405,11 @@ long O3_CPU::promote_to_decode()
                  { return ! x.fetch_completed; });
     // find the first not fetch completed
     auto [window_begin, window_end] = champsim::get_span_p(std::begin(IFETCH_BUFFER), fetched_check_end, available_fetch_bandwidth, fetch_complete_and_ready);
+#if (USER_CODES == ENABLE) && (INSTRUCTION_INLINE_STORAGE == ENABLE)
+    auto decoded_window_end         = champsim::stable_partition(window_begin, window_end, is_decoded, decode_partition_buffer); // reorder instructions
+#else
     auto decoded_window_end         = std::stable_partition(window_begin, window_end, is_decoded); // reorder instructions
+#endif /* USER_CODES, INSTRUCTION_INLINE_STORAGE */
     auto mark_for_decode            = [time = current_time, lat = DECODE_LATENCY, warmup = warmup](auto& x)
     {
         return x.ready_time = time + (warmup ? champsim::chrono::clock::duration {} : lat);
@@ -449,7 +521,8 @@ long O3_CPU::decode_instruction()
 
     long progress {std::distance(dib_hit_buffer_begin, dib_hit_buffer_end) + std::distance(decode_buffer_begin, decode_buffer_end)};
 
-    std::merge(dib_hit_buffer_begin, dib_hit_buffer_end, decode_buffer_begin, decode_buffer_end, std::back_inserter(DISPATCH_BUFFER), ooo_model_instr::program_order);
+    std::merge(std::make_move_iterator(dib_hit_buffer_begin), std::make_move_iterator(dib_hit_buffer_end), std::make_move_iterator(decode_buffer_begin),
+        std::make_move_iterator(decode_buffer_end), std::back_inserter(DISPATCH_BUFFER), ooo_model_instr::program_order);
     DECODE_BUFFER.erase(decode_buffer_begin, decode_buffer_end);
     DIB_HIT_BUFFER.erase(dib_hit_buffer_begin, dib_hit_buffer_end);
 
@@ -882,7 +955,20 @@ long O3_CPU::retire_rob()
     }
 
     uint64_t cycles = current_time.time_since_epoch() / clock_period;
+#if (USER_CODES == ENABLE) && (USE_OPENMP == ENABLE) && (PARALLEL_CYCLE_ENGINE == ENABLE)
+    if (defer_retire)
+    {
+        // Empty events too, since the listeners note the cycle of the first event of a phase
+        deferred_retired.insert(std::end(deferred_retired), retire_begin, retire_end);
+        deferred_retire_events.emplace_back(std::distance(retire_begin, retire_end), cycles);
+    }
+    else
+    {
+        handle_event<Event::RETIRE>(cpu, retire_begin, retire_end, cycles);
+    }
+#else
     handle_event<Event::RETIRE>(cpu, retire_begin, retire_end, cycles);
+#endif /* USER_CODES, USE_OPENMP, PARALLEL_CYCLE_ENGINE */
 
     auto retire_count = std::distance(retire_begin, retire_end);
     num_retired += retire_count;
@@ -891,6 +977,111 @@ long O3_CPU::retire_rob()
     return retire_count;
 }
 
+#if (USER_CODES == ENABLE) && (USE_OPENMP == ENABLE) && (PARALLEL_CYCLE_ENGINE == ENABLE)
+void O3_CPU::flush_retire_events()
+{
+    auto retire_begin = std::cbegin(deferred_retired);
+    for (auto [retire_count, cycles] : deferred_retire_events)
+    {
+        auto retire_end = std::next(retire_begin, retire_count);
+        handle_event<Event::RETIRE>(cpu, retire_begin, retire_end, cycles);
+        retire_begin = retire_end;
+    }
+
+    deferred_retired.clear();
+    deferred_retire_events.clear();
+}
+#endif /* USER_CODES, USE_OPENMP, PARALLEL_CYCLE_ENGINE */
+
+#if (EVENT_DRIVEN_SKIP_AHEAD == ENABLE)
+champsim::chrono::clock::time_point O3_CPU::next_event_time() const
+{
+    const auto next_cycle = current_time + clock_period;
+
+    // New IFETCH entries are checked against the DIB, and fetches rejected by the L1I are reissued, on the next cycle
+    auto is_unchecked     = [](const ooo_model_instr& x)
+    {
+        return ! x.dib_checked || (! x.fetch_issued && ! x.fetch_completed);
+    };
+    if (last_progress > 0 || ! std::empty(L1I_bus.lower_level->returned) || ! std::empty(L1D_bus.lower_level->returned) || std::any_of(std::begin(IFETCH_BUFFER), std::end(IFETCH_BUFFER), is_unchecked))
+    {
+        return next_cycle;
+    }
+
+    auto event_time = champsim::chrono::clock::time_point::max();
+
+    // Work that is retried every cycle from the given time on, until it succeeds
+    auto retry_at   = [&event_time](champsim::chrono::clock::time_point time)
+    {
+        event_time = std::min(event_time, time);
+    };
+
+    // Work that is done once it becomes ready, work that is already ready but still waiting is blocked by another operable
+    auto ready_at   = [&event_time, now = current_time](champsim::chrono::clock::time_point time)
+    {
+        if (time > now)
+        {
+            event_time = std::min(event_time, time);
+        }
+    };
+
+    if (! std::empty(input_queue) && std::size(IFETCH_BUFFER) < IFETCH_BUFFER_SIZE)
+    {
+        retry_at(fetch_resume_time);
+    }
+
+    for (const auto& instr : IFETCH_BUFFER)
+    {
+        if (instr.fetch_completed)
+        {
+            ready_at(instr.ready_time);
+        }
+    }
+
+    for (const auto* buffer : {&DIB_HIT_BUFFER, &DECODE_BUFFER, &DISPATCH_BUFFER})
+    {
+        if (! std::empty(*buffer))
+        {
+            ready_at(buffer->front().ready_time);
+        }
+    }
+
+    for (const auto& instr : ROB)
+    {
+        if (! instr.completed)
+        {
+            ready_at(instr.ready_time);
+        }
+    }
+
+    const auto complete_id = std::empty(ROB) ? std::numeric_limits<uint64_t>::max() : ROB.front().instr_id;
+    for (const auto& sq_entry : SQ)
+    {
+        if (! sq_entry.fetch_issued)
+        {
+            ready_at(sq_entry.ready_time);
+        }
+    }
+
+    // Retired stores are written to the L1D in order
+    if (! std::empty(SQ) && LSQ_ENTRY::precedes(complete_id)(SQ.front()))
+    {
+        retry_at(SQ.front().ready_time);
+    }
+
+    for (const auto& lq_entry : LQ)
+    {
+        // Loads issue strictly after their ready time
+        if (lq_entry.has_value() && ! lq_entry->fetch_issued && lq_entry->producer_id == std::numeric_limits<uint64_t>::max() && lq_entry->ready_time != champsim::chrono::clock::time_point::max())
+        {
+            retry_at(lq_entry->ready_time + champsim::chrono::clock::duration {1});
+        }
+    }
+
+    return std::max(event_time, next_cycle);
+}
+#endif /* EVENT_DRIVEN_SKIP_AHEAD */
+
 void O3_CPU::impl_initialize_branch_predictor() const { branch_module_pimpl->impl_initialize_branch_predictor(); }
 
 void O3_CPU::impl_last_branch_result(champsim::address ip, champsim::address target, bool taken, uint8_t branch_type) const
@@ -980,7 +1171,7 @@ LSQ_ENTRY::LSQ_ENTRY(champsim::address addr, champsim::program_ordered<LSQ_ENTRY
 {
 }
 
-void LSQ_ENTRY::finish(std::deque<ooo_model_instr>::iterator begin, std::deque<ooo_model_instr>::iterator end) const
+void LSQ_ENTRY::finish(champsim::instruction_queue::iterator begin, champsim::instruction_queue::iterator end) const
 {
     auto rob_entry = std::partition_point(begin, end, ooo_model_instr::precedes(this->instr_id));
     assert(rob_entry != end);
@@ -34,7 +34,21 @@ long champsim::operable::operate_on(const champsim::chrono::clock& clock)
 long champsim::operable::_operate()
 {
     current_time += clock_period;
+#if (EVENT_DRIVEN_SKIP_AHEAD == ENABLE)
+    last_progress = operate();
+    return last_progress;
+#else
     return operate();
+#endif /* EVENT_DRIVEN_SKIP_AHEAD */
 }
 
+#if (EVENT_DRIVEN_SKIP_AHEAD == ENABLE)
+long champsim::operable::skip_cycles(long cycles)
+{
+    current_time += clock_period * cycles;
+    last_progress = 0;
+    return 0;
+}
+#endif /* EVENT_DRIVEN_SKIP_AHEAD */
+
 uint64_t champsim::operable::current_cycle() const { return static_cast<uint64_t>(current_time.time_since_epoch() / clock_period); }
@@ -0,0 +1,33 @@
+#include "ChampSim/operable_schedule.h"
+
+#if (USER_CODES == ENABLE)
+#include <numeric>
+#include <utility>
+
+champsim::operable_schedule::operable_schedule(operable_list operables): ordered(std::move(operables)), rank(std::size(ordered))
+{
+    std::iota(std::begin(rank), std::end(rank), std::size_t {0});
+    update();
+}
+
+void champsim::operable_schedule::update()
+{
+    const auto precedes = [this](std::size_t lhs, std::size_t rhs)
+    {
+        const auto lhs_time = ordered[lhs].get().current_time;
+        const auto rhs_time = ordered[rhs].get().current_time;
+        return (lhs_time < rhs_time) || (lhs_time == rhs_time && rank[lhs] < rank[rhs]);
+    };
+
+    // Insertion sort, linear when the order did not change
+    for (std::size_t i = 1; i < std::size(ordered); ++i)
+    {
+        for (std::size_t j = i; j > 0 && precedes(j, j - 1); --j)
+        {
+            std::swap(ordered[j], ordered[j - 1]);
+            std::swap(rank[j], rank[j - 1]);
+        }
+    }
+}
+
+#endif /* USER_CODES */
@@ -31,6 +31,10 @@
 
 #include "ChampSim/stats_printer.h"
 
+#if (USER_CODES == ENABLE) && (SAMPLED_SIMULATION == ENABLE)
+#include "ChampSim/sampling.h"
+#endif /* USER_CODES, SAMPLED_SIMULATION */
+
 namespace
 {
 template<typename N, typename D>
@@ -44,6 +48,23 @@ auto print_ratio(N num, D denom)
     }
     return std::string {"-"};
 }
+
+#if (USER_CODES == ENABLE) && (SAMPLED_SIMULATION == ENABLE)
+auto print_estimate(champsim::sampling::estimate value)
+{
+    auto print_value = [](double x)
+    {
+        if (! std::isnan(x))
+        {
+#if (USE_VCPKG == ENABLE)
+            return fmt::format("{:.4g}", x);
+#endif /* USE_VCPKG */
+        }
+        return std::string {"-"};
+    };
+    return print_value(value.mean) + " +- " + print_value(value.half_width);
+}
+#endif /* USER_CODES, SAMPLED_SIMULATION */
 } // namespace
 
 std::vector<std::string> champsim::plain_printer::format(O3_CPU::stats_type stats)
@@ -323,8 +344,72 @@ std::vector<std::string> champsim::plain_printer::format(champsim::phase_stats&
 #endif /* PRINT_STATISTICS_INTO_FILE */
     }
 
+#if (USER_CODES == ENABLE) && (SAMPLED_SIMULATION == ENABLE)
+    if (! std::empty(stats.samples))
+    {
+        auto sublines = format(stats.samples);
+        lines.emplace_back("");
+        std::move(std::begin(sublines), std::end(sublines), std::back_inserter(lines));
+    }
+#endif /* USER_CODES, SAMPLED_SIMULATION */
+
+    return lines;
+}
+
+#if (USER_CODES == ENABLE) && (SAMPLED_SIMULATION == ENABLE)
+std::vector<std::string> champsim::plain_printer::format(const std::vector<sample_stats>& samples)
+{
+    std::vector<sampling::sample_metrics> metrics;
+    std::vector<double> weights;
+    for (const auto& sample : samples)
+    {
+        metrics.push_back(sampling::metrics(sample));
+        weights.push_back(sample.weight);
+    }
+
+    auto estimate_of = [&metrics, &weights](auto metric)
+    {
+        std::vector<double> values;
+        std::transform(std::begin(metrics), std::end(metrics), std::back_inserter(values), metric);
+        return ::print_estimate(sampling::weighted_estimate(values, weights));
+    };
+
+    std::vector<std::pair<std::string, std::string>> estimates;
+    for (std::size_t cpu = 0; cpu < std::size(samples.front().cpu_stats); ++cpu)
+    {
+        estimates.emplace_back("CPU " + std::to_string(cpu) + " weighted IPC", estimate_of([cpu](const auto& x)
+                                                                                   { return x.ipc.at(cpu); }));
+    }
+    estimates.emplace_back("LLC demand MPKI", estimate_of([](const auto& x)
+                                                  { return x.llc_mpki; }));
+    estimates.emplace_back("Main memory bandwidth (GB/s)", estimate_of([](const auto& x)
+                                                               { return x.memory_bandwidth; }));
+#if (MEMORY_USE_HYBRID == ENABLE)
+    estimates.emplace_back("Fast memory hit rate", estimate_of([](const auto& x)
+                                                       { return x.fast_memory_hit_rate; }));
+#endif /* MEMORY_USE_HYBRID */
+
+    std::vector<std::string> lines {};
+
+#if (USE_VCPKG == ENABLE)
+    lines.push_back(fmt::format("Sampled Simulation Statistics ({} samples, weighted means with 95% confidence intervals)", std::size(samples)));
+    for (const auto& [name, value] : estimates)
+    {
+        lines.push_back(fmt::format("{}: {}", name, value));
+    }
+#endif /* USE_VCPKG */
+
+#if (PRINT_STATISTICS_INTO_FILE == ENABLE)
+    std::fprintf(output_statistics.file_handler, "\nSampled Simulation Statistics (%zu samples, weighted means with 95%% confidence intervals)\n", std::size(samples));
+    for (const auto& [name, value] : estimates)
+    {
+        std::fprintf(output_statistics.file_handler, "%s: %s\n", name.c_str(), value.c_str());
+    }
+#endif /* PRINT_STATISTICS_INTO_FILE */
+
     return lines;
 }
+#endif /* USER_CODES, SAMPLED_SIMULATION */
 
 void champsim::plain_printer::print(champsim::phase_stats& stats)
 {
@@ -2,6 +2,10 @@
 
 #include "ChampSim/cache.h"
 
+#if (USER_CODES == ENABLE)
+#include "ChampSim/checkpoint.h"
+#endif /* USER_CODES */
+
 uint32_t ip_stride::prefetcher_cache_operate(champsim::address addr, champsim::address ip, uint8_t cache_hit, bool useful_prefetch, access_type type, uint32_t metadata_in)
 {
     champsim::block_number cl_addr {addr};
@@ -62,3 +66,14 @@ uint32_t ip_stride::prefetcher_cache_fill(champsim::address addr, long set, long
 {
     return metadata_in;
 }
+
+#if (USER_CODES == ENABLE)
+void ip_stride::prefetcher_checkpoint(champsim::checkpoint_archive& archive)
+{
+    archive(table);
+
+    // A lookahead in flight is not checkpointed
+    if (archive.loading())
+        active_lookahead.reset();
+}
+#endif /* USER_CODES */
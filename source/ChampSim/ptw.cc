@@ -23,6 +23,7 @@
 #include <fmt/core.h>
 #endif /* USE_VCPKG */
 
+#include <algorithm>
 #include <cmath>
 #include <numeric>
 
@@ -68,7 +69,11 @@ PageTableWalker::mshr_type::mshr_type(const request_type& req, std::size_t level
 auto PageTableWalker::handle_read(const request_type& handle_pkt, channel_type* ul) -> std::optional<mshr_type>
 {
     pscl_entry walk_init = {handle_pkt.v_address, CR3_addr, std::size(pscl)};
+#if (USER_CODES == ENABLE) && (INSTRUCTION_INLINE_STORAGE == ENABLE)
+    pscl_hits.clear();
+#else
     std::vector<std::optional<pscl_entry>> pscl_hits;
+#endif /* USER_CODES, INSTRUCTION_INLINE_STORAGE */
     std::transform(std::begin(pscl), std::end(pscl), std::back_inserter(pscl_hits), [walk_init](auto& x)
         { return x.check_hit(walk_init); });
     walk_init =
@@ -162,7 +167,12 @@ long PageTableWalker::operate()
     progress += std::distance(std::cbegin(lower_level->returned), std::cend(lower_level->returned));
     lower_level->returned.clear();
 
+#if (USER_CODES == ENABLE) && (INSTRUCTION_INLINE_STORAGE == ENABLE)
+    auto& next_steps = next_steps_buffer;
+    next_steps.clear();
+#else
     std::vector<mshr_type> next_steps {};
+#endif /* USER_CODES, INSTRUCTION_INLINE_STORAGE */
 
     champsim::bandwidth fill_bw {MAX_FILL};
     auto [complete_begin, complete_end] = champsim::get_span_p(std::cbegin(completed), std::cend(completed), fill_bw, is_ready);
@@ -270,6 +280,34 @@ void PageTableWalker::finish_packet(const response_type& packet)
     MSHR.erase(std::begin(MSHR), last_finished);
 }
 
+#if (EVENT_DRIVEN_SKIP_AHEAD == ENABLE)
+champsim::chrono::clock::time_point PageTableWalker::next_event_time() const
+{
+    const auto next_cycle = current_time + clock_period;
+
+    auto has_request      = [](const channel_type* ul)
+    {
+        return ! std::empty(ul->RQ);
+    };
+    if (last_progress > 0 || ! std::empty(lower_level->returned) || std::any_of(std::begin(upper_levels), std::end(upper_levels), has_request))
+    {
+        return next_cycle;
+    }
+
+    // Walk steps are retried every cycle once their data is ready
+    auto event_time = champsim::chrono::clock::time_point::max();
+    for (const auto* queue : {&completed, &finished})
+    {
+        for (const auto& mshr_entry : *queue)
+        {
+            event_time = std::min(event_time, mshr_entry.data.ready_time());
+        }
+    }
+
+    return std::max(event_time, next_cycle);
+}
+#endif /* EVENT_DRIVEN_SKIP_AHEAD */
+
 void PageTableWalker::begin_phase()
 {
     for (auto* ul : upper_levels)
@@ -281,6 +319,55 @@ void PageTableWalker::begin_phase()
     }
 }
 
+#if (USER_CODES == ENABLE)
+void PageTableWalker::checkpoint(champsim::checkpoint_archive& archive)
+{
+    archive.section(NAME);
+    archive(pscl);
+}
+#endif /* USER_CODES */
+
+#if (USER_CODES == ENABLE) && (FUNCTIONAL_WARMUP == ENABLE)
+champsim::address PageTableWalker::functional_walk(champsim::functional_warmer& warmer, uint32_t cpu, champsim::address v_address)
+{
+    pscl_entry walk_init = {v_address, CR3_addr, std::size(pscl)};
+    std::optional<pscl_entry> deepest_hit;
+    for (auto& cache : pscl)
+    {
+        if (auto hit = cache.check_hit(walk_init); hit.has_value())
+        {
+            deepest_hit = hit;
+        }
+    }
+    walk_init = deepest_hit.value_or(walk_init);
+
+    champsim::address_slice walk_offset {
+        champsim::dynamic_extent {champsim::data::bits {LOG2_PAGE_SIZE}, champsim::data::bits {champsim::lg2(pte_entry::byte_multiple)}},
+        vmem->get_offset(v_address, walk_init.level)
+    };
+
+    champsim::functional_warmer::request_type packet;
+    packet.cpu       = cpu;
+    packet.address   = champsim::address {champsim::splice(champsim::page_number {walk_init.ptw_addr}, champsim::page_offset {walk_offset})};
+    packet.v_address = v_address;
+    packet.type      = access_type::TRANSLATION;
+#if (TRACKING_LOAD_STORE_STATISTICS == ENABLE)
+    packet.type_origin = access_type::TRANSLATION;
+#endif /* TRACKING_LOAD_STORE_STATISTICS */
+
+    for (auto level = walk_init.level; level > 0; --level)
+    {
+        warmer.access(lower_level, packet);
+
+        packet.address = vmem->get_pte_pa(cpu, champsim::page_number {v_address}, level).first;
+        pscl.at(std::size(pscl) - level).fill({v_address, packet.address, level});
+    }
+    warmer.access(lower_level, packet);
+
+    return champsim::address {vmem->va_to_pa(cpu, champsim::page_number {v_address}).first};
+}
+#endif /* USER_CODES, FUNCTIONAL_WARMUP */
+
 // LCOV_EXCL_START Exclude the following function from LCOV
 void PageTableWalker::print_deadlock()
 {
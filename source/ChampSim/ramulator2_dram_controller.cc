@@ -4,6 +4,8 @@
 
 #if (USER_CODES == ENABLE) && (RAMULATOR2 == ENABLE)
 
+#include <algorithm>
+#include <bit>
 #include <cassert>
 #include <cstdio>
 #include <iostream>
@@ -32,6 +34,38 @@
 
 /* Function */
 
+int PacketTable::hold(const packet_type& packet)
+{
+    if (free_handles.empty())
+    {
+        packets.push_back(packet);
+        return static_cast<int>(packets.size() - 1);
+    }
+
+    const int handle = free_handles.back();
+    free_handles.pop_back();
+    packets[handle] = packet; // Reuses the storage of the entry's vectors
+    return handle;
+}
+
+bool MEMORY_CONTROLLER::send_request(Ramulator::IMemorySystem* memory, Ramulator::Addr_t address, int type, int source_id, const DRAM_CHANNEL::request_type& packet, uint8_t memory_id)
+{
+    // Only read requests are answered by the memory, so only they need their packets back
+    const int packet_handle = (type == Ramulator::Request::Type::Read) ? packets.hold(packet) : PacketTable::NO_PACKET;
+
+    Ramulator::Request request(address, type, source_id, Ramulator::RequestCallback::to<&MEMORY_CONTROLLER::return_data>(this), packet_handle, memory_id);
+    if (memory->send(request))
+    {
+        return true;
+    }
+
+    if (packet_handle != PacketTable::NO_PACKET)
+    {
+        packets.release(packet_handle); // The request is retried later with a new handle
+    }
+    return false;
+}
+
 #if (MEMORY_USE_HYBRID == ENABLE)
 // Enable hybrid memory system
 
@@ -104,8 +138,14 @@ MEMORY_CONTROLLER::MEMORY_CONTROLLER(champsim::chrono::picoseconds mc_period, st
     os_transparent_management = new OS_TRANSPARENT_MANAGEMENT(max_address + max_address2, max_address);
 #endif /* MEMORY_USE_OS_TRANSPARENT_MANAGEMENT */
 
+#if (SHADOW_OS_TRANSPARENT_MANAGEMENT == ENABLE)
+    shadow_management = new SHADOW_MANAGEMENT(max_address + max_address2, max_address);
+#endif /* SHADOW_OS_TRANSPARENT_MANAGEMENT */
+
 #if (MEMORY_USE_SWAPPING_UNIT == ENABLE)
     swapping_count = swapping_traffic_in_bytes = 0;
+    first_engine                               = 0;
+    swapping_cycle                             = 0;
 #endif /* MEMORY_USE_SWAPPING_UNIT */
 
 #if (TRACKING_LOAD_STORE_STATISTICS == ENABLE)
@@ -117,7 +157,16 @@ MEMORY_CONTROLLER::MEMORY_CONTROLLER(champsim::chrono::picoseconds mc_period, st
     write_request_in_memory = write_request_in_memory2 = 0;
 
 #if (MEMORY_USE_SWAPPING_UNIT == ENABLE)
-    initialize_swapping();
+    constexpr std::array<uint8_t, SWAPPING_ENGINE_NUMBER> buffer_depths SWAPPING_ENGINE_BUFFER_DEPTHS;
+    static_assert(std::all_of(std::begin(buffer_depths), std::end(buffer_depths), [](uint8_t depth)
+                      { return depth <= SWAPPING_BUFFER_ENTRY_NUMBER; }),
+        "SWAPPING_ENGINE_BUFFER_DEPTHS cannot be larger than SWAPPING_BUFFER_ENTRY_NUMBER.");
+
+    for (std::size_t i = 0; i < engines.size(); i++)
+    {
+        engines[i].buffer_depth = (buffer_depths[i] == 0) ? SWAPPING_BUFFER_ENTRY_NUMBER : buffer_depths[i];
+        initialize_swapping(engines[i]);
+    }
 
 #if (TEST_SWAPPING_UNIT == ENABLE)
     for (auto i = 0; i < MEMORY_DATA_NUMBER; i++)
@@ -134,6 +183,11 @@ MEMORY_CONTROLLER::~MEMORY_CONTROLLER()
 #if (MEMORY_USE_SWAPPING_UNIT == ENABLE)
     output_statistics.swapping_count            = swapping_count;
     output_statistics.swapping_traffic_in_bytes = swapping_traffic_in_bytes;
+    for (std::size_t i = 0; i < engines.size(); i++)
+    {
+        output_statistics.swapping_engine_statistics[i] = engines[i].statistics;
+    }
+    output_statistics.swapping_cycles = swapping_cycle;
 #endif /* MEMORY_USE_SWAPPING_UNIT */
 
 #if (TRACKING_LOAD_STORE_STATISTICS == ENABLE)
@@ -152,6 +206,10 @@ MEMORY_CONTROLLER::~MEMORY_CONTROLLER()
     delete os_transparent_management;
 #endif /* MEMORY_USE_OS_TRANSPARENT_MANAGEMENT */
 
+#if (SHADOW_OS_TRANSPARENT_MANAGEMENT == ENABLE)
+    delete shadow_management;
+#endif /* SHADOW_OS_TRANSPARENT_MANAGEMENT */
+
     // Finalize the simulation. Recursively print all statistics from all components.
     if (frontend != nullptr)
     {
@@ -222,6 +280,51 @@ void MEMORY_CONTROLLER::initialize()
 #endif /* PRINT_STATISTICS_INTO_FILE */
 }
 
+#if (MEMORY_USE_OS_TRANSPARENT_MANAGEMENT == ENABLE)
+void MEMORY_CONTROLLER::checkpoint(champsim::checkpoint_archive& archive)
+{
+    archive.section("MEMORY_CONTROLLER");
+    archive.expect(max_address, "fast memory capacity");
+    archive.expect(max_address2, "slow memory capacity");
+    os_transparent_management->checkpoint(archive);
+}
+
+#if (FUNCTIONAL_WARMUP == ENABLE)
+void MEMORY_CONTROLLER::functional_access(const request_type& packet)
+{
+    const auto ost_type          = (packet.type == access_type::WRITE) ? OS_TRANSPARENT_MANAGEMENT::MemoryRequestType::Write : OS_TRANSPARENT_MANAGEMENT::MemoryRequestType::Read;
+
+    request_type hardware_packet = packet;
+    os_transparent_management->physical_to_hardware_address(hardware_packet);
+
+    // The queues are empty without timing
+#if (TRACKING_LOAD_STORE_STATISTICS == ENABLE)
+    os_transparent_management->memory_activity_tracking(hardware_packet.address.to<uint64_t>(), ost_type, hardware_packet.type_origin, 0.0f);
+#else
+    os_transparent_management->memory_activity_tracking(hardware_packet.address.to<uint64_t>(), ost_type, 0.0f);
+#endif /* TRACKING_LOAD_STORE_STATISTICS */
+
+    OS_TRANSPARENT_MANAGEMENT::RemappingRequest remapping_request;
+#if (MEMORY_USE_SWAPPING_UNIT == ENABLE)
+    // The requests the swapping engines serve finish once timing resumes, so only the others finish here
+    const auto can_start = [this](const OS_TRANSPARENT_MANAGEMENT::RemappingRequest& remapping_request)
+    { return can_start_remapping_request(remapping_request); };
+
+    OS_TRANSPARENT_MANAGEMENT::RemappingRequestHandle handle;
+    while (os_transparent_management->issue_remapping_request(remapping_request, handle, can_start))
+    {
+        os_transparent_management->finish_remapping_request(handle);
+    }
+#else
+    while (os_transparent_management->issue_remapping_request(remapping_request))
+    {
+        os_transparent_management->finish_remapping_request();
+    }
+#endif /* MEMORY_USE_SWAPPING_UNIT */
+}
+#endif /* FUNCTIONAL_WARMUP */
+#endif /* MEMORY_USE_OS_TRANSPARENT_MANAGEMENT */
+
 long MEMORY_CONTROLLER::operate()
 {
     long progress {0};
@@ -252,8 +355,7 @@ long MEMORY_CONTROLLER::operate()
             if ((max_address <= address) && (address < max_address + max_address2))
             {
                 // The memory itself doesn't know other memories' space, so we manage the overall mapping.
-                Ramulator::Request request(static_cast<Ramulator::Addr_t>(address - max_address), Ramulator::Request::Type::Read, static_cast<int>(packet.cpu), std::bind(&MEMORY_CONTROLLER::return_data, this, std::placeholders::_1), rq_it, memory2_id);
-                stall = ! memory_system2->send(request);
+                stall = ! send_request(memory_system2, static_cast<Ramulator::Addr_t>(address - max_address), Ramulator::Request::Type::Read, static_cast<int>(packet.cpu), rq_it, memory2_id);
 
                 if (stall == false)
                 {
@@ -286,8 +388,7 @@ long MEMORY_CONTROLLER::operate()
             // Assign the request to the right memory.
             if (address < max_address)
             {
-                Ramulator::Request request(static_cast<Ramulator::Addr_t>(address), Ramulator::Request::Type::Write, static_cast<int>(packet.cpu), std::bind(&MEMORY_CONTROLLER::return_data, this, std::placeholders::_1), wq_it, memory_id);
-                stall = ! memory_system->send(request);
+                stall = ! send_request(memory_system, static_cast<Ramulator::Addr_t>(address), Ramulator::Request::Type::Write, static_cast<int>(packet.cpu), wq_it, memory_id);
 
                 if (stall == false)
                 {
@@ -298,8 +399,7 @@ long MEMORY_CONTROLLER::operate()
             else if (address < max_address + max_address2)
             {
                 // The memory itself doesn't know other memories' space, so we manage the overall mapping.
-                Ramulator::Request request(static_cast<Ramulator::Addr_t>(address - max_address), Ramulator::Request::Type::Write, static_cast<int>(packet.cpu), std::bind(&MEMORY_CONTROLLER::return_data, this, std::placeholders::_1), wq_it, memory2_id);
-                stall = ! memory_system2->send(request);
+                stall = ! send_request(memory_system2, static_cast<Ramulator::Addr_t>(address - max_address), Ramulator::Request::Type::Write, static_cast<int>(packet.cpu), wq_it, memory2_id);
 
                 if (stall == false)
                 {
@@ -318,82 +418,82 @@ long MEMORY_CONTROLLER::operate()
 
 #if (MEMORY_USE_SWAPPING_UNIT == ENABLE)
     /* Operate swapping below */
-    uint8_t swapping_states = operate_swapping();
-    switch (swapping_states)
-    {
-    case 0: // The swapping unit is idle
-    {
 #if (MEMORY_USE_OS_TRANSPARENT_MANAGEMENT == ENABLE)
-        OS_TRANSPARENT_MANAGEMENT::RemappingRequest remapping_request;
-        bool issue = os_transparent_management->issue_remapping_request(remapping_request);
-        if (issue == true) // Get a new remapping request.
+    const auto can_start = [this](const OS_TRANSPARENT_MANAGEMENT::RemappingRequest& remapping_request)
+    { return can_start_remapping_request(remapping_request); };
+#endif /* MEMORY_USE_OS_TRANSPARENT_MANAGEMENT */
+
+    for (std::size_t turn = 0; turn < engines.size(); turn++)
+    {
+        SWAPPING_ENGINE& engine = engines[(first_engine + turn) % engines.size()];
+
+        uint8_t swapping_states = operate_swapping(engine);
+        switch (swapping_states)
         {
+        case 0: // The swapping engine is idle
+        {
+#if (MEMORY_USE_OS_TRANSPARENT_MANAGEMENT == ENABLE)
+            OS_TRANSPARENT_MANAGEMENT::RemappingRequest remapping_request;
+            bool issue = os_transparent_management->issue_remapping_request(remapping_request, engine.remapping_request_handle, can_start);
+            if (issue == true) // Get a new remapping request.
+            {
 #if (IDEAL_LINE_LOCATION_TABLE == ENABLE) || (COLOCATED_LINE_LOCATION_TABLE == ENABLE) || (IDEAL_VARIABLE_GRANULARITY == ENABLE)
-            start_swapping_segments(remapping_request.address_in_fm, remapping_request.address_in_sm, remapping_request.size);
+                start_swapping_segments(engine, remapping_request.address_in_fm, remapping_request.address_in_sm, remapping_request.size);
 #elif (IDEAL_SINGLE_MEMPOD == ENABLE)
-            start_swapping_segments(remapping_request.h_address_in_fm, remapping_request.h_address_in_sm, remapping_request.size);
+                start_swapping_segments(engine, remapping_request.h_address_in_fm, remapping_request.h_address_in_sm, remapping_request.size);
 #endif /* IDEAL_LINE_LOCATION_TABLE, COLOCATED_LINE_LOCATION_TABLE, IDEAL_SINGLE_MEMPOD */
-        }
+            }
 #endif /* MEMORY_USE_OS_TRANSPARENT_MANAGEMENT */
-    }
-    break;
-    case 1: // The swapping unit is busy
-    {
-#if (MEMORY_USE_OS_TRANSPARENT_MANAGEMENT == ENABLE)
-        OS_TRANSPARENT_MANAGEMENT::RemappingRequest remapping_request;
-        bool issue = os_transparent_management->issue_remapping_request(remapping_request);
-        if (issue == true) // Get a remapping request.
+        }
+        break;
+        case 1: // The swapping engine is busy
         {
+#if (MEMORY_USE_OS_TRANSPARENT_MANAGEMENT == ENABLE)
+            OS_TRANSPARENT_MANAGEMENT::RemappingRequest remapping_request;
+            os_transparent_management->get_remapping_request(engine.remapping_request_handle, remapping_request);
+
             // In case the swapping segments are updated
 #if (IDEAL_LINE_LOCATION_TABLE == ENABLE) || (COLOCATED_LINE_LOCATION_TABLE == ENABLE) || (IDEAL_VARIABLE_GRANULARITY == ENABLE)
-            update_swapping_segments(remapping_request.address_in_fm, remapping_request.address_in_sm, remapping_request.size);
+            update_swapping_segments(engine, remapping_request.address_in_fm, remapping_request.address_in_sm, remapping_request.size);
 #elif (IDEAL_SINGLE_MEMPOD == ENABLE)
-            update_swapping_segments(remapping_request.h_address_in_fm, remapping_request.h_address_in_sm, remapping_request.size);
+            update_swapping_segments(engine, remapping_request.h_address_in_fm, remapping_request.h_address_in_sm, remapping_request.size);
 #endif /* IDEAL_LINE_LOCATION_TABLE, COLOCATED_LINE_LOCATION_TABLE, IDEAL_SINGLE_MEMPOD */
+#endif /* MEMORY_USE_OS_TRANSPARENT_MANAGEMENT */
         }
-        else
+        break;
+        case 2: // The swapping engine finishes a swapping request
         {
-            std::cout << __func__ << ": issue_remapping_request error." << std::endl;
-            assert(false);
-        }
-#endif /* MEMORY_USE_OS_TRANSPARENT_MANAGEMENT */
-    }
-    break;
-    case 2: // The swapping unit finishes a swapping request
-    {
 #if (MEMORY_USE_OS_TRANSPARENT_MANAGEMENT == ENABLE)
-        bool is_updated = false;
-        OS_TRANSPARENT_MANAGEMENT::RemappingRequest remapping_request;
-        bool issue = os_transparent_management->issue_remapping_request(remapping_request);
-        if (issue == true) // Get a remapping request.
-        {
+            bool is_updated = false;
+            OS_TRANSPARENT_MANAGEMENT::RemappingRequest remapping_request;
+            os_transparent_management->get_remapping_request(engine.remapping_request_handle, remapping_request);
+
             // In case the swapping segments are updated
 #if (IDEAL_LINE_LOCATION_TABLE == ENABLE) || (COLOCATED_LINE_LOCATION_TABLE == ENABLE) || (IDEAL_VARIABLE_GRANULARITY == ENABLE)
-            is_updated = update_swapping_segments(remapping_request.address_in_fm, remapping_request.address_in_sm, remapping_request.size);
+            is_updated = update_swapping_segments(engine, remapping_request.address_in_fm, remapping_request.address_in_sm, remapping_request.size);
 #elif (IDEAL_SINGLE_MEMPOD == ENABLE)
-            is_updated = update_swapping_segments(remapping_request.h_address_in_fm, remapping_request.h_address_in_sm, remapping_request.size);
+            is_updated = update_swapping_segments(engine, remapping_request.h_address_in_fm, remapping_request.h_address_in_sm, remapping_request.size);
 #endif /* IDEAL_LINE_LOCATION_TABLE, COLOCATED_LINE_LOCATION_TABLE, IDEAL_SINGLE_MEMPOD */
-        }
-        else
-        {
-            std::cout << __func__ << ": issue_remapping_request error 2." << std::endl;
-            assert(false);
-        }
 
-        if (is_updated == false)
-        {
-            os_transparent_management->finish_remapping_request();
-            initialize_swapping();
-        }
+            if (is_updated == false)
+            {
+                os_transparent_management->finish_remapping_request(engine.remapping_request_handle);
+                initialize_swapping(engine);
+            }
 #else
 
-        initialize_swapping();
+            initialize_swapping(engine);
 #endif /* MEMORY_USE_OS_TRANSPARENT_MANAGEMENT */
-    }
-    break;
-    default:
+        }
         break;
+        default:
+            break;
+        }
     }
+
+    // The engines take turns to issue first
+    first_engine = static_cast<uint8_t>((first_engine + 1) % engines.size());
+    swapping_cycle++;
 #else
 
 #if (MEMORY_USE_OS_TRANSPARENT_MANAGEMENT == ENABLE)
@@ -409,7 +509,7 @@ long MEMORY_CONTROLLER::operate()
 
 #if (MEMORY_USE_OS_TRANSPARENT_MANAGEMENT == ENABLE)
 #if (IDEAL_SINGLE_MEMPOD == ENABLE)
-    os_transparent_management->check_interval_swap(swapping_states, warmup);
+    os_transparent_management->check_interval_swap(warmup);
 #endif /* IDEAL_SINGLE_MEMPOD */
 #endif /* MEMORY_USE_OS_TRANSPARENT_MANAGEMENT */
 
@@ -470,7 +570,10 @@ void MEMORY_CONTROLLER::print_deadlock()
 #endif /* PRINT_STATISTICS_INTO_FILE */
 
 #if (MEMORY_USE_SWAPPING_UNIT == ENABLE)
-    std::printf("base_address[0]: %ld, base_address[1]: %ld.\n", base_address[0], base_address[1]);
+    for (std::size_t i = 0; i < engines.size(); i++)
+    {
+        std::printf("Swapping engine %zu: base_address[0]: %ld, base_address[1]: %ld.\n", i, engines[i].base_address[0], engines[i].base_address[1]);
+    }
 #endif /* MEMORY_USE_SWAPPING_UNIT */
 }
 
@@ -479,6 +582,11 @@ champsim::data::bytes MEMORY_CONTROLLER::size() const
     return champsim::data::bytes {static_cast<long long>(max_address + max_address2)};
 }
 
+champsim::data::bytes MEMORY_CONTROLLER::fast_memory_size() const
+{
+    return champsim::data::bytes {static_cast<long long>(max_address)};
+}
+
 void MEMORY_CONTROLLER::initiate_requests()
 {
     // Initiate read requests
@@ -593,8 +701,7 @@ bool MEMORY_CONTROLLER::add_rq(request_type& packet, champsim::channel* ul)
     // Assign the request to the right memory.
     if (address < max_address)
     {
-        Ramulator::Request request(static_cast<Ramulator::Addr_t>(address), type, static_cast<int>(packet.cpu), std::bind(&MEMORY_CONTROLLER::return_data, this, std::placeholders::_1), rq_it, memory_id);
-        stall = ! memory_system->send(request);
+        stall = ! send_request(memory_system, static_cast<Ramulator::Addr_t>(address), type, static_cast<int>(packet.cpu), rq_it, memory_id);
 
         if (stall == false)
         {
@@ -632,8 +739,7 @@ bool MEMORY_CONTROLLER::add_rq(request_type& packet, champsim::channel* ul)
     else if (address < max_address + max_address2)
     {
         // The memory itself doesn't know other memories' space, so we manage the overall mapping.
-        Ramulator::Request request(static_cast<Ramulator::Addr_t>(address - max_address), type, static_cast<int>(packet.cpu), std::bind(&MEMORY_CONTROLLER::return_data, this, std::placeholders::_1), rq_it, memory2_id);
-        stall = ! memory_system2->send(request);
+        stall = ! send_request(memory_system2, static_cast<Ramulator::Addr_t>(address - max_address), type, static_cast<int>(packet.cpu), rq_it, memory2_id);
 
         if (stall == false)
         {
@@ -670,6 +776,11 @@ bool MEMORY_CONTROLLER::add_rq(request_type& packet, champsim::channel* ul)
         return false; // Queue is full, note Ramulator doesn't merge requests.
     }
 
+#if (SHADOW_OS_TRANSPARENT_MANAGEMENT == ENABLE)
+    // Only accepted requests are tracked, so a request retried after a stall counts once
+    shadow_management->memory_activity_tracking(packet.address.to<uint64_t>(), current_time, warmup);
+#endif /* SHADOW_OS_TRANSPARENT_MANAGEMENT */
+
     return true;
 }
 
@@ -730,8 +841,7 @@ bool MEMORY_CONTROLLER::add_wq(request_type& packet)
     }
 
     address = wq_it.h_address_fm = packet.h_address_fm; // Pretend to access the Location Entry and Data (LEAD) in fast memory
-    Ramulator::Request request(static_cast<Ramulator::Addr_t>(address), Ramulator::Request::Type::Read, static_cast<int>(packet.cpu), std::bind(&MEMORY_CONTROLLER::return_data, this, std::placeholders::_1), wq_it, memory_id);
-    stall = ! memory_system->send(request);
+    stall = ! send_request(memory_system, static_cast<Ramulator::Addr_t>(address), Ramulator::Request::Type::Read, static_cast<int>(packet.cpu), wq_it, memory_id);
 
     if (stall == false)
     {
@@ -757,8 +867,7 @@ bool MEMORY_CONTROLLER::add_wq(request_type& packet)
     // Assign the request to the right memory.
     if (address < max_address)
     {
-        Ramulator::Request request(static_cast<Ramulator::Addr_t>(address), type, static_cast<int>(packet.cpu), std::bind(&MEMORY_CONTROLLER::return_data, this, std::placeholders::_1), wq_it, memory_id);
-        stall = ! memory_system->send(request);
+        stall = ! send_request(memory_system, static_cast<Ramulator::Addr_t>(address), type, static_cast<int>(packet.cpu), wq_it, memory_id);
 
         if (stall == false)
         {
@@ -768,8 +877,7 @@ bool MEMORY_CONTROLLER::add_wq(request_type& packet)
     else if (address < max_address + max_address2)
     {
         // The memory itself doesn't know other memories' space, so we manage the overall mapping.
-        Ramulator::Request request(static_cast<Ramulator::Addr_t>(address - max_address), type, static_cast<int>(packet.cpu), std::bind(&MEMORY_CONTROLLER::return_data, this, std::placeholders::_1), wq_it, memory2_id);
-        stall = ! memory_system2->send(request);
+        stall = ! send_request(memory_system2, static_cast<Ramulator::Addr_t>(address - max_address), type, static_cast<int>(packet.cpu), wq_it, memory2_id);
 
         if (stall == false)
         {
@@ -791,6 +899,11 @@ bool MEMORY_CONTROLLER::add_wq(request_type& packet)
         return false; // Queue is full, note Ramulator doesn't merge requests.
     }
 
+#if (SHADOW_OS_TRANSPARENT_MANAGEMENT == ENABLE)
+    // Only accepted requests are tracked, so a request retried after a stall counts once
+    shadow_management->memory_activity_tracking(packet.address.to<uint64_t>(), current_time, warmup);
+#endif /* SHADOW_OS_TRANSPARENT_MANAGEMENT */
+
     return true;
 }
 
@@ -848,8 +961,31 @@ size_t MEMORY_CONTROLLER::get_queue_size(RequestType queue_type, uint64_t addres
     return 0;
 };
 
+#if (TELEMETRY == ENABLE)
+std::vector<Ramulator::ChannelCounters> MEMORY_CONTROLLER::get_channel_counters(uint8_t memory) const
+{
+    const Ramulator::IMemorySystem* system = (memory == memory_id) ? memory_system : memory_system2;
+
+    std::vector<Ramulator::ChannelCounters> counters(system->get_channel());
+    for (std::size_t channel = 0; channel < counters.size(); channel++)
+    {
+        counters[channel] = system->get_channel_counters(static_cast<int>(channel));
+    }
+    return counters;
+};
+#endif /* TELEMETRY */
+
 void MEMORY_CONTROLLER::return_data(Ramulator::Request& request)
 {
+    if (request.packet_handle == PacketTable::NO_PACKET)
+    {
+        return; // Write requests don't return responses
+    }
+
+    // Sending requests is the only way to reuse the entry, so the packet stays valid in this function
+    const DRAM_CHANNEL::request_type& packet = packets[request.packet_handle];
+    packets.release(request.packet_handle);
+
     // Recover the hardware address to physical address.
     switch (request.memory_id)
     {
@@ -873,7 +1009,7 @@ void MEMORY_CONTROLLER::return_data(Ramulator::Request& request)
     if (uint64_t(request.addr) < max_address)
     {
         // This could be an uncomplete write request
-        bool finish = os_transparent_management->finish_fm_access_in_incomplete_write_request_queue(request.packet.h_address);
+        bool finish = os_transparent_management->finish_fm_access_in_incomplete_write_request_queue(packet.h_address);
         if (finish)
         {
             finish_return_data = true;
@@ -881,10 +1017,10 @@ void MEMORY_CONTROLLER::return_data(Ramulator::Request& request)
         }
     }
 
-    if ((uint64_t(request.addr) < max_address) && (max_address <= request.packet.h_address))
+    if ((uint64_t(request.addr) < max_address) && (max_address <= packet.h_address))
     {
         // This could be an uncomplete read request
-        bool finish = os_transparent_management->finish_fm_access_in_incomplete_read_request_queue(request.packet.h_address);
+        bool finish = os_transparent_management->finish_fm_access_in_incomplete_read_request_queue(packet.h_address);
 
         if (finish)
         {
@@ -896,18 +1032,18 @@ void MEMORY_CONTROLLER::return_data(Ramulator::Request& request)
     if (finish_return_data == false)
     {
         // This is a complete read request
-        response_type response {request.packet.address, request.packet.v_address, request.packet.data, request.packet.pf_metadata, request.packet.instr_depend_on_me};
+        response_type response {packet.address, packet.v_address, packet.data, packet.pf_metadata, packet.instr_depend_on_me};
 
-        for (auto ret : request.packet.to_return)
+        for (auto ret : packet.to_return)
         {
             ret->push_back(response); // Fill the response into the response queue
         }
     }
 
 #else
-    response_type response {request.packet.address, request.packet.v_address, request.packet.data, request.packet.pf_metadata, request.packet.instr_depend_on_me};
+    response_type response {packet.address, packet.v_address, packet.data, packet.pf_metadata, packet.instr_depend_on_me};
 
-    for (auto ret : request.packet.to_return)
+    for (auto ret : packet.to_return)
     {
         ret->push_back(response); // Fill the response into the response queue
     }
@@ -917,56 +1053,105 @@ void MEMORY_CONTROLLER::return_data(Ramulator::Request& request)
 #if (MEMORY_USE_SWAPPING_UNIT == ENABLE)
 
 // Functions for swapping:
-void MEMORY_CONTROLLER::initialize_swapping()
+#if (MEMORY_USE_OS_TRANSPARENT_MANAGEMENT == ENABLE)
+bool MEMORY_CONTROLLER::can_start_remapping_request(const OS_TRANSPARENT_MANAGEMENT::RemappingRequest& remapping_request)
 {
-    swapping_count += active_entry_number * 2;
-    swapping_traffic_in_bytes += active_entry_number * 2 * BLOCK_SIZE;
+#if (IDEAL_LINE_LOCATION_TABLE == ENABLE) || (COLOCATED_LINE_LOCATION_TABLE == ENABLE) || (IDEAL_VARIABLE_GRANULARITY == ENABLE)
+    return is_under_swapping(remapping_request.address_in_fm, remapping_request.address_in_sm, remapping_request.size) == false;
+#elif (IDEAL_SINGLE_MEMPOD == ENABLE)
+    return is_under_swapping(remapping_request.h_address_in_fm, remapping_request.h_address_in_sm, remapping_request.size) == false;
+#endif /* IDEAL_LINE_LOCATION_TABLE, COLOCATED_LINE_LOCATION_TABLE, IDEAL_SINGLE_MEMPOD */
+};
+#endif /* MEMORY_USE_OS_TRANSPARENT_MANAGEMENT */
+
+void MEMORY_CONTROLLER::initialize_swapping(SWAPPING_ENGINE& engine)
+{
+    swapping_count += engine.active_entry_number * 2;
+    swapping_traffic_in_bytes += engine.active_entry_number * 2 * BLOCK_SIZE;
 
-    states = SwappingState::Idle;
+    if (engine.active_entry_number > 0)
+    {
+        const uint64_t latency = swapping_cycle - engine.start_cycle;
+
+        engine.statistics.swaps++;
+        engine.statistics.traffic_in_bytes += engine.active_entry_number * 2 * BLOCK_SIZE;
+        engine.statistics.busy_cycles += latency;
+        engine.statistics.max_latency_cycles = std::max(engine.statistics.max_latency_cycles, latency);
+        engine.statistics.latency_distribution[std::min<std::size_t>(std::bit_width(latency), SWAPPING_LATENCY_BUCKET_NUMBER - 1)]++;
+    }
+
+    engine.states = SwappingState::Idle;
     for (auto i = 0; i < SWAPPING_BUFFER_ENTRY_NUMBER; i++)
     {
-        buffer[i].finish = false;
+        engine.buffer[i].finish = false;
         for (auto j = 0; j < SWAPPING_SEGMENT_NUMBER; j++)
         {
             for (uint64_t z = 0; z < BLOCK_SIZE; z++)
             {
-                buffer[i].data[j][z] = 0;
+                engine.buffer[i].data[j][z] = 0;
             }
-            buffer[i].read_issue[j] = false;
-            buffer[i].read[j]       = false;
-            buffer[i].write[j]      = false;
-            buffer[i].dirty[j]      = false;
+            engine.buffer[i].read_issue[j] = false;
+            engine.buffer[i].read[j]       = false;
+            engine.buffer[i].write[j]      = false;
+            engine.buffer[i].dirty[j]      = false;
         }
     }
 
     for (auto i = 0; i < SWAPPING_SEGMENT_NUMBER; i++)
     {
-        base_address[i] = 0;
+        engine.base_address[i] = 0;
     }
-    active_entry_number = finish_number = 0;
+    engine.active_entry_number = engine.finish_number = 0;
 }
 
 // Input address should be hardware address and at byte granularity
 bool MEMORY_CONTROLLER::start_swapping_segments(uint64_t address_1, uint64_t address_2, uint8_t size)
+{
+    for (SWAPPING_ENGINE& engine : engines)
+    {
+        if (start_swapping_segments(engine, address_1, address_2, size))
+        {
+            return true; // New swapping is issued.
+        }
+    }
+
+    return false; // All engines are busy, they cannot issue new swapping request.
+}
+
+bool MEMORY_CONTROLLER::start_swapping_segments(SWAPPING_ENGINE& engine, uint64_t address_1, uint64_t address_2, uint8_t size)
 {
     assert(size <= SWAPPING_BUFFER_ENTRY_NUMBER);
 
-    if (states == SwappingState::Idle)
+    if (engine.states == SwappingState::Idle)
     {
-        states              = SwappingState::Swapping;      // Start swapping.
-        base_address[0]     = address_1 >> LOG2_BLOCK_SIZE; // The single swapping is conducted at cache line granularity.
-        base_address[1]     = address_2 >> LOG2_BLOCK_SIZE;
-        active_entry_number = size;
+        engine.states              = SwappingState::Swapping;      // Start swapping.
+        engine.base_address[0]     = address_1 >> LOG2_BLOCK_SIZE; // The single swapping is conducted at cache line granularity.
+        engine.base_address[1]     = address_2 >> LOG2_BLOCK_SIZE;
+        engine.active_entry_number = size;
+        engine.start_cycle         = swapping_cycle;
     }
     else
     {
-        return false; // This swapping unit is busy, it cannot issue new swapping request.
+        return false; // This swapping engine is busy, it cannot issue new swapping request.
     }
     return true; // New swapping is issued.
 }
 
 // Input address should be hardware address and at byte granularity
 bool MEMORY_CONTROLLER::update_swapping_segments(uint64_t address_1, uint64_t address_2, uint8_t size)
+{
+    for (SWAPPING_ENGINE& engine : engines)
+    {
+        if (update_swapping_segments(engine, address_1, address_2, size))
+        {
+            return true; // Update swapping segments
+        }
+    }
+
+    return false;
+}
+
+bool MEMORY_CONTROLLER::update_swapping_segments(SWAPPING_ENGINE& engine, uint64_t address_1, uint64_t address_2, uint8_t size)
 {
     assert(size <= SWAPPING_BUFFER_ENTRY_NUMBER);
 
@@ -975,16 +1160,16 @@ bool MEMORY_CONTROLLER::update_swapping_segments(uint64_t address_1, uint64_t ad
     input_base_address[0] = address_1 >> LOG2_BLOCK_SIZE;
     input_base_address[1] = address_2 >> LOG2_BLOCK_SIZE;
 
-    if ((input_base_address[0] == base_address[0]) && (input_base_address[1] == base_address[1]))
+    if ((input_base_address[0] == engine.base_address[0]) && (input_base_address[1] == engine.base_address[1]))
     {
         // They are same swapping segments
-        if (size > active_entry_number)
+        if (size > engine.active_entry_number)
         {
             // There have new data to swap
-            active_entry_number = size;
-            if (states == SwappingState::Idle)
+            engine.active_entry_number = size;
+            if (engine.states == SwappingState::Idle)
             {
-                states = SwappingState::Swapping; // Start swapping.
+                engine.states = SwappingState::Swapping; // Start swapping.
             }
 
             return true; // Update swapping segments
@@ -994,11 +1179,14 @@ bool MEMORY_CONTROLLER::update_swapping_segments(uint64_t address_1, uint64_t ad
     return false;
 }
 
-uint8_t MEMORY_CONTROLLER::operate_swapping()
+uint8_t MEMORY_CONTROLLER::operate_swapping(SWAPPING_ENGINE& engine)
 {
     const static int coreid = 0;
 
-    switch (states)
+    std::array<BUFFER_ENTRY, SWAPPING_BUFFER_ENTRY_NUMBER>& buffer = engine.buffer;
+    const uint64_t* base_address                                   = engine.base_address;
+
+    switch (engine.states)
     {
     case SwappingState::Idle:
     {
@@ -1007,11 +1195,27 @@ uint8_t MEMORY_CONTROLLER::operate_swapping()
     break;
     case SwappingState::Swapping:
     {
+        // Lines whose reads are issued and whose swap is not finished, which buffer_depth bounds
+        uint8_t in_flight_number = 0;
+        for (auto i = 0; i < engine.active_entry_number; i++)
+        {
+            if ((buffer[i].finish == false) && (buffer[i].read_issue[0] || buffer[i].read_issue[1]))
+            {
+                in_flight_number++;
+            }
+        }
+
         // Issue read requests
-        for (auto i = 0; i < active_entry_number; i++) // Go through the active buffer
+        for (auto i = 0; i < engine.active_entry_number; i++) // Go through the active buffer
         {
             if (buffer[i].finish == false)
             {
+                const bool started = buffer[i].read_issue[0] || buffer[i].read_issue[1];
+                if ((started == false) && (in_flight_number >= engine.buffer_depth))
+                {
+                    continue; // A later line may have started already and still have a read to issue
+                }
+
                 for (auto j = 0; j < SWAPPING_SEGMENT_NUMBER; j++)
                 {
                     if (buffer[i].read_issue[j] == false)
@@ -1022,13 +1226,13 @@ uint8_t MEMORY_CONTROLLER::operate_swapping()
                         // Assign the request to the right memory.
                         if (address < max_address)
                         {
-                            Ramulator::Request request(static_cast<Ramulator::Addr_t>(address), Ramulator::Request::Type::Read, coreid, std::bind(&MEMORY_CONTROLLER::return_swapping_data, this, std::placeholders::_1), memory_id);
+                            Ramulator::Request request(static_cast<Ramulator::Addr_t>(address), Ramulator::Request::Type::Read, coreid, Ramulator::RequestCallback::to<&MEMORY_CONTROLLER::return_swapping_data>(this), memory_id);
                             stall = ! memory_system->send(request);
                         }
                         else if (address < max_address + max_address2)
                         {
                             // The memory itself doesn't know other memories' space, so we manage the overall mapping.
-                            Ramulator::Request request(static_cast<Ramulator::Addr_t>(address - max_address), Ramulator::Request::Type::Read, coreid, std::bind(&MEMORY_CONTROLLER::return_swapping_data, this, std::placeholders::_1), memory2_id);
+                            Ramulator::Request request(static_cast<Ramulator::Addr_t>(address - max_address), Ramulator::Request::Type::Read, coreid, Ramulator::RequestCallback::to<&MEMORY_CONTROLLER::return_swapping_data>(this), memory2_id);
                             stall = ! memory_system2->send(request);
                         }
                         else
@@ -1051,11 +1255,16 @@ uint8_t MEMORY_CONTROLLER::operate_swapping()
                         }
                     }
                 }
+
+                if ((started == false) && (buffer[i].read_issue[0] || buffer[i].read_issue[1]))
+                {
+                    in_flight_number++;
+                }
             }
         }
 
         // Issue write requests
-        for (auto i = 0; i < active_entry_number; i++) // Go through the active buffer
+        for (auto i = 0; i < engine.active_entry_number; i++) // Go through the active buffer
         {
             if (buffer[i].finish == false)
             {
@@ -1121,15 +1330,15 @@ uint8_t MEMORY_CONTROLLER::operate_swapping()
                 if ((buffer[i].write[0] == true) && (buffer[i].write[1] == true))
                 {
                     buffer[i].finish = true;
-                    finish_number++;
+                    engine.finish_number++;
                 }
             }
         }
 
         // Check finish_number
-        if (finish_number == active_entry_number)
+        if (engine.finish_number == engine.active_entry_number)
         {
-            states = SwappingState::Idle;
+            engine.states = SwappingState::Idle;
             return 2; // Finished swapping
         }
 
@@ -1146,14 +1355,6 @@ uint8_t MEMORY_CONTROLLER::operate_swapping()
 // This function is used by memories, like Ramulator.
 void MEMORY_CONTROLLER::return_swapping_data(Ramulator::Request& request)
 {
-    // Sanity check
-    // assert(states == SwappingState::Swapping);
-    if (states == SwappingState::Idle)
-    {
-        std::cout << __func__ << ": data is returned while swapping is already finished." << std::endl;
-        return;
-    }
-
     // Recover the hardware address to physical address.
     switch (request.memory_id)
     {
@@ -1171,41 +1372,106 @@ void MEMORY_CONTROLLER::return_swapping_data(Ramulator::Request& request)
     break;
     }
 
+    // The read belongs to the engine that issued it and still waits for its data. Engines start on disjoint segments,
+    // but a segment that grows while it is swapped may reach into another engine's, so the first engine swapping the address may not own it.
     uint64_t address = request.addr >> LOG2_BLOCK_SIZE;
     uint8_t segment_index;
     uint8_t entry_index;
-    // Calculate entry index in the fashion of little-endian.
-    if ((base_address[SWAPPING_SEGMENT_ONE] <= address) && (address < (base_address[SWAPPING_SEGMENT_ONE] + active_entry_number)))
+    SWAPPING_ENGINE* engine = nullptr;
+    for (SWAPPING_ENGINE& candidate : engines)
     {
-        segment_index = SWAPPING_SEGMENT_TWO;
-        entry_index   = static_cast<uint8_t>(address - base_address[SWAPPING_SEGMENT_ONE]);
+        if (find_swapping_entry(candidate, address, segment_index, entry_index) && is_waiting_for_read(candidate.buffer[entry_index], segment_index))
+        {
+            engine = &candidate;
+            break;
+        }
+    }
+
+    if (engine == nullptr)
+    {
+        // An engine finishes only after all its reads return, so every read has an owner
+        std::cout << __func__ << ": swapping error." << std::endl;
+        assert(false);
+        return;
+    }
 
 #if (TEST_SWAPPING_UNIT == ENABLE)
-        request.data = memory_data[entry_index];
+    request.data = memory_data[entry_index + segment_index * MEMORY_DATA_NUMBER / 2];
 #endif /* TEST_SWAPPING_UNIT */
+
+    // The data read from a segment is written to the other one
+    segment_index       = (segment_index == SWAPPING_SEGMENT_ONE) ? SWAPPING_SEGMENT_TWO : SWAPPING_SEGMENT_ONE;
+
+    BUFFER_ENTRY& entry = engine->buffer[entry_index];
+
+    // Read data
+    if ((entry.finish == false) && (entry.write[segment_index] == false) && (entry.dirty[segment_index] == false))
+    {
+        entry.data[segment_index] = request.data;
+        entry.read[segment_index] = true;
     }
-    else if ((base_address[SWAPPING_SEGMENT_TWO] <= address) && (address < (base_address[SWAPPING_SEGMENT_TWO] + active_entry_number)))
+};
+
+MEMORY_CONTROLLER::SWAPPING_ENGINE* MEMORY_CONTROLLER::find_swapping_entry(uint64_t address, uint8_t& segment_index, uint8_t& entry_index)
+{
+    for (SWAPPING_ENGINE& engine : engines)
     {
-        segment_index = SWAPPING_SEGMENT_ONE;
-        entry_index   = static_cast<uint8_t>(address - base_address[SWAPPING_SEGMENT_TWO]);
+        if (find_swapping_entry(engine, address, segment_index, entry_index))
+        {
+            return &engine;
+        }
+    }
 
-#if (TEST_SWAPPING_UNIT == ENABLE)
-        request.data = memory_data[entry_index + MEMORY_DATA_NUMBER / 2];
-#endif /* TEST_SWAPPING_UNIT */
+    return nullptr; // This address is not under swapping.
+}
+
+bool MEMORY_CONTROLLER::find_swapping_entry(const SWAPPING_ENGINE& engine, uint64_t address, uint8_t& segment_index, uint8_t& entry_index) const
+{
+    // Calculate entry index in the fashion of little-endian.
+    if ((engine.base_address[SWAPPING_SEGMENT_ONE] <= address) && (address < (engine.base_address[SWAPPING_SEGMENT_ONE] + engine.active_entry_number)))
+    {
+        segment_index = SWAPPING_SEGMENT_ONE;
+        entry_index   = static_cast<uint8_t>(address - engine.base_address[SWAPPING_SEGMENT_ONE]);
+        return true;
     }
-    else
+    else if ((engine.base_address[SWAPPING_SEGMENT_TWO] <= address) && (address < (engine.base_address[SWAPPING_SEGMENT_TWO] + engine.active_entry_number)))
     {
-        std::cout << __func__ << ": swapping error." << std::endl;
-        assert(false);
+        segment_index = SWAPPING_SEGMENT_TWO;
+        entry_index   = static_cast<uint8_t>(address - engine.base_address[SWAPPING_SEGMENT_TWO]);
+        return true;
     }
 
-    // Read data
-    if ((buffer[entry_index].finish == false) && (buffer[entry_index].write[segment_index] == false) && (buffer[entry_index].dirty[segment_index] == false))
+    return false; // This engine doesn't swap this address.
+}
+
+bool MEMORY_CONTROLLER::is_waiting_for_read(const BUFFER_ENTRY& entry, uint8_t segment_index)
+{
+    // The data read from a segment is kept for the other one
+    const uint8_t other_segment_index = (segment_index == SWAPPING_SEGMENT_ONE) ? SWAPPING_SEGMENT_TWO : SWAPPING_SEGMENT_ONE;
+    return (entry.read_issue[segment_index] == true) && (entry.read[other_segment_index] == false);
+}
+
+// Input address should be hardware address and at byte granularity
+bool MEMORY_CONTROLLER::is_under_swapping(uint64_t address_1, uint64_t address_2, uint8_t size)
+{
+    const uint64_t segment[SWAPPING_SEGMENT_NUMBER] = {address_1 >> LOG2_BLOCK_SIZE, address_2 >> LOG2_BLOCK_SIZE};
+
+    for (const SWAPPING_ENGINE& engine : engines)
     {
-        buffer[entry_index].data[segment_index] = request.data;
-        buffer[entry_index].read[segment_index] = true;
+        for (auto i = 0; i < SWAPPING_SEGMENT_NUMBER; i++)
+        {
+            for (auto j = 0; j < SWAPPING_SEGMENT_NUMBER; j++)
+            {
+                if ((segment[i] < engine.base_address[j] + engine.active_entry_number) && (engine.base_address[j] < segment[i] + size))
+                {
+                    return true; // The segments overlap
+                }
+            }
+        }
     }
-};
+
+    return false;
+}
 
 uint8_t MEMORY_CONTROLLER::check_request(request_type& packet, OS_TRANSPARENT_MANAGEMENT::MemoryRequestType type)
 {
@@ -1219,27 +1485,19 @@ uint8_t MEMORY_CONTROLLER::check_request(request_type& packet, OS_TRANSPARENT_MA
     address >>= LOG2_BLOCK_SIZE;
     uint8_t segment_index;
     uint8_t entry_index;
-    // Calculate entry index in the fashion of little-endian.
-    if ((base_address[SWAPPING_SEGMENT_ONE] <= address) && (address < (base_address[SWAPPING_SEGMENT_ONE] + active_entry_number)))
-    {
-        segment_index = SWAPPING_SEGMENT_ONE;
-        entry_index   = static_cast<uint8_t>(address - base_address[SWAPPING_SEGMENT_ONE]);
-    }
-    else if ((base_address[SWAPPING_SEGMENT_TWO] <= address) && (address < (base_address[SWAPPING_SEGMENT_TWO] + active_entry_number)))
-    {
-        segment_index = SWAPPING_SEGMENT_TWO;
-        entry_index   = static_cast<uint8_t>(address - base_address[SWAPPING_SEGMENT_TWO]);
-    }
-    else
+    SWAPPING_ENGINE* engine = find_swapping_entry(address, segment_index, entry_index);
+    if (engine == nullptr)
     {
         return 1; // This address is not under swapping.
     }
 
+    BUFFER_ENTRY& entry = engine->buffer[entry_index];
+
     if (type == OS_TRANSPARENT_MANAGEMENT::MemoryRequestType::Read) // For read request
     {
-        if ((buffer[entry_index].finish == true) || (buffer[entry_index].read[segment_index] == true) || (buffer[entry_index].write[segment_index] == true) || (buffer[entry_index].dirty[segment_index] == true))
+        if ((entry.finish == true) || (entry.read[segment_index] == true) || (entry.write[segment_index] == true) || (entry.dirty[segment_index] == true))
         {
-            uint64_t& read_data = *((uint64_t*) (&buffer[entry_index].data[segment_index])); // Note the PACKET only has 64 bit data.
+            uint64_t& read_data = *((uint64_t*) (&entry.data[segment_index])); // Note the PACKET only has 64 bit data.
             packet.data         = champsim::address {read_data};
 
             return 2; // Though this address is under swapping, we can service its request because the data is in the swapping buffer.
@@ -1247,17 +1505,17 @@ uint8_t MEMORY_CONTROLLER::check_request(request_type& packet, OS_TRANSPARENT_MA
     }
     else if (type == OS_TRANSPARENT_MANAGEMENT::MemoryRequestType::Write) // For write request
     {
-        if ((buffer[entry_index].read[0] == true) && (buffer[entry_index].read[1] == true))
+        if ((entry.read[0] == true) && (entry.read[1] == true))
         {
-            uint64_t& write_data                     = *((uint64_t*) (&buffer[entry_index].data[segment_index])); // Note the PACKET only has 64 bit data.
-            write_data                               = packet.data.to<uint64_t>();
-            buffer[entry_index].dirty[segment_index] = true;
+            uint64_t& write_data       = *((uint64_t*) (&entry.data[segment_index])); // Note the PACKET only has 64 bit data.
+            write_data                 = packet.data.to<uint64_t>();
+            entry.dirty[segment_index] = true;
 
-            if (buffer[entry_index].finish == true)
+            if (entry.finish == true)
             {
-                --finish_number;
+                --engine->finish_number;
             }
-            buffer[entry_index].finish = false;
+            entry.finish = false;
 
             return 2; // Though this address is under swapping, we can service its request because the data is in the swapping buffer.
         }
@@ -1281,32 +1539,24 @@ uint8_t MEMORY_CONTROLLER::check_address(uint64_t address, uint8_t type)
     address >>= LOG2_BLOCK_SIZE;
     uint8_t segment_index;
     uint8_t entry_index;
-    // Calculate entry index in the fashion of little-endian.
-    if ((base_address[SWAPPING_SEGMENT_ONE] <= address) && (address < (base_address[SWAPPING_SEGMENT_ONE] + active_entry_number)))
-    {
-        segment_index = SWAPPING_SEGMENT_ONE;
-        entry_index   = static_cast<uint8_t>(address - base_address[SWAPPING_SEGMENT_ONE]);
-    }
-    else if ((base_address[SWAPPING_SEGMENT_TWO] <= address) && (address < (base_address[SWAPPING_SEGMENT_TWO] + active_entry_number)))
-    {
-        segment_index = SWAPPING_SEGMENT_TWO;
-        entry_index   = static_cast<uint8_t>(address - base_address[SWAPPING_SEGMENT_TWO]);
-    }
-    else
+    SWAPPING_ENGINE* engine = find_swapping_entry(address, segment_index, entry_index);
+    if (engine == nullptr)
     {
         return 1; // This address is not under swapping.
     }
 
+    const BUFFER_ENTRY& entry = engine->buffer[entry_index];
+
     if (type == 1) // For read request
     {
-        if ((buffer[entry_index].finish == true) || (buffer[entry_index].read[segment_index] == true) || (buffer[entry_index].write[segment_index] == true) || (buffer[entry_index].dirty[segment_index] == true))
+        if ((entry.finish == true) || (entry.read[segment_index] == true) || (entry.write[segment_index] == true) || (entry.dirty[segment_index] == true))
         {
             return 2; // Though this address is under swapping, we can service its request because the data is in the swapping buffer.
         }
     }
     else if (type == 2) // For write request
     {
-        if ((buffer[entry_index].read[0] == true) && (buffer[entry_index].read[1] == true))
+        if ((entry.read[0] == true) && (entry.read[1] == true))
         {
             return 2; // Though this address is under swapping, we can service its request because the data is in the swapping buffer.
         }
@@ -1439,7 +1689,6 @@ long MEMORY_CONTROLLER::operate()
     initiate_requests();
 
     /* Operate memories below */
-    static double leap_operation = 0;
     // Skip periodically
     if (leap_operation >= 1)
     {
@@ -1456,6 +1705,70 @@ long MEMORY_CONTROLLER::operate()
     return progress;
 }
 
+#if (EVENT_DRIVEN_SKIP_AHEAD == ENABLE)
+champsim::chrono::clock::time_point MEMORY_CONTROLLER::next_event_time() const
+{
+    const auto next_cycle = current_time + clock_period;
+
+    // Requests rejected by the memory system are resent every cycle
+    auto has_request      = [](const channel_type* ul)
+    {
+        return ! std::empty(ul->RQ) || ! std::empty(ul->WQ) || ! std::empty(ul->PQ);
+    };
+    if (std::any_of(std::begin(queues), std::end(queues), has_request))
+    {
+        return next_cycle;
+    }
+
+    // Find the CPU cycle in which the memory system ticks for the cycles_to_event-th time
+    const Ramulator::Clk_t cycles_to_event = memory_system->get_cycles_to_next_event();
+    Ramulator::Clk_t ticks                 = 0;
+    double leap                            = leap_operation;
+    long cycles                            = 0;
+    while (ticks < cycles_to_event && cycles < MAX_SKIP_CYCLES)
+    {
+        ++cycles;
+        if (leap >= 1)
+        {
+            leap -= 1;
+        }
+        else
+        {
+            leap += io_freq_scale;
+            ++ticks;
+        }
+    }
+
+    return current_time + clock_period * cycles;
+}
+
+long MEMORY_CONTROLLER::skip_cycles(long cycles)
+{
+    // Replay the clock ratio, so the memory system ticks in the same CPU cycles as with operate()
+    Ramulator::Clk_t ticks = 0;
+    for (long i = 0; i < cycles; ++i)
+    {
+        if (leap_operation >= 1)
+        {
+            leap_operation -= 1;
+        }
+        else
+        {
+            leap_operation += io_freq_scale;
+            ++ticks;
+        }
+    }
+
+    if (ticks > 0)
+    {
+        memory_system->skip_cycles(ticks);
+    }
+
+    champsim::operable::skip_cycles(cycles);
+    return ticks;
+}
+#endif /* EVENT_DRIVEN_SKIP_AHEAD */
+
 void MEMORY_CONTROLLER::begin_phase()
 {
     for (auto* ul : queues)
@@ -1531,8 +1844,7 @@ bool MEMORY_CONTROLLER::add_rq(const request_type& packet, champsim::channel* ul
     // Assign the request to the right memory.
     if (address < max_address)
     {
-        Ramulator::Request request(static_cast<Ramulator::Addr_t>(address), type, static_cast<int>(packet.cpu), std::bind(&MEMORY_CONTROLLER::return_data, this, std::placeholders::_1), rq_it, memory_id);
-        stall = ! memory_system->send(request);
+        stall = ! send_request(memory_system, static_cast<Ramulator::Addr_t>(address), type, static_cast<int>(packet.cpu), rq_it, memory_id);
 
         if (stall == false)
         {
@@ -1573,8 +1885,7 @@ bool MEMORY_CONTROLLER::add_wq(const request_type& packet)
     // Assign the request to the right memory.
     if (address < max_address)
     {
-        Ramulator::Request request(static_cast<Ramulator::Addr_t>(address), type, static_cast<int>(packet.cpu), std::bind(&MEMORY_CONTROLLER::return_data, this, std::placeholders::_1), wq_it, memory_id);
-        stall = ! memory_system->send(request);
+        stall = ! send_request(memory_system, static_cast<Ramulator::Addr_t>(address), type, static_cast<int>(packet.cpu), wq_it, memory_id);
 
         if (stall == false)
         {
@@ -1635,11 +1946,32 @@ size_t MEMORY_CONTROLLER::get_queue_size(RequestType queue_type, uint64_t addres
     return 0;
 };
 
+#if (TELEMETRY == ENABLE)
+std::vector<Ramulator::ChannelCounters> MEMORY_CONTROLLER::get_channel_counters([[maybe_unused]] uint8_t memory) const
+{
+    std::vector<Ramulator::ChannelCounters> counters(memory_system->get_channel());
+    for (std::size_t channel = 0; channel < counters.size(); channel++)
+    {
+        counters[channel] = memory_system->get_channel_counters(static_cast<int>(channel));
+    }
+    return counters;
+};
+#endif /* TELEMETRY */
+
 void MEMORY_CONTROLLER::return_data(Ramulator::Request& request)
 {
-    response_type response {request.packet.address, request.packet.v_address, request.packet.data, request.packet.pf_metadata, request.packet.instr_depend_on_me};
+    if (request.packet_handle == PacketTable::NO_PACKET)
+    {
+        return; // Write requests don't return responses
+    }
+
+    // Sending requests is the only way to reuse the entry, so the packet stays valid in this function
+    const DRAM_CHANNEL::request_type& packet = packets[request.packet_handle];
+    packets.release(request.packet_handle);
+
+    response_type response {packet.address, packet.v_address, packet.data, packet.pf_metadata, packet.instr_depend_on_me};
 
-    for (auto ret : request.packet.to_return)
+    for (auto ret : packet.to_return)
     {
         ret->push_back(response); // Fill the response into the response queue
     }
@@ -5,6 +5,10 @@
 #include <random>
 #include <utility>
 
+#if (USER_CODES == ENABLE)
+#include "ChampSim/checkpoint.h"
+#endif /* USER_CODES */
+
 drrip::drrip(CACHE* cache)
 : replacement(cache), NUM_SET(cache->NUM_SET), NUM_WAY(cache->NUM_WAY), rrpv(static_cast<std::size_t>(NUM_SET * NUM_WAY)),
   PSEL(NUM_CPUS, champsim::msl::dscounter<long, PSEL_WIDTH>(champsim::msl::get_sample_rate(NUM_SET)))
@@ -79,3 +83,10 @@ long drrip::find_victim(uint32_t triggering_cpu, uint64_t instr_id, long set, co
     assert(victim < end);
     return std::distance(begin, victim); // cast protected by assertions
 }
+
+#if (USER_CODES == ENABLE)
+void drrip::replacement_checkpoint(champsim::checkpoint_archive& archive)
+{
+    archive(brrip_counter, rrpv, PSEL);
+}
+#endif /* USER_CODES */
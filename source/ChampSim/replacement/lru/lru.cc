@@ -5,6 +5,10 @@
 
 #include "ChampSim/cache.h"
 
+#if (USER_CODES == ENABLE)
+#include "ChampSim/checkpoint.h"
+#endif /* USER_CODES */
+
 lru::lru(CACHE* cache): lru(cache, cache->NUM_SET, cache->NUM_WAY) {}
 
 lru::lru(CACHE* cache, long sets, long ways): replacement(cache), NUM_WAY(ways), last_used_cycles(static_cast<std::size_t>(sets * ways), 0) {}
@@ -33,3 +37,10 @@ void lru::update_replacement_state(uint32_t triggering_cpu, long set, long way,
     if (hit && access_type {type} != access_type::WRITE) // Skip this for writeback hits
         last_used_cycles.at((std::size_t)(set * NUM_WAY + way)) = cycle++;
 }
+
+#if (USER_CODES == ENABLE)
+void lru::replacement_checkpoint(champsim::checkpoint_archive& archive)
+{
+    archive(last_used_cycles, cycle);
+}
+#endif /* USER_CODES */
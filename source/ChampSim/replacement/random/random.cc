@@ -1,5 +1,9 @@
 #include "ChampSim/replacement/random/random.h"
 
+#if (USER_CODES == ENABLE)
+#include "ChampSim/checkpoint.h"
+#endif /* USER_CODES */
+
 random::random(CACHE* cache): random(cache, cache->NUM_WAY) {}
 
 random::random(CACHE* cache, long ways): replacement(cache), dist(0, ways - 1) {}
@@ -9,3 +13,10 @@ long random::find_victim(uint32_t triggering_cpu, uint64_t instr_id, long set, c
 {
     return dist(rng);
 }
+
+#if (USER_CODES == ENABLE)
+void random::replacement_checkpoint(champsim::checkpoint_archive& archive)
+{
+    archive(rng);
+}
+#endif /* USER_CODES */
@@ -6,6 +6,10 @@
 
 #include "ProjectConfiguration.h" // User file
 
+#if (USER_CODES == ENABLE)
+#include "ChampSim/checkpoint.h"
+#endif /* USER_CODES */
+
 #if (USER_CODES == DISABLE)
 #include "ChampSim/champsim.h"
 #endif /* USER_CODES */
@@ -104,3 +108,10 @@ void ship::replacement_cache_fill(uint32_t triggering_cpu, long set, long way, c
     if (SHCT[triggering_cpu][SHCT_idx].is_max())
         get_rrpv(set, way) = maxRRPV;
 }
+
+#if (USER_CODES == ENABLE)
+void ship::replacement_checkpoint(champsim::checkpoint_archive& archive)
+{
+    archive(access_count, sampler, rrpv_values, SHCT);
+}
+#endif /* USER_CODES */
@@ -6,6 +6,10 @@
 
 #include "ChampSim/cache.h"
 
+#if (USER_CODES == ENABLE)
+#include "ChampSim/checkpoint.h"
+#endif /* USER_CODES */
+
 srrip::srrip(CACHE* cache): srrip(cache, cache->NUM_SET, cache->NUM_WAY) {}
 
 srrip::srrip(CACHE* cache, long sets_, long ways_): replacement(cache)
@@ -44,3 +48,11 @@ long srrip_set_helper::victim()
 }
 
 void srrip_set_helper::update(long way, bool hit) { get_rrpv(way) = hit ? 0 : (maxRRPV - 1); }
+
+#if (USER_CODES == ENABLE)
+void srrip::replacement_checkpoint(champsim::checkpoint_archive& archive)
+{
+    for (auto& set : sets)
+        archive(set.rrpv_values);
+}
+#endif /* USER_CODES */
@@ -0,0 +1,193 @@
+#include "ChampSim/sampling.h"
+
+#if (USER_CODES == ENABLE) && (SAMPLED_SIMULATION == ENABLE)
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <numeric>
+#include <sstream>
+#include <utility>
+
+namespace
+{
+constexpr double Z_95 = 1.96; // Standard normal quantile of a 95% confidence interval
+
+struct simpoint
+{
+    long long start;
+    double weight;
+};
+
+/**
+ * @brief Read (start instruction, weight) lines, where # starts a comment.
+ * @return The samples ordered by their start.
+ */
+std::vector<simpoint> read_simpoints(const std::string& path)
+{
+    std::ifstream file {path};
+    if (! file)
+    {
+        std::cerr << __func__ << ": cannot open SimPoint file " << path << std::endl;
+        std::abort();
+    }
+
+    std::vector<simpoint> simpoints;
+    std::string line;
+    for (std::size_t line_number = 1; std::getline(file, line); ++line_number)
+    {
+        std::istringstream fields {line.substr(0, line.find('#'))};
+        simpoint point {};
+        if (! (fields >> point.start))
+        {
+            continue; // Blank line
+        }
+
+        if (! (fields >> point.weight) || point.start < 0 || point.weight < 0)
+        {
+            std::cerr << __func__ << ": line " << line_number << " of SimPoint file " << path << " is not a (start instruction, weight) pair" << std::endl;
+            std::abort();
+        }
+        simpoints.push_back(point);
+    }
+
+    if (simpoints.empty())
+    {
+        std::cerr << __func__ << ": SimPoint file " << path << " has no samples" << std::endl;
+        std::abort();
+    }
+
+    std::sort(std::begin(simpoints), std::end(simpoints), [](const auto& x, const auto& y)
+        { return x.start < y.start; });
+    return simpoints;
+}
+
+/**
+ * @brief Add the phases of one sample.
+ * @param skip The instructions functionally warmed up before the detailed warmup.
+ */
+void add_sample(std::vector<champsim::phase_info>& phases, std::size_t index, long long skip, long long warmup, long long length, double weight, const std::vector<std::string>& trace_names)
+{
+    const std::string name = "Sample " + std::to_string(index);
+    const std::vector<std::size_t> trace_index(std::size(trace_names), 0);
+
+    if (skip > 0)
+    {
+        champsim::phase_info functional {name + " functional warmup", true, skip, trace_index, trace_names};
+        functional.is_functional = true;
+        phases.push_back(functional);
+    }
+
+    if (warmup > 0)
+    {
+        phases.push_back(champsim::phase_info {name + " warmup", true, warmup, trace_index, trace_names});
+    }
+
+    champsim::phase_info sample {name, false, length, trace_index, trace_names};
+    sample.weight    = weight;
+    sample.is_sample = true;
+    phases.push_back(sample);
+}
+} // namespace
+
+std::vector<champsim::phase_info> champsim::sampling::sampled_phases(const sampling_options& options, long long length, const std::vector<std::string>& trace_names)
+{
+    std::vector<phase_info> phases;
+
+    if (! options.simpoint_path.empty())
+    {
+        long long position = 0; // Instructions the phases so far retire
+        std::size_t index  = 0;
+        for (auto [start, weight] : read_simpoints(options.simpoint_path))
+        {
+            if (start < position)
+            {
+                std::cerr << __func__ << ": the sample at instruction " << start << " overlaps the one before it, whose " << options.sample_instructions << " instructions end at " << position << std::endl;
+                std::abort();
+            }
+
+            const auto warmup = std::min(options.warmup_instructions, start - position);
+            add_sample(phases, index++, start - position - warmup, warmup, options.sample_instructions, weight, trace_names);
+            position = start + options.sample_instructions;
+        }
+        return phases;
+    }
+
+    // Each period ends with its sample, so the first one has time to warm up
+    const auto warmup      = std::min(options.warmup_instructions, options.period - options.sample_instructions);
+    const auto num_samples = std::max(length / options.period, 1LL);
+    for (long long index = 0; index < num_samples; ++index)
+    {
+        add_sample(phases, static_cast<std::size_t>(index), options.period - options.sample_instructions - warmup, warmup, options.sample_instructions, 1.0, trace_names);
+    }
+    return phases;
+}
+
+auto champsim::sampling::metrics(const sample_stats& sample) -> sample_metrics
+{
+    sample_metrics result {};
+
+    long long instrs = 0;
+    for (const auto& cpu : sample.cpu_stats)
+    {
+        result.ipc.push_back(static_cast<double>(cpu.instrs()) / static_cast<double>(std::max(cpu.cycles(), 1LL)));
+        instrs += cpu.instrs();
+    }
+
+    uint64_t llc_misses = 0;
+    auto llc            = std::find_if(std::begin(sample.cache_stats), std::end(sample.cache_stats), [](const auto& cache)
+                   { return cache.name == "LLC"; });
+    if (llc != std::end(sample.cache_stats))
+    {
+        for (const auto type : {access_type::LOAD, access_type::RFO, access_type::TRANSLATION})
+        {
+            for (std::size_t cpu = 0; cpu < NUM_CPUS; ++cpu)
+            {
+                llc_misses += llc->misses.value_or(std::pair {type, cpu}, 0);
+            }
+        }
+    }
+    result.llc_mpki                = 1000.0 * static_cast<double>(llc_misses) / static_cast<double>(std::max(instrs, 1LL));
+
+    const auto memory_requests     = sample.memory_reads + sample.memory_writes;
+    const auto seconds             = std::chrono::duration<double>(sample.elapsed).count();
+    result.memory_bandwidth        = (seconds > 0) ? (static_cast<double>(memory_requests * BLOCK_SIZE) / seconds / 1e9) : 0.0;
+    result.fast_memory_hit_rate    = (memory_requests > 0) ? (static_cast<double>(sample.fast_memory_requests) / static_cast<double>(memory_requests)) : 0.0;
+
+    return result;
+}
+
+auto champsim::sampling::weighted_estimate(const std::vector<double>& values, const std::vector<double>& weights) -> estimate
+{
+    const auto total_weight = std::accumulate(std::begin(weights), std::end(weights), 0.0);
+    if (values.empty() || total_weight <= 0)
+    {
+        return {std::numeric_limits<double>::quiet_NaN(), std::numeric_limits<double>::quiet_NaN()};
+    }
+
+    double mean = 0, sum_of_squared_weights = 0;
+    for (std::size_t i = 0; i < std::size(values); ++i)
+    {
+        mean += weights[i] / total_weight * values[i];
+        sum_of_squared_weights += (weights[i] / total_weight) * (weights[i] / total_weight);
+    }
+
+    // Unbiased variance with normalized weights, and the variance of the mean, which reduce to s^2 and s^2 / n with equal weights
+    if (values.size() < 2 || sum_of_squared_weights >= 1)
+    {
+        return {mean, std::numeric_limits<double>::quiet_NaN()};
+    }
+
+    double variance = 0;
+    for (std::size_t i = 0; i < std::size(values); ++i)
+    {
+        variance += weights[i] / total_weight * (values[i] - mean) * (values[i] - mean);
+    }
+    variance /= (1 - sum_of_squared_weights);
+
+    return {mean, Z_95 * std::sqrt(variance * sum_of_squared_weights)};
+}
+
+#endif /* USER_CODES, SAMPLED_SIMULATION */
@@ -0,0 +1,163 @@
+#include "ChampSim/tag_array.h"
+
+#if (USER_CODES == ENABLE)
+#include <algorithm>
+#include <bit>
+#include <cassert>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define TAG_ARRAY_X86_KERNELS
+#include <immintrin.h>
+#endif
+
+namespace
+{
+/** @return A bitmask of the tags equal to the tag, bit i for tags[i] */
+uint64_t compare_scalar(const uint64_t* tags, std::size_t count, uint64_t tag)
+{
+    uint64_t matches = 0;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        matches |= uint64_t {tags[i] == tag} << i;
+    }
+    return matches;
+}
+
+#ifdef TAG_ARRAY_X86_KERNELS
+__attribute__((target("sse4.1"))) uint64_t compare_sse4_1(const uint64_t* tags, std::size_t count, uint64_t tag)
+{
+    const __m128i key = _mm_set1_epi64x(static_cast<long long>(tag));
+
+    uint64_t matches  = 0;
+    std::size_t i     = 0;
+    for (; i + 2 <= count; i += 2)
+    {
+        const __m128i equal = _mm_cmpeq_epi64(_mm_loadu_si128(reinterpret_cast<const __m128i*>(tags + i)), key);
+        matches |= static_cast<uint64_t>(_mm_movemask_pd(_mm_castsi128_pd(equal))) << i;
+    }
+    // A full 64-way set leaves no tail, and shifting by 64 is undefined
+    return matches | ((i < count) ? (compare_scalar(tags + i, count - i, tag) << i) : 0);
+}
+
+__attribute__((target("avx2"))) uint64_t compare_avx2(const uint64_t* tags, std::size_t count, uint64_t tag)
+{
+    const __m256i key = _mm256_set1_epi64x(static_cast<long long>(tag));
+
+    uint64_t matches  = 0;
+    std::size_t i     = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        const __m256i equal = _mm256_cmpeq_epi64(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(tags + i)), key);
+        matches |= static_cast<uint64_t>(_mm256_movemask_pd(_mm256_castsi256_pd(equal))) << i;
+    }
+    // A full 64-way set leaves no tail, and shifting by 64 is undefined
+    return matches | ((i < count) ? (compare_scalar(tags + i, count - i, tag) << i) : 0);
+}
+#endif /* TAG_ARRAY_X86_KERNELS */
+} // namespace
+
+auto champsim::tag_array::best_kernel() -> compare_kernel
+{
+    for (compare_kernel kernel : {compare_kernel::avx2, compare_kernel::sse4_1})
+    {
+        if (is_supported(kernel))
+        {
+            return kernel;
+        }
+    }
+    return compare_kernel::scalar;
+}
+
+bool champsim::tag_array::is_supported(compare_kernel kernel)
+{
+    switch (kernel)
+    {
+#ifdef TAG_ARRAY_X86_KERNELS
+    case compare_kernel::avx2:
+        return __builtin_cpu_supports("avx2");
+    case compare_kernel::sse4_1:
+        return __builtin_cpu_supports("sse4.1");
+#endif /* TAG_ARRAY_X86_KERNELS */
+    case compare_kernel::scalar:
+        return true;
+    default:
+        return false;
+    }
+}
+
+champsim::tag_array::tag_array(std::size_t num_set, std::size_t num_way_, compare_kernel kernel)
+    : num_way(num_way_), masks_per_set((num_way_ + WAYS_PER_MASK - 1) / WAYS_PER_MASK), compare(compare_scalar), tags(num_set * num_way_), valid(num_set * masks_per_set)
+{
+    assert(is_supported(kernel));
+#ifdef TAG_ARRAY_X86_KERNELS
+    if (kernel == compare_kernel::avx2)
+    {
+        compare = compare_avx2;
+    }
+    else if (kernel == compare_kernel::sse4_1)
+    {
+        compare = compare_sse4_1;
+    }
+#endif /* TAG_ARRAY_X86_KERNELS */
+}
+
+long champsim::tag_array::first_match(long set, uint64_t tag, bool valid_only) const
+{
+    const uint64_t* set_tags  = tags.data() + static_cast<std::size_t>(set) * num_way;
+    const uint64_t* set_valid = valid.data() + static_cast<std::size_t>(set) * masks_per_set;
+    for (std::size_t mask = 0; mask < masks_per_set; ++mask)
+    {
+        const std::size_t first = mask * WAYS_PER_MASK;
+        uint64_t matches        = compare(set_tags + first, std::min(WAYS_PER_MASK, num_way - first), tag);
+        if (valid_only)
+        {
+            matches &= set_valid[mask];
+        }
+
+        if (matches != 0)
+        {
+            return static_cast<long>(first + static_cast<std::size_t>(std::countr_zero(matches)));
+        }
+    }
+    return static_cast<long>(num_way);
+}
+
+long champsim::tag_array::find(long set, uint64_t tag) const { return first_match(set, tag, true); }
+
+long champsim::tag_array::find_any(long set, uint64_t tag) const { return first_match(set, tag, false); }
+
+long champsim::tag_array::find_invalid(long set) const
+{
+    const uint64_t* set_valid = valid.data() + static_cast<std::size_t>(set) * masks_per_set;
+    for (std::size_t mask = 0; mask < masks_per_set; ++mask)
+    {
+        const std::size_t first = mask * WAYS_PER_MASK;
+        const std::size_t count = std::min(WAYS_PER_MASK, num_way - first);
+        uint64_t invalid        = ~set_valid[mask];
+        if (count < WAYS_PER_MASK)
+        {
+            invalid &= (uint64_t {1} << count) - 1;
+        }
+
+        if (invalid != 0)
+        {
+            return static_cast<long>(first + static_cast<std::size_t>(std::countr_zero(invalid)));
+        }
+    }
+    return static_cast<long>(num_way);
+}
+
+uint64_t& champsim::tag_array::valid_mask(long set, long way)
+{
+    return valid[static_cast<std::size_t>(set) * masks_per_set + static_cast<std::size_t>(way) / WAYS_PER_MASK];
+}
+
+void champsim::tag_array::fill(long set, long way, uint64_t tag)
+{
+    tags[static_cast<std::size_t>(set) * num_way + static_cast<std::size_t>(way)] = tag;
+    valid_mask(set, way) |= uint64_t {1} << (static_cast<std::size_t>(way) % WAYS_PER_MASK);
+}
+
+void champsim::tag_array::invalidate(long set, long way) { valid_mask(set, way) &= ~(uint64_t {1} << (static_cast<std::size_t>(way) % WAYS_PER_MASK)); }
+
+#endif /* USER_CODES */
@@ -0,0 +1,320 @@
+#include "ChampSim/telemetry.h"
+
+#if (USER_CODES == ENABLE) && (TELEMETRY == ENABLE)
+#include <fmt/core.h>
+
+#include <cstdlib>
+#include <iostream>
+#include <numeric>
+#include <utility>
+
+#include "ChampSim/champsim.h"
+
+namespace
+{
+void write_bytes(const void* data, std::size_t size, FILE* file)
+{
+    if (std::fwrite(data, 1, size, file) != size)
+    {
+        std::cerr << __func__ << ": File Write Error." << std::endl;
+        std::abort();
+    }
+}
+
+/** @return numerator / denominator, or 0 for an empty interval */
+float ratio(double numerator, double denominator) { return (denominator > 0) ? static_cast<float>(numerator / denominator) : 0.0f; }
+} // namespace
+
+namespace champsim::telemetry
+{
+column_writer::column_writer(FILE* file, std::vector<column> columns_)
+: file(file), columns(std::move(columns_))
+{
+    std::size_t offset = 0;
+    for (const auto& column : columns)
+    {
+        column_offsets.push_back(offset);
+        offset += ROWS_PER_BLOCK * width(column.type);
+    }
+    current = new_block();
+
+    // Header
+    write_bytes(MAGIC.data(), MAGIC.size(), file);
+    const uint32_t number = static_cast<uint32_t>(columns.size());
+    write_bytes(&number, sizeof(number), file);
+    for (const auto& column : columns)
+    {
+        const uint16_t length = static_cast<uint16_t>(column.name.size());
+        write_bytes(&column.type, sizeof(column.type), file);
+        write_bytes(&length, sizeof(length), file);
+        write_bytes(column.name.data(), length, file);
+    }
+
+    writer = std::thread(&column_writer::run, this);
+}
+
+column_writer::~column_writer()
+{
+    close();
+}
+
+column_writer::block column_writer::new_block() const
+{
+    const std::size_t row_bytes = std::accumulate(std::begin(columns), std::end(columns), std::size_t {0}, [](std::size_t sum, const column& column)
+        { return sum + width(column.type); });
+    return block {std::vector<uint8_t>(ROWS_PER_BLOCK * row_bytes), 0};
+}
+
+void column_writer::end_row()
+{
+    assert(next_column == columns.size());
+    next_column = 0;
+    rows++;
+
+    if (++current.rows < ROWS_PER_BLOCK)
+    {
+        return;
+    }
+
+    std::lock_guard lock {mutex};
+    full_blocks.push_back(std::move(current));
+    if (free_blocks.empty())
+    {
+        current = new_block();
+    }
+    else
+    {
+        current = std::move(free_blocks.back());
+        free_blocks.pop_back();
+        current.rows = 0;
+    }
+    full_ready.notify_one();
+}
+
+void column_writer::close()
+{
+    if (! writer.joinable())
+    {
+        return;
+    }
+
+    {
+        std::lock_guard lock {mutex};
+        if (current.rows > 0)
+        {
+            full_blocks.push_back(std::move(current));
+            current = block {};
+        }
+        stopping = true;
+    }
+    full_ready.notify_one();
+    writer.join();
+    std::fflush(file);
+}
+
+void column_writer::write_block(const block& full) const
+{
+    write_bytes(&full.rows, sizeof(full.rows), file);
+    for (std::size_t index = 0; index < columns.size(); index++)
+    {
+        write_bytes(full.data.data() + column_offsets[index], full.rows * width(columns[index].type), file);
+    }
+}
+
+void column_writer::run()
+{
+    std::unique_lock lock {mutex};
+    while (true)
+    {
+        full_ready.wait(lock, [this]()
+            { return ! full_blocks.empty() || stopping; });
+        if (full_blocks.empty())
+        {
+            return; // Stopping, and everything is written
+        }
+
+        block full = std::move(full_blocks.front());
+        full_blocks.pop_front();
+
+        // The simulation thread goes on filling blocks while this one is written
+        lock.unlock();
+        write_block(full);
+        lock.lock();
+
+        free_blocks.push_back(std::move(full));
+    }
+}
+
+sampler::sampler(environment& env_, const telemetry_options& options_)
+: env(env_), options(options_), next_sample(options_.interval), start_time(std::chrono::steady_clock::now())
+{
+    file = std::fopen(options.path.c_str(), "wb");
+    if (file == nullptr)
+    {
+        std::cerr << __func__ << ": Cannot open " << options.path << " for the telemetry." << std::endl;
+        std::abort();
+    }
+    writer = std::make_unique<column_writer>(file, columns());
+
+    previous_retired.resize(std::size(env.cpu_view()));
+    previous_cpu_cycles.resize(std::size(env.cpu_view()));
+    previous_misses.resize(std::size(env.cache_view()));
+#if (RAMULATOR2 == ENABLE)
+    previous_channels.resize(NUMBER_OF_MEMORIES);
+#endif /* RAMULATOR2 */
+}
+
+sampler::~sampler()
+{
+    close();
+}
+
+std::vector<column> sampler::columns()
+{
+    std::vector<column> result {{"time_ps", column_type::uint64}, {"cycle", column_type::uint64}, {"phase", column_type::uint32}};
+
+    for (const O3_CPU& cpu : env.cpu_view())
+    {
+        result.push_back({fmt::format("cpu{}.instructions", cpu.cpu), column_type::uint64});
+        result.push_back({fmt::format("cpu{}.ipc", cpu.cpu), column_type::float32});
+    }
+
+    for (const CACHE& cache : env.cache_view())
+    {
+        result.push_back({cache.NAME + ".mpki", column_type::float32});
+        result.push_back({cache.NAME + ".mshr_occupancy", column_type::uint32});
+    }
+
+#if (RAMULATOR2 == ENABLE)
+    for (uint8_t memory = 0; memory < NUMBER_OF_MEMORIES; memory++)
+    {
+        for (std::size_t channel = 0; channel < std::size(env.dram_view().get_channel_counters(memory)); channel++)
+        {
+            const std::string prefix = fmt::format("memory{}.channel{}", memory, channel);
+            result.push_back({prefix + ".bandwidth", column_type::float32});
+            result.push_back({prefix + ".row_hit_rate", column_type::float32});
+            result.push_back({prefix + ".queue_occupancy", column_type::uint32});
+        }
+    }
+
+#if (MEMORY_USE_OS_TRANSPARENT_MANAGEMENT == ENABLE)
+    result.push_back({"remapping_request_queue_occupancy", column_type::uint32});
+#endif /* MEMORY_USE_OS_TRANSPARENT_MANAGEMENT */
+#endif /* RAMULATOR2 */
+
+    return result;
+}
+
+void sampler::begin_phase(champsim::chrono::clock::time_point now)
+{
+    phase++;
+
+    // The first interval of a phase starts with it, since caches restart their statistics in each phase
+    // and instructions retire without time in functional warmup phases
+    previous_time = now;
+    for (const O3_CPU& cpu : env.cpu_view())
+    {
+        previous_retired[cpu.cpu]    = cpu.num_retired;
+        previous_cpu_cycles[cpu.cpu] = cpu.current_time.time_since_epoch() / cpu.clock_period;
+    }
+
+    auto caches = env.cache_view();
+    for (std::size_t index = 0; index < std::size(caches); index++)
+    {
+        previous_misses[index] = caches[index].get().sim_stats.misses.total();
+    }
+
+#if (RAMULATOR2 == ENABLE)
+    for (uint8_t memory = 0; memory < NUMBER_OF_MEMORIES; memory++)
+    {
+        previous_channels[memory] = env.dram_view().get_channel_counters(memory);
+    }
+#endif /* RAMULATOR2 */
+}
+
+void sampler::sample(champsim::chrono::clock::time_point now)
+{
+    const auto sample_start = std::chrono::steady_clock::now();
+
+    writer->add(static_cast<uint64_t>(now.time_since_epoch().count()));
+    writer->add(cycles);
+    writer->add(phase);
+
+    long long instructions = 0;
+    for (const O3_CPU& cpu : env.cpu_view())
+    {
+        const long long cpu_cycles = cpu.current_time.time_since_epoch() / cpu.clock_period;
+        instructions += cpu.num_retired - previous_retired[cpu.cpu];
+
+        writer->add(static_cast<uint64_t>(cpu.num_retired));
+        writer->add(ratio(static_cast<double>(cpu.num_retired - previous_retired[cpu.cpu]), static_cast<double>(cpu_cycles - previous_cpu_cycles[cpu.cpu])));
+
+        previous_retired[cpu.cpu]    = cpu.num_retired;
+        previous_cpu_cycles[cpu.cpu] = cpu_cycles;
+    }
+
+    auto caches = env.cache_view();
+    for (std::size_t index = 0; index < std::size(caches); index++)
+    {
+        const CACHE& cache = caches[index];
+        const long misses  = cache.sim_stats.misses.total();
+
+        writer->add(ratio(1000.0 * static_cast<double>(misses - previous_misses[index]), static_cast<double>(instructions)));
+        writer->add(static_cast<uint32_t>(std::size(cache.MSHR)));
+
+        previous_misses[index] = misses;
+    }
+
+#if (RAMULATOR2 == ENABLE)
+    auto& dram               = env.dram_view();
+    const double interval_ps = static_cast<double>((now - previous_time).count());
+    for (uint8_t memory = 0; memory < NUMBER_OF_MEMORIES; memory++)
+    {
+        const auto channels = dram.get_channel_counters(memory);
+        for (std::size_t channel = 0; channel < std::size(channels); channel++)
+        {
+            const auto& counters = channels[channel];
+            const auto& previous = previous_channels[memory][channel];
+            const auto accesses  = (counters.row_hits + counters.row_misses + counters.row_conflicts) - (previous.row_hits + previous.row_misses + previous.row_conflicts);
+
+            // Bytes per picosecond are thousands of GB/s
+            writer->add(ratio(1000.0 * static_cast<double>((counters.served_requests - previous.served_requests) * BLOCK_SIZE), interval_ps));
+            writer->add(ratio(static_cast<double>(counters.row_hits - previous.row_hits), static_cast<double>(accesses)));
+            writer->add(static_cast<uint32_t>(counters.queue_occupancy));
+        }
+        previous_channels[memory] = channels;
+    }
+
+#if (MEMORY_USE_OS_TRANSPARENT_MANAGEMENT == ENABLE)
+    writer->add(static_cast<uint32_t>(dram.os_transparent_management->remapping_request_queue.size()));
+#endif /* MEMORY_USE_OS_TRANSPARENT_MANAGEMENT */
+#endif /* RAMULATOR2 */
+
+    writer->end_row();
+    previous_time = now;
+
+    sampling_time += std::chrono::steady_clock::now() - sample_start;
+}
+
+void sampler::close()
+{
+    if (writer == nullptr)
+    {
+        return;
+    }
+
+    writer->close();
+    std::fclose(file);
+
+    const std::chrono::duration<double> sampling_seconds = sampling_time;
+    const std::chrono::duration<double> run_seconds      = std::chrono::steady_clock::now() - start_time;
+    fmt::print("Telemetry: {} snapshots of {} columns written to {} ({:.3f} sec, {:.2f}% of the run, spent taking them)\n", writer->row_number(), writer->column_number(), options.path,
+        sampling_seconds.count(), (run_seconds.count() > 0) ? (100.0 * sampling_seconds.count() / run_seconds.count()) : 0.0);
+
+    writer.reset();
+    file = nullptr;
+}
+
+} // namespace champsim::telemetry
+
+#endif /* USER_CODES, TELEMETRY */
@@ -0,0 +1,247 @@
+#include "ChampSim/trace_fanout.h"
+
+#if (USER_CODES == ENABLE) && (MULTI_CONFIG_SWEEP == ENABLE)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <new>
+#include <thread>
+
+namespace
+{
+constexpr uint64_t NOBODY = std::numeric_limits<uint64_t>::max(); // The slowest tail when every consumer has finished
+
+constexpr auto WAIT_BACKOFF  = std::chrono::microseconds(100); // How long either side sleeps while the other catches up
+constexpr auto IDLE_INTERVAL = std::chrono::milliseconds(100); // How often the producer checks on the consumers while it waits
+
+constexpr std::size_t round_up(std::size_t bytes, std::size_t alignment) { return (bytes + alignment - 1) / alignment * alignment; }
+} // namespace
+
+/**
+ * @brief The reader of one trace for one consumer.
+ */
+struct champsim::trace_fanout::reader
+{
+    trace_fanout* fanout;
+    std::size_t trace;
+
+    [[nodiscard]] bool eof() const
+    {
+        if (! fanout->spilled[trace].empty())
+        {
+            return false;
+        }
+
+        const counter& head     = fanout->heads[trace];
+        const uint64_t position = fanout->tail(trace).value.load(std::memory_order_relaxed);
+        while (head.value.load(std::memory_order_acquire) == position)
+        {
+            // The head is read again after the end, which is only marked once the last instruction is written
+            if (fanout->ended[trace].value.load(std::memory_order_acquire) != 0)
+            {
+                return head.value.load(std::memory_order_acquire) == position;
+            }
+            fanout->spill(trace);                       // The producer may be waiting for this consumer on another ring
+            std::this_thread::sleep_for(WAIT_BACKOFF); // The producer is behind
+        }
+        return false;
+    }
+
+    ooo_model_instr operator()()
+    {
+        [[maybe_unused]] const bool at_end = eof(); // Wait for the instruction
+        assert(! at_end);
+
+        if (std::deque<ooo_model_instr>& queue = fanout->spilled[trace]; ! queue.empty())
+        {
+            const ooo_model_instr instr = queue.front();
+            queue.pop_front();
+            return instr;
+        }
+        return fanout->take(trace);
+    }
+};
+
+std::size_t champsim::trace_fanout::size_of(std::size_t num_traces, std::size_t num_consumers, std::size_t depth)
+{
+    const std::size_t counters = 2 * num_traces + num_consumers * num_traces + num_consumers;
+    return round_up(sizeof(layout), alignof(counter)) + counters * sizeof(counter) + num_traces * depth * sizeof(ooo_model_instr);
+}
+
+void champsim::trace_fanout::map(std::size_t num_traces, std::size_t num_consumers, std::size_t depth)
+{
+    static_assert(alignof(counter) % alignof(ooo_model_instr) == 0);
+
+    shape    = reinterpret_cast<layout*>(memory);
+    heads    = reinterpret_cast<counter*>(memory + round_up(sizeof(layout), alignof(counter)));
+    ended    = heads + num_traces;
+    tails    = ended + num_traces;
+    finished = tails + num_consumers * num_traces;
+    slots    = reinterpret_cast<ooo_model_instr*>(finished + num_consumers);
+    assert(reinterpret_cast<std::byte*>(slots + num_traces * depth) == memory + size_of(num_traces, num_consumers, depth));
+}
+
+champsim::trace_fanout::trace_fanout(std::size_t num_traces, std::size_t num_consumers, std::size_t depth)
+    : fd(::memfd_create("champsim-trace-fanout", 0)), consumer(num_consumers), bytes(size_of(num_traces, num_consumers, depth))
+{
+    if (fd < 0 || ::ftruncate(fd, static_cast<off_t>(bytes)) != 0)
+    {
+        std::cerr << __func__ << ": cannot create the shared memory of " << bytes << " bytes: " << std::strerror(errno) << std::endl;
+        std::abort();
+    }
+
+    void* mapping = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (mapping == MAP_FAILED)
+    {
+        std::cerr << __func__ << ": cannot map the shared memory: " << std::strerror(errno) << std::endl;
+        std::abort();
+    }
+    memory = static_cast<std::byte*>(mapping);
+
+    // The file starts zeroed, so every counter starts at 0
+    map(num_traces, num_consumers, depth);
+    *shape = layout {num_traces, num_consumers, depth, sizeof(ooo_model_instr)};
+}
+
+champsim::trace_fanout::trace_fanout(int fd_, std::size_t consumer_): fd(fd_), consumer(consumer_)
+{
+    struct stat status;
+    if (::fstat(fd, &status) != 0 || static_cast<std::size_t>(status.st_size) < sizeof(layout))
+    {
+        std::cerr << __func__ << ": file descriptor " << fd << " is not the shared memory of a sweep" << std::endl;
+        std::abort();
+    }
+    bytes = static_cast<std::size_t>(status.st_size);
+
+    void* mapping = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (mapping == MAP_FAILED)
+    {
+        std::cerr << __func__ << ": cannot map the shared memory: " << std::strerror(errno) << std::endl;
+        std::abort();
+    }
+    memory = static_cast<std::byte*>(mapping);
+
+    const layout stored = *reinterpret_cast<const layout*>(memory);
+    if (stored.instr_size != sizeof(ooo_model_instr) || consumer >= stored.num_consumers || bytes != size_of(stored.num_traces, stored.num_consumers, stored.depth))
+    {
+        std::cerr << __func__ << ": the shared memory was created by another build, or for fewer consumers" << std::endl;
+        std::abort();
+    }
+    map(stored.num_traces, stored.num_consumers, stored.depth);
+    spilled.resize(stored.num_traces);
+}
+
+champsim::trace_fanout::~trace_fanout()
+{
+    ::munmap(memory, bytes);
+    ::close(fd);
+}
+
+uint64_t champsim::trace_fanout::slowest_tail(std::size_t trace) const
+{
+    uint64_t slowest = NOBODY;
+    for (std::size_t c = 0; c < shape->num_consumers; ++c)
+    {
+        if (finished[c].value.load(std::memory_order_acquire) == 0)
+        {
+            slowest = std::min(slowest, tails[c * shape->num_traces + trace].value.load(std::memory_order_acquire));
+        }
+    }
+    return slowest;
+}
+
+champsim::trace_fanout::counter& champsim::trace_fanout::tail(std::size_t trace) const { return tails[consumer * shape->num_traces + trace]; }
+
+ooo_model_instr champsim::trace_fanout::take(std::size_t trace)
+{
+    counter& position           = tail(trace);
+    const uint64_t index        = position.value.load(std::memory_order_relaxed);
+    const ooo_model_instr instr = slots[trace * shape->depth + index % shape->depth];
+    position.value.store(index + 1, std::memory_order_release);
+    return instr;
+}
+
+void champsim::trace_fanout::spill(std::size_t waiting_trace)
+{
+    for (std::size_t trace = 0; trace < shape->num_traces; ++trace)
+    {
+        const uint64_t head = heads[trace].value.load(std::memory_order_acquire);
+        while (trace != waiting_trace && tail(trace).value.load(std::memory_order_relaxed) != head)
+        {
+            spilled[trace].push_back(take(trace));
+        }
+    }
+}
+
+void champsim::trace_fanout::broadcast(std::vector<tracereader>& traces, const std::function<void()>& idle)
+{
+    assert(std::size(traces) == shape->num_traces);
+
+    const auto running = [this]
+    {
+        return std::any_of(finished, finished + shape->num_consumers, [](const counter& c)
+            { return c.value.load(std::memory_order_acquire) == 0; });
+    };
+
+    auto last_idle          = std::chrono::steady_clock::now();
+    std::size_t traces_left = std::size(traces);
+    while (traces_left > 0 && running())
+    {
+        bool progress = false;
+        for (std::size_t trace = 0; trace < std::size(traces); ++trace)
+        {
+            if (ended[trace].value.load(std::memory_order_relaxed) != 0)
+            {
+                continue;
+            }
+
+            uint64_t head          = heads[trace].value.load(std::memory_order_relaxed);
+            const uint64_t slowest = slowest_tail(trace);
+            for (; slowest != NOBODY && head - slowest < shape->depth && ! traces[trace].eof(); ++head)
+            {
+                new (&slots[trace * shape->depth + head % shape->depth]) ooo_model_instr {traces[trace]()};
+                heads[trace].value.store(head + 1, std::memory_order_release);
+                progress = true;
+            }
+
+            if (traces[trace].eof())
+            {
+                ended[trace].value.store(1, std::memory_order_release);
+                --traces_left;
+            }
+        }
+
+        if (! progress)
+        {
+            if (const auto now = std::chrono::steady_clock::now(); now - last_idle >= IDLE_INTERVAL)
+            {
+                idle();
+                last_idle = now;
+            }
+            std::this_thread::sleep_for(WAIT_BACKOFF); // Every ring waits for its slowest consumer
+        }
+    }
+}
+
+std::vector<champsim::tracereader> champsim::trace_fanout::readers()
+{
+    std::vector<tracereader> result;
+    for (std::size_t trace = 0; trace < shape->num_traces; ++trace)
+    {
+        result.emplace_back(reader {this, trace});
+    }
+    return result;
+}
+
+void champsim::trace_fanout::finish(std::size_t consumer_) { finished[consumer_].value.store(1, std::memory_order_release); }
+
+#endif /* USER_CODES, MULTI_CONFIG_SWEEP */
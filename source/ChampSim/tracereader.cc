@@ -19,6 +19,9 @@
 #include <fstream>
 #include <string>
 
+#if (USER_CODES == ENABLE) && (TRACE_PREFETCH_THREAD == ENABLE)
+#include "ChampSim/async_istream.h"
+#endif /* USER_CODES, TRACE_PREFETCH_THREAD */
 #include "ChampSim/inf_stream.h"
 #include "ChampSim/repeatable.h"
 
@@ -32,25 +35,34 @@ ooo_model_instr apply_branch_target(ooo_model_instr branch, const ooo_model_inst
     return branch;
 }
 
+#if (USER_CODES == ENABLE) && (TRACE_PREFETCH_THREAD == ENABLE)
+// Decompress each trace on its own thread, ahead of the simulation
+template<typename F>
+using trace_stream = champsim::async_istream<F>;
+#else
+template<typename F>
+using trace_stream = F;
+#endif /* USER_CODES, TRACE_PREFETCH_THREAD */
+
 template<template<class, class> typename R, typename T>
 champsim::tracereader get_tracereader_for_type(std::string fname, uint8_t cpu)
 {
     if (bool is_gzip_compressed = (fname.substr(std::size(fname) - 2) == "gz"); is_gzip_compressed)
     {
-        return champsim::tracereader {R<T, champsim::inf_istream<champsim::decomp_tags::gzip_tag_t<>>>(cpu, fname)};
+        return champsim::tracereader {R<T, trace_stream<champsim::inf_istream<champsim::decomp_tags::gzip_tag_t<>>>>(cpu, fname)};
     }
 
     if (bool is_lzma_compressed = (fname.substr(std::size(fname) - 2) == "xz"); is_lzma_compressed)
     {
-        return champsim::tracereader {R<T, champsim::inf_istream<champsim::decomp_tags::lzma_tag_t<>>>(cpu, fname)};
+        return champsim::tracereader {R<T, trace_stream<champsim::inf_istream<champsim::decomp_tags::lzma_tag_t<>>>>(cpu, fname)};
     }
 
     if (bool is_bzip2_compressed = (fname.substr(std::size(fname) - 3) == "bz2"); is_bzip2_compressed)
     {
-        return champsim::tracereader {R<T, champsim::inf_istream<champsim::decomp_tags::bzip2_tag_t>>(cpu, fname)};
+        return champsim::tracereader {R<T, trace_stream<champsim::inf_istream<champsim::decomp_tags::bzip2_tag_t>>>(cpu, fname)};
     }
 
-    return champsim::tracereader {R<T, std::ifstream>(cpu, fname)};
+    return champsim::tracereader {R<T, trace_stream<std::ifstream>>(cpu, fname)};
 }
 } // namespace champsim
 
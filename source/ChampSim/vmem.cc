@@ -32,13 +32,74 @@
 
 using namespace champsim::data::data_literals;
 
-VirtualMemory::VirtualMemory(champsim::data::bytes page_table_page_size, std::size_t page_table_levels, champsim::chrono::clock::duration minor_penalty, champsim::data::bytes memory_size_, std::optional<uint64_t> randomization_seed_)
+namespace
+{
+// The finalizer of SplitMix64, a bijective mixing of 64 bits
+uint64_t mix64(uint64_t x)
+{
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ull;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebull;
+    return x ^ (x >> 31);
+}
+
+uint64_t splitmix64(uint64_t& state) { return mix64(state += 0x9e3779b97f4a7c15ull); }
+} // namespace
+
+VirtualMemory::page_permutation::page_permutation(uint64_t first_, uint64_t count_, std::optional<uint64_t> seed)
+: first(first_), count(count_), shuffled(seed.has_value())
+{
+    // The smallest even number of bits that covers the range, so the network permutes less than 4 times the range
+    while ((uint64_t {1} << (2 * half_width)) < count)
+    {
+        half_width++;
+    }
+
+    uint64_t state = seed.value_or(0);
+    for (uint64_t& key : round_keys)
+    {
+        key = splitmix64(state);
+    }
+}
+
+uint64_t VirtualMemory::page_permutation::encrypt(uint64_t index) const
+{
+    const uint64_t mask = (uint64_t {1} << half_width) - 1;
+    uint64_t left       = index >> half_width;
+    uint64_t right      = index & mask;
+    for (uint64_t key : round_keys)
+    {
+        left ^= mix64(right ^ key) & mask;
+        std::swap(left, right);
+    }
+    return (left << half_width) | right;
+}
+
+uint64_t VirtualMemory::page_permutation::take()
+{
+    assert(! exhausted());
+    uint64_t index = allocated++;
+    if (shuffled)
+    {
+        // Cycle-walk until the permuted index falls into the range, which keeps the order a bijection of the range
+        do
+        {
+            index = encrypt(index);
+        } while (index >= count);
+    }
+    return first + index;
+}
+
+VirtualMemory::VirtualMemory(champsim::data::bytes page_table_page_size, std::size_t page_table_levels, champsim::chrono::clock::duration minor_penalty, champsim::data::bytes memory_size_, std::optional<uint64_t> randomization_seed_,
+    champsim::data::bytes fast_memory_size_, page_placement placement_)
 : randomization_seed(randomization_seed_), memory_size(memory_size_), minor_fault_penalty(minor_penalty), pt_levels(page_table_levels),
-  pte_page_size(page_table_page_size),
+  pte_page_size(page_table_page_size), fast_memory_size(fast_memory_size_), placement(placement_),
   next_pte_page(champsim::dynamic_extent {champsim::data::bits {LOG2_PAGE_SIZE}, champsim::data::bits {champsim::lg2(champsim::data::bytes {pte_page_size}.count())}}, 0)
 {
     assert(pte_page_size > 1_kiB);
     assert(champsim::is_power_of_2(pte_page_size.count()));
+    assert(pt_levels < (1u << 8)); // The level is packed into the low byte of a page table key
 
     champsim::page_number last_vpage {champsim::lowest_address_for_size(champsim::data::bytes {PAGE_SIZE + champsim::ipow(pte_page_size.count(), static_cast<unsigned>(pt_levels))})};
     champsim::data::bits required_bits {LOG2_PAGE_SIZE + champsim::lg2(last_vpage.to<uint64_t>())};
@@ -68,7 +129,11 @@ VirtualMemory::VirtualMemory(champsim::data::bytes page_table_page_size, std::si
     }
 
     populate_pages();
-    shuffle_pages();
+}
+
+VirtualMemory::VirtualMemory(champsim::data::bytes page_table_page_size, std::size_t page_table_levels, champsim::chrono::clock::duration minor_penalty, champsim::data::bytes memory_size_, std::optional<uint64_t> randomization_seed_)
+: VirtualMemory(page_table_page_size, page_table_levels, minor_penalty, memory_size_, randomization_seed_, champsim::data::bytes {0}, page_placement::random)
+{
 }
 
 VirtualMemory::VirtualMemory(champsim::data::bytes page_table_page_size, std::size_t page_table_levels, champsim::chrono::clock::duration minor_penalty, champsim::data::bytes memory_size_)
@@ -80,23 +145,54 @@ void VirtualMemory::populate_pages()
 {
     assert(memory_size > 1_MiB);
 
-    ppage_free_list.resize(((memory_size - 1_MiB) / PAGE_SIZE).count());
-    assert(ppage_free_list.size() != 0);
+    ppage_count = ((memory_size - 1_MiB) / PAGE_SIZE).count();
+    assert(ppage_count != 0);
 
-    champsim::page_number base_address = champsim::page_number {champsim::lowest_address_for_size(std::max<champsim::data::mebibytes>(champsim::data::bytes {PAGE_SIZE}, 1_MiB))};
-    for (auto it = ppage_free_list.begin(); it != ppage_free_list.end(); it++)
+    first_ppage     = champsim::page_number {champsim::lowest_address_for_size(std::max<champsim::data::mebibytes>(champsim::data::bytes {PAGE_SIZE}, 1_MiB))};
+    ppage_allocated = 0;
+
+    // Random placement draws from all pages at once, the other policies draw from each memory separately
+    uint64_t fast_ppage_count = ppage_count;
+    if (placement != page_placement::random)
     {
-        *it = base_address;
-        base_address++;
+        const uint64_t fast_ppage_end = (fast_memory_size / PAGE_SIZE).count();
+        fast_ppage_count              = std::min(ppage_count, fast_ppage_end - std::min(fast_ppage_end, first_ppage.to<uint64_t>()));
     }
+
+    auto range_seed = [this](uint64_t range) -> std::optional<uint64_t>
+    {
+        if (randomization_seed.has_value())
+        {
+            return randomization_seed.value() + range;
+        }
+        return std::nullopt;
+    };
+    ppage_ranges = {page_permutation {0, fast_ppage_count, range_seed(0)}, page_permutation {fast_ppage_count, ppage_count - fast_ppage_count, range_seed(1)}};
+
+    draw_ppage();
 }
 
-void VirtualMemory::shuffle_pages()
+void VirtualMemory::draw_ppage()
 {
-    if (randomization_seed.has_value())
+    auto& [fast, slow] = ppage_ranges;
+
+    bool use_fast = ! fast.exhausted();
+    if (use_fast && ! slow.exhausted() && placement == page_placement::interleaved)
     {
-        std::shuffle(ppage_free_list.begin(), ppage_free_list.end(), std::mt19937_64 {randomization_seed.value()});
+        // Keep the share of the fast memory in the allocated pages at its share of the capacity
+        use_fast = (fast.allocated * slow.count <= slow.allocated * fast.count);
     }
+
+    next_ppage = champsim::page_number {first_ppage.to<uint64_t>() + (use_fast ? fast : slow).take()};
+}
+
+VirtualMemory::address_space& VirtualMemory::space_of(uint32_t cpu_num)
+{
+    if (cpu_num >= address_spaces.size())
+    {
+        address_spaces.resize(cpu_num + 1);
+    }
+    return address_spaces[cpu_num];
 }
 
 champsim::dynamic_extent VirtualMemory::extent(std::size_t level) const
@@ -115,12 +211,12 @@ uint64_t VirtualMemory::get_offset(champsim::page_number vaddr, std::size_t leve
 champsim::page_number VirtualMemory::ppage_front() const
 {
     assert(available_ppages() > 0);
-    return ppage_free_list.front();
+    return next_ppage;
 }
 
 void VirtualMemory::ppage_pop()
 {
-    ppage_free_list.pop_front();
+    ppage_allocated++;
 
     if (available_ppages() == 0)
     {
@@ -133,15 +229,19 @@ void VirtualMemory::ppage_pop()
 #endif /* PRINT_STATISTICS_INTO_FILE */
 
         populate_pages();
-        shuffle_pages();
+    }
+    else
+    {
+        draw_ppage();
     }
 }
 
-std::size_t VirtualMemory::available_ppages() const { return (ppage_free_list.size()); }
+std::size_t VirtualMemory::available_ppages() const { return (ppage_count - ppage_allocated); }
 
 std::pair<champsim::page_number, champsim::chrono::clock::duration> VirtualMemory::va_to_pa(uint32_t cpu_num, champsim::page_number vaddr)
 {
-    auto [ppage, fault] = vpage_to_ppage_map.try_emplace({cpu_num, champsim::page_number {vaddr}}, ppage_front());
+    auto [ppage_value, fault] = space_of(cpu_num).vpage_to_ppage.try_emplace(champsim::page_number {vaddr}.to<uint64_t>(), ppage_front().to<uint64_t>());
+    champsim::page_number ppage {ppage_value};
 
     // this vpage doesn't yet have a ppage mapping
     if (fault)
@@ -158,25 +258,24 @@ std::pair<champsim::page_number, champsim::chrono::clock::duration> VirtualMemor
     if constexpr (champsim::debug_print)
     {
 #if (USE_VCPKG == ENABLE)
-        fmt::print("[VMEM] {} paddr: {} vpage: {} fault: {}\n", __func__, ppage->second, champsim::page_number {vaddr}, fault);
+        fmt::print("[VMEM] {} paddr: {} vpage: {} fault: {}\n", __func__, ppage, champsim::page_number {vaddr}, fault);
 #endif /* USE_VCPKG */
 
 #if (PRINT_STATISTICS_INTO_FILE == ENABLE)
-        std::fprintf(output_statistics.file_handler, "[VMEM] %s paddr: %ld vpage: %ld fault: %d\n", __func__, ppage->second.to<uint64_t>(), champsim::page_number(vaddr).to<uint64_t>(), fault);
+        std::fprintf(output_statistics.file_handler, "[VMEM] %s paddr: %ld vpage: %ld fault: %d\n", __func__, ppage.to<uint64_t>(), champsim::page_number(vaddr).to<uint64_t>(), fault);
 #endif /* PRINT_STATISTICS_INTO_FILE */
     }
 
-    return std::pair {ppage->second, penalty};
+    return std::pair {ppage, penalty};
 }
 
 std::pair<champsim::address, champsim::chrono::clock::duration> VirtualMemory::get_pte_pa(uint32_t cpu_num, champsim::page_number vaddr, std::size_t level)
 {
+    // The key packs the virtual address bits above this level with the level in the low byte
     champsim::dynamic_extent pte_table_entry_extent {champsim::address::bits, shamt(level + 1)};
-    auto [ppage, fault] = page_table.try_emplace(
-        {
-            cpu_num, level, champsim::address_slice {pte_table_entry_extent, vaddr}
-    },
-        champsim::splice(active_pte_page, next_pte_page));
+    const uint64_t key           = (champsim::address_slice {pte_table_entry_extent, vaddr}.to<uint64_t>() << 8) | level;
+    auto [pte_page_value, fault] = space_of(cpu_num).page_table.try_emplace(key, champsim::address {champsim::splice(active_pte_page, next_pte_page)}.to<uint64_t>());
+    champsim::address pte_page {pte_page_value};
 
     // this PTE doesn't yet have a mapping
     if (fault)
@@ -195,7 +294,7 @@ std::pair<champsim::address, champsim::chrono::clock::duration> VirtualMemory::g
 
     auto offset = get_offset(vaddr, level);
     champsim::address paddr {
-        champsim::splice(ppage->second, champsim::address_slice {champsim::dynamic_extent {champsim::data::bits {champsim::lg2(pte_entry::byte_multiple)}, static_cast<std::size_t>(champsim::lg2(pte_page_size.count()))}, offset}
+        champsim::splice(pte_page, champsim::address_slice {champsim::dynamic_extent {champsim::data::bits {champsim::lg2(pte_entry::byte_multiple)}, static_cast<std::size_t>(champsim::lg2(pte_page_size.count()))}, offset}
           )
     };
 
@@ -219,3 +318,16 @@ std::pair<champsim::address, champsim::chrono::clock::duration> VirtualMemory::g
 
     return {paddr, penalty};
 }
+
+#if (USER_CODES == ENABLE)
+void VirtualMemory::checkpoint(champsim::checkpoint_archive& archive)
+{
+    archive.section("VirtualMemory");
+    archive.expect(memory_size, "memory size");
+    archive.expect(pt_levels, "number of page table levels");
+    archive.expect(randomization_seed, "page randomization seed");
+    archive.expect(fast_memory_size, "fast memory size");
+    archive.expect(placement, "page placement");
+    archive(address_spaces, ppage_allocated, next_ppage, ppage_ranges, active_pte_page, next_pte_page);
+}
+#endif /* USER_CODES */
@@ -1,5 +1,9 @@
 #include "ProjectConfiguration.h"
 
+#if (BINARY_MEMORY_TRACE == ENABLE)
+#include "binary_memory_trace.h"
+#endif /* BINARY_MEMORY_TRACE */
+
 #include <errno.h>
 #include <limits.h>
 #include <stddef.h>
@@ -42,7 +46,11 @@ std::string shorten_path_if_needed(const std::string& path)
 }
 } // namespace
 
+#if (BINARY_MEMORY_TRACE == ENABLE)
+MEMORY_TRACE output_memorytrace("memory trace", ".trace.xz");
+#else
 MEMORY_TRACE output_memorytrace("memory trace", ".trace");
+#endif /* BINARY_MEMORY_TRACE */
 SIMULATOR_STATISTICS output_statistics("ChampSim statistics", ".statistics");
 
 DATA_OUTPUT::DATA_OUTPUT(std::string v1, std::string v2)
@@ -161,10 +169,26 @@ MEMORY_TRACE::MEMORY_TRACE(std::string v1, std::string v2, char** string_array,
 {
 }
 
+MEMORY_TRACE::~MEMORY_TRACE()
+{
+#if (BINARY_MEMORY_TRACE == ENABLE)
+    // Write out the remaining requests before the file is closed
+    binary_writer.reset();
+#endif /* BINARY_MEMORY_TRACE */
+}
+
 void MEMORY_TRACE::output_memory_trace_hexadecimal(uint64_t address, char type)
 {
     assert(file_handler);
+#if (BINARY_MEMORY_TRACE == ENABLE)
+    if (binary_writer == nullptr)
+    {
+        binary_writer = std::make_unique<binary_memory_trace::BinaryMemoryTraceWriter>(file_handler);
+    }
+    binary_writer->write(address, type == 'W');
+#else
     fprintf(file_handler, "0x%lx %c\n", address, type);
+#endif /* BINARY_MEMORY_TRACE */
 }
 
 SIMULATOR_STATISTICS::SIMULATOR_STATISTICS(std::string v1, std::string v2)
@@ -206,9 +230,29 @@ SIMULATOR_STATISTICS::~SIMULATOR_STATISTICS()
 #endif /* TRACKING_LOAD_STORE_STATISTICS */
 
         fprintf(file_handler, "swapping_count: %ld, swapping_traffic_in_bytes: %ld.\n", swapping_count, swapping_traffic_in_bytes);
+#if (MEMORY_USE_SWAPPING_UNIT == ENABLE)
+        const uint64_t cycles = std::max<uint64_t>(swapping_cycles, 1);
+        for (uint64_t i = 0; i < swapping_engine_statistics.size(); i++)
+        {
+            const SwappingEngineStatistics& engine = swapping_engine_statistics[i];
+            fprintf(file_handler, "swapping_engine: %ld, swaps: %ld, traffic_in_bytes: %ld, busy: %f, bytes_per_cycle: %f.\n", i, engine.swaps, engine.traffic_in_bytes, engine.busy_cycles / double(cycles), engine.traffic_in_bytes / double(cycles));
+            fprintf(file_handler, "swapping_engine: %ld, average_latency_cycles: %f, max_latency_cycles: %ld, latency_distribution (below 2^i cycles):", i, engine.swaps ? engine.busy_cycles / double(engine.swaps) : 0.0, engine.max_latency_cycles);
+            for (uint64_t swaps : engine.latency_distribution)
+            {
+                fprintf(file_handler, " %ld", swaps);
+            }
+            fprintf(file_handler, ".\n");
+        }
+#endif /* MEMORY_USE_SWAPPING_UNIT */
 
         fprintf(file_handler, "remapping_request_queue_congestion: %ld.\n", remapping_request_queue_congestion);
 
+#if (MEMORY_USE_OS_TRANSPARENT_MANAGEMENT == ENABLE)
+        fprintf(file_handler, "remapping_request_enqueued: %ld, remapping_request_duplicated: %ld, remapping_request_cancelled: %ld, remapping_request_finished: %ld.\n", remapping_request_enqueued, remapping_request_duplicated, remapping_request_cancelled, remapping_request_finished);
+        fprintf(file_handler, "remapping_request_queue_average_occupancy: %f, remapping_request_queue_max_occupancy: %ld.\n", remapping_request_queue_average_occupancy, remapping_request_queue_max_occupancy);
+        fprintf(file_handler, "remapping_request_average_waiting_cycles: %f, remapping_request_average_service_cycles: %f, remapping_request_max_latency_cycles: %ld.\n", remapping_request_average_waiting_cycles, remapping_request_average_service_cycles, remapping_request_max_latency_cycles);
+#endif /* MEMORY_USE_OS_TRANSPARENT_MANAGEMENT */
+
 #if (IDEAL_VARIABLE_GRANULARITY == ENABLE)
         fprintf(file_handler, "no_free_space_for_migration: %ld (%f).\n", no_free_space_for_migration, no_free_space_for_migration / float(total_access_request_in_memory));
         fprintf(file_handler, "no_invalid_group_for_migration: %ld (%f).\n", no_invalid_group_for_migration, no_invalid_group_for_migration / float(total_access_request_in_memory));
@@ -245,8 +289,21 @@ void SIMULATOR_STATISTICS::statistics_initialization()
     swapping_count                     = 0;
     swapping_traffic_in_bytes          = 0;
 
+#if (MEMORY_USE_SWAPPING_UNIT == ENABLE)
+    swapping_engine_statistics.fill(SwappingEngineStatistics {});
+    swapping_cycles = 0;
+#endif /* MEMORY_USE_SWAPPING_UNIT */
+
     remapping_request_queue_congestion = 0;
 
+#if (MEMORY_USE_OS_TRANSPARENT_MANAGEMENT == ENABLE)
+    remapping_request_enqueued = remapping_request_duplicated = remapping_request_cancelled = remapping_request_finished = 0;
+    remapping_request_queue_max_occupancy     = 0;
+    remapping_request_queue_average_occupancy = 0;
+    remapping_request_average_waiting_cycles = remapping_request_average_service_cycles = 0;
+    remapping_request_max_latency_cycles                                                 = 0;
+#endif /* MEMORY_USE_OS_TRANSPARENT_MANAGEMENT */
+
 #if (IDEAL_VARIABLE_GRANULARITY == ENABLE)
     no_free_space_for_migration         = 0;
     no_invalid_group_for_migration      = 0;
@@ -1,5 +1,7 @@
 #include "Ramulator2/base/request.h"
 
+#include <stdexcept>
+
 namespace Ramulator
 {
 
@@ -9,18 +11,220 @@ Request::Request(Addr_t addr, int type): addr(addr), type_id(type) {};
 
 Request::Request(AddrVec_t addr_vec, int type): addr_vec(addr_vec), type_id(type) {};
 
-Request::Request(Addr_t addr, int type, int source_id, std::function<void(Request&)> callback): addr(addr), type_id(type), source_id(source_id), callback(callback) {};
+Request::Request(Addr_t addr, int type, int source_id, RequestCallback callback): addr(addr), type_id(type), source_id(source_id), callback(callback) {};
 
-Request::Request(Addr_t addr, int type, int source_id, std::function<void(Request&)> callback, uint8_t memory_id)
+Request::Request(Addr_t addr, int type, int source_id, RequestCallback callback, uint8_t memory_id)
 : addr(addr), type_id(type), source_id(source_id), callback(callback), memory_id(memory_id) {};
 
 #if (RAMULATOR2 == ENABLE)
 
-Request::Request(Addr_t addr, int type, int source_id, std::function<void(Request&)> callback, DRAM_CHANNEL::request_type packet, uint8_t memory_id)
-: addr(addr), type_id(type), source_id(source_id), callback(callback), packet(packet), memory_id(memory_id) {};
+Request::Request(Addr_t addr, int type, int source_id, RequestCallback callback, int packet_handle, uint8_t memory_id)
+: addr(addr), type_id(type), source_id(source_id), callback(callback), packet_handle(packet_handle), memory_id(memory_id) {};
 
 #endif /* RAMULATOR */
 
+bool ReqBuffer::enqueue(const Request& request)
+{
+    if (m_size > max_size)
+    {
+        return false;
+    }
+
+    int slot = npos;
+    if (m_free.empty())
+    {
+        slot = static_cast<int>(m_slots.size());
+        m_slots.push_back(request);
+        m_prev.push_back(npos);
+        m_next.push_back(npos);
+        m_seq.push_back(0);
+        m_bank.push_back(m_num_banks);
+        m_row.push_back(-1);
+        m_ready.push_back(false);
+        m_bank_prev.push_back(npos);
+        m_bank_next.push_back(npos);
+    }
+    else
+    {
+        slot = m_free.back();
+        m_free.pop_back();
+        m_slots[slot] = request;
+    }
+
+    // Append to the arrival order
+    m_prev[slot] = m_tail;
+    m_next[slot] = npos;
+    if (m_tail != npos)
+    {
+        m_next[m_tail] = slot;
+    }
+    else
+    {
+        m_head = slot;
+    }
+    m_tail = slot;
+    m_size++;
+
+    m_seq[slot]   = m_next_seq++;
+    m_ready[slot] = false;
+    decode_bank(slot);
+
+    // Append to the bank's sub-queue
+    const int bank    = m_bank[slot];
+    m_bank_prev[slot] = m_bank_tail[bank];
+    m_bank_next[slot] = npos;
+    if (m_bank_tail[bank] != npos)
+    {
+        m_bank_next[m_bank_tail[bank]] = slot;
+    }
+    else
+    {
+        m_bank_head[bank]  = slot;
+        m_active_pos[bank] = static_cast<int>(m_active_banks.size());
+        m_active_banks.push_back(bank);
+    }
+    m_bank_tail[bank] = slot;
+
+    return true;
+}
+
+void ReqBuffer::remove(iterator it)
+{
+    const int slot = it.slot();
+
+    // Unlink from the arrival order
+    if (m_prev[slot] != npos)
+    {
+        m_next[m_prev[slot]] = m_next[slot];
+    }
+    else
+    {
+        m_head = m_next[slot];
+    }
+    if (m_next[slot] != npos)
+    {
+        m_prev[m_next[slot]] = m_prev[slot];
+    }
+    else
+    {
+        m_tail = m_prev[slot];
+    }
+
+    // Unlink from the bank's sub-queue
+    const int bank = m_bank[slot];
+    if (m_bank_prev[slot] != npos)
+    {
+        m_bank_next[m_bank_prev[slot]] = m_bank_next[slot];
+    }
+    else
+    {
+        m_bank_head[bank] = m_bank_next[slot];
+    }
+    if (m_bank_next[slot] != npos)
+    {
+        m_bank_prev[m_bank_next[slot]] = m_bank_prev[slot];
+    }
+    else
+    {
+        m_bank_tail[bank] = m_bank_prev[slot];
+    }
+
+    if (m_bank_head[bank] == npos)
+    {
+        // The bank has no more requests
+        const int pos                     = m_active_pos[bank];
+        m_active_banks[pos]               = m_active_banks.back();
+        m_active_pos[m_active_banks[pos]] = pos;
+        m_active_banks.pop_back();
+        m_active_pos[bank] = npos;
+    }
+
+    m_free.push_back(slot);
+    m_size--;
+}
+
+void ReqBuffer::set_organization(const std::vector<int>& count, int bank_level, int row_level)
+{
+    if (m_size != 0)
+    {
+        throw std::runtime_error("The organization of a request buffer must be set while it is empty!");
+    }
+
+    m_bank_level = bank_level;
+    m_row_level  = row_level;
+
+    // Flatten the levels down to the bank in row-major order
+    m_bank_stride.assign(bank_level + 1, 1);
+    m_num_banks = 1;
+    for (int level = bank_level; level >= 0; level--)
+    {
+        m_bank_stride[level] = m_num_banks;
+        m_num_banks *= count[level];
+    }
+
+    // One more sub-queue for requests that do not target one bank
+    m_bank_head.assign(m_num_banks + 1, npos);
+    m_bank_tail.assign(m_num_banks + 1, npos);
+    m_active_pos.assign(m_num_banks + 1, npos);
+    m_active_banks.clear();
+    m_ready_banks.clear();
+}
+
+void ReqBuffer::decode_bank(int slot)
+{
+    const auto& addr_vec = m_slots[slot].addr_vec;
+
+    m_bank[slot]         = m_num_banks;
+    m_row[slot]          = (m_row_level >= 0 && m_row_level < static_cast<int>(addr_vec.size())) ? addr_vec[m_row_level] : -1;
+    if (m_bank_level < 0 || m_bank_level >= static_cast<int>(addr_vec.size()))
+    {
+        return;
+    }
+
+    int bank = 0;
+    for (int level = 0; level <= m_bank_level; level++)
+    {
+        if (addr_vec[level] < 0)
+        {
+            // e.g., an all-bank command
+            return;
+        }
+        bank += addr_vec[level] * m_bank_stride[level];
+    }
+    m_bank[slot] = bank;
+}
+
+ReqBuffer::iterator ReqBuffer::first_ready_first_come()
+{
+    int candidate = npos;
+    if (! m_ready_banks.empty())
+    {
+        // Only the banks that can issue have candidates
+        for (int bank : m_ready_banks)
+        {
+            for (int slot = m_bank_head[bank]; slot != npos; slot = m_bank_next[slot])
+            {
+                if (m_ready[slot] && (candidate == npos || arrives_before(slot, candidate)))
+                {
+                    candidate = slot;
+                }
+            }
+        }
+    }
+    else
+    {
+        for (int slot = m_head; slot != npos; slot = m_next[slot])
+        {
+            if (candidate == npos || arrives_before(slot, candidate))
+            {
+                candidate = slot;
+            }
+        }
+    }
+
+    return iterator(this, candidate);
+}
+
 #else
 /* Original code of Ramulator */
 
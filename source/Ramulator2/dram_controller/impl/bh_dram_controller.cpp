@@ -39,6 +39,10 @@ class BHDRAMController final : public IBHDRAMController, public Implementation {
     int s_num_row_misses = 0;
     int s_num_row_conflicts = 0;
 
+#if (USER_CODES == ENABLE) && (TELEMETRY == ENABLE)
+    size_t s_num_served_reqs = 0;
+#endif /* USER_CODES, TELEMETRY */
+
     // DEBUG STAT
     int m_invalidate_ctr = -1;
 
@@ -69,6 +73,12 @@ class BHDRAMController final : public IBHDRAMController, public Implementation {
       m_bank_addr_idx = m_dram->m_levels("bank");
       m_row_addr_idx = m_dram->m_levels("row");
       m_priority_buffer.max_size = 512*3 + 32;
+#if (USER_CODES == ENABLE)
+      // Per-bank sub-queues let the scheduler skip the banks that cannot issue
+      for (auto* buffer : {&m_active_buffer, &m_priority_buffer, &m_read_buffer, &m_write_buffer}) {
+        buffer->set_organization(m_dram->m_organization.count, m_bank_addr_idx, m_dram->m_levels("row"));
+      }
+#endif /* USER_CODES */
       
       int num_cores = static_cast<BHO3*>(frontend)->get_num_cores();
       s_core_row_hits.resize(num_cores);
@@ -100,6 +110,9 @@ class BHDRAMController final : public IBHDRAMController, public Implementation {
           // The request will depart at the next cycle
           req.depart = m_clk + 1;
           pending.push_back(req);
+#if (USER_CODES == ENABLE) && (TELEMETRY == ENABLE)
+          s_num_served_reqs++;
+#endif /* USER_CODES, TELEMETRY */
           return true;
         }
       }
@@ -159,6 +172,9 @@ class BHDRAMController final : public IBHDRAMController, public Implementation {
 
         // If we are issuing the last command, set depart clock cycle and move the request to the pending queue
         if (req_it->command == req_it->final_command) {
+#if (USER_CODES == ENABLE) && (TELEMETRY == ENABLE)
+          s_num_served_reqs++;
+#endif /* USER_CODES, TELEMETRY */
           if (req_it->type_id == Request::Type::Read) {
             req_it->depart = m_clk + m_dram->m_read_latency;
             pending.push_back(*req_it);
@@ -177,6 +193,14 @@ class BHDRAMController final : public IBHDRAMController, public Implementation {
 
     };
 
+#if (USER_CODES == ENABLE) && (TELEMETRY == ENABLE)
+    ChannelCounters get_counters() const override
+    {
+      return {s_num_served_reqs, static_cast<size_t>(s_num_row_hits), static_cast<size_t>(s_num_row_misses), static_cast<size_t>(s_num_row_conflicts),
+              m_read_buffer.size() + m_write_buffer.size() + m_priority_buffer.size()};
+    };
+#endif /* USER_CODES, TELEMETRY */
+
   private:
     /**
      * @brief    Helper function to serve the completed read requests
@@ -198,7 +222,11 @@ class BHDRAMController final : public IBHDRAMController, public Implementation {
 
           if (req.callback) {
             // If the request comes from outside (e.g., processor), call its callback
+#if (USER_CODES == ENABLE)
+            complete(req);
+#else
             req.callback(req);
+#endif /* USER_CODES */
           }
           // Finally, remove this request from the pending queue
           pending.pop_front();
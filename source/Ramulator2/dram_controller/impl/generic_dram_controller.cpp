@@ -1,12 +1,14 @@
 #include "Ramulator2/dram_controller/controller.h"
 #include "Ramulator2/memory_system/memory_system.h"
 
+#include "ChampSim/msl/pool_allocator.h"
+
 namespace Ramulator {
 
 class GenericDRAMController final : public IDRAMController, public Implementation {
   RAMULATOR_REGISTER_IMPLEMENTATION(IDRAMController, GenericDRAMController, "Generic", "A generic DRAM controller.");
   private:
-    std::deque<Request> pending;          // A queue for read requests that are about to finish (callback after RL)
+    std::deque<Request, champsim::msl::pool_allocator<Request>> pending;  // A queue for read requests that are about to finish (callback after RL), whose blocks are recycled
 
     ReqBuffer m_active_buffer;            // Buffer for requests being served. This has the highest priority 
     ReqBuffer m_priority_buffer;          // Buffer for high-priority requests (e.g., maintenance like refresh).
@@ -49,6 +51,10 @@ class GenericDRAMController final : public IDRAMController, public Implementatio
     size_t s_read_latency = 0;
     float s_avg_read_latency = 0;
 
+#if (USER_CODES == ENABLE) && (TELEMETRY == ENABLE)
+    size_t s_num_served_reqs = 0;
+#endif /* USER_CODES, TELEMETRY */
+
 
   public:
     void init() override {
@@ -71,6 +77,12 @@ class GenericDRAMController final : public IDRAMController, public Implementatio
       m_dram = memory_system->get_ifce<IDRAM>();
       m_bank_addr_idx = m_dram->m_levels("bank");
       m_priority_buffer.max_size = 512*3 + 32;
+#if (USER_CODES == ENABLE)
+      // Per-bank sub-queues let the scheduler skip the banks that cannot issue
+      for (auto* buffer : {&m_active_buffer, &m_priority_buffer, &m_read_buffer, &m_write_buffer}) {
+        buffer->set_organization(m_dram->m_organization.count, m_bank_addr_idx, m_dram->m_levels("row"));
+      }
+#endif /* USER_CODES */
 
       m_num_cores = frontend->get_num_cores();
 
@@ -137,6 +149,9 @@ class GenericDRAMController final : public IDRAMController, public Implementatio
           // The request will depart at the next cycle
           req.depart = m_clk + 1;
           pending.push_back(req);
+#if (USER_CODES == ENABLE) && (TELEMETRY == ENABLE)
+          s_num_served_reqs++;
+#endif /* USER_CODES, TELEMETRY */
           return true;
         }
       }
@@ -205,6 +220,9 @@ class GenericDRAMController final : public IDRAMController, public Implementatio
 
         // If we are issuing the last command, set depart clock cycle and move the request to the pending queue
         if (req_it->command == req_it->final_command) {
+#if (USER_CODES == ENABLE) && (TELEMETRY == ENABLE)
+          s_num_served_reqs++;
+#endif /* USER_CODES, TELEMETRY */
           if (req_it->type_id == Request::Type::Read) {
             req_it->depart = m_clk + m_dram->m_read_latency;
             pending.push_back(*req_it);
@@ -264,6 +282,42 @@ class GenericDRAMController final : public IDRAMController, public Implementatio
 
         return size;
     };
+
+    Clk_t get_cycles_to_next_event() const override
+    {
+        // Buffered requests wait on DRAM timings and plugins may act in any tick, so only an empty controller is idle
+        if (m_active_buffer.size() || m_priority_buffer.size() || m_read_buffer.size() || m_write_buffer.size() || m_plugins.size())
+        {
+            return 1;
+        }
+
+        Clk_t cycles = m_refresh->get_cycles_to_next_event();
+        if (pending.size())
+        {
+            cycles = std::min(cycles, std::max<Clk_t>(pending.front().depart - m_clk, 1));
+        }
+
+        return cycles;
+    };
+
+    void skip_cycles(Clk_t cycles) override
+    {
+        m_clk += cycles;
+
+        // Same statistics as ticking with empty buffers
+        s_queue_len += pending.size() * static_cast<size_t>(cycles);
+        s_read_queue_len += pending.size() * static_cast<size_t>(cycles);
+
+        set_write_mode();
+        m_refresh->skip_cycles(cycles);
+    };
+
+#if (TELEMETRY == ENABLE)
+    ChannelCounters get_counters() const override
+    {
+        return {s_num_served_reqs, s_row_hits, s_row_misses, s_row_conflicts, m_read_buffer.size() + m_write_buffer.size() + m_priority_buffer.size()};
+    };
+#endif /* TELEMETRY */
 #endif /* USER_CODES */
 
 private:
@@ -350,7 +404,11 @@ private:
 
           if (req.callback) {
             // If the request comes from outside (e.g., processor), call its callback
+#if (USER_CODES == ENABLE)
+            complete(req);
+#else
             req.callback(req);
+#endif /* USER_CODES */
           }
           // Finally, remove this request from the pending queue
           pending.pop_front();
@@ -56,7 +56,9 @@ class BlockHammer : public IControllerPlugin, public Implementation, public IBlo
     std::vector<BaseFilter*> m_filters;
     std::vector<HistoryBuffer<elem_t>*> m_histbufs;
     std::unordered_set<int> m_blacklisted_rows;
+#if (USER_CODES != ENABLE)
     std::vector<std::unordered_map<int ,int>*> m_activations; 
+#endif
     AttackThrottler* m_attack_throttler;
 
     int m_clk = -1;
@@ -152,17 +154,29 @@ class BlockHammer : public IControllerPlugin, public Implementation, public IBlo
           ));
         }
         m_filters.push_back(new BaseFilter(*sub_filters, m_bf_len_epoch_clk, m_llc));
+#if (USER_CODES != ENABLE)
         m_activations.push_back(new std::unordered_map<int, int>);
+#endif
       }
       m_filters[m_num_ranks * m_num_banks_per_rank - 1]->insert(0);
       m_filters[m_num_ranks * m_num_banks_per_rank - 1]->reset();
 
       for (int i = 0; i < m_num_ranks; i++) {
+#if (USER_CODES == ENABLE)
+        m_histbufs.push_back(new HistoryBuffer<elem_t>(m_bf_hist_size, m_bf_hist_max_freq, m_num_rows_per_bank));
+#else
         m_histbufs.push_back(new HistoryBuffer<elem_t>(m_bf_hist_size, m_bf_hist_max_freq));
+#endif
       }
 
+#if (USER_CODES == ENABLE)
+      m_attack_throttler = new AttackThrottler(m_llc, m_bf_num_rh, m_bf_ctr_thresh, m_bf_len_epoch_clk,
+                                                m_bf_trefw, m_bf_num_filters,
+                                                frontend->get_num_cores(), m_num_ranks * m_num_banks_per_rank);
+#else
       m_attack_throttler = new AttackThrottler(m_llc, m_bf_num_rh, m_bf_ctr_thresh, m_bf_len_epoch_clk,
                                                 m_bf_trefw, m_bf_num_filters);
+#endif
 
       if (m_is_debug) {
         std::cout << "------------------------------------" << std::endl
@@ -6,6 +6,9 @@
 #include "Ramulator2/base/base.h"
 #include "Ramulator2/dram_controller/controller.h"
 #include "Ramulator2/dram_controller/plugin.h"
+#if (USER_CODES == ENABLE)
+#include "Ramulator2/dram_controller/impl/plugin/counter_table/counter_table.h"
+#endif
 
 namespace Ramulator {
 
@@ -37,7 +40,12 @@ class Graphene : public IControllerPlugin, public Implementation {
     // indexed using flattened <rank id, bank id>
     // e.g., if rank 0, bank 4, index is 4
     // if rank 1, bank 5, index is 16 (assuming 16 banks/rank) + 5
+#if (USER_CODES == ENABLE)
+    // each table keeps its entries with the minimum count at hand, which are the ones that can be replaced
+    std::vector<SpaceSavingTable> m_activation_count_table;
+#else
     std::vector<std::unordered_map<int, int>> m_activation_count_table;
+#endif
     // spillover counter per bank
     std::vector<int> m_spillover_counter;
 
@@ -73,6 +81,12 @@ class Graphene : public IControllerPlugin, public Implementation {
       m_num_rows_per_bank = m_dram->get_level_size("row");
 
       // Initialize bank act count tables
+#if (USER_CODES == ENABLE)
+      m_activation_count_table.reserve(m_num_banks_per_rank * m_num_ranks);
+      for (int i = 0; i < m_num_banks_per_rank * m_num_ranks; i++) {
+        m_activation_count_table.emplace_back(m_num_table_entries, m_num_rows_per_bank);
+      }
+#else
       for (int i = 0; i < m_num_banks_per_rank * m_num_ranks; i++) {
         std::unordered_map<int, int> table;
         for (int j = -m_num_rows_per_bank; j < -m_num_rows_per_bank + m_num_table_entries; j++) {
@@ -80,6 +94,7 @@ class Graphene : public IControllerPlugin, public Implementation {
         }
         m_activation_count_table.push_back(table);
       }
+#endif
 
       // Initialize spillover counter
       m_spillover_counter = std::vector<int>(m_num_banks_per_rank * m_num_ranks, 0);
@@ -92,8 +107,12 @@ class Graphene : public IControllerPlugin, public Implementation {
       if (m_clk % m_reset_period_clk == 0) {
         // Reset
         for (int i = 0; i < m_num_banks_per_rank * m_num_ranks; i++) {
+#if (USER_CODES == ENABLE)
+          m_activation_count_table[i].counters().reset();
+#else
           for (auto it = m_activation_count_table[i].begin(); it != m_activation_count_table[i].end(); it++)
             it->second = 0;
+#endif
           m_spillover_counter[i] = 0;
         }
       }
@@ -117,6 +136,55 @@ class Graphene : public IControllerPlugin, public Implementation {
             std::cout << "  └  " << "index: " << flat_bank_id << std::endl;
           }
 
+#if (USER_CODES == ENABLE)
+          SpaceSavingTable& table = m_activation_count_table[flat_bank_id];
+          CounterSummary& counters = table.counters();
+          int entry = table.find(row_id);
+          if (entry == SpaceSavingTable::NO_KEY) {
+            // if row is not in the table, replace an entry
+            // with a count equal to that of the spillover counter,
+            // which can only be the minimum count, as no count is below the spillover counter
+            if (counters.min() == m_spillover_counter[flat_bank_id]) {
+              int to_remove = counters.min_counter();
+              // for debug
+              if (m_is_debug) {
+                // print the row that is being removed
+                std::cout << "Removing row " << table.key(to_remove) << " from table " << flat_bank_id << std::endl;
+                // print the row that is being added
+                std::cout << "Adding row " << row_id << " to table " << flat_bank_id << std::endl;
+                std::cout << "  └  " << "spillover counter: " << m_spillover_counter[flat_bank_id] << std::endl;
+              }
+              // the entry takes row_id with a count of spillover_value + 1
+              table.replace(to_remove, row_id);
+              counters.increment(to_remove);
+            }
+            // if we did not find such an entry, increment spillover counter by one
+            else {
+              m_spillover_counter[flat_bank_id] += 1;
+            }
+          }
+          else {
+            // if row in table, increment its activation count
+            counters.increment(entry);
+
+            if (m_is_debug) {
+              std::cout << "Row " << row_id << " in table[" << flat_bank_id << "]" << std::endl;
+              std::cout << "  └  " << "threshold: " << m_activation_threshold << std::endl;
+              std::cout << "  └  " << "count: " << counters.count(entry) << std::endl;
+            }
+
+            // check if the count exceeds the threshold
+            if (counters.count(entry) >= m_activation_threshold) {
+              if (m_is_debug) {
+                std::cout << "Row " << row_id << " in table " << flat_bank_id << " has exceeded the threshold!" << std::endl;
+              }
+              // if yes, schedule preventive refreshes
+              Request vrr_req(req_it->addr_vec, m_VRR_req_id);
+              m_ctrl->priority_send(vrr_req);
+              counters.lower(entry, m_spillover_counter[flat_bank_id]);
+            }
+          }
+#else
           if (m_activation_count_table[flat_bank_id].find(row_id) == m_activation_count_table[flat_bank_id].end()) {
             // if row is not in the table, find an entry 
             // with a count equal to that of the spillover counter
@@ -176,6 +244,7 @@ class Graphene : public IControllerPlugin, public Implementation {
               m_activation_count_table[flat_bank_id][row_id] = m_spillover_counter[flat_bank_id];
             }
           }
+#endif
         }
       }
     }
@@ -11,6 +11,9 @@
 #include "Ramulator2/addr_mapper/addr_mapper.h"
 #include "Ramulator2/dram_controller/controller.h"
 #include "Ramulator2/dram_controller/plugin.h"
+#if (USER_CODES == ENABLE)
+#include "Ramulator2/dram_controller/impl/plugin/counter_table/counter_table.h"
+#endif
 
 namespace Ramulator {
 
@@ -27,6 +30,14 @@ class Hydra : public IControllerPlugin, public Implementation {
       bool initialized;
     };
 
+#if (USER_CODES == ENABLE)
+    struct RCC_Entry {
+      Addr_t tag;
+      int row_count;
+      bool valid;
+    };
+#endif
+
     int m_clk = -1;
 
     // input parameters
@@ -70,6 +81,18 @@ class Hydra : public IControllerPlugin, public Implementation {
     int m_rct_per_cl = -1;
     int m_group_rct_cl_size = -1;
 
+#if (USER_CODES == ENABLE)
+    // The tables are flat arrays, where an entry that is not tracked holds zeros
+    // per bank GCT, indexed by the flat bank id and the row group id
+    FlatCounterTable<GCT_Entry> group_count_table;
+    // per bank RCT, indexed by the flat bank id and the row id
+    FlatCounterTable<int> row_count_table;
+    // per rank RCC, a 16-set associative cache,
+    // each table is a set of 16 ways, indexed by rank id * m_rcc_set_num + rcc set id
+    FlatCounterTable<RCC_Entry> row_count_cache;
+    // per bank RCT count table, indexed by the flat bank id and the row id
+    FlatCounterTable<int> rct_count_table;
+#else
     // per bank GCT, 
     // the first index is the flat bank id
     // the second index is the row group id
@@ -94,6 +117,7 @@ class Hydra : public IControllerPlugin, public Implementation {
     // the second index is the row id
     // each entry has a row counter
     std::vector<std::unordered_map<Addr_t, int>> rct_count_table;
+#endif
 
     // rng for random policy
     std::mt19937 generator;
@@ -177,6 +201,12 @@ class Hydra : public IControllerPlugin, public Implementation {
       m_group_rct_cl_size = m_row_group_size * m_counter_bits / 512;
 
       // Initialize tables
+#if (USER_CODES == ENABLE)
+      group_count_table = FlatCounterTable<GCT_Entry>(m_num_ranks * m_num_banks_per_rank, m_gct_entries_per_bank, {0, false});
+      row_count_cache = FlatCounterTable<RCC_Entry>(m_num_ranks * m_rcc_set_num, 16, {0, 0, false});
+      row_count_table = FlatCounterTable<int>(m_num_ranks * m_num_banks_per_rank, m_num_rows_per_bank, 0);
+      rct_count_table = FlatCounterTable<int>(m_num_ranks * m_num_banks_per_rank, m_total_rct_row_size, 0);
+#else
       for (int i = 0; i < m_num_ranks * m_num_banks_per_rank; i++) {
         std::unordered_map<Addr_t, GCT_Entry> gct_bank;
         group_count_table.push_back(gct_bank);
@@ -201,6 +231,7 @@ class Hydra : public IControllerPlugin, public Implementation {
         std::unordered_map<Addr_t, int> rctct_bank;
         rct_count_table.push_back(rctct_bank);
       }
+#endif
 
       if (m_is_debug) {
         std::cout << "------------------------------------" << std::endl
@@ -255,6 +286,12 @@ class Hydra : public IControllerPlugin, public Implementation {
 
       m_clk++;
       if (m_clk % m_reset_period_clk == 0) {
+#if (USER_CODES == ENABLE)
+        group_count_table.reset();
+        row_count_table.reset();
+        row_count_cache.reset();
+        rct_count_table.reset();
+#else
         for (int i = 0; i < m_num_ranks * m_num_banks_per_rank; i++) {
           group_count_table[i].clear();
         }
@@ -269,6 +306,7 @@ class Hydra : public IControllerPlugin, public Implementation {
         for (int i = 0; i < m_num_ranks * m_num_banks_per_rank; i++) {
           rct_count_table[i].clear();
         }
+#endif
         if (m_is_debug) {
           std::cout << "----------------------------------" << std::endl;
           std::cout << "Hydra: Reset all tables (" << m_clk << ")" << std::endl;
@@ -304,6 +342,211 @@ class Hydra : public IControllerPlugin, public Implementation {
                       << "        rcc_tag:      " << std::setw(6) << rcc_tag      << " -  " << std::bitset<12>(rcc_tag) << std::endl;
           }
 
+#if (USER_CODES == ENABLE)
+          // if the row is in the RCT rows, use RCT_count_table
+          if (row_id < static_cast<unsigned int>(m_total_rct_row_size)){
+            // increment RCT_count_table
+            int& rct_count = rct_count_table.at(flat_bank_id, row_id);
+            rct_count++;
+            if (m_is_debug) {
+              std::cout << "Hydra: Row in RCT rows" << std::endl;
+              std::cout << "Hydra: RCT_count_table incremented (" << rct_count << ")" << std::endl;
+            }
+            // check rct_count_table
+            s_rctct_check++;
+            if (rct_count >= m_tracking_threshold){
+              if (m_is_debug) {
+                std::cout << "Hydra: RCT_count_table above threshold, issue VRR, reset counter" << std::endl;
+              }
+              // issue VRR
+              Request vrr_req(req_it->addr_vec, m_VRR_req_id);
+              m_ctrl->priority_send(vrr_req);
+              s_num_vrr_rct++;
+              s_num_vrr++;
+              // reset rcc
+              rct_count = 0;
+            } else {
+              if (m_is_debug) {
+                std::cout << "Hydra: RCT_count_table below threshold, do nothing" << std::endl;
+              }
+            }
+            return;
+          }
+
+          // check gct
+          s_gct_check++;
+
+          GCT_Entry& group_entry = group_count_table.at(flat_bank_id, gct_index);
+          if (group_entry.group_count >= m_group_threshold){
+            if (m_is_debug) {
+              std::cout << "Hydra: Checking GCT" << std::endl;
+              std::cout << "Hydra: GCT above threshold " 
+                        << group_entry.group_count << std::endl;
+            }
+
+            if (!group_entry.initialized){
+              if (m_is_debug) {
+                std::cout << "Hydra: Group not initialized" << std::endl;
+              }
+
+              // initialize rct
+              group_entry.initialized = true;
+              s_num_initialization++;
+              int row_group_start_row_id = gct_index * m_row_group_size;
+              for (int i = 0; i < m_row_group_size; i++){
+                int row = row_group_start_row_id + i;
+                row_count_table.at(flat_bank_id, row) = m_group_threshold;
+              }
+              // generate write request to DRAM for rct
+              for (int i = 0; i < m_group_rct_cl_size; i++){
+                std::vector<int> rct_init_addr_vec;
+                for (size_t j = 0; j < req_it->addr_vec.size(); j++){
+                  rct_init_addr_vec.push_back(req_it->addr_vec[j]);
+                }
+                std::pair<Addr_t, Addr_t> init_row_col_id = generate_row_col_id(row_group_start_row_id + i * m_rct_per_cl);
+                rct_init_addr_vec[m_row_level] = init_row_col_id.first;
+                rct_init_addr_vec[m_col_level] = init_row_col_id.second;
+                Request rct_init_req(rct_init_addr_vec, m_WR_req_id);
+                m_ctrl->priority_send(rct_init_req);
+                s_num_write_req++;
+                
+                if (m_is_debug) {
+                  std::cout << "Hydra: Group initializing, generating write request to DRAM for RCT" << std::endl
+                            << "        rct_bank: " << flat_bank_id << std::endl
+                            << "        rct_row:  " << rct_init_addr_vec[m_row_level] << std::endl
+                            << "        rct_col:  " << rct_init_addr_vec[m_col_level] << std::endl;
+                }
+              }
+            } else {
+              if (m_is_debug) {
+                std::cout << "Hydra: Group already initialized" << std::endl;
+              }
+            }
+
+            std::span<RCC_Entry> rcc_set = row_count_cache.table(rank_id * m_rcc_set_num + rcc_index);
+            if (m_is_debug) {
+              std::cout << "Hydra: Checking RCC[" << rank_id << "][" << rcc_index << "].size() = " << std::ranges::count_if(rcc_set, &RCC_Entry::valid) << std::endl;
+              for (const RCC_Entry& rcc_entry : rcc_set){
+                if (rcc_entry.valid) {
+                  std::cout << "        tag: " << std::setw(6) << rcc_entry.tag << " counter: " << rcc_entry.row_count << std::endl;
+                }
+              }
+            }
+
+            // check rcc
+            s_rcc_check++;
+            auto rcc_entry = std::ranges::find_if(rcc_set, [rcc_tag](const RCC_Entry& entry) { return entry.valid && entry.tag == rcc_tag; });
+            if (rcc_entry == rcc_set.end()){
+              s_num_rcc_miss++;
+              if (m_is_debug) {
+                std::cout << "Hydra: RCC miss" << std::endl;
+              }
+              // check if rcc line is full
+              rcc_entry = std::ranges::find_if_not(rcc_set, &RCC_Entry::valid);
+              if (rcc_entry == rcc_set.end()){
+                // evicting an entry
+                rcc_entry = rcc_set.begin() + get_way_to_evict(rcc_set);
+                int tag_to_evict = rcc_entry->tag;
+                if (m_is_debug) {
+                  std::cout << "Hydra: RCC full, evicting " << tag_to_evict << std::endl;
+                }
+                // generate write request to DRAM for evicted entry
+                std::vector<int> evicted_entry_addr_vec;
+                for (size_t i = 0; i < req_it->addr_vec.size(); i++){
+                  evicted_entry_addr_vec.push_back(req_it->addr_vec[i]);
+                }
+                int evicted_row_id = (tag_to_evict & ((1 << m_rcc_tag_row_bits) - 1)) << m_rcc_index_bits | rcc_index;
+                int evicted_bank_id = tag_to_evict >> m_rcc_tag_row_bits;
+                std::pair<Addr_t, Addr_t> evicted_row_col_id = generate_row_col_id(evicted_row_id);
+                evicted_entry_addr_vec[m_bank_group_level] = evicted_bank_id / m_dram->get_level_size("bank");
+                evicted_entry_addr_vec[m_bank_level] = evicted_bank_id % m_dram->get_level_size("bank");
+                evicted_entry_addr_vec[m_row_level] = evicted_row_col_id.first;
+                evicted_entry_addr_vec[m_col_level] = evicted_row_col_id.second;
+                Request rct_write_req(evicted_entry_addr_vec, m_WR_req_id);
+                m_ctrl->priority_send(rct_write_req);
+                s_num_eviction++;
+                s_num_write_req++;
+
+                if (m_is_debug) {
+                  std::cout << "Hydra: Generating write request to DRAM for evicted entry" << std::endl
+                            << "        evicted_row_id:  " << std::setw(6) << evicted_row_id  << " -     " << std::bitset<16>(evicted_row_id) << std::endl
+                            << "        evicted_bank_id: " << std::setw(6) << evicted_bank_id << " - " << std::bitset<4>(evicted_bank_id) << std::endl
+                            << "        evicted_tag:     " << std::setw(6) << tag_to_evict    << " - " << std::bitset<12>(tag_to_evict) << std::endl
+                            << "        rct_bank:        " << std::setw(6) << evicted_bank_id << std::endl
+                            << "        rct_row:         " << std::setw(6) << evicted_entry_addr_vec[m_row_level] << std::endl
+                            << "        rct_col:         " << std::setw(6) << evicted_entry_addr_vec[m_col_level] << std::endl;
+                }
+              } else {
+                if (m_is_debug) {
+                  std::cout << "Hydra: RCC not full" << std::endl;
+                }
+              }
+              // read rct from DRAM and update rcc
+              s_rct_check++;
+              // copy addr_vec and update row_id
+              AddrVec_t rct_read_addr_vec;
+              for (size_t i = 0; i < req_it->addr_vec.size(); i++){
+                rct_read_addr_vec.push_back(req_it->addr_vec[i]);
+              }
+              std::pair<Addr_t, Addr_t> row_col_id = generate_row_col_id(rct_read_addr_vec[m_row_level]);
+              rct_read_addr_vec[m_row_level] = row_col_id.first;
+              rct_read_addr_vec[m_col_level] = row_col_id.second;
+
+              Request rct_read_req(rct_read_addr_vec, m_RD_req_id);
+              m_ctrl->priority_send(rct_read_req);
+              s_num_read_req++;
+
+              // insert new entry and increment rcc
+              row_count_table.at(flat_bank_id, row_id)++;
+              *rcc_entry = {rcc_tag, row_count_table.at(flat_bank_id, row_id), true};
+              
+              if (m_is_debug) {
+                std::cout << "Hydra: Generating read request to DRAM for RCT" << std::endl
+                          << "        rct_bank: " << flat_bank_id << std::endl
+                          << "        rct_row:  " << rct_read_addr_vec[m_row_level] << std::endl
+                          << "        rct_col:  " << rct_read_addr_vec[m_col_level] << std::endl;
+                std::cout << "Hydra: RCC incrementing" << std::endl;
+              }
+            } else {
+              rcc_entry->row_count++;
+              row_count_table.at(flat_bank_id, row_id)++;
+              if (m_is_debug) {
+                std::cout << "Hydra: RCC hit" << std::endl;
+                std::cout << "Hydra: RCC incrementing" << std::endl;
+              }
+            }
+
+            if (m_is_debug) {
+              std::cout << "Hydra: Checking RCC counter (" << rcc_entry->row_count << ")" << std::endl;
+            }
+
+            // check if counter is above threshold
+            if (rcc_entry->row_count >= m_tracking_threshold){
+              if (m_is_debug) {
+                std::cout << "Hydra: RCC above threshold, issue VRR, reset counter" << std::endl;
+              }
+              // issue VRR
+              Request vrr_req(req_it->addr_vec, m_VRR_req_id);
+              m_ctrl->priority_send(vrr_req);
+              s_num_vrr++;
+              // reset rcc
+              rcc_entry->row_count = 0;
+              row_count_table.at(flat_bank_id, row_id) = 0;
+            } else {
+              if (m_is_debug) {
+                std::cout << "Hydra: RCC below threshold, do nothing" << std::endl;
+              }
+            }
+          }
+          else{
+            if (m_is_debug) {
+              std::cout << "Hydra: Checking GCT" << std::endl;
+              std::cout << "Hydra: GCT below threshold (" << group_entry.group_count << ")" << std::endl;
+              std::cout << "Hydra: GCT incrementing" << std::endl;
+            }
+            group_entry.group_count++;
+          }
+#else
           // if the row is in the RCT rows, use RCT_count_table
 #if (USER_CODES == ENABLE)
           if (row_id < static_cast<unsigned int>(m_total_rct_row_size)){
@@ -526,6 +769,7 @@ class Hydra : public IControllerPlugin, public Implementation {
             }
             group_count_table[flat_bank_id][gct_index].group_count++;
           }
+#endif
         }
       }
     };
@@ -537,6 +781,18 @@ class Hydra : public IControllerPlugin, public Implementation {
       return std::make_pair(rct_row_id, rct_col_id);
     };
 
+#if (USER_CODES == ENABLE)
+    // @return The way to evict from a full RCC set
+    int get_way_to_evict(std::span<const RCC_Entry> rcc_set) {
+      if (m_rcc_policy == "RANDOM") {
+        return distribution(generator);
+      } else if (m_rcc_policy == "MIN_COUNT") {
+        return std::ranges::min_element(rcc_set, {}, &RCC_Entry::row_count) - rcc_set.begin();
+      } else {
+        throw ConfigurationError("Undefined RCC eviction policy.");
+      }
+    };
+#else
     int get_tag_to_evict(int rank_id, int rcc_index) {
       int tag_to_evict = -1;
 
@@ -559,6 +815,7 @@ class Hydra : public IControllerPlugin, public Implementation {
 
       return tag_to_evict;
     };
+#endif
 
     void reserve_rows_for_rct() {
       Addr_t max_addr = m_translation->get_max_addr();
@@ -3,6 +3,9 @@
 #include "Ramulator2/dram_controller/plugin.h"
 #include "Ramulator2/dram_controller/impl/plugin/prac/prac.h"
 #include "Ramulator2/dram_controller/impl/plugin/device_config/device_config.h"
+#if (USER_CODES == ENABLE)
+#include "Ramulator2/dram_controller/impl/plugin/counter_table/counter_table.h"
+#endif
 
 #include <limits>
 #include <vector>
@@ -195,8 +198,8 @@ private:
     public: 
         PerBankCounters(int bank_id, DeviceConfig& cfg, bool& is_abo_needed, int alert_thresh, bool debug)
 #if (USER_CODES == ENABLE)
-        : m_cfg(cfg), m_is_abo_needed(is_abo_needed), m_alert_thresh(alert_thresh),
-        m_debug(debug), m_bank_id(bank_id) {
+        : m_cfg(cfg), m_is_abo_needed(is_abo_needed), m_counters(cfg.m_num_rows_per_bank),
+        m_alert_thresh(alert_thresh), m_debug(debug), m_bank_id(bank_id) {
 #else
         : m_bank_id(bank_id), m_cfg(cfg), m_is_abo_needed(is_abo_needed),
         m_alert_thresh(alert_thresh), m_debug(debug) {
@@ -206,7 +209,9 @@ private:
         }
 
         ~PerBankCounters() {
+#if (USER_CODES != ENABLE)
             m_counters.clear();
+#endif
         }
 
         void on_request(const Request& req) {
@@ -232,12 +237,21 @@ private:
         }
 
         void reset() {
+#if (USER_CODES == ENABLE)
+            m_counters.reset();
+            m_num_critical_rows = 0;
+#else
             m_counters.clear();
             m_critical_rows.clear();
+#endif
         }
 
         bool is_critical() {
+#if (USER_CODES == ENABLE)
+            return m_num_critical_rows > 0;
+#else
             return m_critical_rows.size() > 0;
+#endif
         }
 
     private:
@@ -249,14 +263,57 @@ private:
         DeviceConfig& m_cfg;
         bool& m_is_abo_needed;
 
+#if (USER_CODES == ENABLE)
+        // One counter per row of the bank. PRAC only increments them and resets them to 0, so the row to refresh is the maximum, found in O(1)
+        CounterSummary m_counters;
+        // Rows whose counter reached the alert threshold
+        int m_num_critical_rows = 0;
+#else
         std::unordered_map<int, uint32_t> m_counters;
         std::unordered_map<int, uint32_t> m_critical_rows;
+#endif
         std::unordered_map<int, CommandHandler> m_handlertable;
 
         int m_alert_thresh = -1;
         bool m_debug = false;
         int m_bank_id = -1;
 
+#if (USER_CODES == ENABLE)
+        void process_act(const Request& req) {
+            auto row_addr = req.addr_vec[m_cfg.m_row_level];
+            m_counters.increment(row_addr);
+            uint32_t counter = m_counters.count(row_addr);
+            if (m_debug) {
+                std::printf("[PRAC] [%d] [ACT] Row: %d Act: %u\n",
+                    m_bank_id, row_addr, counter);
+            }
+            if (counter >= static_cast<uint32_t>(m_alert_thresh)) {
+                if (counter == static_cast<uint32_t>(m_alert_thresh)) {
+                    m_num_critical_rows++;
+                }
+                m_is_abo_needed = true;
+            }
+        }
+
+        void process_rfm(const Request& req) {
+            uint32_t act_max = m_counters.max();
+            if (act_max == 0) {
+                if (m_debug) {
+                    std::printf("[PRAC] [%d] [RFM] No critical row.\n", m_bank_id);
+                }
+                return;
+            }
+            int row_addr = m_counters.max_counter();
+            if (m_debug) {
+                std::printf("[PRAC] [%d] [RFM] Row: %d Act: %u\n",
+                    m_bank_id, row_addr, act_max);
+            }
+            if (act_max >= static_cast<uint32_t>(m_alert_thresh)) {
+                m_num_critical_rows--;
+            }
+            m_counters.lower(row_addr, 0);
+        }
+#else
         void process_act(const Request& req) {
             auto row_addr = req.addr_vec[m_cfg.m_row_level];    
             if (m_counters.find(row_addr) == m_counters.end()) {
@@ -295,6 +352,7 @@ private:
             m_counters[act_max->first] = 0;
             m_critical_rows.erase(act_max->first);
         }
+#endif
     };  // class PerBankCounters
 
 };      // class PRAC
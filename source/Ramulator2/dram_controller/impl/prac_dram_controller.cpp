@@ -46,6 +46,10 @@ private:
     int s_num_row_misses = 0;
     int s_num_row_conflicts = 0;
 
+#if (USER_CODES == ENABLE) && (TELEMETRY == ENABLE)
+    size_t s_num_served_reqs = 0;
+#endif /* USER_CODES, TELEMETRY */
+
     // DEBUG STAT
     int m_invalidate_ctr = -1;
 
@@ -83,6 +87,12 @@ public:
         m_bank_addr_idx = m_dram->m_levels("bank");
         m_row_addr_idx = m_dram->m_levels("row");
         m_priority_buffer.max_size = 512*3 + 32;
+#if (USER_CODES == ENABLE)
+        // Per-bank sub-queues let the scheduler skip the banks that cannot issue
+        for (auto* buffer : {&m_active_buffer, &m_priority_buffer, &m_read_buffer, &m_write_buffer, &m_prac_buffer}) {
+          buffer->set_organization(m_dram->m_organization.count, m_bank_addr_idx, m_dram->m_levels("row"));
+        }
+#endif /* USER_CODES */
 
         std::vector<int> all_bank_addr_vec(m_dram->m_levels.size(), -1);
         all_bank_addr_vec[m_dram->m_levels("channel")] = m_channel_id;
@@ -127,6 +137,9 @@ public:
                 // The request will depart at the next cycle
                 req.depart = m_clk + 1;
                 pending.push_back(req);
+#if (USER_CODES == ENABLE) && (TELEMETRY == ENABLE)
+                s_num_served_reqs++;
+#endif /* USER_CODES, TELEMETRY */
                 return true;
             }
         }
@@ -202,6 +215,9 @@ public:
 
             // If we are issuing the last command, set depart clock cycle and move the request to the pending queue
             if (req_it->command == req_it->final_command) {
+#if (USER_CODES == ENABLE) && (TELEMETRY == ENABLE)
+                s_num_served_reqs++;
+#endif /* USER_CODES, TELEMETRY */
                 if (req_it->type_id == Request::Type::Read) {
                     req_it->depart = m_clk + m_dram->m_read_latency;
                     pending.push_back(*req_it);
@@ -220,6 +236,14 @@ public:
 
     };
 
+#if (USER_CODES == ENABLE) && (TELEMETRY == ENABLE)
+    ChannelCounters get_counters() const override
+    {
+        return {s_num_served_reqs, static_cast<size_t>(s_num_row_hits), static_cast<size_t>(s_num_row_misses), static_cast<size_t>(s_num_row_conflicts),
+                m_read_buffer.size() + m_write_buffer.size() + m_priority_buffer.size()};
+    };
+#endif /* USER_CODES, TELEMETRY */
+
 private:
     /**
         * @brief    Helper function to serve the completed read requests
@@ -241,7 +265,11 @@ private:
 
                 if (req.callback) {
                     // If the request comes from outside (e.g., processor), call its callback
+#if (USER_CODES == ENABLE)
+                    complete(req);
+#else
                     req.callback(req);
+#endif /* USER_CODES */
                 }
                 // Finally, remove this request from the pending queue
                 pending.pop_front();
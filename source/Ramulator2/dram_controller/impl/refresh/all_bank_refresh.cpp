@@ -56,6 +56,12 @@ class AllBankRefresh : public IRefreshManager, public Implementation {
       }
     };
 
+#if (USER_CODES == ENABLE)
+    Clk_t get_cycles_to_next_event() const override { return m_next_refresh_cycle - m_clk; };
+
+    void skip_cycles(Clk_t cycles) override { m_clk += cycles; };
+#endif /* USER_CODES */
+
 };
 
 }       // namespace Ramulator
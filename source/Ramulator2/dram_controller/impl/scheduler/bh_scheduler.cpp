@@ -25,8 +25,14 @@ class BHScheduler : public IBHScheduler, public Implementation {
     }
 
     ReqBuffer::iterator compare(ReqBuffer::iterator req1, ReqBuffer::iterator req2) override {
+#if (USER_CODES == ENABLE)
+      // Readiness recorded by ReqBuffer::decode_commands()
+      bool ready1 = req1.is_ready();
+      bool ready2 = req2.is_ready();
+#else
       bool ready1 = m_dram->check_ready(req1->command, req1->addr_vec);
       bool ready2 = m_dram->check_ready(req2->command, req2->addr_vec);
+#endif /* USER_CODES */
 
       if (ready1 ^ ready2) {
         if (ready1) {
@@ -49,6 +55,11 @@ class BHScheduler : public IBHScheduler, public Implementation {
         return buffer.end();
       }
 
+#if (USER_CODES == ENABLE)
+      // Same choice as folding compare() over the buffer, but only the banks that can issue are scanned
+      buffer.decode_commands(m_dram);
+      return buffer.first_ready_first_come();
+#else
       for (auto& req : buffer) {
         req.command = m_dram->get_preq_command(req.final_command, req.addr_vec);
       }
@@ -58,6 +69,7 @@ class BHScheduler : public IBHScheduler, public Implementation {
         candidate = compare(candidate, next);
       }
       return candidate;
+#endif /* USER_CODES */
     }
 
     virtual void tick() override {
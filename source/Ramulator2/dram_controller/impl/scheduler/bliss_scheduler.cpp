@@ -76,6 +76,21 @@ class BLISSScheduler : public IBHScheduler, public Implementation {
         return buffer.end();
       }
 
+#if (USER_CODES == ENABLE)
+      buffer.decode_commands(m_dram);
+      for (auto it = buffer.begin(); it != buffer.end(); it++) {
+        auto& req = *it;
+
+        // Check if the request is safe to issue
+        bool blisted = m_bliss->is_blacklisted(req.source_id);
+        bool isrw = req.type_id == m_req_rd || req.type_id == m_req_wr;
+        bool safe = !isrw || !blisted;
+        req.scratchpad[SAFE_IDX] = safe;
+
+        // Check if the request is ready
+        req.scratchpad[READY_IDX] = it.is_ready();
+      }
+#else
       for (auto& req : buffer) {
         req.command = m_dram->get_preq_command(req.final_command, req.addr_vec);
 
@@ -89,6 +104,7 @@ class BLISSScheduler : public IBHScheduler, public Implementation {
         bool ready = m_dram->check_ready(req.command, req.addr_vec);
         req.scratchpad[READY_IDX] = ready;
       }
+#endif /* USER_CODES */
 
       auto candidate = buffer.begin();
       for (auto next = std::next(buffer.begin(), 1); next != buffer.end(); next++) {
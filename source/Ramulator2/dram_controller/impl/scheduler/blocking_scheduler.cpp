@@ -35,8 +35,14 @@ class BlockingScheduler : public IBHScheduler, public Implementation {
     }
 
     ReqBuffer::iterator compare(ReqBuffer::iterator req1, ReqBuffer::iterator req2) override {
+#if (USER_CODES == ENABLE)
+      // Readiness recorded by ReqBuffer::decode_commands()
+      bool ready1 = req1.is_ready();
+      bool ready2 = req2.is_ready();
+#else
       bool ready1 = m_dram->check_ready(req1->command, req1->addr_vec);
       bool ready2 = m_dram->check_ready(req2->command, req2->addr_vec);
+#endif /* USER_CODES */
 
       if (ready1 ^ ready2) {
         if (ready1) {
@@ -59,9 +65,13 @@ class BlockingScheduler : public IBHScheduler, public Implementation {
         return buffer.end();
       }
 
+#if (USER_CODES == ENABLE)
+      buffer.decode_commands(m_dram);
+#else
       for (auto& req : buffer) {
         req.command = m_dram->get_preq_command(req.final_command, req.addr_vec);
       }
+#endif /* USER_CODES */
 
       auto candidate = buffer.begin();
       while (candidate != buffer.end() && !m_bh->is_act_safe(*candidate)) {
@@ -79,11 +79,20 @@ public:
         }
 
         Clk_t next_recovery = m_prac->next_recovery_cycle();
+#if (USER_CODES == ENABLE)
+        buffer.decode_commands(m_dram);
+        for (auto it = buffer.begin(); it != buffer.end(); it++) {
+            auto& req = *it;
+            req.scratchpad[FITS_IDX] = m_clk + m_prac->min_cycles_with_preall(req) < next_recovery;
+            req.scratchpad[READY_IDX] = it.is_ready();
+        }
+#else
         for (auto& req : buffer) {
             req.command = m_dram->get_preq_command(req.final_command, req.addr_vec);
             req.scratchpad[FITS_IDX] = m_clk + m_prac->min_cycles_with_preall(req) < next_recovery;
             req.scratchpad[READY_IDX] = m_dram->check_ready(req.command, req.addr_vec);
         }
+#endif /* USER_CODES */
 
         auto candidate = buffer.begin();
         for (auto next = std::next(buffer.begin(), 1); next != buffer.end(); next++) {
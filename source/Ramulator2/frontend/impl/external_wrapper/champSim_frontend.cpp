@@ -28,7 +28,7 @@ private:
     // ChampSim frontend is used to complete the Ramulator::IMemorySystem's initialization (connect_frontend)
     void tick() override {};
 
-    bool receive_external_requests(int req_type_id, Addr_t addr, int source_id, std::function<void(Request&)> callback) override { return true; };
+    bool receive_external_requests(int req_type_id, Addr_t addr, int source_id, RequestCallback callback) override { return true; };
 
     bool is_finished() override { return true; };
 };
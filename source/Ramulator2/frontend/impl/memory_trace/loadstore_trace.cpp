@@ -5,10 +5,117 @@
 #include "Ramulator2/frontend/frontend.h"
 #include "Ramulator2/base/exception.h"
 
+#if (USER_CODES == ENABLE)
+#include "Ramulator2/frontend/impl/memory_trace/trace_reader.h"
+#endif /* USER_CODES */
+
 namespace Ramulator {
 
 namespace fs = std::filesystem;
 
+#if (USER_CODES == ENABLE)
+class LoadStoreTrace : public IFrontEnd, public Implementation {
+  RAMULATOR_REGISTER_IMPLEMENTATION(IFrontEnd, LoadStoreTrace, "LoadStoreTrace", "Load/Store memory address trace.")
+
+  private:
+    struct Trace {
+      bool is_write;
+      Addr_t addr;
+    };
+    // The trace is streamed instead of loaded whole, only the request to be sent next is kept here
+    std::unique_ptr<TraceReader<Trace>> m_reader;
+    Trace m_curr_trace = {false, -1};
+
+    size_t m_trace_length = 0;    // Known after the first pass over the trace
+    size_t m_pass_count = 0;      // Requests read in the current pass
+
+    size_t m_trace_count = 0;
+
+    Logger_t m_logger;
+
+  public:
+    void init() override {
+      std::string trace_path_str = param<std::string>("path").desc("Path to the load store trace file.").required();
+      m_clock_ratio = param<uint>("clock_ratio").required();
+
+      m_logger = Logging::create_logger("LoadStoreTrace");
+      m_logger->info("Loading trace file {} ...", trace_path_str);
+      m_reader = std::make_unique<TraceReader<Trace>>(
+        trace_path_str,
+        [trace_path_str](std::string_view line) { return parse_line(trace_path_str, line); },
+        // Memory traces written by ChampSim under BINARY_MEMORY_TRACE
+        [](uint64_t address, bool is_write) { return Trace{is_write, static_cast<Addr_t>(address)}; });
+      if (!next_trace()) {
+        throw ConfigurationError("Trace {} is empty!", trace_path_str);
+      }
+    };
+
+
+    void tick() override {
+      const Trace& t = m_curr_trace;
+      bool request_sent = m_memory_system->send({t.addr, t.is_write ? Request::Type::Write : Request::Type::Read});
+      if (request_sent) {
+        m_trace_count++;
+        advance_trace();
+      }
+    };
+
+
+  private:
+    static Trace parse_line(const std::string& file_path_str, std::string_view line) {
+      std::vector<std::string> tokens;
+      tokenize(tokens, std::string(line), " ");
+
+      // TODO: Add line number here for better error messages
+      if (tokens.size() != 2) {
+        throw ConfigurationError("Trace {} format invalid!", file_path_str);
+      }
+
+      bool is_write = false;
+      if (tokens[0] == "LD") {
+        is_write = false;
+      } else if (tokens[0] == "ST") {
+        is_write = true;
+      } else {
+        throw ConfigurationError("Trace {} format invalid!", file_path_str);
+      }
+
+      Addr_t addr = -1;
+      if ((tokens[1].compare(0, 2, "0x") == 0) | (tokens[1].compare(0, 2, "0X") == 0)) {
+        addr = std::stoll(tokens[1].substr(2), nullptr, 16);
+      } else {
+        addr = std::stoll(tokens[1]);
+      }
+      return {is_write, addr};
+    };
+
+    bool next_trace() {
+      if (!m_reader->next(m_curr_trace)) {
+        return false;
+      }
+      m_pass_count++;
+      return true;
+    };
+
+    /**
+     * @brief    Read the next request, wrapping around to the start of the trace at its end.
+     */
+    void advance_trace() {
+      if (next_trace()) {
+        return;
+      }
+      m_trace_length = m_pass_count;
+      m_pass_count = 0;
+      m_reader->rewind();
+      next_trace();
+    };
+
+    // TODO: FIXME
+    bool is_finished() override {
+      return (m_trace_length != 0) && (m_trace_count >= m_trace_length);
+    };
+};
+#else
 class LoadStoreTrace : public IFrontEnd, public Implementation {
   RAMULATOR_REGISTER_IMPLEMENTATION(IFrontEnd, LoadStoreTrace, "LoadStoreTrace", "Load/Store memory address trace.")
 
@@ -102,5 +209,6 @@ class LoadStoreTrace : public IFrontEnd, public Implementation {
       return m_trace_count >= m_trace_length; 
     };
 };
+#endif /* USER_CODES */
 
 }        // namespace Ramulator
\ No newline at end of file
@@ -5,10 +5,93 @@
 #include "Ramulator2/frontend/frontend.h"
 #include "Ramulator2/base/exception.h"
 
+#if (USER_CODES == ENABLE)
+#include "Ramulator2/frontend/impl/memory_trace/trace_reader.h"
+#endif /* USER_CODES */
+
 namespace Ramulator {
 
 namespace fs = std::filesystem;
 
+#if (USER_CODES == ENABLE)
+class ReadWriteTrace : public IFrontEnd, public Implementation {
+  RAMULATOR_REGISTER_IMPLEMENTATION(IFrontEnd, ReadWriteTrace, "ReadWriteTrace", "Read/Write DRAM address vector trace.")
+
+  private:
+    struct Trace {
+      bool is_write;
+      AddrVec_t addr_vec;
+    };
+    // The trace is streamed instead of loaded whole, only the request to be sent next is kept here
+    std::unique_ptr<TraceReader<Trace>> m_reader;
+    Trace m_curr_trace;
+
+    Logger_t m_logger;
+
+  public:
+    void init() override {
+      std::string trace_path_str = param<std::string>("path").desc("Path to the load store trace file.").required();
+      m_clock_ratio = param<uint>("clock_ratio").required();
+
+      m_logger = Logging::create_logger("ReadWriteTrace");
+      m_logger->info("Loading trace file {} ...", trace_path_str);
+      m_reader = std::make_unique<TraceReader<Trace>>(
+        trace_path_str,
+        [trace_path_str](std::string_view line) { return parse_line(trace_path_str, line); });
+      if (!m_reader->next(m_curr_trace)) {
+        throw ConfigurationError("Trace {} is empty!", trace_path_str);
+      }
+    };
+
+
+    void tick() override {
+      const Trace& t = m_curr_trace;
+      m_memory_system->send({t.addr_vec, t.is_write ? Request::Type::Write : Request::Type::Read});
+
+      // Wrap around to the start of the trace at its end
+      if (!m_reader->next(m_curr_trace)) {
+        m_reader->rewind();
+        m_reader->next(m_curr_trace);
+      }
+    };
+
+
+  private:
+    static Trace parse_line(const std::string& file_path_str, std::string_view line) {
+      std::vector<std::string> tokens;
+      tokenize(tokens, std::string(line), " ");
+
+      // TODO: Add line number here for better error messages
+      if (tokens.size() != 2) {
+        throw ConfigurationError("Trace {} format invalid!", file_path_str);
+      }
+
+      bool is_write = false;
+      if (tokens[0] == "R") {
+        is_write = false;
+      } else if (tokens[0] == "W") {
+        is_write = true;
+      } else {
+        throw ConfigurationError("Trace {} format invalid!", file_path_str);
+      }
+
+      std::vector<std::string> addr_vec_tokens;
+      tokenize(addr_vec_tokens, tokens[1], ",");
+
+      AddrVec_t addr_vec;
+      for (const auto& token : addr_vec_tokens) {
+        addr_vec.push_back(std::stoll(token));
+      }
+
+      return {is_write, addr_vec};
+    };
+
+    // TODO: FIXME
+    bool is_finished() override {
+      return true;
+    };
+};
+#else
 class ReadWriteTrace : public IFrontEnd, public Implementation {
   RAMULATOR_REGISTER_IMPLEMENTATION(IFrontEnd, ReadWriteTrace, "ReadWriteTrace", "Read/Write DRAM address vector trace.")
 
@@ -95,5 +178,6 @@ class ReadWriteTrace : public IFrontEnd, public Implementation {
       return true; 
     };    
 };
+#endif /* USER_CODES */
 
-}        // namespace Ramulator
\ No newline at end of file
+}        // namespace Ramulator
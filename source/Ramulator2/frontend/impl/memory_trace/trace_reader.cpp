@@ -0,0 +1,63 @@
+#include "Ramulator2/frontend/impl/memory_trace/trace_reader.h"
+
+#if (USER_CODES == ENABLE)
+#include <filesystem>
+#include <fstream>
+
+#include "ChampSim/inf_stream.h"
+
+namespace Ramulator {
+
+namespace fs = std::filesystem;
+
+namespace {
+
+template<typename StreamType>
+class StreamByteSource : public ITraceByteSource {
+  public:
+    explicit StreamByteSource(const std::string& path): m_stream(path) {};
+
+    std::size_t read(char* dst, std::size_t count) override {
+      m_stream.read(dst, static_cast<std::streamsize>(count));
+      return static_cast<std::size_t>(m_stream.gcount());
+    };
+
+  private:
+    StreamType m_stream;
+};
+
+bool has_suffix(const std::string& path, const std::string& suffix) {
+  return path.size() >= suffix.size() && path.compare(path.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+void check_trace_exists(const std::string& path) {
+  if (!fs::exists(fs::path(path))) {
+    throw ConfigurationError("Trace {} does not exist!", path);
+  }
+}
+
+}        // namespace
+
+std::unique_ptr<ITraceByteSource> open_trace_bytes(const std::string& path) {
+  check_trace_exists(path);
+
+  if (has_suffix(path, ".gz")) {
+    return std::make_unique<StreamByteSource<champsim::inf_istream<champsim::decomp_tags::gzip_tag_t<>>>>(path);
+  }
+  if (has_suffix(path, ".xz")) {
+    return std::make_unique<StreamByteSource<champsim::inf_istream<champsim::decomp_tags::lzma_tag_t<>>>>(path);
+  }
+  if (has_suffix(path, ".bz2")) {
+    return std::make_unique<StreamByteSource<champsim::inf_istream<champsim::decomp_tags::bzip2_tag_t>>>(path);
+  }
+
+  std::ifstream probe(path);
+  if (!probe.is_open()) {
+    throw ConfigurationError("Trace {} cannot be opened!", path);
+  }
+  return std::make_unique<StreamByteSource<std::ifstream>>(path);
+}
+
+}        // namespace Ramulator
+
+#endif /* USER_CODES */
@@ -67,7 +67,11 @@ void BHO3::init() {
     BHO3Core* core = new BHO3Core(id, ipc, depth,
       m_num_expected_insts, m_num_max_cycles, active_list[active_id],
       cur_translate, m_llc, lat_hist_sensitivity, lat_dump_path, is_attacker);
+#if (USER_CODES == ENABLE)
+    core->m_callback = RequestCallback::to<&BHO3::receive>(this);
+#else
     core->m_callback = [this](Request& req){return this->receive(req);} ;
+#endif /* USER_CODES */
     m_cores.push_back(core);
   }
 
@@ -56,7 +56,11 @@ class SimpleO3 final : public IFrontEnd, public Implementation {
       // Create the cores
       for (int id = 0; id < m_num_cores; id++) {
         SimpleO3Core* core = new SimpleO3Core(id, ipc, depth, m_num_expected_insts, trace_list[id], m_translation, m_llc);
+#if (USER_CODES == ENABLE)
+        core->m_callback = RequestCallback::to<&SimpleO3::receive>(this);
+#else
         core->m_callback = [this](Request& req){return this->receive(req);} ;
+#endif /* USER_CODES */
         m_cores.push_back(core);
       }
 
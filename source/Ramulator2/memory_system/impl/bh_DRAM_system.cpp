@@ -86,6 +86,12 @@ class BHDRAMSystem final : public IBHMemorySystem, public Implementation {
     IDRAM* get_dram() override {
       return m_dram;
     }
+
+#if (USER_CODES == ENABLE) && (TELEMETRY == ENABLE)
+    ChannelCounters get_channel_counters(int channel_id) const override {
+      return m_controllers[channel_id]->get_counters();
+    };
+#endif /* USER_CODES, TELEMETRY */
 };
   
 }   // namespace 
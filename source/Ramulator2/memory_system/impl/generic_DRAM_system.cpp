@@ -17,6 +17,10 @@ class GenericDRAMSystem final : public IMemorySystem, public Implementation {
     IAddrMapper*  m_addr_mapper;
     std::vector<IDRAMController*> m_controllers;
 
+#if (USER_CODES == ENABLE) && (PARALLEL_CHANNEL_TICK == ENABLE)
+    int m_num_tick_threads = 1; // Threads ticking the channel controllers, 1 means they tick serially
+#endif /* USER_CODES, PARALLEL_CHANNEL_TICK */
+
   public:
     int s_num_read_requests = 0;
     int s_num_write_requests = 0;
@@ -41,6 +45,14 @@ class GenericDRAMSystem final : public IMemorySystem, public Implementation {
 
       m_clock_ratio = param<uint>("clock_ratio").required();
 
+#if (USER_CODES == ENABLE) && (PARALLEL_CHANNEL_TICK == ENABLE)
+      m_num_tick_threads = param<int>("num_tick_threads").desc("The number of threads ticking the channel controllers in parallel.").default_val(1);
+      m_num_tick_threads = std::clamp(m_num_tick_threads, 1, num_channels);
+      for (auto controller : m_controllers) {
+        controller->defer_completions(m_num_tick_threads > 1);
+      }
+#endif /* USER_CODES, PARALLEL_CHANNEL_TICK */
+
       register_stat(m_clk).name("memory_system_cycles");
       register_stat(s_num_read_requests).name("total_num_read_requests");
       register_stat(s_num_write_requests).name("total_num_write_requests");
@@ -77,6 +89,22 @@ class GenericDRAMSystem final : public IMemorySystem, public Implementation {
     void tick() override {
       m_clk++;
       m_dram->tick();
+#if (USER_CODES == ENABLE) && (PARALLEL_CHANNEL_TICK == ENABLE)
+      if (m_num_tick_threads > 1) {
+        // Channels only share the device's future actions, which are added under a lock, and the callbacks, which are deferred
+        const int num_controllers = m_controllers.size();
+#pragma omp parallel for num_threads(m_num_tick_threads) schedule(static)
+        for (int i = 0; i < num_controllers; i++) {
+          m_controllers[i]->tick();
+        }
+
+        // Calling back in channel order is the order of serial ticks, as callbacks don't change the controllers
+        for (auto controller : m_controllers) {
+          controller->flush_completions();
+        }
+        return;
+      }
+#endif /* USER_CODES, PARALLEL_CHANNEL_TICK */
       for (auto controller : m_controllers) {
         controller->tick();
       }
@@ -175,6 +203,34 @@ class GenericDRAMSystem final : public IMemorySystem, public Implementation {
 
         return size;
     };
+
+    Clk_t get_cycles_to_next_event() const override
+    {
+        Clk_t cycles = m_dram->get_cycles_to_next_event();
+        for (auto controller : m_controllers)
+        {
+            cycles = std::min(cycles, controller->get_cycles_to_next_event());
+        }
+
+        return cycles;
+    };
+
+    void skip_cycles(Clk_t cycles) override
+    {
+        m_clk += cycles;
+        m_dram->skip_cycles(cycles);
+        for (auto controller : m_controllers)
+        {
+            controller->skip_cycles(cycles);
+        }
+    };
+
+#if (TELEMETRY == ENABLE)
+    ChannelCounters get_channel_counters(int channel_id) const override
+    {
+        return m_controllers[channel_id]->get_counters();
+    };
+#endif /* TELEMETRY */
 #endif /* USER_CODES */
 };
 
@@ -0,0 +1,148 @@
+#include "binary_memory_trace.h"
+
+#include <lzma.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+#include "ChampSim/inf_stream.h"
+
+// Functions private to a Compilation Unit (TU - Translation Unit): using anonymous namespaces or the static keyword
+namespace
+{
+constexpr uint32_t COMPRESSION_PRESET = 1; // Fast presets keep the writer thread ahead of the simulation
+
+using lzma_state_type = champsim::decomp_tags::lzma_tag_t<>::deflate_state_type;
+
+/**
+ * @brief Feed @p size bytes to the encoder and write out what it produces.
+ * With LZMA_RUN it returns once the input is consumed, otherwise once the flush or finish is done.
+ */
+void compress(lzma_state_type& stream, const uint8_t* input, std::size_t size, lzma_action action, FILE* file)
+{
+    std::array<uint8_t, 1 << 16> output;
+
+    stream->next_in  = input;
+    stream->avail_in = size;
+    while (true)
+    {
+        stream->next_out  = output.data();
+        stream->avail_out = output.size();
+
+        const lzma_ret ret = ::lzma_code(stream.get(), action);
+        if ((ret != LZMA_OK) && (ret != LZMA_STREAM_END))
+        {
+            std::cerr << __func__ << ": Compression Error " << ret << "." << std::endl;
+            std::abort();
+        }
+
+        const std::size_t produced = output.size() - stream->avail_out;
+        if (std::fwrite(output.data(), 1, produced, file) != produced)
+        {
+            std::cerr << __func__ << ": File Write Error." << std::endl;
+            std::abort();
+        }
+
+        if ((ret == LZMA_STREAM_END) || ((action == LZMA_RUN) && (stream->avail_in == 0)))
+        {
+            return;
+        }
+    }
+}
+} // namespace
+
+namespace binary_memory_trace
+{
+BinaryMemoryTraceWriter::BinaryMemoryTraceWriter(FILE* file)
+: file(file), ring(RING_SIZE)
+{
+    writer = std::thread(&BinaryMemoryTraceWriter::run, this);
+}
+
+BinaryMemoryTraceWriter::~BinaryMemoryTraceWriter()
+{
+    close();
+}
+
+void BinaryMemoryTraceWriter::close()
+{
+    if (writer.joinable())
+    {
+        stopping.store(true, std::memory_order_release);
+        writer.join();
+    }
+}
+
+void BinaryMemoryTraceWriter::run()
+{
+    lzma_state_type stream {new lzma_stream};
+    *stream = LZMA_STREAM_INIT;
+    if (::lzma_easy_encoder(stream.get(), COMPRESSION_PRESET, LZMA_CHECK_CRC64) != LZMA_OK)
+    {
+        std::cerr << __func__ << ": Compression Initialization Error." << std::endl;
+        std::abort();
+    }
+
+    compress(stream, reinterpret_cast<const uint8_t*>(MAGIC.data()), MAGIC.size(), LZMA_RUN, file);
+
+    std::vector<uint8_t> block(BLOCK_HEADER_SIZE + REQUESTS_PER_BLOCK * MAX_VARINT_SIZE);
+    uint32_t request_count    = 0;
+    std::size_t payload_bytes = 0;
+    uint64_t previous_address = 0;
+
+    const auto flush_block = [&]()
+    {
+        const uint32_t payload_size = static_cast<uint32_t>(payload_bytes);
+        std::memcpy(block.data(), &request_count, sizeof(request_count));
+        std::memcpy(block.data() + sizeof(request_count), &payload_size, sizeof(payload_size));
+        compress(stream, block.data(), BLOCK_HEADER_SIZE + payload_bytes, LZMA_FULL_FLUSH, file);
+
+        request_count    = 0;
+        payload_bytes    = 0;
+        previous_address = 0;
+    };
+
+    while (true)
+    {
+        // Read stopping first, so everything pushed before close() is seen in head
+        const bool stop        = stopping.load(std::memory_order_acquire);
+        const std::size_t head = ring_head.load(std::memory_order_acquire);
+        std::size_t tail       = ring_tail.load(std::memory_order_relaxed);
+
+        if (head == tail)
+        {
+            if (stop)
+            {
+                break;
+            }
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+            continue;
+        }
+
+        for (; tail != head; tail++)
+        {
+            const uint64_t entry  = ring[tail & (RING_SIZE - 1)];
+            const uint64_t address = entry >> 1;
+
+            payload_bytes += put_varint(block.data() + BLOCK_HEADER_SIZE + payload_bytes, encode_request(previous_address, address, entry & 1));
+            previous_address = address;
+
+            if (++request_count == REQUESTS_PER_BLOCK)
+            {
+                flush_block();
+            }
+        }
+        ring_tail.store(tail, std::memory_order_release);
+    }
+
+    if (request_count > 0)
+    {
+        flush_block();
+    }
+    compress(stream, nullptr, 0, LZMA_FINISH, file);
+    std::fflush(file);
+}
+
+} // namespace binary_memory_trace
@@ -34,6 +34,7 @@ OS_TRANSPARENT_MANAGEMENT::OS_TRANSPARENT_MANAGEMENT(uint64_t max_address, uint6
 OS_TRANSPARENT_MANAGEMENT::~OS_TRANSPARENT_MANAGEMENT()
 {
     output_statistics.remapping_request_queue_congestion = remapping_request_queue_congestion;
+    remapping_request_queue.report_statistics();
 
     delete &counter_table;
     delete &hotness_table;
@@ -357,21 +358,37 @@ void OS_TRANSPARENT_MANAGEMENT::physical_to_hardware_address(uint64_t& address)
 
 bool OS_TRANSPARENT_MANAGEMENT::issue_remapping_request(RemappingRequest& remapping_request)
 {
-    if (remapping_request_queue.empty() == false)
+    // The queue holds only requests that swapping engines serve when none can start
+    if (const RemappingRequest* front = remapping_request_queue.front(cycle); front != nullptr)
     {
-        remapping_request = remapping_request_queue.front();
+        remapping_request = *front;
         return true;
     }
 
     return false;
 };
 
-bool OS_TRANSPARENT_MANAGEMENT::finish_remapping_request()
+bool OS_TRANSPARENT_MANAGEMENT::issue_remapping_request(RemappingRequest& remapping_request, RemappingRequestHandle& handle, const std::function<bool(const RemappingRequest&)>& can_start)
+{
+    if (remapping_request_queue.start(cycle, handle, can_start))
+    {
+        remapping_request = remapping_request_queue.at(handle);
+        return true;
+    }
+
+    return false;
+};
+
+void OS_TRANSPARENT_MANAGEMENT::get_remapping_request(RemappingRequestHandle handle, RemappingRequest& remapping_request)
+{
+    remapping_request = remapping_request_queue.at(handle);
+};
+
+bool OS_TRANSPARENT_MANAGEMENT::finish_remapping_request(RemappingRequestHandle handle)
 {
     if (remapping_request_queue.empty() == false)
     {
-        RemappingRequest remapping_request = remapping_request_queue.front();
-        remapping_request_queue.pop_front();
+        RemappingRequest remapping_request = remapping_request_queue.finish(handle, cycle);
 
         uint64_t data_block_address        = remapping_request.address_in_fm >> DATA_MANAGEMENT_OFFSET_BITS;
         // data_block_address = remapping_request.address_in_sm >> DATA_MANAGEMENT_OFFSET_BITS;
@@ -459,33 +476,13 @@ bool OS_TRANSPARENT_MANAGEMENT::enqueue_remapping_request(RemappingRequest& rema
     uint64_t data_block_address        = remapping_request.address_in_fm >> DATA_MANAGEMENT_OFFSET_BITS;
     uint64_t line_location_table_index = data_block_address % fast_memory_capacity_at_data_block_granularity;
 
-    // Check duplicated remapping request in remapping_request_queue
+    // Check duplicated remapping request in remapping_request_queue, which is indexed by line_location_table_index
     // If duplicated remapping requests exist, we won't add this new remapping request into the remapping_request_queue.
-    bool duplicated_remapping_request  = false;
-    /** @todo O(N) scan over remapping_request_queue is acceptable at
-     *  REMAPPING_REQUEST_QUEUE_LENGTH = 64. If that macro is bumped to
-     *  1024/4096 (see the comment on its definition in include/cameo.h),
-     *  replace this loop with an std::unordered_set<uint64_t> of
-     *  line_location_table_index values kept in sync with the deque
-     *  (push_back / pop_front) for O(1) duplicate detection on the
-     *  LLC-miss path.
-     */
-    for (uint64_t i = 0; i < remapping_request_queue.size(); i++)
-    {
-        uint64_t data_block_address_to_check        = remapping_request_queue[i].address_in_fm >> DATA_MANAGEMENT_OFFSET_BITS;
-        uint64_t line_location_table_index_to_check = data_block_address_to_check % fast_memory_capacity_at_data_block_granularity;
-
-        if (line_location_table_index_to_check == line_location_table_index)
-        {
-            duplicated_remapping_request = true; // Find a duplicated remapping request
-
-            break;
-        }
-    }
+    bool duplicated_remapping_request  = remapping_request_queue.contains(line_location_table_index);
 
     if (duplicated_remapping_request == false)
     {
-        if (remapping_request_queue.size() < REMAPPING_REQUEST_QUEUE_LENGTH)
+        if (remapping_request_queue.full() == false)
         {
             if (remapping_request.address_in_fm == remapping_request.address_in_sm) // Check
             {
@@ -493,8 +490,8 @@ bool OS_TRANSPARENT_MANAGEMENT::enqueue_remapping_request(RemappingRequest& rema
                 std::abort();
             }
 
-            // Enqueue a remapping request
-            remapping_request_queue.push_back(remapping_request);
+            // Enqueue a remapping request, whose priority is the hotness of the data block moving into fast memory
+            remapping_request_queue.push(remapping_request, line_location_table_index, counter_table.at(remapping_request.address_in_sm >> DATA_MANAGEMENT_OFFSET_BITS), cycle);
         }
         else
         {
@@ -504,6 +501,7 @@ bool OS_TRANSPARENT_MANAGEMENT::enqueue_remapping_request(RemappingRequest& rema
     }
     else
     {
+        remapping_request_queue.drop_duplicate();
         return false;
     }
 
@@ -555,5 +553,13 @@ bool OS_TRANSPARENT_MANAGEMENT::finish_fm_access_in_incomplete_write_request_que
 }
 #endif /* COLOCATED_LINE_LOCATION_TABLE */
 
+void OS_TRANSPARENT_MANAGEMENT::checkpoint(champsim::checkpoint_archive& archive)
+{
+    archive.section("OS_TRANSPARENT_MANAGEMENT");
+    archive.expect(total_capacity, "total capacity");
+    archive.expect(fast_memory_capacity, "fast memory capacity");
+    archive(cycle, hotness_threshold, counter_table, hotness_table, line_location_table);
+}
+
 #endif /* IDEAL_LINE_LOCATION_TABLE, COLOCATED_LINE_LOCATION_TABLE */
 #endif /* MEMORY_USE_OS_TRANSPARENT_MANAGEMENT */
@@ -11,9 +11,7 @@ OS_TRANSPARENT_MANAGEMENT::OS_TRANSPARENT_MANAGEMENT(uint64_t max_address, uint6
   total_capacity_at_granularity(max_address >> DATA_MANAGEMENT_OFFSET_BITS),
   fast_memory_capacity_at_granularity(fast_memory_max_address >> DATA_MANAGEMENT_OFFSET_BITS),
   fast_memory_offset_bit(DATA_MANAGEMENT_OFFSET_BITS),
-  mea_counter_table(*(new std::unordered_map<REMAPPING_TABLE_ENTRY_WIDTH, MEA_COUNTER_WIDTH>())),
-  address_remapping_table(*(new std::unordered_map<REMAPPING_TABLE_ENTRY_WIDTH, REMAPPING_TABLE_ENTRY_WIDTH>())),
-  invert_address_remapping_table(*(new std::unordered_map<REMAPPING_TABLE_ENTRY_WIDTH, REMAPPING_TABLE_ENTRY_WIDTH>()))
+  mea_counter_table(*(new std::unordered_map<REMAPPING_TABLE_ENTRY_WIDTH, MEA_COUNTER_WIDTH>()))
 {
     remapping_request_queue_congestion = 0;
     intervals                          = 1;
@@ -21,30 +19,16 @@ OS_TRANSPARENT_MANAGEMENT::OS_TRANSPARENT_MANAGEMENT(uint64_t max_address, uint6
     interval_cycle                     = CPU_FREQUENCY * (double) TIME_INTERVAL_MEMPOD_us / MEMORY_CONTROLLER_CLOCK_SCALE;
     next_interval_cycle                = interval_cycle;
 
-    /* Initializing address_remapping_table and invert_address_remapping_table */
-    // TODO: I think there is faster way to construct mapping.
-
-    for (REMAPPING_TABLE_ENTRY_WIDTH itr_map = 0; itr_map < fast_memory_capacity_at_granularity; itr_map++)
-    {
-        address_remapping_table[itr_map]        = itr_map;
-        invert_address_remapping_table[itr_map] = itr_map;
-    }
-    for (REMAPPING_TABLE_ENTRY_WIDTH itr_map = fast_memory_capacity_at_granularity; itr_map < total_capacity_at_granularity; itr_map++)
-    {
-        address_remapping_table[itr_map] = itr_map;
-    }
-    assert(address_remapping_table.size() == total_capacity_at_granularity);
-    assert(invert_address_remapping_table.size() == fast_memory_capacity_at_granularity);
+    /* address_remapping_table and invert_address_remapping_table start as the identity mapping, which needs no entries */
 };
 
 // Complete
 OS_TRANSPARENT_MANAGEMENT::~OS_TRANSPARENT_MANAGEMENT()
 {
     output_statistics.remapping_request_queue_congestion = remapping_request_queue_congestion;
+    remapping_request_queue.report_statistics();
 
     delete &mea_counter_table;
-    delete &address_remapping_table;
-    delete &invert_address_remapping_table;
 };
 
 #if (TRACKING_LOAD_STORE_STATISTICS == ENABLE)
@@ -138,9 +122,9 @@ void OS_TRANSPARENT_MANAGEMENT::physical_to_hardware_address(request_type& packe
     uint64_t data_segment_address = packet.address.to<uint64_t>() >> DATA_MANAGEMENT_OFFSET_BITS;
     uint64_t data_segment_offset  = packet.address.to<uint64_t>() - (data_segment_address << DATA_MANAGEMENT_OFFSET_BITS);
 #if (DEBUG_PRINTF == ENABLE)
-    std::printf("physical_to_hardware_address(PACKET), p_segment %lu, h_segment %lu \n", data_segment_address, address_remapping_table[data_segment_address]);
+    std::printf("physical_to_hardware_address(PACKET), p_segment %lu, h_segment %lu \n", data_segment_address, address_remapping_table.lookup(data_segment_address));
 #endif
-    packet.h_address = (address_remapping_table[data_segment_address] << DATA_MANAGEMENT_OFFSET_BITS) + data_segment_offset;
+    packet.h_address = (address_remapping_table.lookup(data_segment_address) << DATA_MANAGEMENT_OFFSET_BITS) + data_segment_offset;
 };
 
 // Complete
@@ -149,17 +133,30 @@ void OS_TRANSPARENT_MANAGEMENT::physical_to_hardware_address(uint64_t& address)
     uint64_t data_segment_address = address >> DATA_MANAGEMENT_OFFSET_BITS;
     uint64_t data_segment_offset  = address - (data_segment_address << DATA_MANAGEMENT_OFFSET_BITS);
 #if (DEBUG_PRINTF == ENABLE)
-    std::printf("physical_to_hardware_address(uint64_t), p_segment %lu, h_segment %lu \n", data_segment_address, address_remapping_table[data_segment_address]);
+    std::printf("physical_to_hardware_address(uint64_t), p_segment %lu, h_segment %lu \n", data_segment_address, address_remapping_table.lookup(data_segment_address));
 #endif
-    address = (address_remapping_table[data_segment_address] << DATA_MANAGEMENT_OFFSET_BITS) + data_segment_offset;
+    address = (address_remapping_table.lookup(data_segment_address) << DATA_MANAGEMENT_OFFSET_BITS) + data_segment_offset;
 };
 
 // Complete
 bool OS_TRANSPARENT_MANAGEMENT::issue_remapping_request(RemappingRequest& remapping_request)
 {
-    if (remapping_request_queue.empty() == false)
+    // The queue holds only requests that swapping engines serve when none can start
+    if (const RemappingRequest* front = remapping_request_queue.front(cycle); front != nullptr)
+    {
+        remapping_request = *front;
+        return true;
+    }
+
+    return false;
+};
+
+// Complete
+bool OS_TRANSPARENT_MANAGEMENT::issue_remapping_request(RemappingRequest& remapping_request, RemappingRequestHandle& handle, const std::function<bool(const RemappingRequest&)>& can_start)
+{
+    if (remapping_request_queue.start(cycle, handle, can_start))
     {
-        remapping_request = remapping_request_queue.front();
+        remapping_request = remapping_request_queue.at(handle);
         return true;
     }
 
@@ -167,12 +164,17 @@ bool OS_TRANSPARENT_MANAGEMENT::issue_remapping_request(RemappingRequest& remapp
 };
 
 // Complete
-bool OS_TRANSPARENT_MANAGEMENT::finish_remapping_request()
+void OS_TRANSPARENT_MANAGEMENT::get_remapping_request(RemappingRequestHandle handle, RemappingRequest& remapping_request)
+{
+    remapping_request = remapping_request_queue.at(handle);
+};
+
+// Complete
+bool OS_TRANSPARENT_MANAGEMENT::finish_remapping_request(RemappingRequestHandle handle)
 {
     if (remapping_request_queue.empty() == false)
     {
-        RemappingRequest remapping_request = remapping_request_queue.front();
-        remapping_request_queue.pop_front();
+        RemappingRequest remapping_request = remapping_request_queue.finish(handle, cycle);
 
         /* Update address_remapping_table */
         uint64_t data_segment_p_address_fm = remapping_request.p_address_in_fm >> DATA_MANAGEMENT_OFFSET_BITS;
@@ -188,11 +190,11 @@ bool OS_TRANSPARENT_MANAGEMENT::finish_remapping_request()
             std::abort();
         }
 
-        address_remapping_table[data_segment_p_address_sm]        = data_segment_h_address_fm;
-        address_remapping_table[data_segment_p_address_fm]        = data_segment_h_address_sm;
+        address_remapping_table.remap(data_segment_p_address_sm, data_segment_h_address_fm);
+        address_remapping_table.remap(data_segment_p_address_fm, data_segment_h_address_sm);
 
         /* Update invert_address_remapping_table*/
-        invert_address_remapping_table[data_segment_h_address_fm] = data_segment_p_address_sm;
+        invert_address_remapping_table.remap(data_segment_h_address_fm, data_segment_p_address_sm);
     }
     else
     {
@@ -210,12 +212,12 @@ void OS_TRANSPARENT_MANAGEMENT::cold_data_detection()
 };
 
 // Complete
-void OS_TRANSPARENT_MANAGEMENT::check_interval_swap(uint8_t swapping_states, bool warmup)
+void OS_TRANSPARENT_MANAGEMENT::check_interval_swap(bool warmup)
 {
     if (cycle >= next_interval_cycle)
     {
         /* Cancel remapping request what is not started in last epoch */
-        cancel_not_started_remapping_request(swapping_states);
+        cancel_not_started_remapping_request();
 
         /* Get hot pages and victim pages */
         std::vector<REMAPPING_TABLE_ENTRY_WIDTH> hot_pages(mea_counter_table.size());
@@ -282,7 +284,7 @@ bool OS_TRANSPARENT_MANAGEMENT::enqueue_remapping_request(RemappingRequest& rema
             return false;
         }
     */
-    if (remapping_request_queue.size() < REMAPPING_REQUEST_QUEUE_LENGTH)
+    if (remapping_request_queue.full() == false)
     {
         if (remapping_request.h_address_in_fm == remapping_request.h_address_in_sm) // Check
         {
@@ -290,8 +292,9 @@ bool OS_TRANSPARENT_MANAGEMENT::enqueue_remapping_request(RemappingRequest& rema
             std::abort();
         }
 
-        // Enqueue a remapping request
-        remapping_request_queue.push_back(remapping_request);
+        // Enqueue a remapping request, indexed by the segment in fast memory it swaps and prioritized by the MEA counter of the hot page
+        auto mea_itr = mea_counter_table.find(remapping_request.p_address_in_sm >> DATA_MANAGEMENT_OFFSET_BITS);
+        remapping_request_queue.push(remapping_request, remapping_request.h_address_in_fm >> DATA_MANAGEMENT_OFFSET_BITS, (mea_itr != mea_counter_table.end()) ? mea_itr->second : MEA_COUNTER_WIDTH(COUNTER_DEFAULT_VALUE), cycle);
     }
     else
     {
@@ -336,7 +339,7 @@ void OS_TRANSPARENT_MANAGEMENT::determine_swap_pair(std::vector<REMAPPING_TABLE_
     for (uint32_t hot_page_itr = 0; hot_page_itr < hot_pages.size(); hot_page_itr++)
     {
         hot_page_p_address = hot_pages[hot_page_itr];
-        hot_page_h_address = address_remapping_table[hot_page_p_address];
+        hot_page_h_address = address_remapping_table.lookup(hot_page_p_address);
         PhysicalHardwareAddressTuple hot_page_ph_address;
         hot_page_ph_address.h_address = hot_page_h_address;
         hot_page_ph_address.p_address = hot_page_p_address;
@@ -367,7 +370,7 @@ void OS_TRANSPARENT_MANAGEMENT::determine_swap_pair(std::vector<REMAPPING_TABLE_
         }
 
         RemappingRequest remapping_request;
-        remapping_request.p_address_in_fm = invert_address_remapping_table[swap_fm_address_itr] << DATA_MANAGEMENT_OFFSET_BITS;
+        remapping_request.p_address_in_fm = invert_address_remapping_table.lookup(swap_fm_address_itr) << DATA_MANAGEMENT_OFFSET_BITS;
         remapping_request.p_address_in_sm = hot_page_in_sm[hot_page_in_sm_itr].p_address << DATA_MANAGEMENT_OFFSET_BITS;
         remapping_request.h_address_in_fm = swap_fm_address_itr << DATA_MANAGEMENT_OFFSET_BITS;
         remapping_request.h_address_in_sm = hot_page_in_sm[hot_page_in_sm_itr].h_address << DATA_MANAGEMENT_OFFSET_BITS;
@@ -393,31 +396,19 @@ void OS_TRANSPARENT_MANAGEMENT::determine_swap_pair(std::vector<REMAPPING_TABLE_
 };
 
 // Complete
-void OS_TRANSPARENT_MANAGEMENT::cancel_not_started_remapping_request(uint8_t swapping_states)
+void OS_TRANSPARENT_MANAGEMENT::cancel_not_started_remapping_request()
 {
-    switch (swapping_states)
-    {
-    case 0: // The swapping unit is idle
-    {
-        remapping_request_queue.clear();
-        break;
-    }
-    case 1: // The swapping unit is busy
-    {
-        RemappingRequest remapping_request_in_progress = remapping_request_queue.front();
-        remapping_request_queue.clear();
-        remapping_request_queue.push_back(remapping_request_in_progress);
-        break;
-    }
-    case 2: // The swapping unit finishes a swapping request
-    {
-        remapping_request_queue.clear();
-        break;
-    }
-    default:
-        break;
-    }
+    // The remapping request the swapping unit started stays until it finishes, even if it started in this cycle
+    remapping_request_queue.cancel_not_started(cycle);
 };
 
+void OS_TRANSPARENT_MANAGEMENT::checkpoint(champsim::checkpoint_archive& archive)
+{
+    archive.section("OS_TRANSPARENT_MANAGEMENT");
+    archive.expect(total_capacity, "total capacity");
+    archive.expect(fast_memory_capacity, "fast memory capacity");
+    archive(cycle, swap_fm_address_itr, mea_counter_table, address_remapping_table, invert_address_remapping_table, next_interval_cycle, intervals);
+}
+
 #endif /* IDEAL_SINGLE_MEMPOD */
 #endif /* MEMORY_USE_OS_TRANSPARENT_MANAGEMENT */
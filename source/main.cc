@@ -33,12 +33,30 @@ struct simulator_input_parameter
     bool simulation_given {false};
     long long warmup_instructions     = 0;
     long long simulation_instructions = std::numeric_limits<long long>::max();
+#if (FUNCTIONAL_WARMUP == ENABLE)
+    long long functional_warmup_instructions = 0; // Instructions of the functional warmup phase run before the warmup phase
+#endif /* FUNCTIONAL_WARMUP */
+#if (SAMPLED_SIMULATION == ENABLE)
+    champsim::sampling::sampling_options sampling;
+#endif /* SAMPLED_SIMULATION */
+    std::vector<champsim::phase_info> requested_phases; // Phases given by --phase, in order, which replace the warmup and simulation phases
 
     bool json_given {false};
     std::string json_file_name;
     std::vector<std::string> requested_listeners;
     std::vector<std::string> trace_names;
 
+    champsim::checkpoint_options checkpoint;
+#if (TELEMETRY == ENABLE)
+    champsim::telemetry::telemetry_options telemetry;
+#endif /* TELEMETRY */
+
+#if (RAMULATOR2 == ENABLE) && (MULTI_CONFIG_SWEEP == ENABLE)
+    std::size_t sweep_configs = 0;                    // Number of memory configurations of the sweep, 0 outside sweeps
+    int sweep_fanout_fd       = -1;                   // Shared memory of the sweep, in a worker process
+    std::size_t sweep_worker  = 0;                    // Configuration a worker process simulates
+#endif /* RAMULATOR2, MULTI_CONFIG_SWEEP */
+
     std::vector<champsim::phase_info> phases;
     std::vector<champsim::tracereader> traces;
 };
@@ -90,6 +108,11 @@ void start_run_simulation_r2(const std::string& yaml_path, const std::string& ya
 void start_run_simulation_r2(const std::string& yaml_path, simulator_input_parameter& input_parameter);
 #endif /* MEMORY_USE_HYBRID */
 
+#if (MULTI_CONFIG_SWEEP == ENABLE)
+/** Sweep dispatch: start a worker process per memory configuration and feed them all from one decoding of the traces. */
+int run_sweep_r2(int argc, char** argv, argc_type start_position_of_configs, argc_type start_position_of_traces, simulator_input_parameter& input_parameter);
+#endif /* MULTI_CONFIG_SWEEP */
+
 #else
 void run_simulation(simulator_input_parameter& input_parameter);
 
@@ -167,6 +190,128 @@ long long parse_long_long_arg(const char* flag_name, const char* arg_value, uint
 
     return value;
 }
+
+// Parse a --phase argument, <kind>:<instructions>, where kind is warmup, simulation or, with FUNCTIONAL_WARMUP, functional.
+// Failures are reported like parse_long_long_arg() does.
+champsim::phase_info parse_phase_arg(const char* arg_value, uint8_t& abort_flag)
+{
+    champsim::phase_info phase {};
+
+    const std::string_view argument {arg_value};
+    const auto separator = argument.find(':');
+    if (separator == std::string_view::npos)
+    {
+        std::cout << __func__ << ": Invalid value for --phase: '" << arg_value << "', expected <kind>:<instructions>." << std::endl;
+        abort_flag++;
+        return phase;
+    }
+
+    const std::string_view kind = argument.substr(0, separator);
+    if (kind == "warmup")
+    {
+        phase.name      = "Warmup";
+        phase.is_warmup = true;
+    }
+    else if (kind == "simulation")
+    {
+        phase.name      = "Simulation";
+        phase.is_warmup = false;
+    }
+#if (FUNCTIONAL_WARMUP == ENABLE)
+    else if (kind == "functional")
+    {
+        phase.name          = "Functional warmup";
+        phase.is_warmup     = true;
+        phase.is_functional = true;
+    }
+#endif /* FUNCTIONAL_WARMUP */
+    else
+    {
+        std::cout << __func__ << ": Unknown phase kind for --phase: '" << kind << "'." << std::endl;
+        abort_flag++;
+    }
+
+    phase.length = parse_long_long_arg("--phase", arg_value + separator + 1, abort_flag);
+    if (phase.length <= 0)
+    {
+        std::cout << __func__ << ": --phase needs a positive number of instructions: '" << arg_value << "'." << std::endl;
+        abort_flag++;
+    }
+
+    return phase;
+}
+
+#if (RAMULATOR2 == ENABLE) && (MULTI_CONFIG_SWEEP == ENABLE)
+// Join the basenames of `paths` with "_", the way the output files are named.
+std::string joined_basenames(const std::vector<char*>& paths)
+{
+    std::string joined;
+    for (const std::string path : paths)
+    {
+        joined += path.substr(path.find_last_of('/') + 1) + "_";
+    }
+    joined.pop_back();
+    return joined;
+}
+#endif /* RAMULATOR2, MULTI_CONFIG_SWEEP */
+
+// Print the simulator banner, with the instructions of each kind of phase in input_parameter.phases, or the sampling parameters when samples replace them.
+void print_banner(const simulator_input_parameter& input_parameter, std::size_t num_cpus)
+{
+    const auto phase_length = [&phases = input_parameter.phases](auto predicate)
+    {
+        return std::accumulate(std::begin(phases), std::end(phases), 0ll, [&predicate](long long length, const champsim::phase_info& p)
+            { return predicate(p) ? length + p.length : length; });
+    };
+
+    std::string banner = "\n*** ChampSim Multicore Out-of-Order Simulator ***\n";
+#if (SAMPLED_SIMULATION == ENABLE)
+    if (const auto& sampling = input_parameter.sampling; sampling.enabled())
+    {
+        // Samples replace the warmup and simulation phases, so their parameters are printed instead
+        const auto num_samples = std::count_if(std::begin(input_parameter.phases), std::end(input_parameter.phases), [](const champsim::phase_info& p)
+            { return p.is_sample; });
+
+        banner += sampling.simpoint_path.empty() ? "Sampling: SMARTS, period " + std::to_string(sampling.period) + " instructions\n" : "Sampling: SimPoint, " + sampling.simpoint_path + "\n";
+        banner += "Samples: " + std::to_string(num_samples) + "\n";
+        banner += "Sample Instructions: " + std::to_string(sampling.sample_instructions) + "\n";
+        banner += "Sample Warmup Instructions: " + std::to_string(sampling.warmup_instructions) + "\n";
+    }
+    else
+    {
+#endif /* SAMPLED_SIMULATION */
+#if (FUNCTIONAL_WARMUP == ENABLE)
+    const long long functional_warmup_instructions = phase_length([](const champsim::phase_info& p)
+        { return p.is_functional; });
+    if (functional_warmup_instructions > 0)
+    {
+        banner += "Functional Warmup Instructions: " + std::to_string(functional_warmup_instructions) + "\n";
+    }
+    const long long warmup_instructions = phase_length([](const champsim::phase_info& p)
+        { return p.is_warmup && ! p.is_functional; });
+#else
+    const long long warmup_instructions = phase_length([](const champsim::phase_info& p)
+        { return p.is_warmup; });
+#endif /* FUNCTIONAL_WARMUP */
+    const long long simulation_instructions = phase_length([](const champsim::phase_info& p)
+        { return ! p.is_warmup; });
+
+    banner += "Warmup Instructions: " + std::to_string(warmup_instructions) + "\n";
+    banner += "Simulation Instructions: " + std::to_string(simulation_instructions) + "\n";
+#if (SAMPLED_SIMULATION == ENABLE)
+    }
+#endif /* SAMPLED_SIMULATION */
+    banner += "Number of CPUs: " + std::to_string(num_cpus) + "\n";
+    banner += "Page size: " + std::to_string(PAGE_SIZE) + "\n\n";
+
+#if (USE_VCPKG == ENABLE)
+    fmt::print("{}", banner);
+#endif /* USE_VCPKG */
+
+#if (PRINT_STATISTICS_INTO_FILE == ENABLE)
+    std::fputs(banner.c_str(), output_statistics.file_handler);
+#endif /* PRINT_STATISTICS_INTO_FILE */
+}
 } // namespace
 
 int main(int argc, char** argv) // NOLINT(bugprone-exception-escape)
@@ -283,6 +428,120 @@ int main(int argc, char** argv) // NOLINT(bugprone-exception-escape)
             }
         }
 
+#if (FUNCTIONAL_WARMUP == ENABLE)
+        /** The number of instructions in the functional warmup phase, which warms up caches, TLBs, branch predictors and remapping tables without timing before the warmup phase */
+        if (strcmp(argv[i], "--functional-warmup-instructions") == 0)
+        {
+            if (i + 1 < argc)
+            {
+                input_parameter.functional_warmup_instructions = parse_long_long_arg("--functional-warmup-instructions", argv[++i], abort_flag);
+
+#if (RAMULATOR == ENABLE) || (RAMULATOR2 == ENABLE)
+                start_position_of_configs = i + 1;
+                start_position_of_traces  = start_position_of_configs + NUMBER_OF_MEMORIES;
+#else
+                start_position_of_traces = i + 1;
+#endif /* RAMULATOR || RAMULATOR2 */
+                continue;
+            }
+            else
+            {
+                std::cout << __func__ << ": Need parameter behind --functional-warmup-instructions." << std::endl;
+                abort_flag++;
+            }
+        }
+#endif /* FUNCTIONAL_WARMUP */
+
+#if (SAMPLED_SIMULATION == ENABLE)
+        /** The SimPoint file of (start instruction, weight) lines, whose samples replace the warmup and simulation phases */
+        if (strcmp(argv[i], "--simpoints") == 0)
+        {
+            if (i + 1 < argc)
+            {
+                input_parameter.sampling.simpoint_path = argv[++i];
+
+#if (RAMULATOR == ENABLE) || (RAMULATOR2 == ENABLE)
+                start_position_of_configs = i + 1;
+                start_position_of_traces  = start_position_of_configs + NUMBER_OF_MEMORIES;
+#else
+                start_position_of_traces = i + 1;
+#endif /* RAMULATOR || RAMULATOR2 */
+                continue;
+            }
+            else
+            {
+                std::cout << __func__ << ": Need parameter behind --simpoints." << std::endl;
+                abort_flag++;
+            }
+        }
+
+        /** The instructions from one periodic (SMARTS) sample to the next, whose samples replace the warmup and simulation phases */
+        if (strcmp(argv[i], "--smarts") == 0)
+        {
+            if (i + 1 < argc)
+            {
+                input_parameter.sampling.period = parse_long_long_arg("--smarts", argv[++i], abort_flag);
+
+#if (RAMULATOR == ENABLE) || (RAMULATOR2 == ENABLE)
+                start_position_of_configs = i + 1;
+                start_position_of_traces  = start_position_of_configs + NUMBER_OF_MEMORIES;
+#else
+                start_position_of_traces = i + 1;
+#endif /* RAMULATOR || RAMULATOR2 */
+                continue;
+            }
+            else
+            {
+                std::cout << __func__ << ": Need parameter behind --smarts." << std::endl;
+                abort_flag++;
+            }
+        }
+
+        /** The number of instructions measured in each sample */
+        if (strcmp(argv[i], "--sample-instructions") == 0)
+        {
+            if (i + 1 < argc)
+            {
+                input_parameter.sampling.sample_instructions = parse_long_long_arg("--sample-instructions", argv[++i], abort_flag);
+
+#if (RAMULATOR == ENABLE) || (RAMULATOR2 == ENABLE)
+                start_position_of_configs = i + 1;
+                start_position_of_traces  = start_position_of_configs + NUMBER_OF_MEMORIES;
+#else
+                start_position_of_traces = i + 1;
+#endif /* RAMULATOR || RAMULATOR2 */
+                continue;
+            }
+            else
+            {
+                std::cout << __func__ << ": Need parameter behind --sample-instructions." << std::endl;
+                abort_flag++;
+            }
+        }
+
+        /** The number of instructions warmed up in detail before each sample */
+        if (strcmp(argv[i], "--sample-warmup-instructions") == 0)
+        {
+            if (i + 1 < argc)
+            {
+                input_parameter.sampling.warmup_instructions = parse_long_long_arg("--sample-warmup-instructions", argv[++i], abort_flag);
+
+#if (RAMULATOR == ENABLE) || (RAMULATOR2 == ENABLE)
+                start_position_of_configs = i + 1;
+                start_position_of_traces  = start_position_of_configs + NUMBER_OF_MEMORIES;
+#else
+                start_position_of_traces = i + 1;
+#endif /* RAMULATOR || RAMULATOR2 */
+                continue;
+            }
+            else
+            {
+                std::cout << __func__ << ": Need parameter behind --sample-warmup-instructions." << std::endl;
+                abort_flag++;
+            }
+        }
+#endif /* SAMPLED_SIMULATION */
+
         /** The number of instructions in the detailed phase. If not specified, run to the end of the trace */
         if ((strcmp(argv[i], "--simulation-instructions") == 0) || (strcmp(argv[i], "-i") == 0))
         {
@@ -307,6 +566,28 @@ int main(int argc, char** argv) // NOLINT(bugprone-exception-escape)
             }
         }
 
+        /** A phase to run, as <kind>:<instructions>. The phases given run in order instead of the warmup and simulation phases */
+        if (strcmp(argv[i], "--phase") == 0)
+        {
+            if (i + 1 < argc)
+            {
+                input_parameter.requested_phases.push_back(parse_phase_arg(argv[++i], abort_flag));
+
+#if (RAMULATOR == ENABLE) || (RAMULATOR2 == ENABLE)
+                start_position_of_configs = i + 1;
+                start_position_of_traces  = start_position_of_configs + NUMBER_OF_MEMORIES;
+#else
+                start_position_of_traces = i + 1;
+#endif /* RAMULATOR || RAMULATOR2 */
+                continue;
+            }
+            else
+            {
+                std::cout << __func__ << ": Need parameter behind --phase." << std::endl;
+                abort_flag++;
+            }
+        }
+
         /** The name of the file to receive JSON output. If no name is specified, stdout will be used */
         if (strcmp(argv[i], "--json") == 0)
         {
@@ -330,6 +611,175 @@ int main(int argc, char** argv) // NOLINT(bugprone-exception-escape)
             }
         }
 
+        /** The file to save the warmed-up state to once warmup finishes */
+        if (strcmp(argv[i], "--checkpoint-out") == 0)
+        {
+            if (i + 1 < argc)
+            {
+                input_parameter.checkpoint.save_path = argv[++i];
+
+#if (RAMULATOR == ENABLE) || (RAMULATOR2 == ENABLE)
+                start_position_of_configs = i + 1;
+                start_position_of_traces  = start_position_of_configs + NUMBER_OF_MEMORIES;
+#else
+                start_position_of_traces = i + 1;
+#endif /* RAMULATOR || RAMULATOR2 */
+                continue;
+            }
+            else
+            {
+                std::cout << __func__ << ": Need parameter behind --checkpoint-out." << std::endl;
+                abort_flag++;
+            }
+        }
+
+        /** The file to restore the warmed-up state from, skipping warmup */
+        if (strcmp(argv[i], "--checkpoint-in") == 0)
+        {
+            if (i + 1 < argc)
+            {
+                input_parameter.checkpoint.restore_path = argv[++i];
+
+#if (RAMULATOR == ENABLE) || (RAMULATOR2 == ENABLE)
+                start_position_of_configs = i + 1;
+                start_position_of_traces  = start_position_of_configs + NUMBER_OF_MEMORIES;
+#else
+                start_position_of_traces = i + 1;
+#endif /* RAMULATOR || RAMULATOR2 */
+                continue;
+            }
+            else
+            {
+                std::cout << __func__ << ": Need parameter behind --checkpoint-in." << std::endl;
+                abort_flag++;
+            }
+        }
+
+#if (TELEMETRY == ENABLE)
+        /** The file to write a snapshot of the cores, caches and main memory into, every --telemetry-interval cycles */
+        if (strcmp(argv[i], "--telemetry") == 0)
+        {
+            if (i + 1 < argc)
+            {
+                input_parameter.telemetry.path = argv[++i];
+
+#if (RAMULATOR == ENABLE) || (RAMULATOR2 == ENABLE)
+                start_position_of_configs = i + 1;
+                start_position_of_traces  = start_position_of_configs + NUMBER_OF_MEMORIES;
+#else
+                start_position_of_traces = i + 1;
+#endif /* RAMULATOR || RAMULATOR2 */
+                continue;
+            }
+            else
+            {
+                std::cout << __func__ << ": Need parameter behind --telemetry." << std::endl;
+                abort_flag++;
+            }
+        }
+
+        /** The number of cycles from one telemetry snapshot to the next */
+        if (strcmp(argv[i], "--telemetry-interval") == 0)
+        {
+            if (i + 1 < argc)
+            {
+                const long long interval = parse_long_long_arg("--telemetry-interval", argv[++i], abort_flag);
+                if (interval <= 0)
+                {
+                    std::cout << __func__ << ": --telemetry-interval must be positive." << std::endl;
+                    abort_flag++;
+                }
+                input_parameter.telemetry.interval = static_cast<uint64_t>(std::max(interval, 1LL));
+
+#if (RAMULATOR == ENABLE) || (RAMULATOR2 == ENABLE)
+                start_position_of_configs = i + 1;
+                start_position_of_traces  = start_position_of_configs + NUMBER_OF_MEMORIES;
+#else
+                start_position_of_traces = i + 1;
+#endif /* RAMULATOR || RAMULATOR2 */
+                continue;
+            }
+            else
+            {
+                std::cout << __func__ << ": Need parameter behind --telemetry-interval." << std::endl;
+                abort_flag++;
+            }
+        }
+#endif /* TELEMETRY */
+
+#if (RAMULATOR2 == ENABLE) && (MULTI_CONFIG_SWEEP == ENABLE)
+        /** The number of memory configurations to simulate side by side, each in its own process, from one decoding of the traces */
+        if (strcmp(argv[i], "--sweep") == 0)
+        {
+            if (i + 1 < argc)
+            {
+                const long long configs = parse_long_long_arg("--sweep", argv[++i], abort_flag);
+                if (configs < 1)
+                {
+                    std::cout << __func__ << ": Need at least one configuration behind --sweep." << std::endl;
+                    abort_flag++;
+                }
+                input_parameter.sweep_configs = static_cast<std::size_t>(std::max(configs, 1LL));
+
+                start_position_of_configs     = i + 1;
+                start_position_of_traces      = start_position_of_configs + NUMBER_OF_MEMORIES;
+            }
+            else
+            {
+                std::cout << __func__ << ": Need parameter behind --sweep." << std::endl;
+                abort_flag++;
+            }
+        }
+
+        /** Internal: run as a worker of a sweep, given the shared memory of the sweep and the configuration to simulate */
+        if (strcmp(argv[i], "--sweep-worker") == 0)
+        {
+            if (i + 2 < argc)
+            {
+                input_parameter.sweep_fanout_fd = static_cast<int>(parse_long_long_arg("--sweep-worker", argv[++i], abort_flag));
+                input_parameter.sweep_worker    = static_cast<std::size_t>(parse_long_long_arg("--sweep-worker", argv[++i], abort_flag));
+
+                start_position_of_configs       = i + 1;
+                start_position_of_traces        = start_position_of_configs + NUMBER_OF_MEMORIES;
+            }
+            else
+            {
+                std::cout << __func__ << ": Need parameters behind --sweep-worker." << std::endl;
+                abort_flag++;
+            }
+        }
+#endif /* RAMULATOR2, MULTI_CONFIG_SWEEP */
+
+#if (USE_OPENMP == ENABLE) && (PARALLEL_CYCLE_ENGINE == ENABLE)
+        /** The number of threads operating the CPUs' private components every cycle, 1 operates them serially */
+        if (strcmp(argv[i], "--threads") == 0)
+        {
+            if (i + 1 < argc)
+            {
+                const long long threads = parse_long_long_arg("--threads", argv[++i], abort_flag);
+                if (threads <= 0)
+                {
+                    std::cout << __func__ << ": --threads must be positive." << std::endl;
+                    abort_flag++;
+                }
+                champsim::cycle_engine_threads = static_cast<int>(std::clamp(threads, 1LL, static_cast<long long>(std::numeric_limits<int>::max())));
+
+#if (RAMULATOR == ENABLE) || (RAMULATOR2 == ENABLE)
+                start_position_of_configs = i + 1;
+                start_position_of_traces  = start_position_of_configs + NUMBER_OF_MEMORIES;
+#else
+                start_position_of_traces = i + 1;
+#endif /* RAMULATOR || RAMULATOR2 */
+                continue;
+            }
+            else
+            {
+                std::cout << __func__ << ": Need parameter behind --threads." << std::endl;
+                abort_flag++;
+            }
+        }
+#endif /* USE_OPENMP, PARALLEL_CYCLE_ENGINE */
+
         /** A list of the listeners to be attached to the run */
         if (strcmp(argv[i], "--listeners") == 0)
         {
@@ -397,6 +847,94 @@ int main(int argc, char** argv) // NOLINT(bugprone-exception-escape)
         }
     }
 
+#if (SAMPLED_SIMULATION == ENABLE)
+    if (input_parameter.sampling.enabled())
+    {
+        const auto& sampling = input_parameter.sampling;
+        if (! sampling.simpoint_path.empty() && sampling.period > 0)
+        {
+            std::cout << __func__ << ": --simpoints cannot be combined with --smarts." << std::endl;
+            abort();
+        }
+
+        if (! input_parameter.checkpoint.save_path.empty() || ! input_parameter.checkpoint.restore_path.empty())
+        {
+            std::cout << __func__ << ": --simpoints and --smarts cannot be combined with --checkpoint-out or --checkpoint-in." << std::endl;
+            abort();
+        }
+
+        if (sampling.sample_instructions <= 0 || sampling.warmup_instructions < 0)
+        {
+            std::cout << __func__ << ": --sample-instructions must be positive and --sample-warmup-instructions must not be negative." << std::endl;
+            abort();
+        }
+
+        if (sampling.period > 0 && (sampling.period <= sampling.sample_instructions || ! input_parameter.simulation_given))
+        {
+            std::cout << __func__ << ": --smarts needs a period longer than --sample-instructions, and --simulation-instructions to sample from." << std::endl;
+            abort();
+        }
+    }
+#endif /* SAMPLED_SIMULATION */
+
+    if (const auto& requested_phases = input_parameter.requested_phases; ! requested_phases.empty())
+    {
+#if (FUNCTIONAL_WARMUP == ENABLE)
+        const bool functional_warmup_given = input_parameter.functional_warmup_instructions > 0;
+#else
+        const bool functional_warmup_given = false;
+#endif /* FUNCTIONAL_WARMUP */
+        if (input_parameter.warmup_given || input_parameter.simulation_given || functional_warmup_given)
+        {
+            std::cout << __func__ << ": --phase cannot be combined with --warmup-instructions, --simulation-instructions or --functional-warmup-instructions." << std::endl;
+            abort();
+        }
+
+#if (SAMPLED_SIMULATION == ENABLE)
+        if (input_parameter.sampling.enabled())
+        {
+            std::cout << __func__ << ": --phase cannot be combined with --simpoints or --smarts." << std::endl;
+            abort();
+        }
+#endif /* SAMPLED_SIMULATION */
+
+        // A checkpoint holds the state before the first simulation phase, and a restored run skips every warmup phase
+        const auto first_simulation = std::find_if(std::begin(requested_phases), std::end(requested_phases), [](const champsim::phase_info& p)
+            { return ! p.is_warmup; });
+        const bool warmup_after_simulation = std::any_of(first_simulation, std::end(requested_phases), [](const champsim::phase_info& p)
+            { return p.is_warmup; });
+        if (warmup_after_simulation && (! input_parameter.checkpoint.save_path.empty() || ! input_parameter.checkpoint.restore_path.empty()))
+        {
+            std::cout << __func__ << ": With --checkpoint-out or --checkpoint-in, every warmup --phase must come before the simulation phases." << std::endl;
+            abort();
+        }
+    }
+
+#if (RAMULATOR2 == ENABLE) && (MULTI_CONFIG_SWEEP == ENABLE)
+    if (input_parameter.sweep_configs > 0)
+    {
+        // The configurations of all sweep points come before the traces
+        start_position_of_traces += static_cast<argc_type>((input_parameter.sweep_configs - 1) * NUMBER_OF_MEMORIES);
+
+        if (! input_parameter.checkpoint.save_path.empty() || ! input_parameter.checkpoint.restore_path.empty())
+        {
+            std::cout << __func__ << ": --sweep cannot be combined with --checkpoint-out or --checkpoint-in." << std::endl;
+            abort();
+        }
+
+        if (input_parameter.sweep_worker >= input_parameter.sweep_configs)
+        {
+            std::cout << __func__ << ": Sweep worker " << input_parameter.sweep_worker << " is beyond the " << input_parameter.sweep_configs << " configurations." << std::endl;
+            abort();
+        }
+    }
+
+    // The producer of a sweep only decodes the traces, its workers simulate
+    const bool is_sweep_producer = (input_parameter.sweep_configs > 0) && (input_parameter.sweep_fanout_fd < 0);
+#else
+    constexpr bool is_sweep_producer = false;
+#endif /* RAMULATOR2, MULTI_CONFIG_SWEEP */
+
     /** Store the trace names */
     for (argc_type i = start_position_of_traces; i < argc; i++) // From argv[start_position_of_traces] to argv[argc - start_position_of_traces - 1]
     {
@@ -409,15 +947,29 @@ int main(int argc, char** argv) // NOLINT(bugprone-exception-escape)
         assert(false);
     }
 
+    // The output files are named after the traces
+    std::vector<char*> output_names(argv + start_position_of_traces, argv + argc);
+#if (RAMULATOR2 == ENABLE) && (MULTI_CONFIG_SWEEP == ENABLE)
+    if (input_parameter.sweep_configs > 0)
+    {
+        // and after the configuration in a sweep, whose workers would otherwise write into the same files
+        const auto worker_configs = std::next(argv, start_position_of_configs + static_cast<argc_type>(input_parameter.sweep_worker * NUMBER_OF_MEMORIES));
+        output_names.insert(std::begin(output_names), worker_configs, std::next(worker_configs, NUMBER_OF_MEMORIES));
+    }
+#endif /* RAMULATOR2, MULTI_CONFIG_SWEEP */
+
+    if (! is_sweep_producer)
+    {
 #if (PRINT_MEMORY_TRACE == ENABLE)
-    // Prepare file for recording memory traces.
-    output_memorytrace.output_file_initialization(&(argv[start_position_of_traces]), argc - start_position_of_traces);
+        // Prepare file for recording memory traces.
+        output_memorytrace.output_file_initialization(std::data(output_names), static_cast<uint32_t>(std::size(output_names)));
 #endif /* PRINT_MEMORY_TRACE */
 
 #if (PRINT_STATISTICS_INTO_FILE == ENABLE)
-    // Prepare file for recording statistics.
-    output_statistics.output_file_initialization(&(argv[start_position_of_traces]), argc - start_position_of_traces);
+        // Prepare file for recording statistics.
+        output_statistics.output_file_initialization(std::data(output_names), static_cast<uint32_t>(std::size(output_names)));
 #endif /* PRINT_STATISTICS_INTO_FILE */
+    }
 
     /** Prepare the ChampSim framework */
 
@@ -431,11 +983,76 @@ int main(int argc, char** argv) // NOLINT(bugprone-exception-escape)
         input_parameter.warmup_instructions = input_parameter.simulation_instructions / 5;
     }
 
-    std::transform(std::begin(input_parameter.trace_names), std::end(input_parameter.trace_names), std::back_inserter(input_parameter.traces), [knob_cloudsuite = input_parameter.knob_cloudsuite, repeat = input_parameter.simulation_given, i = uint8_t(0)](auto name) mutable
-        { return get_tracereader(name, i++, knob_cloudsuite, repeat); });
+#if (RAMULATOR2 == ENABLE) && (MULTI_CONFIG_SWEEP == ENABLE)
+    std::unique_ptr<champsim::trace_fanout> sweep_fanout;
+    if (input_parameter.sweep_fanout_fd >= 0)
+    {
+        // A sweep worker reads the instructions its producer decodes
+        sweep_fanout           = std::make_unique<champsim::trace_fanout>(input_parameter.sweep_fanout_fd, input_parameter.sweep_worker);
+        input_parameter.traces = sweep_fanout->readers();
+        assert(std::size(input_parameter.traces) == std::size(input_parameter.trace_names));
 
-    input_parameter.phases.push_back(champsim::phase_info {"Warmup", true, input_parameter.warmup_instructions, std::vector<std::size_t>(std::size(input_parameter.trace_names), 0), input_parameter.trace_names});          // Push back warmup phase
-    input_parameter.phases.push_back(champsim::phase_info {"Simulation", false, input_parameter.simulation_instructions, std::vector<std::size_t>(std::size(input_parameter.trace_names), 0), input_parameter.trace_names}); // Push back simulation phase
+        if (input_parameter.json_given)
+        {
+            const std::filesystem::path json_path {input_parameter.json_file_name};
+            input_parameter.json_file_name = json_path.parent_path() / (joined_basenames({std::begin(output_names), std::next(std::begin(output_names), NUMBER_OF_MEMORIES)}) + "_" + json_path.filename().string());
+        }
+
+#if (TELEMETRY == ENABLE)
+        if (input_parameter.telemetry.enabled())
+        {
+            const std::filesystem::path telemetry_path {input_parameter.telemetry.path};
+            input_parameter.telemetry.path = telemetry_path.parent_path() / (joined_basenames({std::begin(output_names), std::next(std::begin(output_names), NUMBER_OF_MEMORIES)}) + "_" + telemetry_path.filename().string());
+        }
+#endif /* TELEMETRY */
+    }
+    else
+#endif /* RAMULATOR2, MULTI_CONFIG_SWEEP */
+    {
+        std::transform(std::begin(input_parameter.trace_names), std::end(input_parameter.trace_names), std::back_inserter(input_parameter.traces), [knob_cloudsuite = input_parameter.knob_cloudsuite, repeat = input_parameter.simulation_given, i = uint8_t(0)](auto name) mutable
+            { return get_tracereader(name, i++, knob_cloudsuite, repeat); });
+    }
+
+#if (SAMPLED_SIMULATION == ENABLE)
+    if (input_parameter.sampling.enabled())
+    {
+        // Samples replace the warmup and simulation phases
+        input_parameter.phases = champsim::sampling::sampled_phases(input_parameter.sampling, input_parameter.simulation_instructions, input_parameter.trace_names);
+    }
+    else
+    {
+#endif /* SAMPLED_SIMULATION */
+    if (const auto& requested_phases = input_parameter.requested_phases; ! requested_phases.empty())
+    {
+        for (auto requested = std::begin(requested_phases); requested != std::end(requested_phases); ++requested)
+        {
+            champsim::phase_info& phase = input_parameter.phases.emplace_back(*requested);
+            phase.trace_index           = std::vector<std::size_t>(std::size(input_parameter.trace_names), 0);
+            phase.trace_names           = input_parameter.trace_names;
+
+            // A kind given again is numbered, e.g., "Warmup", then "Warmup 2"
+            const auto repeats = std::count_if(std::begin(requested_phases), requested, [&requested](const champsim::phase_info& p)
+                { return p.name == requested->name; });
+            if (repeats > 0)
+            {
+                phase.name += " " + std::to_string(repeats + 1);
+            }
+        }
+    }
+    else
+    {
+#if (FUNCTIONAL_WARMUP == ENABLE)
+        if (input_parameter.functional_warmup_instructions > 0)
+        {
+            input_parameter.phases.push_back(champsim::phase_info {"Functional warmup", true, input_parameter.functional_warmup_instructions, std::vector<std::size_t>(std::size(input_parameter.trace_names), 0), input_parameter.trace_names, true}); // Push back functional warmup phase
+        }
+#endif /* FUNCTIONAL_WARMUP */
+        input_parameter.phases.push_back(champsim::phase_info {"Warmup", true, input_parameter.warmup_instructions, std::vector<std::size_t>(std::size(input_parameter.trace_names), 0), input_parameter.trace_names});          // Push back warmup phase
+        input_parameter.phases.push_back(champsim::phase_info {"Simulation", false, input_parameter.simulation_instructions, std::vector<std::size_t>(std::size(input_parameter.trace_names), 0), input_parameter.trace_names}); // Push back simulation phase
+    }
+#if (SAMPLED_SIMULATION == ENABLE)
+    }
+#endif /* SAMPLED_SIMULATION */
 
     for (auto& p : input_parameter.phases)
     {
@@ -531,6 +1148,15 @@ int main(int argc, char** argv) // NOLINT(bugprone-exception-escape)
 
     std::printf("Simulation done. Statistics written to %s\n", stats_out.c_str());
 #elif (RAMULATOR2 == ENABLE)
+#if (MULTI_CONFIG_SWEEP == ENABLE)
+    if (is_sweep_producer)
+    {
+        return run_sweep_r2(argc, argv, start_position_of_configs, start_position_of_traces, input_parameter);
+    }
+
+    // A sweep worker simulates its own configuration
+    start_position_of_configs += static_cast<argc_type>(input_parameter.sweep_worker * NUMBER_OF_MEMORIES);
+#endif /* MULTI_CONFIG_SWEEP */
     {
 #if (MEMORY_USE_HYBRID == ENABLE)
         const std::string yaml_path  = argv[start_position_of_configs];     // Fast memory
@@ -543,6 +1169,13 @@ int main(int argc, char** argv) // NOLINT(bugprone-exception-escape)
         std::printf("Simulation done. YAML config: %s\n", yaml_path.c_str());
 #endif /* MEMORY_USE_HYBRID */
     }
+
+#if (MULTI_CONFIG_SWEEP == ENABLE)
+    if (sweep_fanout != nullptr)
+    {
+        sweep_fanout->finish(); // Let the producer stop decoding for this worker
+    }
+#endif /* MULTI_CONFIG_SWEEP */
 #else
     run_simulation(input_parameter);
     std::printf("Simulation done.\n");
@@ -862,14 +1495,7 @@ void run_simulation(const ramulator::Config& configs, ramulator::Memory<T, ramul
         }
     }
 
-#if (USE_VCPKG == ENABLE)
-    fmt::print("\n*** ChampSim Multicore Out-of-Order Simulator ***\nWarmup Instructions: {}\nSimulation Instructions: {}\nNumber of CPUs: {}\nPage size: {}\n\n", input_parameter.phases.at(0).length, input_parameter.phases.at(1).length, std::size(gen_environment.cpu_view()), PAGE_SIZE);
-#endif /* USE_VCPKG */
-
-#if (PRINT_STATISTICS_INTO_FILE == ENABLE)
-    std::fprintf(output_statistics.file_handler, "\n*** ChampSim Multicore Out-of-Order Simulator ***\nWarmup Instructions: %lld\nSimulation Instructions: %lld\nNumber of CPUs: %ld\nPage size: %d\n\n",
-        input_parameter.phases.at(0).length, input_parameter.phases.at(1).length, std::size(gen_environment.cpu_view()), PAGE_SIZE);
-#endif /* PRINT_STATISTICS_INTO_FILE */
+    print_banner(input_parameter, std::size(gen_environment.cpu_view()));
 
 #if (MEMORY_USE_SWAPPING_UNIT == ENABLE) && (TEST_SWAPPING_UNIT == ENABLE)
     fmt::print("\n*** TEST_SWAPPING_UNIT enabled — bypassing real simulation ***\n\n");
@@ -877,7 +1503,11 @@ void run_simulation(const ramulator::Config& configs, ramulator::Memory<T, ramul
     return;
 #endif /* MEMORY_USE_SWAPPING_UNIT && TEST_SWAPPING_UNIT */
 
-    auto phase_stats = champsim::main(gen_environment, input_parameter.phases, input_parameter.traces);
+#if (TELEMETRY == ENABLE)
+    auto phase_stats = champsim::main(gen_environment, input_parameter.phases, input_parameter.traces, input_parameter.checkpoint, input_parameter.telemetry);
+#else
+    auto phase_stats = champsim::main(gen_environment, input_parameter.phases, input_parameter.traces, input_parameter.checkpoint);
+#endif /* TELEMETRY */
 
 #if (USE_VCPKG == ENABLE)
     fmt::print("\nChampSim completed all CPUs\n\n");
@@ -1042,16 +1672,13 @@ void run_simulation(const ramulator::Config& configs, ramulator::Memory<T, ramul
         }
     }
 
-#if (USE_VCPKG == ENABLE)
-    fmt::print("\n*** ChampSim Multicore Out-of-Order Simulator ***\nWarmup Instructions: {}\nSimulation Instructions: {}\nNumber of CPUs: {}\nPage size: {}\n\n", input_parameter.phases.at(0).length, input_parameter.phases.at(1).length, std::size(gen_environment.cpu_view()), PAGE_SIZE);
-#endif /* USE_VCPKG */
-
-#if (PRINT_STATISTICS_INTO_FILE == ENABLE)
-    std::fprintf(output_statistics.file_handler, "\n*** ChampSim Multicore Out-of-Order Simulator ***\nWarmup Instructions: %lld\nSimulation Instructions: %lld\nNumber of CPUs: %ld\nPage size: %d\n\n",
-        input_parameter.phases.at(0).length, input_parameter.phases.at(1).length, std::size(gen_environment.cpu_view()), PAGE_SIZE);
-#endif /* PRINT_STATISTICS_INTO_FILE */
+    print_banner(input_parameter, std::size(gen_environment.cpu_view()));
 
-    auto phase_stats = champsim::main(gen_environment, input_parameter.phases, input_parameter.traces);
+#if (TELEMETRY == ENABLE)
+    auto phase_stats = champsim::main(gen_environment, input_parameter.phases, input_parameter.traces, input_parameter.checkpoint, input_parameter.telemetry);
+#else
+    auto phase_stats = champsim::main(gen_environment, input_parameter.phases, input_parameter.traces, input_parameter.checkpoint);
+#endif /* TELEMETRY */
 
 #if (USE_VCPKG == ENABLE)
     fmt::print("\nChampSim completed all CPUs\n\n");
@@ -1109,16 +1736,13 @@ void start_run_simulation_r2(const std::string& yaml_path, simulator_input_param
         }
     }
 
-#if (USE_VCPKG == ENABLE)
-    fmt::print("\n*** ChampSim Multicore Out-of-Order Simulator ***\nWarmup Instructions: {}\nSimulation Instructions: {}\nNumber of CPUs: {}\nPage size: {}\n\n", input_parameter.phases.at(0).length, input_parameter.phases.at(1).length, std::size(gen_environment.cpu_view()), PAGE_SIZE);
-#endif /* USE_VCPKG */
-
-#if (PRINT_STATISTICS_INTO_FILE == ENABLE)
-    std::fprintf(output_statistics.file_handler, "\n*** ChampSim Multicore Out-of-Order Simulator ***\nWarmup Instructions: %lld\nSimulation Instructions: %lld\nNumber of CPUs: %ld\nPage size: %d\n\n",
-        input_parameter.phases.at(0).length, input_parameter.phases.at(1).length, std::size(gen_environment.cpu_view()), PAGE_SIZE);
-#endif /* PRINT_STATISTICS_INTO_FILE */
+    print_banner(input_parameter, std::size(gen_environment.cpu_view()));
 
-    auto phase_stats = champsim::main(gen_environment, input_parameter.phases, input_parameter.traces);
+#if (TELEMETRY == ENABLE)
+    auto phase_stats = champsim::main(gen_environment, input_parameter.phases, input_parameter.traces, input_parameter.checkpoint, input_parameter.telemetry);
+#else
+    auto phase_stats = champsim::main(gen_environment, input_parameter.phases, input_parameter.traces, input_parameter.checkpoint);
+#endif /* TELEMETRY */
 
 #if (USE_VCPKG == ENABLE)
     fmt::print("\nChampSim completed all CPUs\n\n");
@@ -1147,6 +1771,74 @@ void start_run_simulation_r2(const std::string& yaml_path, simulator_input_param
     }
 }
 
+#if (MULTI_CONFIG_SWEEP == ENABLE)
+int run_sweep_r2(int argc, char** argv, argc_type start_position_of_configs, argc_type start_position_of_traces, simulator_input_parameter& input_parameter)
+{
+    champsim::trace_fanout fanout {std::size(input_parameter.traces), input_parameter.sweep_configs};
+    const std::string fanout_fd = std::to_string(fanout.file_descriptor());
+
+    /* Each worker runs this simulator again with the same parameters, told which configuration is its own.
+     * Separate processes keep the global state of the simulator (output files, statistics, loggers) apart. */
+    std::vector<pid_t> workers;
+    for (std::size_t worker = 0; worker < input_parameter.sweep_configs; ++worker)
+    {
+        std::string worker_index = std::to_string(worker);
+        std::vector<char*> worker_argv {argv[0], const_cast<char*>("--sweep-worker"), const_cast<char*>(fanout_fd.c_str()), worker_index.data()};
+        worker_argv.insert(std::end(worker_argv), std::next(argv), std::next(argv, argc));
+        worker_argv.push_back(nullptr);
+
+        // The standard output of the worker goes into a log named like its other output files
+        const auto worker_configs = std::next(argv, start_position_of_configs + static_cast<argc_type>(worker * NUMBER_OF_MEMORIES));
+        std::vector<char*> output_names(worker_configs, std::next(worker_configs, NUMBER_OF_MEMORIES));
+        output_names.insert(std::end(output_names), std::next(argv, start_position_of_traces), std::next(argv, argc));
+        const std::string log_name = joined_basenames(output_names) + ".log";
+
+        posix_spawn_file_actions_t actions;
+        posix_spawn_file_actions_init(&actions);
+        posix_spawn_file_actions_addopen(&actions, STDOUT_FILENO, log_name.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+
+        pid_t pid;
+        const int error = posix_spawn(&pid, "/proc/self/exe", &actions, nullptr, std::data(worker_argv), environ);
+        posix_spawn_file_actions_destroy(&actions);
+        if (error != 0)
+        {
+            std::cerr << __func__ << ": cannot start sweep worker " << worker << ": " << std::strerror(error) << std::endl;
+            std::abort();
+        }
+
+        std::printf("Sweep worker %zu (pid %d) simulates %s, output in %s\n", worker, pid, joined_basenames({worker_configs, std::next(worker_configs, NUMBER_OF_MEMORIES)}).c_str(), log_name.c_str());
+        workers.push_back(pid);
+    }
+    std::fflush(stdout);
+
+    // Stop waiting for a worker once it exits, even if it failed before reading all its instructions
+    std::size_t failures = 0;
+    const auto reap      = [&](int options)
+    {
+        for (std::size_t worker = 0; worker < std::size(workers); ++worker)
+        {
+            int status;
+            if (workers[worker] > 0 && waitpid(workers[worker], &status, options) == workers[worker])
+            {
+                const bool success = WIFEXITED(status) && (WEXITSTATUS(status) == EXIT_SUCCESS);
+                std::printf("Sweep worker %zu %s\n", worker, success ? "done" : "failed");
+                failures += success ? 0 : 1;
+
+                fanout.finish(worker);
+                workers[worker] = 0;
+            }
+        }
+    };
+
+    fanout.broadcast(input_parameter.traces, [&reap]
+        { reap(WNOHANG); });
+    reap(0);
+
+    std::printf("Sweep done. %zu of %zu configurations succeeded\n", input_parameter.sweep_configs - failures, input_parameter.sweep_configs);
+    return (failures == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+#endif /* MULTI_CONFIG_SWEEP */
+
 #else
 void run_simulation(simulator_input_parameter& input_parameter)
 {
@@ -1161,16 +1853,13 @@ void run_simulation(simulator_input_parameter& input_parameter)
         }
     }
 
-#if (USE_VCPKG == ENABLE)
-    fmt::print("\n*** ChampSim Multicore Out-of-Order Simulator ***\nWarmup Instructions: {}\nSimulation Instructions: {}\nNumber of CPUs: {}\nPage size: {}\n\n", input_parameter.phases.at(0).length, input_parameter.phases.at(1).length, std::size(gen_environment.cpu_view()), PAGE_SIZE);
-#endif /* USE_VCPKG */
-
-#if (PRINT_STATISTICS_INTO_FILE == ENABLE)
-    std::fprintf(output_statistics.file_handler, "\n*** ChampSim Multicore Out-of-Order Simulator ***\nWarmup Instructions: %lld\nSimulation Instructions: %lld\nNumber of CPUs: %ld\nPage size: %d\n\n",
-        input_parameter.phases.at(0).length, input_parameter.phases.at(1).length, std::size(gen_environment.cpu_view()), PAGE_SIZE);
-#endif /* PRINT_STATISTICS_INTO_FILE */
+    print_banner(input_parameter, std::size(gen_environment.cpu_view()));
 
-    auto phase_stats = champsim::main(gen_environment, input_parameter.phases, input_parameter.traces);
+#if (TELEMETRY == ENABLE)
+    auto phase_stats = champsim::main(gen_environment, input_parameter.phases, input_parameter.traces, input_parameter.checkpoint, input_parameter.telemetry);
+#else
+    auto phase_stats = champsim::main(gen_environment, input_parameter.phases, input_parameter.traces, input_parameter.checkpoint);
+#endif /* TELEMETRY */
 
 #if (USE_VCPKG == ENABLE)
     fmt::print("\nChampSim completed all CPUs\n\n");
@@ -0,0 +1,249 @@
+#include "shadow_management.h"
+
+#if (SHADOW_OS_TRANSPARENT_MANAGEMENT == ENABLE)
+
+#include <algorithm>
+#include <cstdio>
+#include <iterator>
+#include <unordered_map>
+#include <utility>
+
+#include "ChampSim/util/bits.h"
+
+namespace
+{
+/** @brief Never migrates, which is the static (no-migration) baseline. */
+class StaticPolicy : public SHADOW_MANAGEMENT::Policy
+{
+public:
+    using Policy::Policy;
+
+    std::size_t footprint() const final { return 0; };
+
+private:
+    void track(uint64_t, uint64_t) final {};
+};
+
+/**
+ * @brief Swaps a segment in slow memory with the segment in fast memory of its congruence group on every access, like the line location table of CAMEO.
+ * @note The congruence group of a segment is its number modulo the fast memory capacity, and swaps stay in the group.
+ */
+class LineLocationPolicy : public SHADOW_MANAGEMENT::Policy
+{
+public:
+    using Policy::Policy;
+
+private:
+    void track(uint64_t p_segment, uint64_t h_segment) final
+    {
+        if (h_segment >= fast_memory_capacity_at_granularity)
+        {
+            swap(p_segment, invert_address_remapping_table.lookup(h_segment % fast_memory_capacity_at_granularity));
+        }
+    };
+};
+
+/**
+ * @brief Counts the hottest segments with a Majority Element Algorithm (MEA) counter table and moves the hot segments in slow memory into fast memory every epoch, like MemPod.
+ * @note The victims in fast memory are picked round-robin, skipping the hot segments.
+ */
+class MempodPolicy : public SHADOW_MANAGEMENT::Policy
+{
+public:
+    static constexpr std::size_t NUMBER_MEA_COUNTER = 16;
+    static constexpr uint8_t MEA_COUNTER_MAX_VALUE  = 4;
+
+    using Policy::Policy;
+
+    void end_epoch() final
+    {
+        std::vector<uint64_t> hot_page_in_fm;
+        std::vector<std::pair<uint64_t, uint64_t>> hot_page_in_sm; // (hardware segment, physical segment)
+        for (const auto& [p_segment, count] : mea_counter_table)
+        {
+            const uint64_t h_segment = address_remapping_table.lookup(p_segment);
+            if (h_segment < fast_memory_capacity_at_granularity)
+            {
+                hot_page_in_fm.push_back(h_segment);
+            }
+            else
+            {
+                hot_page_in_sm.emplace_back(h_segment, p_segment);
+            }
+        }
+        std::sort(hot_page_in_sm.begin(), hot_page_in_sm.end());
+
+        for (const auto& [h_segment, p_segment] : hot_page_in_sm)
+        {
+            while (std::find(hot_page_in_fm.begin(), hot_page_in_fm.end(), swap_fm_segment_itr) != hot_page_in_fm.end())
+            {
+                swap_fm_segment_itr = (swap_fm_segment_itr + 1) % fast_memory_capacity_at_granularity;
+            }
+
+            swap(p_segment, invert_address_remapping_table.lookup(swap_fm_segment_itr));
+            swap_fm_segment_itr = (swap_fm_segment_itr + 1) % fast_memory_capacity_at_granularity;
+        }
+
+        mea_counter_table.clear();
+    };
+
+    std::size_t footprint() const final { return Policy::footprint() + NUMBER_MEA_COUNTER * (sizeof(uint64_t) + sizeof(uint8_t)); };
+
+private:
+    std::unordered_map<uint64_t, uint8_t> mea_counter_table;
+    uint64_t swap_fm_segment_itr = 0;
+
+    void track(uint64_t p_segment, uint64_t) final
+    {
+        if (auto counter = mea_counter_table.find(p_segment); counter != mea_counter_table.end())
+        {
+            counter->second = std::min<uint8_t>(counter->second + 1, MEA_COUNTER_MAX_VALUE + 1);
+        }
+        else if (mea_counter_table.size() >= NUMBER_MEA_COUNTER) // MEA counter table is full
+        {
+            for (auto counter = mea_counter_table.begin(); counter != mea_counter_table.end();)
+            {
+                counter = (--counter->second == 0) ? mea_counter_table.erase(counter) : std::next(counter);
+            }
+        }
+        else
+        {
+            mea_counter_table.emplace(p_segment, 1);
+        }
+    };
+};
+} // namespace
+
+SHADOW_MANAGEMENT::Policy::Policy(std::string name_, uint8_t offset_bits_, uint64_t max_address, uint64_t fast_memory_max_address)
+: name(std::move(name_)), offset_bits(offset_bits_),
+  total_capacity_at_granularity(max_address >> offset_bits_),
+  fast_memory_capacity_at_granularity(fast_memory_max_address >> offset_bits_),
+  address_remapping_table(0), invert_address_remapping_table(0) {};
+
+void SHADOW_MANAGEMENT::Policy::access(uint64_t address)
+{
+    const uint64_t p_segment = address >> offset_bits;
+    if (p_segment >= total_capacity_at_granularity)
+    {
+        return; // Not a memory address
+    }
+
+    const uint64_t h_segment = address_remapping_table.lookup(p_segment);
+    epoch.accesses++;
+    if (h_segment < fast_memory_capacity_at_granularity)
+    {
+        epoch.fast_memory_hits++;
+    }
+
+    track(p_segment, h_segment);
+}
+
+std::size_t SHADOW_MANAGEMENT::Policy::footprint() const
+{
+    return address_remapping_table.footprint() + invert_address_remapping_table.footprint();
+}
+
+void SHADOW_MANAGEMENT::Policy::swap(uint64_t p_segment, uint64_t p_segment2)
+{
+    const uint64_t h_segment  = address_remapping_table.lookup(p_segment);
+    const uint64_t h_segment2 = address_remapping_table.lookup(p_segment2);
+
+    address_remapping_table.remap(p_segment, h_segment2);
+    address_remapping_table.remap(p_segment2, h_segment);
+    invert_address_remapping_table.remap(h_segment2, p_segment);
+    invert_address_remapping_table.remap(h_segment, p_segment2);
+
+    // Both segments are read from and written to memory
+    epoch.migrations++;
+    epoch.migration_traffic_in_bytes += 2 * (uint64_t {1} << offset_bits);
+}
+
+SHADOW_MANAGEMENT::SHADOW_MANAGEMENT(uint64_t max_address, uint64_t fast_memory_max_address)
+: epoch_length(std::chrono::duration_cast<champsim::chrono::clock::duration>(champsim::chrono::microseconds {SHADOW_EPOCH_us}))
+{
+    // The granularities follow the defaults of cameo.h, variable_granularity.h (its coarsest granularity) and ideal_single_mempod.h
+    policies.push_back(std::make_unique<StaticPolicy>("static", champsim::lg2(64), max_address, fast_memory_max_address));
+    policies.push_back(std::make_unique<LineLocationPolicy>("line_location_64B", champsim::lg2(64), max_address, fast_memory_max_address));
+    policies.push_back(std::make_unique<LineLocationPolicy>("line_location_4KiB", champsim::lg2(4096), max_address, fast_memory_max_address));
+    policies.push_back(std::make_unique<MempodPolicy>("mempod_2KiB", champsim::lg2(2048), max_address, fast_memory_max_address));
+}
+
+SHADOW_MANAGEMENT::~SHADOW_MANAGEMENT()
+{
+    if (started)
+    {
+        end_epoch(warmup_of_epoch); // The last epoch ends with the simulation
+    }
+
+    for (const auto& policy : policies)
+    {
+        const Statistics& total = policy->total;
+        const double hit_rate   = total.accesses == 0 ? 0 : total.fast_memory_hits / double(total.accesses);
+
+        std::printf("Shadow policy: %s, epochs: %u, accesses: %ld, fast_memory_hit_rate: %f, migrations: %ld, migration_traffic_in_bytes: %ld, remapping_table_entries: %zu, remapping_table_footprint_in_bytes: %zu.\n",
+            policy->name.c_str(), epochs, total.accesses, hit_rate, total.migrations, total.migration_traffic_in_bytes, policy->remapped_segments(), policy->footprint());
+
+#if (PRINT_STATISTICS_INTO_FILE == ENABLE)
+        if (output_statistics.file_handler)
+        {
+            std::fprintf(output_statistics.file_handler, "Shadow policy: %s, epochs: %u, accesses: %ld, fast_memory_hit_rate: %f, migrations: %ld, migration_traffic_in_bytes: %ld, remapping_table_entries: %zu, remapping_table_footprint_in_bytes: %zu.\n",
+                policy->name.c_str(), epochs, total.accesses, hit_rate, total.migrations, total.migration_traffic_in_bytes, policy->remapped_segments(), policy->footprint());
+        }
+#endif /* PRINT_STATISTICS_INTO_FILE */
+    }
+}
+
+void SHADOW_MANAGEMENT::memory_activity_tracking(uint64_t address, champsim::chrono::clock::time_point time, bool warmup)
+{
+    if (! started)
+    {
+        next_epoch = time + epoch_length;
+        started    = true;
+    }
+    warmup_of_epoch = warmup;
+
+    // Epochs without requests still end, since MemPod migrates at every epoch
+    while (time >= next_epoch)
+    {
+        end_epoch(warmup);
+        next_epoch += epoch_length;
+    }
+
+    for (auto& policy : policies)
+    {
+        policy->access(address);
+    }
+}
+
+void SHADOW_MANAGEMENT::end_epoch(bool warmup)
+{
+    for (auto& policy : policies)
+    {
+        policy->end_epoch();
+
+        if (warmup == false)
+        {
+            Statistics& epoch = policy->epoch;
+#if (PRINT_STATISTICS_INTO_FILE == ENABLE)
+            if (output_statistics.file_handler && epoch.accesses != 0)
+            {
+                std::fprintf(output_statistics.file_handler, "[SHADOW_EPOCH] epoch: %u policy: %s accesses: %ld fast_memory_hit_rate: %f migrations: %ld migration_traffic_in_bytes: %ld remapping_table_footprint_in_bytes: %zu\n",
+                    epochs, policy->name.c_str(), epoch.accesses, epoch.fast_memory_hits / double(epoch.accesses), epoch.migrations, epoch.migration_traffic_in_bytes, policy->footprint());
+            }
+#endif /* PRINT_STATISTICS_INTO_FILE */
+
+            policy->total.accesses += epoch.accesses;
+            policy->total.fast_memory_hits += epoch.fast_memory_hits;
+            policy->total.migrations += epoch.migrations;
+            policy->total.migration_traffic_in_bytes += epoch.migration_traffic_in_bytes;
+        }
+        policy->epoch = Statistics {};
+    }
+
+    if (warmup == false)
+    {
+        epochs++;
+    }
+}
+
+#endif /* SHADOW_OS_TRANSPARENT_MANAGEMENT */
@@ -24,6 +24,7 @@ OS_TRANSPARENT_MANAGEMENT::OS_TRANSPARENT_MANAGEMENT(uint64_t max_address, uint6
 OS_TRANSPARENT_MANAGEMENT::~OS_TRANSPARENT_MANAGEMENT()
 {
     output_statistics.remapping_request_queue_congestion = remapping_request_queue_congestion;
+    remapping_request_queue.report_statistics();
 
 #if (STATISTICS_INFORMATION == ENABLE)
     uint64_t estimated_spatial_locality_counts[MIGRATION_GRANULARITY_WIDTH(MigrationGranularity::Max)] = {0};
@@ -778,21 +779,37 @@ void OS_TRANSPARENT_MANAGEMENT::physical_to_hardware_address(uint64_t& address)
 
 bool OS_TRANSPARENT_MANAGEMENT::issue_remapping_request(RemappingRequest& remapping_request)
 {
-    if (remapping_request_queue.empty() == false)
+    // The queue holds only requests that swapping engines serve when none can start
+    if (const RemappingRequest* front = remapping_request_queue.front(cycle); front != nullptr)
+    {
+        remapping_request = *front;
+        return true;
+    }
+
+    return false;
+};
+
+bool OS_TRANSPARENT_MANAGEMENT::issue_remapping_request(RemappingRequest& remapping_request, RemappingRequestHandle& handle, const std::function<bool(const RemappingRequest&)>& can_start)
+{
+    if (remapping_request_queue.start(cycle, handle, can_start))
     {
-        remapping_request = remapping_request_queue.front();
+        remapping_request = remapping_request_queue.at(handle);
         return true;
     }
 
     return false;
 };
 
-bool OS_TRANSPARENT_MANAGEMENT::finish_remapping_request()
+void OS_TRANSPARENT_MANAGEMENT::get_remapping_request(RemappingRequestHandle handle, RemappingRequest& remapping_request)
+{
+    remapping_request = remapping_request_queue.at(handle);
+};
+
+bool OS_TRANSPARENT_MANAGEMENT::finish_remapping_request(RemappingRequestHandle handle)
 {
     if (remapping_request_queue.empty() == false)
     {
-        RemappingRequest remapping_request = remapping_request_queue.front();
-        remapping_request_queue.pop_front();
+        RemappingRequest remapping_request = remapping_request_queue.finish(handle, cycle);
 
         uint64_t data_block_address    = remapping_request.address_in_fm >> DATA_MANAGEMENT_OFFSET_BITS;
         //data_block_address = remapping_request.address_in_sm >> DATA_MANAGEMENT_OFFSET_BITS;
@@ -1264,61 +1281,61 @@ bool OS_TRANSPARENT_MANAGEMENT::enqueue_remapping_request(RemappingRequest& rema
     uint64_t data_block_address       = remapping_request.address_in_fm >> DATA_MANAGEMENT_OFFSET_BITS;
     uint64_t placement_table_index    = data_block_address % fast_memory_capacity_at_data_block_granularity;
 
-    // Check duplicated remapping request in remapping_request_queue
+    // Check duplicated remapping request in remapping_request_queue, whose requests of this set are visited in arrival order
     // If duplicated remapping requests exist, we won't add this new remapping request into the remapping_request_queue.
     bool duplicated_remapping_request = false;
-    for (uint64_t i = 0; i < remapping_request_queue.size(); i++)
-    {
-        uint64_t data_block_address_to_check    = remapping_request_queue[i].address_in_fm >> DATA_MANAGEMENT_OFFSET_BITS;
-        uint64_t placement_table_index_to_check = data_block_address_to_check % fast_memory_capacity_at_data_block_granularity;
-
-        if (placement_table_index_to_check == placement_table_index)
+    bool updated_remapping_request    = false;
+    remapping_request_queue.for_each(placement_table_index, [&](RemappingRequest& queued_remapping_request)
         {
             duplicated_remapping_request = true; // Find a duplicated remapping request
 
             // Check whether the remapping_request moves block 0's data into fast memory
-            if ((remapping_request.fm_location == REMAPPING_LOCATION_WIDTH(RemappingLocation::Zero)) && (remapping_request_queue[i].fm_location == REMAPPING_LOCATION_WIDTH(RemappingLocation::Zero)))
+            if ((remapping_request.fm_location == REMAPPING_LOCATION_WIDTH(RemappingLocation::Zero)) && (queued_remapping_request.fm_location == REMAPPING_LOCATION_WIDTH(RemappingLocation::Zero)))
             {
                 // For the request that moves block 0's data into slow memory, only one remapping request for the same set can exist in remapping_request_queue to maintain data consistency
-                if ((remapping_request_queue[i].address_in_fm == remapping_request.address_in_fm) && ((remapping_request_queue[i].address_in_sm == remapping_request.address_in_sm)))
+                if ((queued_remapping_request.address_in_fm == remapping_request.address_in_fm) && ((queued_remapping_request.address_in_sm == remapping_request.address_in_sm)))
                 {
-                    if (remapping_request.size > remapping_request_queue[i].size)
+                    if (remapping_request.size > queued_remapping_request.size)
                     {
-                        remapping_request_queue[i].size = remapping_request.size; // Update size for data swapping
+                        queued_remapping_request.size = remapping_request.size; // Update size for data swapping
                     }
 
-                    // New remapping request won't be issued, but the duplicated one is updated.
-                    return true;
+                    updated_remapping_request = true;
                 }
             }
-            else if ((remapping_request.sm_location == REMAPPING_LOCATION_WIDTH(RemappingLocation::Zero)) && (remapping_request_queue[i].sm_location == REMAPPING_LOCATION_WIDTH(RemappingLocation::Zero)))
+            else if ((remapping_request.sm_location == REMAPPING_LOCATION_WIDTH(RemappingLocation::Zero)) && (queued_remapping_request.sm_location == REMAPPING_LOCATION_WIDTH(RemappingLocation::Zero)))
             {
                 // For the request that moves block 0's data into fast memory, multiple remapping requests for the same set can exist as long as the data movement in fast memory are different
-                if ((remapping_request_queue[i].address_in_fm == remapping_request.address_in_fm) && (remapping_request_queue[i].address_in_sm == remapping_request.address_in_sm))
+                if ((queued_remapping_request.address_in_fm == remapping_request.address_in_fm) && (queued_remapping_request.address_in_sm == remapping_request.address_in_sm))
                 {
-                    if (remapping_request.size > remapping_request_queue[i].size)
+                    if (remapping_request.size > queued_remapping_request.size)
                     {
-                        remapping_request_queue[i].size = remapping_request.size; // Update size for data swapping
+                        queued_remapping_request.size = remapping_request.size; // Update size for data swapping
                     }
 
-                    // New remapping request won't be issued, but the duplicated one is updated.
-                    return true;
+                    updated_remapping_request = true;
                 }
-                else if (remapping_request_queue[i].address_in_fm != remapping_request.address_in_fm)
+                else if (queued_remapping_request.address_in_fm != remapping_request.address_in_fm)
                 {
                     duplicated_remapping_request = false;
-                    continue;
+                    return true; // Check the next remapping request of this set
                 }
             }
 
-            break;
-        }
+            return false;
+        });
+
+    if (updated_remapping_request)
+    {
+        // New remapping request won't be issued, but the duplicated one is updated.
+        remapping_request_queue.drop_duplicate();
+        return true;
     }
 
     // Add new remapping request to queue
     if (duplicated_remapping_request == false)
     {
-        if (remapping_request_queue.size() < REMAPPING_REQUEST_QUEUE_LENGTH)
+        if (remapping_request_queue.full() == false)
         {
             if (remapping_request.address_in_fm == remapping_request.address_in_sm) // Check
             {
@@ -1326,8 +1343,8 @@ bool OS_TRANSPARENT_MANAGEMENT::enqueue_remapping_request(RemappingRequest& rema
                 std::abort();
             }
 
-            // Enqueue a remapping request
-            remapping_request_queue.push_back(remapping_request);
+            // Enqueue a remapping request, whose priority is the hotness of the data block moving into fast memory
+            remapping_request_queue.push(remapping_request, placement_table_index, counter_table.at(remapping_request.address_in_sm >> DATA_MANAGEMENT_OFFSET_BITS), cycle);
         }
         else
         {
@@ -1336,6 +1353,7 @@ bool OS_TRANSPARENT_MANAGEMENT::enqueue_remapping_request(RemappingRequest& rema
     }
     else
     {
+        remapping_request_queue.drop_duplicate();
         return false;
     }
     // New remapping request is issued.
@@ -1499,5 +1517,13 @@ START_ADDRESS_WIDTH OS_TRANSPARENT_MANAGEMENT::round_down_migration_granularity(
     return updated_end_address;
 }
 
+void OS_TRANSPARENT_MANAGEMENT::checkpoint(champsim::checkpoint_archive& archive)
+{
+    archive.section("OS_TRANSPARENT_MANAGEMENT");
+    archive.expect(total_capacity, "total capacity");
+    archive.expect(fast_memory_capacity, "fast memory capacity");
+    archive(cycle, hotness_threshold, counter_table, hotness_table, access_table, placement_table);
+}
+
 #endif /* IDEAL_VARIABLE_GRANULARITY */
 #endif /* MEMORY_USE_OS_TRANSPARENT_MANAGEMENT */
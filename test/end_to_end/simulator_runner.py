@@ -34,6 +34,11 @@ class Mode:
     ramulator2: bool       # RAMULATOR2 == ENABLE
     hybrid: bool           # MEMORY_USE_HYBRID == ENABLE
     multicore: bool        # CPU_USE_MULTIPLE_CORES == ENABLE
+    user_codes: bool          # USER_CODES == ENABLE (--checkpoint-out, --checkpoint-in)
+    functional_warmup: bool   # FUNCTIONAL_WARMUP == ENABLE (--functional-warmup-instructions)
+    sampled_simulation: bool  # SAMPLED_SIMULATION == ENABLE (--simpoints, --smarts)
+    sweep: bool               # MULTI_CONFIG_SWEEP == ENABLE (--sweep, with Ramulator 2.0)
+    cycle_engine: bool        # USE_OPENMP and PARALLEL_CYCLE_ENGINE == ENABLE (--threads)
 
     @property
     def name(self) -> str:
@@ -60,6 +65,12 @@ _TOGGLE_RE = {
     "ramulator2": re.compile(r"^\s*#define\s+RAMULATOR2\s+\((ENABLE|DISABLE)\)", re.M),
     "hybrid": re.compile(r"^\s*#define\s+MEMORY_USE_HYBRID\s+\((ENABLE|DISABLE)\)", re.M),
     "multicore": re.compile(r"^\s*#define\s+CPU_USE_MULTIPLE_CORES\s+\((ENABLE|DISABLE)\)", re.M),
+    "user_codes": re.compile(r"^\s*#define\s+USER_CODES\s+\((ENABLE|DISABLE)\)", re.M),
+    "functional_warmup": re.compile(r"^\s*#define\s+FUNCTIONAL_WARMUP\s+\((ENABLE|DISABLE)\)", re.M),
+    "sampled_simulation": re.compile(r"^\s*#define\s+SAMPLED_SIMULATION\s+\((ENABLE|DISABLE)\)", re.M),
+    "sweep": re.compile(r"^\s*#define\s+MULTI_CONFIG_SWEEP\s+\((ENABLE|DISABLE)\)", re.M),
+    "openmp": re.compile(r"^\s*#define\s+USE_OPENMP\s+\((ENABLE|DISABLE)\)", re.M),
+    "cycle_engine": re.compile(r"^\s*#define\s+PARALLEL_CYCLE_ENGINE\s+\((ENABLE|DISABLE)\)", re.M),
 }
 
 
@@ -83,6 +94,11 @@ def detect_mode_from_text(text: str) -> Mode:
         ramulator2=values["ramulator2"],
         hybrid=values["hybrid"],
         multicore=values["multicore"],
+        user_codes=values["user_codes"],
+        functional_warmup=values["functional_warmup"],
+        sampled_simulation=values["sampled_simulation"],
+        sweep=values["sweep"],
+        cycle_engine=values["openmp"] and values["cycle_engine"],
     )
 
 
@@ -133,19 +149,21 @@ class Execution:
         return self.statistics_path.is_file() and self.statistics_path.stat().st_size > 0
 
 
-def statistics_filename_for(trace: Path) -> str:
-    """The binary names its stats file ``<trace-basename>.statistics`` (see
+def statistics_filename_for(traces: list[Path]) -> str:
+    """The binary names its stats file after the trace basenames joined with "_",
+    ``<trace-basename>.statistics`` for a single trace (see
     DATA_OUTPUT::output_file_initialization in source/ProjectConfiguration.cc)."""
-    return trace.name + ".statistics"
+    return "_".join(trace.name for trace in traces) + ".statistics"
 
 
 def run_simulation(
     binary: Path,
     config_files: list[Path],
     traces: list[Path],
-    warmup: int,
-    simulation: int,
+    warmup: int | None,
+    simulation: int | None,
     workdir: Path,
+    extra_args: list[str] | None = None,
     timeout: float = 259200.0,  # In seconds (3 day = 72 hour = 259200 s)
 ) -> Execution:
     """Run the simulator with absolute paths, capturing stdout/stderr.
@@ -153,11 +171,16 @@ def run_simulation(
     ``workdir`` becomes the process CWD so the ``.statistics`` / ``.trace`` output
     files land there instead of polluting the repository. All other paths are made
     absolute so the choice of CWD does not affect argument resolution.
+
+    ``extra_args`` (e.g. ``["--smarts", "25000"]``) go before the config files,
+    since the binary takes every argument after its options as configs and traces.
+    A ``warmup`` or ``simulation`` of None leaves its option out, e.g. for ``--phase``.
     """
     argv = [
         os.fspath(binary.resolve()),
-        "--warmup-instructions", str(warmup),
-        "--simulation-instructions", str(simulation),
+        *(["--warmup-instructions", str(warmup)] if warmup is not None else []),
+        *(["--simulation-instructions", str(simulation)] if simulation is not None else []),
+        *(extra_args or []),
         *[os.fspath(c.resolve()) for c in config_files],
         *[os.fspath(t.resolve()) for t in traces],
     ]
@@ -171,8 +194,8 @@ def run_simulation(
         timeout=timeout,
     )
 
-    # The stats file is named after the first trace's basename.
-    statistics_path = workdir / statistics_filename_for(traces[0])
+    # The stats file is named after the traces' basenames.
+    statistics_path = workdir / statistics_filename_for(traces)
 
     return Execution(
         returncode=proc.returncode,
@@ -187,6 +210,7 @@ def run_simulation(
 
 _IPC_RE = re.compile(r"cumulative IPC:\s*([0-9]*\.?[0-9]+)")
 _L1D_RE = re.compile(r"cpu0->cpu0_L1D TOTAL\s+ACCESS:\s*([0-9]+)")
+_TOTAL_RE = re.compile(r"^(\S+) TOTAL\s+ACCESS:\s*([0-9]+)\s+HIT:\s*([0-9]+)\s+MISS:\s*([0-9]+)", re.M)
 
 
 @dataclass
@@ -196,6 +220,7 @@ class ParsedStatistics:
     last_cumulative_ipc: float | None
     l1d_total_access: int | None
     has_dram_section: bool
+    miss_ratios: dict[str, float]  # ROI misses per access of each cache and TLB, e.g. "cpu0->cpu0_L1D"
 
 
 def parse_statistics(text: str) -> ParsedStatistics:
@@ -203,10 +228,16 @@ def parse_statistics(text: str) -> ParsedStatistics:
 
     ipc_matches = _IPC_RE.findall(text)
     l1d_match = _L1D_RE.search(text)
+    miss_ratios = {
+        name: int(miss) / int(access)
+        for name, access, _, miss in _TOTAL_RE.findall(text)
+        if int(access) > 0
+    }
 
     return ParsedStatistics(
         completed=COMPLETION_MARKER in text,
         last_cumulative_ipc=float(ipc_matches[-1]) if ipc_matches else None,
         l1d_total_access=int(l1d_match.group(1)) if l1d_match else None,
         has_dram_section=("DRAM Statistics" in text),
+        miss_ratios=miss_ratios,
     )
@@ -9,6 +9,9 @@ All runs use a tmp_path working directory, so no .statistics/.trace files are le
 
 from __future__ import annotations
 
+import re
+import shutil
+import time
 import warnings
 from pathlib import Path
 
@@ -20,6 +23,7 @@ from simulator_runner import (
     config_args_for_mode,
     run_simulation,
     parse_statistics,
+    statistics_filename_for,
 )
 
 
@@ -118,3 +122,328 @@ def test_metrics_sane(run_result: Execution) -> None:
     assert stats.l1d_total_access is not None and stats.l1d_total_access > 0, (
         "Expected a positive cpu0 L1D total access count."
     )
+
+# Test case: warmup and sampling options
+
+
+# A checkpoint leaves out the requests in flight and the state inside Ramulator
+# (see ../../README.md), so a restored run only reproduces the ROI statistics closely,
+# even on a single core with the built-in DRAM: the instructions in the ROB at the end
+# of warmup are fetched and access the caches again. The checkpointed state itself
+# does not depend on them and must survive a restore exactly.
+CHECKPOINT_TOLERANCE = 0.05
+
+
+def _run_with_options(
+    binary: Path,
+    mode: Mode,
+    repository_root: Path,
+    trace: Path,
+    warmup: int | None,
+    simulation: int | None,
+    workdir: Path,
+    extra_args: list[str],
+) -> Execution:
+    RESULT = run_simulation(
+        binary=binary,
+        config_files=config_args_for_mode(mode, repository_root),
+        traces=[trace] * (2 if mode.multicore else 1),
+        warmup=warmup,
+        simulation=simulation,
+        workdir=workdir,
+        extra_args=extra_args,
+    )
+
+    assert (RESULT.returncode == 0) and RESULT.completed, (
+        f"Run did not complete ({RESULT.returncode}).\n"
+        f"argv: {RESULT.argv}\n"
+        f"stdout tail:\n{RESULT.stdout[-2000:]}\n"
+        f"stderr tail:\n{RESULT.stderr[-2000:]}"
+    )
+    assert RESULT.statistics_written, (
+        f"Expected non-empty statistics file at {RESULT.statistics_path}"
+    )
+
+    return RESULT
+
+
+def test_functional_warmup_completes(
+    get_binary_path: Path,
+    get_current_mode: Mode,
+    get_repository_root: Path,
+    find_trace: Path,
+    get_warmup: int,
+    get_simulation: int,
+    tmp_path: Path,
+) -> None:
+    if not get_current_mode.functional_warmup:
+        pytest.skip("Built without FUNCTIONAL_WARMUP.")
+
+    RESULT = _run_with_options(
+        get_binary_path, get_current_mode, get_repository_root, find_trace,
+        get_warmup, get_simulation, tmp_path,
+        ["--functional-warmup-instructions", str(get_warmup)],
+    )
+
+    assert "Functional warmup complete" in RESULT.stdout, (
+        f"No functional warmup phase in stdout.\nstdout tail:\n{RESULT.stdout[-2000:]}"
+    )
+    stats = parse_statistics(RESULT.statistics_path.read_text(encoding="utf-8", errors="replace"))
+    assert stats.last_cumulative_ipc is not None and stats.last_cumulative_ipc > 0.0
+
+
+# Functional warmup skips timing, so the ROI after it sees caches and TLBs close to, not exactly as, a detailed warmup leaves them.
+# Its speedup over a detailed warmup is reported against FUNCTIONAL_WARMUP_TARGET_SPEEDUP, not asserted, as it depends on the host.
+FUNCTIONAL_WARMUP_TOLERANCE = 0.02  # Absolute difference of ROI miss ratios
+FUNCTIONAL_WARMUP_TARGET_SPEEDUP = (20.0, 50.0)
+
+
+def test_functional_warmup_matches_detailed(
+    get_binary_path: Path,
+    get_current_mode: Mode,
+    get_repository_root: Path,
+    find_trace: Path,
+    get_warmup: int,
+    get_simulation: int,
+    tmp_path: Path,
+) -> None:
+    if not get_current_mode.functional_warmup:
+        pytest.skip("Built without FUNCTIONAL_WARMUP.")
+
+    def timed(name: str, phases: list[str]) -> tuple[Execution, float]:
+        start = time.perf_counter()
+        RESULT = _run_with_options(
+            get_binary_path, get_current_mode, get_repository_root, find_trace,
+            None, None, tmp_path / name,
+            [argument for phase in phases for argument in ("--phase", phase)],
+        )
+        return RESULT, time.perf_counter() - start
+
+    # Start-up, trace decoding and the ROI cost the same in every run, so they are measured alone and taken out
+    _, baseline_seconds = timed("baseline", [f"simulation:{get_simulation}"])
+    DETAILED, detailed_seconds = timed("detailed", [f"warmup:{get_warmup}", f"simulation:{get_simulation}"])
+    FUNCTIONAL, functional_seconds = timed("functional", [f"functional:{get_warmup}", f"simulation:{get_simulation}"])
+
+    detailed = parse_statistics(DETAILED.statistics_path.read_text(encoding="utf-8", errors="replace"))
+    functional = parse_statistics(FUNCTIONAL.statistics_path.read_text(encoding="utf-8", errors="replace"))
+
+    assert detailed.miss_ratios and detailed.miss_ratios.keys() == functional.miss_ratios.keys(), (
+        f"Expected the same caches and TLBs in both runs: {sorted(detailed.miss_ratios)} and {sorted(functional.miss_ratios)}"
+    )
+    for name, ratio in detailed.miss_ratios.items():
+        assert functional.miss_ratios[name] == pytest.approx(ratio, abs=FUNCTIONAL_WARMUP_TOLERANCE), (
+            f"{name} misses {functional.miss_ratios[name]:.4f} of its ROI accesses after functional warmup, "
+            f"but {ratio:.4f} after detailed warmup."
+        )
+
+    detailed_warmup_seconds = detailed_seconds - baseline_seconds
+    functional_warmup_seconds = max(functional_seconds - baseline_seconds, 1e-3)
+    speedup = detailed_warmup_seconds / functional_warmup_seconds
+    low, high = FUNCTIONAL_WARMUP_TARGET_SPEEDUP
+    print(
+        f"\nFunctional warmup of {get_warmup} instructions: {functional_warmup_seconds:.3f} s, "
+        f"detailed: {detailed_warmup_seconds:.3f} s, speedup {speedup:.1f}x (target {low:.0f}-{high:.0f}x)"
+    )
+    if speedup < low:
+        warnings.warn(f"Functional warmup is only {speedup:.1f}x faster than detailed warmup, below the {low:.0f}x target.", stacklevel=1)
+
+
+def test_phases_run_in_order(
+    get_binary_path: Path,
+    get_current_mode: Mode,
+    get_repository_root: Path,
+    find_trace: Path,
+    get_warmup: int,
+    get_simulation: int,
+    tmp_path: Path,
+) -> None:
+    if not get_current_mode.functional_warmup:
+        pytest.skip("Built without FUNCTIONAL_WARMUP.")
+
+    # Functional warmup and detailed warmup before each of two measured phases.
+    PHASES = [
+        f"functional:{get_warmup}", f"warmup:{get_warmup}", f"simulation:{get_simulation}",
+        f"functional:{get_warmup}", f"warmup:{get_warmup}", f"simulation:{get_simulation}",
+    ]
+    RESULT = _run_with_options(
+        get_binary_path, get_current_mode, get_repository_root, find_trace,
+        None, None, tmp_path,
+        [argument for phase in PHASES for argument in ("--phase", phase)],
+    )
+
+    NAMES = ["Functional warmup", "Warmup", "Simulation", "Functional warmup 2", "Warmup 2", "Simulation 2"]
+    positions = [RESULT.stdout.find(f"{name} complete") for name in NAMES]
+    assert all(position >= 0 for position in positions), (
+        f"Missing a phase among {NAMES}.\nstdout tail:\n{RESULT.stdout[-2000:]}"
+    )
+    assert positions == sorted(positions), f"Phases did not run in the order given: {NAMES}"
+
+
+def test_checkpoint_reproduces_statistics(
+    get_binary_path: Path,
+    get_current_mode: Mode,
+    get_repository_root: Path,
+    find_trace: Path,
+    get_warmup: int,
+    get_simulation: int,
+    tmp_path: Path,
+) -> None:
+    # Checkpointing (source/ChampSim/checkpoint.cc) comes with USER_CODES, whatever FUNCTIONAL_WARMUP is.
+    if not get_current_mode.user_codes:
+        pytest.skip("Built without USER_CODES.")
+
+    CHECKPOINT = tmp_path / "warmed_up.checkpoint"
+    RESAVED_CHECKPOINT = tmp_path / "restored.checkpoint"
+
+    SAVED = _run_with_options(
+        get_binary_path, get_current_mode, get_repository_root, find_trace,
+        get_warmup, get_simulation, tmp_path / "save",
+        ["--checkpoint-out", str(CHECKPOINT)],
+    )
+    assert CHECKPOINT.is_file() and CHECKPOINT.stat().st_size > 0, (
+        f"Expected a checkpoint at {CHECKPOINT}"
+    )
+
+    # The restored run saves its state again where the saving run did, right before the ROI
+    RESTORED = _run_with_options(
+        get_binary_path, get_current_mode, get_repository_root, find_trace,
+        get_warmup, get_simulation, tmp_path / "restore",
+        ["--checkpoint-in", str(CHECKPOINT), "--checkpoint-out", str(RESAVED_CHECKPOINT)],
+    )
+    assert "Warmup complete" not in RESTORED.stdout, "A restored run should skip the warmup phase."
+
+    # Caches and their replacement state, prefetchers, branch predictors and BTBs, page tables
+    # and remapping tables are restored exactly when saving them again gives the same bytes.
+    assert RESAVED_CHECKPOINT.is_file(), f"Expected a checkpoint at {RESAVED_CHECKPOINT}"
+    assert RESAVED_CHECKPOINT.read_bytes() == CHECKPOINT.read_bytes(), (
+        f"The state restored from {CHECKPOINT} and saved again to {RESAVED_CHECKPOINT} differs, "
+        "so a restore loses part of the warmed-up state."
+    )
+
+    saved = parse_statistics(SAVED.statistics_path.read_text(encoding="utf-8", errors="replace"))
+    restored = parse_statistics(RESTORED.statistics_path.read_text(encoding="utf-8", errors="replace"))
+
+    assert saved.last_cumulative_ipc and restored.last_cumulative_ipc, "No cumulative IPC found in statistics."
+    assert restored.last_cumulative_ipc == pytest.approx(saved.last_cumulative_ipc, rel=CHECKPOINT_TOLERANCE), (
+        f"Restored ROI IPC {restored.last_cumulative_ipc} differs from {saved.last_cumulative_ipc}"
+    )
+    assert saved.l1d_total_access and restored.l1d_total_access, "No cpu0 L1D total access count found."
+    assert restored.l1d_total_access == pytest.approx(saved.l1d_total_access, rel=CHECKPOINT_TOLERANCE), (
+        f"Restored ROI L1D accesses {restored.l1d_total_access} differ from {saved.l1d_total_access}"
+    )
+
+
+def test_smarts_hybrid_completes(
+    get_binary_path: Path,
+    get_current_mode: Mode,
+    get_repository_root: Path,
+    find_trace: Path,
+    get_warmup: int,
+    get_simulation: int,
+    tmp_path: Path,
+) -> None:
+    if not (get_current_mode.sampled_simulation and get_current_mode.hybrid):
+        pytest.skip("Needs SAMPLED_SIMULATION and MEMORY_USE_HYBRID.")
+
+    # Two samples, each reached by functional warmup from the end of the previous one.
+    RESULT = _run_with_options(
+        get_binary_path, get_current_mode, get_repository_root, find_trace,
+        get_warmup, get_simulation, tmp_path,
+        ["--smarts", str(get_simulation // 2), "--sample-instructions", str(get_simulation // 10)],
+    )
+
+    assert "Sample 1 complete" in RESULT.stdout, (
+        f"Expected a second sample in stdout.\nstdout tail:\n{RESULT.stdout[-2000:]}"
+    )
+    stats = parse_statistics(RESULT.statistics_path.read_text(encoding="utf-8", errors="replace"))
+    assert stats.last_cumulative_ipc is not None and stats.last_cumulative_ipc > 0.0
+
+
+def test_sweep_feeds_every_trace(
+    get_binary_path: Path,
+    get_current_mode: Mode,
+    get_repository_root: Path,
+    find_trace: Path,
+    get_warmup: int,
+    get_simulation: int,
+    tmp_path: Path,
+) -> None:
+    if not (get_current_mode.sweep and get_current_mode.user_codes and get_current_mode.ramulator2 and get_current_mode.multicore):
+        pytest.skip("Needs MULTI_CONFIG_SWEEP with USER_CODES, Ramulator 2.0 and CPU_USE_MULTIPLE_CORES.")
+
+    CONFIG_FILES = config_args_for_mode(get_current_mode, get_repository_root)
+    TRACES = [find_trace] * 2  # One ring per trace, read by the cores of each worker in lockstep
+
+    # The second configuration has the same memories under other names, so both workers write their own files
+    COPIES = [tmp_path / f"copy_{config.name}" for config in CONFIG_FILES]
+    for config, copy in zip(CONFIG_FILES, COPIES):
+        shutil.copyfile(config, copy)
+
+    SWEEP = run_simulation(
+        binary=get_binary_path,
+        config_files=CONFIG_FILES + COPIES,
+        traces=TRACES,
+        warmup=get_warmup,
+        simulation=get_simulation,
+        workdir=tmp_path / "sweep",
+        extra_args=["--sweep", "2"],
+    )
+    assert SWEEP.returncode == 0 and "2 of 2 configurations succeeded" in SWEEP.stdout, (
+        f"Sweep failed ({SWEEP.returncode}).\nstdout tail:\n{SWEEP.stdout[-2000:]}\nstderr tail:\n{SWEEP.stderr[-2000:]}"
+    )
+
+    ALONE = _run_with_options(
+        get_binary_path, get_current_mode, get_repository_root, find_trace,
+        get_warmup, get_simulation, tmp_path / "alone", [],
+    )
+    alone = parse_statistics(ALONE.statistics_path.read_text(encoding="utf-8", errors="replace"))
+
+    # A worker reads the instructions it would have read from the traces itself, so it reproduces a run without the sweep
+    for configs in (CONFIG_FILES, COPIES):
+        statistics_path = tmp_path / "sweep" / statistics_filename_for(configs + TRACES)
+        assert statistics_path.is_file(), f"Expected the statistics of a sweep worker at {statistics_path}"
+        worker = parse_statistics(statistics_path.read_text(encoding="utf-8", errors="replace"))
+        assert worker.last_cumulative_ipc == alone.last_cumulative_ipc, (
+            f"Sweep worker of {[c.name for c in configs]} has ROI IPC {worker.last_cumulative_ipc}, not {alone.last_cumulative_ipc}"
+        )
+        assert worker.l1d_total_access == alone.l1d_total_access
+
+
+# Wall time differs from run to run, and the cycle engine report names its threads
+_WALL_TIME_RE = re.compile(r"\(Simulation time: [^)]*\)|^.* cycle engine: .*$", re.M)
+
+
+def test_cycle_engine_matches_serial(
+    get_binary_path: Path,
+    get_current_mode: Mode,
+    get_repository_root: Path,
+    find_trace: Path,
+    get_warmup: int,
+    get_simulation: int,
+    tmp_path: Path,
+) -> None:
+    if not (get_current_mode.cycle_engine and get_current_mode.user_codes and get_current_mode.multicore):
+        pytest.skip("Needs PARALLEL_CYCLE_ENGINE with USER_CODES and CPU_USE_MULTIPLE_CORES.")
+
+    RUNS = {
+        threads: _run_with_options(
+            get_binary_path, get_current_mode, get_repository_root, find_trace,
+            get_warmup, get_simulation, tmp_path / f"threads_{threads}",
+            ["--threads", str(threads)],
+        )
+        for threads in (1, 2)
+    }
+
+    for threads, run in RUNS.items():
+        assert f"cycle engine: 2 CPUs on {threads} threads" in run.stdout, (
+            f"No cycle engine report for {threads} threads.\nstdout tail:\n{run.stdout[-2000:]}"
+        )
+
+    # Each CPU's private components on their own thread simulate exactly the cycles of the serial loop
+    serial, parallel = (
+        _WALL_TIME_RE.sub("", RUNS[threads].statistics_path.read_text(encoding="utf-8", errors="replace"))
+        for threads in (1, 2)
+    )
+    assert parallel == serial, (
+        f"Statistics of --threads 2 differ from --threads 1 ({RUNS[2].statistics_path} against {RUNS[1].statistics_path})"
+    )